@@ -281,6 +281,11 @@ void Catalog::updateTableDescriptorSchema() {
                          std::to_string(-1));
       sqliteConnector_.query(queryString);
     }
+    if (std::find(cols.begin(), cols.end(), std::string("page_compression")) ==
+        cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD page_compression TEXT DEFAULT ''");
+    }
   } catch (std::exception& e) {
     sqliteConnector_.query("ROLLBACK TRANSACTION");
     throw;
@@ -509,6 +514,28 @@ void Catalog::updateDeletedColumnIndicator() {
   sqliteConnector_.query("END TRANSACTION");
 }
 
+void Catalog::updateBloomFilterColumnIndicator() {
+  cat_sqlite_lock sqlite_lock(getObjForLock());
+  sqliteConnector_.query("BEGIN TRANSACTION");
+  try {
+    sqliteConnector_.query("PRAGMA TABLE_INFO(mapd_columns)");
+    std::vector<std::string> cols;
+    for (size_t i = 0; i < sqliteConnector_.getNumRows(); i++) {
+      cols.push_back(sqliteConnector_.getData<std::string>(i, 1));
+    }
+    if (std::find(cols.begin(), cols.end(), std::string("has_bloom_filter")) ==
+        cols.end()) {
+      LOG(INFO) << "Updating mapd_columns updateBloomFilterColumnIndicator";
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_columns ADD has_bloom_filter boolean default 0");
+    }
+  } catch (std::exception& e) {
+    sqliteConnector_.query("ROLLBACK TRANSACTION");
+    throw;
+  }
+  sqliteConnector_.query("END TRANSACTION");
+}
+
 // introduce DB version into the dictionary tables
 // if the DB does not have a version rename all dictionary tables
 
@@ -894,6 +921,7 @@ void Catalog::CheckAndExecuteMigrations() {
   updateDictionarySchema();
   updatePageSize();
   updateDeletedColumnIndicator();
+  updateBloomFilterColumnIndicator();
   updateFrontendViewsToDashboards();
   recordOwnershipOfObjectsInObjectPermissions();
   if (g_enable_fsi) {
@@ -944,7 +972,7 @@ void Catalog::buildMaps() {
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, "
       "max_chunk_size, frag_page_size, "
       "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, userid, "
-      "sort_column_id, storage_type, max_rollback_epochs "
+      "sort_column_id, storage_type, max_rollback_epochs, page_compression "
       "from mapd_tables");
   sqliteConnector_.query(tableQuery);
   numRows = sqliteConnector_.getNumRows();
@@ -990,6 +1018,7 @@ void Catalog::buildMaps() {
       td->fragmenter = nullptr;
     }
     td->maxRollbackEpochs = sqliteConnector_.getData<int>(r, 18);
+    td->pageCompression = sqliteConnector_.getData<string>(r, 19);
     td->hasDeletedCol = false;
 
     tableDescriptorMap_[to_upper(td->tableName)] = td;
@@ -1005,8 +1034,8 @@ void Catalog::buildMaps() {
   string columnQuery(
       "SELECT tableid, columnid, name, coltype, colsubtype, coldim, colscale, "
       "is_notnull, compression, comp_param, "
-      "size, chunks, is_systemcol, is_virtualcol, virtual_expr, is_deletedcol from "
-      "mapd_columns ORDER BY tableid, "
+      "size, chunks, is_systemcol, is_virtualcol, virtual_expr, is_deletedcol, "
+      "has_bloom_filter from mapd_columns ORDER BY tableid, "
       "columnid");
   sqliteConnector_.query(columnQuery);
   numRows = sqliteConnector_.getNumRows();
@@ -1029,6 +1058,7 @@ void Catalog::buildMaps() {
     cd->isVirtualCol = sqliteConnector_.getData<bool>(r, 13);
     cd->virtualExpr = sqliteConnector_.getData<string>(r, 14);
     cd->isDeletedCol = sqliteConnector_.getData<bool>(r, 15);
+    cd->hasBloomFilter = sqliteConnector_.getData<bool>(r, 16);
     cd->isGeoPhyCol = skip_physical_cols > 0;
     ColumnKey columnKey(cd->tableId, to_upper(cd->columnName));
     columnDescriptorMap_[columnKey] = cd;
@@ -1924,12 +1954,12 @@ void Catalog::addColumn(const TableDescriptor& td, ColumnDescriptor& cd) {
       "INSERT INTO mapd_columns (tableid, columnid, name, coltype, colsubtype, coldim, "
       "colscale, is_notnull, "
       "compression, comp_param, size, chunks, is_systemcol, is_virtualcol, virtual_expr, "
-      "is_deletedcol) "
+      "is_deletedcol, has_bloom_filter) "
       "VALUES (?, "
       "(SELECT max(columnid) + 1 FROM mapd_columns WHERE tableid = ?), "
       "?, ?, ?, "
       "?, "
-      "?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+      "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
       std::vector<std::string>{std::to_string(td.tableId),
                                std::to_string(td.tableId),
                                cd.columnName,
@@ -1945,7 +1975,8 @@ void Catalog::addColumn(const TableDescriptor& td, ColumnDescriptor& cd) {
                                std::to_string(cd.isSystemCol),
                                std::to_string(cd.isVirtualCol),
                                cd.virtualExpr,
-                               std::to_string(cd.isDeletedCol)});
+                               std::to_string(cd.isDeletedCol),
+                               std::to_string(cd.hasBloomFilter)});
 
   sqliteConnector_.query_with_text_params(
       "UPDATE mapd_tables SET ncolumns = ncolumns + 1 WHERE tableid = ?",
@@ -2258,7 +2289,7 @@ void Catalog::createTable(
   if (td.persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     try {
       sqliteConnector_.query_with_text_params(
-          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, key_metainfo) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
+          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, page_compression, key_metainfo) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
           std::vector<std::string>{td.tableName,
                                    std::to_string(td.userId),
                                    std::to_string(td.nColumns),
@@ -2276,6 +2307,7 @@ void Catalog::createTable(
                                    std::to_string(td.sortedColumnId),
                                    td.storageType,
                                    std::to_string(td.maxRollbackEpochs),
+                                   td.pageCompression,
                                    td.keyMetainfo});
 
       // now get the auto generated tableid
@@ -2306,10 +2338,10 @@ void Catalog::createTable(
             "INSERT INTO mapd_columns (tableid, columnid, name, coltype, colsubtype, "
             "coldim, colscale, is_notnull, "
             "compression, comp_param, size, chunks, is_systemcol, is_virtualcol, "
-            "virtual_expr, is_deletedcol) "
+            "virtual_expr, is_deletedcol, has_bloom_filter) "
             "VALUES (?, ?, ?, ?, ?, "
             "?, "
-            "?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
             std::vector<std::string>{std::to_string(td.tableId),
                                      std::to_string(colId),
                                      cd.columnName,
@@ -2325,7 +2357,8 @@ void Catalog::createTable(
                                      std::to_string(cd.isSystemCol),
                                      std::to_string(cd.isVirtualCol),
                                      cd.virtualExpr,
-                                     std::to_string(cd.isDeletedCol)});
+                                     std::to_string(cd.isDeletedCol),
+                                     std::to_string(cd.hasBloomFilter)});
         cd.tableId = td.tableId;
         cd.columnId = colId++;
         cds.push_back(cd);
@@ -2871,6 +2904,7 @@ void Catalog::setTableEpoch(const int db_id, const int table_id, int new_epoch)
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.epoch = new_epoch;
   file_mgr_params.max_rollback_epochs = td->maxRollbackEpochs;
+  file_mgr_params.page_compression = td->pageCompression;
 
   const auto physicalTableIt = logicalToPhysicalTableMapById_.find(table_id);
   if (physicalTableIt != logicalToPhysicalTableMapById_.end()) {
@@ -2971,6 +3005,7 @@ void Catalog::setMaxRollbackEpochs(const int32_t table_id,
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.epoch = -1;  // Use existing epoch
   file_mgr_params.max_rollback_epochs = max_rollback_epochs;
+  file_mgr_params.page_compression = td->pageCompression;
   setTableFileMgrParams(table_id, file_mgr_params);
   // Unlock as alterTableCatalogMetadata will take write lock, and Catalog locks are not
   // upgradeable Should be safe as we have schema lock on this table
@@ -3008,6 +3043,7 @@ void Catalog::setUncappedTableEpoch(const std::string& table_name) {
 
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.max_rollback_epochs = -1;
+  file_mgr_params.page_compression = td->pageCompression;
   setTableFileMgrParams(td->tableId, file_mgr_params);
 }
 
@@ -3080,6 +3116,7 @@ void Catalog::setTableEpochs(const int32_t db_id,
   CHECK(td);
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.max_rollback_epochs = td->maxRollbackEpochs;
+  file_mgr_params.page_compression = td->pageCompression;
 
   cat_read_lock read_lock(this);
   for (const auto& table_epoch_info : table_epochs) {
@@ -4425,9 +4462,13 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
   std::string comma;
   std::vector<std::string> shared_dicts;
   std::map<const std::string, const ColumnDescriptor*> dict_root_cds;
+  std::vector<std::string> bloom_filter_columns;
   for (const auto cd : cds) {
     if (!(cd->isSystemCol || cd->isVirtualCol)) {
       const auto& ti = cd->columnType;
+      if (cd->hasBloomFilter) {
+        bloom_filter_columns.push_back(cd->columnName);
+      }
       os << comma << cd->columnName;
       // CHAR is perculiar... better dump it as TEXT(32) like \d does
       if (ti.get_type() == SQLTypes::kCHAR) {
@@ -4468,6 +4509,8 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
                  (ti.get_size() > 0 && ti.get_size() != ti.get_logical_size())) {
         const auto comp_param = ti.get_comp_param() ? ti.get_comp_param() : 32;
         os << " ENCODING " << ti.get_compression_name() << "(" << comp_param << ")";
+      } else if (ti.get_compression() == kENCODING_RL) {
+        os << " ENCODING " << ti.get_compression_name();
       } else if (ti.is_geometry()) {
         if (ti.get_compression() == kENCODING_GEOINT) {
           os << " ENCODING " << ti.get_compression_name() << "(" << ti.get_comp_param()
@@ -4507,11 +4550,18 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  if (!bloom_filter_columns.empty()) {
+    with_options.push_back("BLOOM_FILTER='" +
+                           boost::algorithm::join(bloom_filter_columns, ",") + "'");
+  }
   if (td->maxRollbackEpochs != DEFAULT_MAX_ROLLBACK_EPOCHS &&
       td->maxRollbackEpochs != -1) {
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
                            std::to_string(td->maxRollbackEpochs));
   }
+  if (!td->pageCompression.empty()) {
+    with_options.push_back("PAGE_COMPRESSION='" + td->pageCompression + "'");
+  }
   os << ") WITH (" + boost::algorithm::join(with_options, ", ") + ");";
   return os.str();
 }
@@ -4567,10 +4617,14 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
   // gather column defines
   const auto cds = getAllColumnMetadataForTable(td->tableId, false, false, false);
   std::map<const std::string, const ColumnDescriptor*> dict_root_cds;
+  std::vector<std::string> bloom_filter_columns;
   bool first = true;
   for (const auto cd : cds) {
     if (!(cd->isSystemCol || cd->isVirtualCol)) {
       const auto& ti = cd->columnType;
+      if (cd->hasBloomFilter) {
+        bloom_filter_columns.push_back(cd->columnName);
+      }
       if (!first) {
         os << ",";
         if (!multiline_formatting) {
@@ -4610,6 +4664,8 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
                    (ti.get_size() > 0 && ti.get_size() != ti.get_logical_size())) {
           const auto comp_param = ti.get_comp_param() ? ti.get_comp_param() : 32;
           os << " ENCODING " << ti.get_compression_name() << "(" << comp_param << ")";
+        } else if (ti.get_compression() == kENCODING_RL) {
+          os << " ENCODING " << ti.get_compression_name();
         } else if (ti.is_geometry()) {
           if (ti.get_compression() == kENCODING_GEOINT) {
             os << " ENCODING " << ti.get_compression_name() << "(" << ti.get_comp_param()
@@ -4666,6 +4722,11 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
                            std::to_string(td->maxRollbackEpochs));
   }
+  if (!foreign_table && (dump_defaults || !td->pageCompression.empty())) {
+    with_options.push_back("PAGE_COMPRESSION='" +
+                           (td->pageCompression.empty() ? "NONE" : td->pageCompression) +
+                           "'");
+  }
   if (!foreign_table && (dump_defaults || !td->hasDeletedCol)) {
     with_options.push_back(td->hasDeletedCol ? "VACUUM='DELAYED'" : "VACUUM='IMMEDIATE'");
   }
@@ -4684,6 +4745,10 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  if (!foreign_table && !bloom_filter_columns.empty()) {
+    with_options.push_back("BLOOM_FILTER='" +
+                           boost::algorithm::join(bloom_filter_columns, ",") + "'");
+  }
 
   if (!with_options.empty()) {
     if (!multiline_formatting) {
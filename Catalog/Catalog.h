@@ -558,6 +558,7 @@ class Catalog final {
   void updateDictionarySchema();
   void updatePageSize();
   void updateDeletedColumnIndicator();
+  void updateBloomFilterColumnIndicator();
   void updateFrontendViewsToDashboards();
   void updateCustomExpressionsSchema();
   void updateFsiSchemas();
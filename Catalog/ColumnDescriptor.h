@@ -40,6 +40,7 @@ struct ColumnDescriptor {
   std::string virtualExpr;
   bool isDeletedCol;
   bool isGeoPhyCol{false};
+  bool hasBloomFilter{false};  // set through the BLOOM_FILTER table option
 
   ColumnDescriptor() : isSystemCol(false), isVirtualCol(false), isDeletedCol(false) {}
   ColumnDescriptor(const int tableId,
@@ -32,6 +32,7 @@
 #include "QueryEngine/Execute.h"  // Executor::getArenaBlockSize()
 #include "QueryEngine/ExternalCacheInvalidators.h"
 #include "QueryEngine/ResultSetBuilder.h"
+#include "QueryEngine/ResultSetRecycler.h"
 
 extern bool g_enable_fsi;
 extern bool g_enable_s3_fsi;
@@ -141,6 +142,11 @@ std::unique_ptr<RexLiteral> genLiteralBigInt(int64_t val) {
       new RexLiteral(val, SQLTypes::kBIGINT, SQLTypes::kBIGINT, 0, 8, 0, 8));
 }
 
+std::unique_ptr<RexLiteral> genLiteralDouble(double val) {
+  return std::unique_ptr<RexLiteral>(
+      new RexLiteral(val, SQLTypes::kDOUBLE, SQLTypes::kDOUBLE, 0, 0, 0, 0));
+}
+
 std::unique_ptr<RexLiteral> genLiteralBoolean(bool val) {
   return std::unique_ptr<RexLiteral>(
       // new RexLiteral(val, SQLTypes::kBOOLEAN, SQLTypes::kBOOLEAN, 0, 0, 0, 0));
@@ -395,6 +401,8 @@ ExecutionResult DdlCommandExecutor::execute() {
     LOG(ERROR) << "SHOW QUERIES DDL is not ready yet!\n";
   } else if (ddl_command_ == "SHOW_DISK_CACHE_USAGE") {
     result = ShowDiskCacheUsageCommand{*ddl_data_, session_ptr_}.execute();
+  } else if (ddl_command_ == "SHOW_RESULT_CACHE_USAGE") {
+    result = ShowResultCacheUsageCommand{*ddl_data_, session_ptr_}.execute();
   } else if (ddl_command_ == "KILL_QUERY") {
     auto& ddl_payload = extractPayload(*ddl_data_);
     CHECK(ddl_payload.HasMember("querySession"));
@@ -1334,10 +1342,12 @@ ExecutionResult RefreshForeignTablesCommand::execute() {
   for (const auto& table_name_json : ddl_payload["tableNames"].GetArray()) {
     std::string table_name = table_name_json.GetString();
     foreign_storage::refresh_foreign_table(cat, table_name, evict_cached_entries);
+    const auto td = cat.getMetadataForTable(table_name, false);
+    CHECK(td);
+    UpdateTriggeredCacheInvalidator::invalidateCachesByTable(cat.getDatabaseId(),
+                                                             td->tableId);
   }
 
-  UpdateTriggeredCacheInvalidator::invalidateCaches();
-
   return ExecutionResult();
 }
 
@@ -1519,3 +1529,40 @@ ExecutionResult ShowDiskCacheUsageCommand::execute() {
 
   return ExecutionResult(rSet, label_infos);
 }
+
+ShowResultCacheUsageCommand::ShowResultCacheUsageCommand(
+    const DdlCommandData& ddl_data,
+    std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr)
+    : DdlCommand(ddl_data, session_ptr) {}
+
+ExecutionResult ShowResultCacheUsageCommand::execute() {
+  const auto stats = ResultSetRecycler::getInstance().getStats();
+
+  // label_infos -> column labels
+  std::vector<TargetMetaInfo> label_infos;
+  label_infos.emplace_back("entries", SQLTypeInfo(kBIGINT, true));
+  label_infos.emplace_back("current cache size", SQLTypeInfo(kBIGINT, true));
+  label_infos.emplace_back("max cache size", SQLTypeInfo(kBIGINT, true));
+  label_infos.emplace_back("hits", SQLTypeInfo(kBIGINT, true));
+  label_infos.emplace_back("misses", SQLTypeInfo(kBIGINT, true));
+  label_infos.emplace_back("hit rate", SQLTypeInfo(kDOUBLE, true));
+  label_infos.emplace_back("evictions", SQLTypeInfo(kBIGINT, true));
+
+  // logical_values -> table data
+  const auto lookups = stats.hits + stats.misses;
+  std::vector<RelLogicalValues::RowValues> logical_values;
+  logical_values.emplace_back(RelLogicalValues::RowValues{});
+  logical_values.back().emplace_back(genLiteralBigInt(stats.num_entries));
+  logical_values.back().emplace_back(genLiteralBigInt(stats.total_size_bytes));
+  logical_values.back().emplace_back(genLiteralBigInt(stats.max_size_bytes));
+  logical_values.back().emplace_back(genLiteralBigInt(stats.hits));
+  logical_values.back().emplace_back(genLiteralBigInt(stats.misses));
+  logical_values.back().emplace_back(
+      genLiteralDouble(lookups ? static_cast<double>(stats.hits) / lookups : 0.0));
+  logical_values.back().emplace_back(genLiteralBigInt(stats.evictions));
+
+  std::shared_ptr<ResultSet> rSet = std::shared_ptr<ResultSet>(
+      ResultSetLogicalValuesBuilder::create(label_infos, logical_values));
+
+  return ExecutionResult(rSet, label_infos);
+}
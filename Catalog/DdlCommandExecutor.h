@@ -173,6 +173,15 @@ class ShowDiskCacheUsageCommand : public DdlCommand {
   std::vector<std::string> getFilteredTableNames();
 };
 
+class ShowResultCacheUsageCommand : public DdlCommand {
+ public:
+  ShowResultCacheUsageCommand(
+      const DdlCommandData& ddl_data,
+      std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr);
+
+  ExecutionResult execute() override;
+};
+
 class RefreshForeignTablesCommand : public DdlCommand {
  public:
   RefreshForeignTablesCommand(
@@ -1141,6 +1141,7 @@ void SysCatalog::createDatabase(const string& name, int owner) {
         "comp_param integer, size integer, chunks text, is_systemcol boolean, "
         "is_virtualcol boolean, virtual_expr "
         "text, is_deletedcol boolean, version_num BIGINT, "
+        "has_bloom_filter boolean default 0, "
         "primary key(tableid, columnid), unique(tableid, name))");
     dbConn->query(
         "CREATE TABLE mapd_views (tableid integer references mapd_tables, sql text)");
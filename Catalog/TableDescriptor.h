@@ -75,6 +75,7 @@ struct TableDescriptor {
   std::string storageType;          // foreign/local storage
 
   int32_t maxRollbackEpochs;
+  std::string pageCompression;  // codec of new data pages, empty for uncompressed
 
   // write mutex, only to be used inside catalog package
   std::shared_ptr<std::mutex> mutex_;
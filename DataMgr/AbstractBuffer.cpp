@@ -36,6 +36,7 @@ void AbstractBuffer::syncEncoder(const AbstractBuffer* src_buffer) {
       initEncoder(src_buffer->sql_type_);
     }
     encoder_->copyMetadata(src_buffer->encoder_.get());
+    encoder_->copyBloomFilter(src_buffer->encoder_.get());
   } else {
     encoder_ = nullptr;
   }
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/Allocators/ArenaAllocator.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "OSDependent/omnisci_memory.h"
+
+bool g_enable_transparent_huge_pages{false};
+bool g_use_explicit_huge_pages{false};
+
+namespace {
+
+std::mutex huge_page_blocks_mutex;
+std::unordered_map<void*, size_t> huge_page_blocks;
+// spares the malloc path the lock when no block is on huge pages
+std::atomic<size_t> num_huge_page_blocks{0};
+
+}  // namespace
+
+void* allocate_arena_block(const size_t num_bytes) {
+  if ((g_enable_transparent_huge_pages || g_use_explicit_huge_pages) &&
+      num_bytes >= omnisci::get_huge_page_size()) {
+    if (auto ptr = omnisci::map_huge_pages(num_bytes, g_use_explicit_huge_pages)) {
+      std::lock_guard<std::mutex> lock(huge_page_blocks_mutex);
+      huge_page_blocks.emplace(ptr, num_bytes);
+      ++num_huge_page_blocks;
+      return ptr;
+    }
+    VLOG(1) << "Could not map " << num_bytes << " bytes on "
+            << (g_use_explicit_huge_pages ? "explicit" : "transparent")
+            << " huge pages, using regular pages";
+  }
+  return checked_malloc(num_bytes);
+}
+
+void free_arena_block(void* ptr) {
+  if (num_huge_page_blocks) {
+    std::unique_lock<std::mutex> lock(huge_page_blocks_mutex);
+    auto it = huge_page_blocks.find(ptr);
+    if (it != huge_page_blocks.end()) {
+      const auto num_bytes = it->second;
+      huge_page_blocks.erase(it);
+      --num_huge_page_blocks;
+      lock.unlock();
+      omnisci::unmap_huge_pages(ptr, num_bytes);
+      return;
+    }
+  }
+  free(ptr);
+}
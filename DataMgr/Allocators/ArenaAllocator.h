@@ -19,6 +19,15 @@
 #include "DataMgr/DataMgr.h"
 #include "Shared/checked_alloc.h"
 
+/**
+ * Allocates the blocks of arenas. Blocks of at least a huge page are mapped on huge
+ * pages when enabled, so that scans of large slabs and output buffers take fewer TLB
+ * misses and page faults. Smaller blocks and blocks which could not be mapped on huge
+ * pages, e.g. because the explicit huge page pool is exhausted, use malloc.
+ */
+void* allocate_arena_block(const size_t num_bytes);
+void free_arena_block(void* ptr);
+
 template <class T>
 class SysAllocator {
  public:
@@ -33,10 +42,10 @@ class SysAllocator {
   constexpr SysAllocator(const SysAllocator<U>&) noexcept {}
 
   [[nodiscard]] T* allocate(size_t count) {
-    return reinterpret_cast<T*>(checked_malloc(count));
+    return reinterpret_cast<T*>(allocate_arena_block(count));
   }
 
-  void deallocate(T* p, size_t /* count */) { free(p); }
+  void deallocate(T* p, size_t /* count */) { free_arena_block(p); }
 
   friend bool operator==(Self const&, Self const&) noexcept { return true; }
   friend bool operator!=(Self const&, Self const&) noexcept { return false; }
@@ -22,6 +22,7 @@
 #include "DataMgr/BufferMgr/BufferMgr.h"
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <limits>
 
@@ -32,6 +33,23 @@
 
 using namespace std;
 
+bool g_enable_segmented_lru_buffer_pool{true};
+
+namespace {
+
+// Share of the allocated pages the protected segment may hold, the rest of the pool is
+// left to probationary chunks so that a scan cycles through it rather than the hot set.
+constexpr size_t kMaxProtectedPagesPercent{80};
+
+// Lowest score is evicted first: probationary before protected segments, and least
+// recently used first within a segment.
+uint64_t eviction_score(const Buffer_Namespace::BufferSeg& seg) {
+  return (static_cast<uint64_t>(seg.tier == Buffer_Namespace::PROTECTED) << 32) |
+         seg.last_touched;
+}
+
+}  // namespace
+
 namespace Buffer_Namespace {
 
 std::string BufferMgr::keyToString(const ChunkKey& key) {
@@ -60,7 +78,8 @@ BufferMgr::BufferMgr(const int device_id,
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
-    , buffer_epoch_(0) {
+    , buffer_epoch_(0)
+    , num_protected_pages_(0) {
   CHECK(max_buffer_pool_size_ > 0);
   CHECK(page_size_ > 0);
   // TODO change checks on run-time configurable slab size variables to exceptions
@@ -103,6 +122,10 @@ void BufferMgr::clear() {
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
+  slab_numa_nodes_.clear();
+  free_segs_.clear();
+  protected_segs_.clear();
+  num_protected_pages_ = 0;
   buffer_epoch_ = 0;
 }
 
@@ -161,9 +184,16 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   while (num_pages < num_pages_requested) {
     if (evict_it->mem_status == USED) {
       CHECK(evict_it->buffer->getPinCount() < 1);
+      unprotectSegment(*evict_it);
+    } else {
+      removeFreeSegment(slab_num, evict_it);
     }
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
+      if (evict_it->chunk_key.size() > 1 && evict_it->chunk_key[0] != -1) {
+        std::lock_guard<std::mutex> table_stats_lock(table_stats_mutex_);
+        table_stats_[{evict_it->chunk_key[0], evict_it->chunk_key[1]}].num_evictions++;
+      }
       chunk_index_.erase(evict_it->chunk_key);
     }
     evict_it = slab_segments_[slab_num].erase(
@@ -180,11 +210,13 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     size_t excess_pages = num_pages - num_pages_requested;
     if (evict_it != slab_segments_[slab_num].end() &&
         evict_it->mem_status == FREE) {  // need to merge with current page
+      removeFreeSegment(slab_num, evict_it);
       evict_it->start_page = start_page + num_pages_requested;
       evict_it->num_pages += excess_pages;
+      addFreeSegment(slab_num, evict_it);
     } else {  // need to insert a free seg before evict_it for excess_pages
       BufferSeg free_seg(start_page + num_pages_requested, excess_pages, FREE);
-      slab_segments_[slab_num].insert(evict_it, free_seg);
+      addFreeSegment(slab_num, slab_segments_[slab_num].insert(evict_it, free_seg));
     }
   }
   return data_seg_it;
@@ -209,15 +241,21 @@ BufferList::iterator BufferMgr::reserveBuffer(
         next_it->num_pages >= num_pages_extra_needed) {
       // Then we can just use the next BufferSeg which happens to be free
       size_t leftover_pages = next_it->num_pages - num_pages_extra_needed;
+      removeFreeSegment(slab_num, next_it);
+      if (seg_it->tier == PROTECTED) {
+        num_protected_pages_ += num_pages_extra_needed;
+      }
       seg_it->num_pages = num_pages_requested;
       next_it->num_pages = leftover_pages;
       next_it->start_page = seg_it->start_page + seg_it->num_pages;
+      addFreeSegment(slab_num, next_it);
       return seg_it;
     }
   }
   // If we're here then we couldn't keep buffer in existing slot
   // need to find new segment, copy data over, and then delete old
-  auto new_seg_it = findFreeBuffer(num_bytes);
+  auto new_seg_it =
+      findFreeBuffer(num_bytes, getNumaNodeForChunk(seg_it->chunk_key));
 
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
@@ -236,7 +274,11 @@ BufferList::iterator BufferMgr::reserveBuffer(
                                   device_id_);
   }
   // Decrement pin count to reverse effect above
+  const bool is_protected = seg_it->tier == PROTECTED;
   removeSegment(seg_it);
+  if (is_protected) {
+    protectSegment(new_seg_it);
+  }
   {
     std::lock_guard<std::mutex> lock(chunk_index_mutex_);
     chunk_index_[new_seg_it->chunk_key] = new_seg_it;
@@ -247,33 +289,36 @@ BufferList::iterator BufferMgr::reserveBuffer(
 
 BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
                                                      const size_t num_pages_requested) {
-  for (auto buffer_it = slab_segments_[slab_num].begin();
-       buffer_it != slab_segments_[slab_num].end();
-       ++buffer_it) {
-    if (buffer_it->mem_status == FREE && buffer_it->num_pages >= num_pages_requested) {
-      // startPage doesn't change
-      size_t excess_pages = buffer_it->num_pages - num_pages_requested;
-      buffer_it->num_pages = num_pages_requested;
-      buffer_it->mem_status = USED;
-      buffer_it->last_touched = buffer_epoch_++;
-      buffer_it->slab_num = slab_num;
-      if (excess_pages > 0) {
-        BufferSeg free_seg(
-            buffer_it->start_page + num_pages_requested, excess_pages, FREE);
-        auto temp_it = buffer_it;  // this should make a copy and not be a reference
-        // - as we do not want to increment buffer_it
-        temp_it++;
-        slab_segments_[slab_num].insert(temp_it, free_seg);
-      }
-      return buffer_it;
-    }
+  // Best fit over the free segments of the slab
+  const int numa_node = slab_numa_nodes_[slab_num];
+  auto free_it = free_segs_.lower_bound({numa_node, num_pages_requested});
+  while (free_it != free_segs_.end() && free_it->first.first == numa_node &&
+         free_it->second.first != static_cast<int>(slab_num)) {
+    ++free_it;
   }
-  // If here then we did not find a free buffer of sufficient size in this slab,
-  // return the end iterator
-  return slab_segments_[slab_num].end();
+  if (free_it == free_segs_.end() || free_it->first.first != numa_node) {
+    // If here then we did not find a free buffer of sufficient size in this slab,
+    // return the end iterator
+    return slab_segments_[slab_num].end();
+  }
+  auto buffer_it = free_it->second.second;
+  free_segs_.erase(free_it);
+  // startPage doesn't change
+  size_t excess_pages = buffer_it->num_pages - num_pages_requested;
+  buffer_it->num_pages = num_pages_requested;
+  buffer_it->mem_status = USED;
+  buffer_it->last_touched = buffer_epoch_++;
+  buffer_it->tier = PROBATIONARY;
+  buffer_it->slab_num = slab_num;
+  if (excess_pages > 0) {
+    BufferSeg free_seg(buffer_it->start_page + num_pages_requested, excess_pages, FREE);
+    addFreeSegment(slab_num,
+                   slab_segments_[slab_num].insert(std::next(buffer_it), free_seg));
+  }
+  return buffer_it;
 }
 
-BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
+BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes, const int numa_node) {
   size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
   if (num_pages_requested > max_num_pages_per_slab_) {
     throw TooBigForSlab(num_bytes);
@@ -281,11 +326,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t num_slabs = slab_segments_.size();
 
-  for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
-    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
-    if (seg_it != slab_segments_[slab_num].end()) {
-      return seg_it;
-    }
+  const int free_slab_num = findBestFitSlab(num_pages_requested, numa_node);
+  if (free_slab_num >= 0) {
+    return findFreeBufferInSlab(free_slab_num, num_pages_requested);
   }
 
   // If we're here then we didn't find a free segment of sufficient size
@@ -309,6 +352,18 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
       }
       // if here then addSlab succeeded
       num_pages_allocated_ += current_max_slab_page_size_;
+      if (numa_node >= 0 &&
+          !bindSlabToNumaNode(
+              num_slabs, current_max_slab_page_size_ * page_size_, numa_node)) {
+        LOG(WARNING) << "ALLOCATION could not bind slab " << num_slabs
+                     << " to NUMA node " << numa_node << " " << getStringMgrType()
+                     << ":" << device_id_;
+      }
+      // the slab counts as the node's even if it could not be bound, otherwise every
+      // allocation for the node would add another slab
+      slab_numa_nodes_.push_back(numa_node);
+      prefaultSlab(num_slabs, current_max_slab_page_size_ * page_size_);
+      addFreeSegment(num_slabs, slab_segments_[num_slabs].begin());
       return findFreeBufferInSlab(
           num_slabs,
           num_pages_requested);  // has to succeed since we made sure to request a slab
@@ -343,67 +398,70 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
     throw FailedToCreateFirstSlab(num_bytes);
   }
 
+  // Remote memory still beats evicting a chunk
+  if (numa_node >= 0) {
+    const int remote_slab_num = findBestFitSlab(num_pages_requested, -1);
+    if (remote_slab_num >= 0) {
+      return findFreeBufferInSlab(remote_slab_num, num_pages_requested);
+    }
+  }
+
   // If here then we can't add a slab - so we need to evict
 
-  size_t min_score = std::numeric_limits<size_t>::max();
+  uint64_t min_score = std::numeric_limits<uint64_t>::max();
   // We're going for lowest score here, like golf
-  // This is because score is the sum of the lastTouched score for all pages evicted.
-  // Evicting fewer pages and older pages will lower the score
+  // The score of a run of segments is the highest eviction score of its used segments,
+  // so runs of probationary and older segments win. Summing up the scores instead
+  // caused thrashing when going from 8M fragment size chunks back to 64M, as one large
+  // chunk would always lose against several smaller unused older chunks, so under
+  // memory pressure a query would evict its own current chunks and cause reloads.
   BufferList::iterator best_eviction_start = slab_segments_[0].end();
   int best_eviction_start_slab = -1;
   int slab_num = 0;
 
   for (auto slab_it = slab_segments_.begin(); slab_it != slab_segments_.end();
        ++slab_it, ++slab_num) {
+    // Slide a window of unpinned segments over the slab, which for each segment ending
+    // the window is the shortest run starting it with enough pages. The scores of its
+    // used segments are kept in decreasing order, so the front holds the run score.
+    auto window_start = slab_it->begin();
+    size_t window_pages = 0;
+    std::deque<std::pair<uint64_t, BufferSeg*>> window_scores;
     for (auto buffer_it = slab_it->begin(); buffer_it != slab_it->end(); ++buffer_it) {
-      // Note there are some shortcuts we could take here - like we should never consider
-      // a USED buffer coming after a free buffer as we would have used the FREE buffer,
-      // but we won't worry about this for now
-
-      // We can't evict pinned buffers - only normal usedbuffers
-
-      // if (buffer_it->mem_status == FREE || buffer_it->buffer->getPinCount() == 0) {
-      size_t page_count = 0;
-      size_t score = 0;
-      bool solution_found = false;
-      auto evict_it = buffer_it;
-      for (; evict_it != slab_segments_[slab_num].end(); ++evict_it) {
-        // pinCount should never go up - only down because we have
-        // global lock on buffer pool and pin count only increments
-        // on getChunk
-        if (evict_it->mem_status == USED && evict_it->buffer->getPinCount() > 0) {
-          break;
-        }
-        page_count += evict_it->num_pages;
-        if (evict_it->mem_status == USED) {
-          // MAT changed from
-          // score += evictIt->lastTouched;
-          // Issue was thrashing when going from 8M fragment size chunks back to 64M
-          // basically the large chunks were being evicted prior to small as many small
-          // chunk score was larger than one large chunk so it always would evict a large
-          // chunk so under memory pressure a query would evict its own current chunks and
-          // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+      // pinCount should never go up - only down because we have
+      // global lock on buffer pool and pin count only increments
+      // on getChunk
+      if (buffer_it->mem_status == USED && buffer_it->buffer->getPinCount() > 0) {
+        // We can't evict pinned buffers - only normal usedbuffers
+        window_start = std::next(buffer_it);
+        window_pages = 0;
+        window_scores.clear();
+        continue;
+      }
+      window_pages += buffer_it->num_pages;
+      if (buffer_it->mem_status == USED) {
+        const auto score = eviction_score(*buffer_it);
+        while (!window_scores.empty() && window_scores.back().first <= score) {
+          window_scores.pop_back();
         }
-        if (page_count >= num_pages_requested) {
-          solution_found = true;
-          break;
+        window_scores.emplace_back(score, &*buffer_it);
+      }
+      while (window_start != buffer_it &&
+             window_pages - window_start->num_pages >= num_pages_requested) {
+        window_pages -= window_start->num_pages;
+        if (!window_scores.empty() && window_scores.front().second == &*window_start) {
+          window_scores.pop_front();
         }
+        ++window_start;
       }
-      if (solution_found && score < min_score) {
-        min_score = score;
-        best_eviction_start = buffer_it;
-        best_eviction_start_slab = slab_num;
-      } else if (evict_it == slab_segments_[slab_num].end()) {
-        // this means that every segment after this will fail as well, so our search has
-        // proven futile
-        // throw std::runtime_error ("Couldn't evict chunks to get free space");
-        break;
-        // in reality we should try to rearrange the buffer to get more contiguous free
-        // space
+      if (window_pages >= num_pages_requested) {
+        const auto score = window_scores.empty() ? 0 : window_scores.front().first;
+        if (score < min_score) {
+          min_score = score;
+          best_eviction_start = window_start;
+          best_eviction_start_slab = slab_num;
+        }
       }
-      // other possibility is ending at PINNED - do nothing in this case
-      //}
     }
   }
   if (best_eviction_start == slab_segments_[0].end()) {
@@ -644,11 +702,13 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
     unsized_segs_.erase(seg_it);
   } else {
+    unprotectSegment(*seg_it);
     if (seg_it != slab_segments_[slab_num].begin()) {
       auto prev_it = std::prev(seg_it);
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
       // printSeg(prev_it);
       if (prev_it->mem_status == FREE) {
+        removeFreeSegment(slab_num, prev_it);
         seg_it->start_page = prev_it->start_page;
         seg_it->num_pages += prev_it->num_pages;
         slab_segments_[slab_num].erase(prev_it);
@@ -657,6 +717,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     auto next_it = std::next(seg_it);
     if (next_it != slab_segments_[slab_num].end()) {
       if (next_it->mem_status == FREE) {
+        removeFreeSegment(slab_num, next_it);
         seg_it->num_pages += next_it->num_pages;
         slab_segments_[slab_num].erase(next_it);
       }
@@ -664,9 +725,106 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     seg_it->mem_status = FREE;
     // seg_it->pinCount = 0;
     seg_it->buffer = 0;
+    addFreeSegment(slab_num, seg_it);
   }
 }
 
+/// Returns the slab with the smallest free segment of sufficient size on the NUMA node,
+/// or on any node if numa_node is -1. Returns -1 if there is no such segment.
+int BufferMgr::findBestFitSlab(const size_t num_pages_requested, const int numa_node) {
+  if (numa_node >= 0) {
+    auto free_it = free_segs_.lower_bound({numa_node, num_pages_requested});
+    return free_it != free_segs_.end() && free_it->first.first == numa_node
+               ? free_it->second.first
+               : -1;
+  }
+  // the best fit of each node in turn, there are few nodes
+  int best_slab_num = -1;
+  size_t best_num_pages = std::numeric_limits<size_t>::max();
+  auto free_it = free_segs_.begin();
+  while (free_it != free_segs_.end()) {
+    const int node = free_it->first.first;
+    free_it = free_segs_.lower_bound({node, num_pages_requested});
+    if (free_it != free_segs_.end() && free_it->first.first == node) {
+      if (free_it->first.second < best_num_pages) {
+        best_num_pages = free_it->first.second;
+        best_slab_num = free_it->second.first;
+      }
+    }
+    free_it = free_segs_.lower_bound({node + 1, 0});
+  }
+  return best_slab_num;
+}
+
+void BufferMgr::addFreeSegment(const int slab_num, const BufferList::iterator& seg_it) {
+  CHECK(seg_it->mem_status == FREE);
+  free_segs_.emplace(std::make_pair(slab_numa_nodes_[slab_num], seg_it->num_pages),
+                     std::make_pair(slab_num, seg_it));
+}
+
+void BufferMgr::removeFreeSegment(const int slab_num,
+                                  const BufferList::iterator& seg_it) {
+  // Free segments of the same size are rare, so the range is short
+  auto range = free_segs_.equal_range(
+      std::make_pair(slab_numa_nodes_[slab_num], seg_it->num_pages));
+  for (auto free_it = range.first; free_it != range.second; ++free_it) {
+    if (&*free_it->second.second == &*seg_it) {
+      free_segs_.erase(free_it);
+      return;
+    }
+  }
+  UNREACHABLE();
+}
+
+void BufferMgr::touchSegment(const BufferList::iterator& seg_it) {
+  if (seg_it->slab_num < 0 || !g_enable_segmented_lru_buffer_pool) {
+    seg_it->last_touched = buffer_epoch_++;
+    return;
+  }
+  // A chunk referenced again while resident is no longer a one-off, e.g. a scan
+  unprotectSegment(*seg_it);
+  seg_it->last_touched = buffer_epoch_++;
+  protectSegment(seg_it);
+}
+
+void BufferMgr::protectSegment(const BufferList::iterator& seg_it) {
+  CHECK_EQ(seg_it->tier, PROBATIONARY);
+  seg_it->tier = PROTECTED;
+  num_protected_pages_ += seg_it->num_pages;
+  protected_segs_.emplace(seg_it->last_touched, &*seg_it);
+  const size_t max_protected_pages =
+      num_pages_allocated_ * kMaxProtectedPagesPercent / 100;
+  while (num_protected_pages_ > max_protected_pages && protected_segs_.size() > 1) {
+    unprotectSegment(*protected_segs_.begin()->second);
+  }
+}
+
+void BufferMgr::unprotectSegment(BufferSeg& seg) {
+  if (seg.tier == PROTECTED) {
+    protected_segs_.erase(std::make_pair(seg.last_touched, &seg));
+    num_protected_pages_ -= seg.num_pages;
+    seg.tier = PROBATIONARY;
+  }
+}
+
+void BufferMgr::recordAccess(const ChunkKey& key, const bool hit) {
+  if (key.size() < 2 || key[0] == -1) {
+    return;  // not a chunk
+  }
+  std::lock_guard<std::mutex> table_stats_lock(table_stats_mutex_);
+  auto& stats = table_stats_[{key[0], key[1]}];
+  if (hit) {
+    stats.num_hits++;
+  } else {
+    stats.num_misses++;
+  }
+}
+
+std::map<std::pair<int, int>, BufferPoolTableStats> BufferMgr::getTableStats() {
+  std::lock_guard<std::mutex> table_stats_lock(table_stats_mutex_);
+  return table_stats_;
+}
+
 void BufferMgr::checkpoint() {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
   std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
@@ -720,13 +878,13 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
   auto buffer_it = chunk_index_.find(key);
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
+  recordAccess(key, found_buffer);
   if (found_buffer) {
     CHECK(buffer_it->second->buffer);
     buffer_it->second->buffer->pin();
+    touchSegment(buffer_it->second);
     sized_segs_lock.unlock();
 
-    buffer_it->second->last_touched = buffer_epoch_++;  // race
-
     if (buffer_it->second->buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
       parent_mgr_->fetchBuffer(key, buffer_it->second->buffer, num_bytes);
@@ -762,6 +920,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   auto buffer_it = chunk_index_.find(key);
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
+  recordAccess(key, found_buffer);
   AbstractBuffer* buffer;
   if (!found_buffer) {
     sized_segs_lock.unlock();
@@ -775,6 +934,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   } else {
     buffer = buffer_it->second->buffer;
     buffer->pin();
+    touchSegment(buffer_it->second);
     if (num_bytes > buffer->size()) {
       try {
         parent_mgr_->fetchBuffer(key, buffer, num_bytes);
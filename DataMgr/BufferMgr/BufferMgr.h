@@ -30,6 +30,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
@@ -86,6 +87,12 @@ using namespace Data_Namespace;
 
 namespace Buffer_Namespace {
 
+struct BufferPoolTableStats {
+  size_t num_hits{0};
+  size_t num_misses{0};
+  size_t num_evictions{0};
+};
+
 /**
  * @class   BufferMgr
  * @brief
@@ -125,6 +132,8 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   size_t getPageSize();
   bool isAllocationCapped() override;
   const std::vector<BufferList>& getSlabSegments();
+  /// Hit, miss and eviction counts of the chunks of each table, by (db id, table id)
+  std::map<std::pair<int, int>, BufferPoolTableStats> getTableStats();
 
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
@@ -181,14 +190,32 @@ class BufferMgr : public AbstractBufferMgr {  // implements
                                 /// allocation of the buffer pool
   std::vector<BufferList> slab_segments_;
 
+  /// NUMA node the pages of a chunk should be placed on, -1 for any node
+  virtual int getNumaNodeForChunk(const ChunkKey& chunk_key) { return -1; }
+
  private:
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
+  int findBestFitSlab(const size_t num_pages_requested, const int numa_node);
+  void addFreeSegment(const int slab_num, const BufferList::iterator& seg_it);
+  void removeFreeSegment(const int slab_num, const BufferList::iterator& seg_it);
+  void touchSegment(const BufferList::iterator& seg_it);
+  void protectSegment(const BufferList::iterator& seg_it);
+  void unprotectSegment(BufferSeg& seg);
+  void recordAccess(const ChunkKey& key, const bool hit);
   int getBufferId();
   virtual void addSlab(const size_t slab_size) = 0;
+  /// Places the pages of a new slab on a NUMA node, before any of them are touched
+  virtual bool bindSlabToNumaNode(const size_t slab_num,
+                                  const size_t slab_size,
+                                  const int numa_node) {
+    return false;
+  }
+  /// Called once a new slab is placed, before its first buffer is allocated
+  virtual void prefaultSlab(const size_t slab_num, const size_t slab_size) {}
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
                               const size_t page_size,
@@ -212,23 +239,41 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   BufferList unsized_segs_;
 
+  // NUMA node of each slab, -1 if it is not bound to a node
+  std::vector<int> slab_numa_nodes_;
+
+  // Free segments of all slabs by NUMA node of the slab and number of pages, for best
+  // fit allocation without walking the slabs. Free segments do not know their slab,
+  // hence the slab number.
+  std::multimap<std::pair<int, size_t>, std::pair<int, BufferList::iterator>> free_segs_;
+
+  // Protected segments by last touch, the least recently used one is demoted back to
+  // probationary once the protected segments exceed their share of the pool.
+  std::set<std::pair<unsigned int, BufferSeg*>> protected_segs_;
+  size_t num_protected_pages_;
+
+  std::mutex table_stats_mutex_;
+  std::map<std::pair<int, int>, BufferPoolTableStats> table_stats_;
+
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
   /**
    * @brief Gets a buffer of required size and returns an iterator to it
    *
-   * If possible, this function will just select a free buffer of
-   * sufficient size and use that. If not, it will evict as many
+   * If possible, this function will just select the smallest free buffer of
+   * sufficient size and use that, on the given NUMA node unless there is none
+   * and no slab can be added for the node. If not, it will evict as many
    * non-pinned but used buffers as needed to have enough space for the
-   * buffer
+   * buffer, preferring probationary over protected and older over recently
+   * touched buffers
    *
    * @return An iterator to the reserved buffer. We guarantee that this
    * buffer won't be evicted by PINNING it - caller should change this to
    * USED if applicable
    *
    */
-  BufferList::iterator findFreeBuffer(size_t num_bytes);
+  BufferList::iterator findFreeBuffer(size_t num_bytes, const int numa_node = -1);
 };
 
 }  // namespace Buffer_Namespace
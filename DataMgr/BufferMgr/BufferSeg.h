@@ -27,6 +27,10 @@ class Buffer;  // forward declaration
 // Memory Pages types in buffer pool
 enum MemStatus { FREE, USED };
 
+// Segments of the segmented LRU replacement policy. Chunks enter the buffer pool as
+// probationary and are only protected from eviction once they are referenced again.
+enum SegTier { PROBATIONARY, PROTECTED };
+
 struct BufferSeg {
   int start_page;
   size_t num_pages;
@@ -36,6 +40,7 @@ struct BufferSeg {
   unsigned int pin_count;
   int slab_num;
   unsigned int last_touched;
+  SegTier tier{PROBATIONARY};
 
   BufferSeg()
       : mem_status(FREE), buffer(0), pin_count(0), slab_num(-1), last_touched(0) {}
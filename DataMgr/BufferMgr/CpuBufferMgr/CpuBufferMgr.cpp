@@ -19,9 +19,29 @@
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "OSDependent/omnisci_memory.h"
+#include "OSDependent/omnisci_numa.h"
+
+bool g_enable_numa_affinity{true};
+bool g_enable_slab_prefaulting{false};
 
 namespace Buffer_Namespace {
 
+int CpuBufferMgr::getNumaNodeForFragment(const int fragment_id) {
+  const auto num_numa_nodes = omnisci::get_numa_node_count();
+  if (!g_enable_numa_affinity || num_numa_nodes < 2 || fragment_id < 0) {
+    return -1;
+  }
+  return fragment_id % num_numa_nodes;
+}
+
+int CpuBufferMgr::getNumaNodeForChunk(const ChunkKey& chunk_key) {
+  if (chunk_key.size() <= CHUNK_KEY_FRAGMENT_IDX || chunk_key[CHUNK_KEY_DB_IDX] == -1) {
+    return -1;  // not a chunk, e.g. a buffer from alloc()
+  }
+  return getNumaNodeForFragment(chunk_key[CHUNK_KEY_FRAGMENT_IDX]);
+}
+
 void CpuBufferMgr::addSlab(const size_t slab_size) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
@@ -36,8 +56,38 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
       BufferSeg(0, slab_size / page_size_));
 }
 
+bool CpuBufferMgr::bindSlabToNumaNode(const size_t slab_num,
+                                      const size_t slab_size,
+                                      const int numa_node) {
+  CHECK_LT(slab_num, slabs_.size());
+  return omnisci::bind_memory_to_numa_node(slabs_[slab_num], slab_size, numa_node);
+}
+
+void CpuBufferMgr::prefaultSlab(const size_t slab_num, const size_t slab_size) {
+  if (!g_enable_slab_prefaulting) {
+    return;
+  }
+  CHECK_LT(slab_num, slabs_.size());
+  // faults the pages in the background instead of in the kernels scanning the slab,
+  // buffers may be written to the slab meanwhile
+  slab_prefault_futures_.emplace_back(
+      std::async(std::launch::async, [slab = slabs_[slab_num], slab_size] {
+        if (!omnisci::prefault_memory(slab, slab_size)) {
+          VLOG(1) << "Could not prefault a slab of " << slab_size << " bytes";
+        }
+      }));
+}
+
+void CpuBufferMgr::waitForSlabPrefaulting() {
+  for (auto& future : slab_prefault_futures_) {
+    future.wait();
+  }
+  slab_prefault_futures_.clear();
+}
+
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
+  waitForSlabPrefaulting();
   allocator_.reset(new Arena(max_slab_size_ + kArenaBlockOverhead));
 }
 
@@ -18,6 +18,8 @@
 
 #include "DataMgr/BufferMgr/BufferMgr.h"
 
+#include <future>
+
 #include "DataMgr/Allocators/ArenaAllocator.h"
 
 namespace CudaMgr_Namespace {
@@ -47,13 +49,26 @@ class CpuBufferMgr : public BufferMgr {
 
   ~CpuBufferMgr() {
     /* the destruction of the allocator automatically frees all memory */
+    waitForSlabPrefaulting();
   }
 
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
 
+  /// NUMA node holding the chunks of a fragment, -1 for any node. Fragments are spread
+  /// round robin over the nodes, so that kernels can be run next to their chunks.
+  static int getNumaNodeForFragment(const int fragment_id);
+
+ protected:
+  int getNumaNodeForChunk(const ChunkKey& chunk_key) override;
+
  private:
   void addSlab(const size_t slab_size) override;
+  bool bindSlabToNumaNode(const size_t slab_num,
+                          const size_t slab_size,
+                          const int numa_node) override;
+  void prefaultSlab(const size_t slab_num, const size_t slab_size) override;
+  void waitForSlabPrefaulting();
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator segment_iter,
                       const size_t page_size,
@@ -61,6 +76,7 @@ class CpuBufferMgr : public BufferMgr {
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
   std::unique_ptr<Arena> allocator_;
+  std::vector<std::future<void>> slab_prefault_futures_;
 };
 
 }  // namespace Buffer_Namespace
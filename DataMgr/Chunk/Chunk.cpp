@@ -224,6 +224,9 @@ void Chunk::unpinBuffer() {
 
 void Chunk::initEncoder() {
   buffer_->initEncoder(column_desc_->columnType);
+  if (column_desc_->hasBloomFilter) {
+    buffer_->getEncoder()->enableBloomFilter();
+  }
   if (column_desc_->columnType.is_varlen() &&
       !column_desc_->columnType.is_fixlen_array()) {
     switch (column_desc_->columnType.get_type()) {
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * Bloom filter over the non-null values of an integer, time or dictionary encoded chunk,
+ * used to skip fragments on equality and IN predicates which the min / max chunk stats
+ * cannot rule out.
+ *
+ * The filter is persisted on the metadata page of the chunk and therefore has a fixed
+ * size. It pays off for chunks holding up to a few thousand distinct values, e.g. small
+ * fragments or clustered keys. Once too many bits are set, the filter is saturated and
+ * no longer used for pruning.
+ *
+ * Values are only ever added. Paths which change values without adding them to the
+ * filter (e.g. UPDATE) saturate it instead.
+ */
+class ChunkBloomFilter {
+ public:
+  static constexpr size_t kNumBytes = 2048;
+  static constexpr size_t kNumBits = kNumBytes * 8;
+  static constexpr size_t kNumHashes = 3;
+
+  void add(const int64_t value) {
+    uint64_t h1, h2;
+    hash(value, h1, h2);
+    for (size_t i = 0; i < kNumHashes; ++i) {
+      setBit((h1 + i * h2) & (kNumBits - 1));
+    }
+  }
+
+  bool mayContain(const int64_t value) const {
+    if (isSaturated()) {
+      return true;
+    }
+    uint64_t h1, h2;
+    hash(value, h1, h2);
+    for (size_t i = 0; i < kNumHashes; ++i) {
+      if (!testBit((h1 + i * h2) & (kNumBits - 1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns false only if the two filters cannot have a value in common, i.e. they share
+  // fewer bits than a single value sets. Only selective for a few dozen values per side.
+  bool mayIntersect(const ChunkBloomFilter& that) const {
+    if (isSaturated() || that.isSaturated()) {
+      return true;
+    }
+    size_t num_common_bits{0};
+    for (size_t i = 0; i < words_.size(); ++i) {
+      num_common_bits += __builtin_popcountll(words_[i] & that.words_[i]);
+      if (num_common_bits >= kNumHashes) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void merge(const ChunkBloomFilter& that) {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      words_[i] |= that.words_[i];
+    }
+    countBits();
+  }
+
+  void saturate() {
+    words_.fill(~uint64_t(0));
+    num_bits_set_ = kNumBits;
+  }
+
+  // At half of the bits set, three probes report a false positive one time in eight.
+  bool isSaturated() const { return num_bits_set_ > kNumBits / 2; }
+
+  void clear() {
+    words_.fill(0);
+    num_bits_set_ = 0;
+  }
+
+  void write(FILE* f) const {
+    fwrite(reinterpret_cast<const int8_t*>(words_.data()),
+           sizeof(uint64_t),
+           words_.size(),
+           f);
+  }
+
+  void read(FILE* f) {
+    fread(
+        reinterpret_cast<int8_t*>(words_.data()), sizeof(uint64_t), words_.size(), f);
+    countBits();
+  }
+
+ private:
+  static void hash(const int64_t value, uint64_t& h1, uint64_t& h2) {
+    // splitmix64 finalizer, the upper half provides the odd step of the double hashing
+    uint64_t x = static_cast<uint64_t>(value) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x = x ^ (x >> 31);
+    h1 = x;
+    h2 = (x >> 32) | 1;
+  }
+
+  void setBit(const size_t bit) {
+    auto& word = words_[bit / 64];
+    const uint64_t mask = uint64_t(1) << (bit % 64);
+    if (!(word & mask)) {
+      word |= mask;
+      num_bits_set_++;
+    }
+  }
+
+  bool testBit(const size_t bit) const {
+    return words_[bit / 64] & (uint64_t(1) << (bit % 64));
+  }
+
+  void countBits() {
+    num_bits_set_ = 0;
+    for (const auto word : words_) {
+      num_bits_set_ += __builtin_popcountll(word);
+    }
+  }
+
+  std::array<uint64_t, kNumBits / 64> words_{};
+  size_t num_bits_set_{0};
+};
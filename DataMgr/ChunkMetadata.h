@@ -17,7 +17,9 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include "../Shared/sqltypes.h"
+#include "ChunkBloomFilter.h"
 #include "Shared/types.h"
 
 #include "Logger/Logger.h"
@@ -33,6 +35,8 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // only present for columns created with the BLOOM_FILTER table option
+  std::shared_ptr<const ChunkBloomFilter> bloomFilter;
 
   std::string dump() const {
     auto type = sqlType.is_array() ? sqlType.get_elem_type() : sqlType;
@@ -330,6 +330,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
         mi.nodeMemoryData.push_back(md);
       }
     }
+    mi.tableStats = cpu_buffer->getTableStats();
     mem_info.push_back(mi);
   } else if (hasGpus_) {
     int numGpus = cudaMgr_->getDeviceCount();
@@ -359,6 +360,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
           mi.nodeMemoryData.push_back(md);
         }
       }
+      mi.tableStats = gpu_buffer->getTableStats();
       mem_info.push_back(mi);
     }
   }
@@ -63,6 +63,8 @@ struct MemoryInfo {
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  std::map<std::pair<int32_t, int32_t>, Buffer_Namespace::BufferPoolTableStats>
+      tableStats;
 };
 
 //! Parse /proc/meminfo into key/value pairs.
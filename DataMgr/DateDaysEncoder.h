@@ -41,6 +41,7 @@ class DateDaysEncoder : public Encoder {
     CHECK(ti.is_date_in_days());
     if (offset == 0 && num_elems_to_append >= num_elems_) {
       resetChunkStats();
+      clearBloomFilter();
     }
     T* unencoded_data = reinterpret_cast<T*>(src_data);
     auto encoded_data = std::make_unique<V[]>(num_elems_to_append);
@@ -125,7 +126,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
@@ -193,6 +194,7 @@ class DateDaysEncoder : public Encoder {
       const T data = DateConverters::get_epoch_seconds_from_days(encoded_data);
       dataMax = std::max(dataMax, data);
       dataMin = std::min(dataMin, data);
+      addToBloomFilter(data);
     }
     return encoded_data;
   }
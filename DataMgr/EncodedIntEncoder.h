@@ -0,0 +1,401 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENCODED_INT_ENCODER_H
+#define ENCODED_INT_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+#include <Shared/EncodedIntStream.h>
+
+/**
+ * Chunk stats shared by the RL and DIFF encoders. Both take the logical values of integer
+ * and time columns, nulls included, and lay them out as described in
+ * Shared/EncodedIntStream.h.
+ *
+ * Rows of DIFF chunks are read directly at their fixed width offset and rows of RL chunks
+ * through a binary search over the runs, but neither layout can be written in place by
+ * row, hence only appends and rewrites of the whole chunk are supported.
+ */
+template <typename T>
+class EncodedIntEncoder : public Encoder {
+ public:
+  EncodedIntEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
+    resetChunkStats();
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      validateDataAndUpdateStats(unencoded_data[i]);
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto& that_typed = static_cast<const EncodedIntEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const EncodedIntEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, sizeof(T), 1, f);
+    fread((int8_t*)&dataMax, sizeof(T), 1, f);
+    fread((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  void resetChunkStats() override {
+    dataMin = std::numeric_limits<T>::max();
+    dataMax = std::numeric_limits<T>::lowest();
+    has_nulls = false;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ protected:
+  static bool isNull(const int64_t value) { return value == inline_int_null_value<T>(); }
+
+  // Returns true for nulls.
+  bool validateDataAndUpdateStats(const T unencoded_data) {
+    if (isNull(unencoded_data)) {
+      has_nulls = true;
+      return true;
+    }
+    decimal_overflow_validator_.validate(unencoded_data);
+    dataMin = std::min(dataMin, unencoded_data);
+    dataMax = std::max(dataMax, unencoded_data);
+    addToBloomFilter(unencoded_data);
+    return false;
+  }
+
+  // An offset of 0 rewrites the chunk with the appended rows only, other offsets are not
+  // supported.
+  void startAppend(const int64_t offset) {
+    if (offset == -1) {
+      return;
+    }
+    CHECK_EQ(offset, 0) << "Partial rewrites of RL or DIFF encoded chunks not supported";
+    resetChunkStats();
+    clearBloomFilter();
+    num_elems_ = 0;
+    buffer_->setSize(0);
+  }
+
+  EncodedIntStreamHeader readHeader() const {
+    EncodedIntStreamHeader header;
+    buffer_->read(reinterpret_cast<int8_t*>(&header), sizeof(header), 0);
+    return header;
+  }
+
+  void writeHeader(EncodedIntStreamHeader& header) {
+    buffer_->write(reinterpret_cast<int8_t*>(&header), sizeof(header), 0);
+  }
+
+  std::shared_ptr<ChunkMetadata> appendedMetadata() {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+};  // EncodedIntEncoder
+
+/**
+ * Run length encoding, for columns sorted or clustered on the encoded column. Appends
+ * extend the last run of the chunk when they start with its value.
+ */
+template <typename T>
+class RunLengthEncoder : public EncodedIntEncoder<T> {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : EncodedIntEncoder<T>(buffer) {}
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo& ti,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    this->startAppend(offset);
+    const auto num_elems = this->num_elems_;
+    EncodedIntStreamHeader header{0, 0, 0};
+    std::vector<EncodedIntRun> runs;
+    size_t runs_offset = sizeof(EncodedIntStreamHeader);
+    if (num_elems) {
+      header = this->readHeader();
+      CHECK_GT(header.num_runs, 0);
+      // the last run is rewritten, possibly extended
+      header.num_runs--;
+      runs_offset += header.num_runs * sizeof(EncodedIntRun);
+      runs.emplace_back();
+      this->buffer_->read(
+          reinterpret_cast<int8_t*>(&runs.back()), sizeof(EncodedIntRun), runs_offset);
+    }
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      const T data = unencoded_data[replicating ? 0 : i];
+      this->validateDataAndUpdateStats(data);
+      const int64_t run_end = num_elems + i + 1;
+      if (!runs.empty() && runs.back().value == static_cast<int64_t>(data)) {
+        runs.back().end = run_end;
+      } else {
+        runs.push_back({run_end, static_cast<int64_t>(data)});
+      }
+    }
+    header.num_runs += runs.size();
+    if (!runs.empty()) {
+      this->buffer_->write(reinterpret_cast<int8_t*>(runs.data()),
+                           runs.size() * sizeof(EncodedIntRun),
+                           runs_offset);
+    }
+    this->writeHeader(header);
+    this->num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+    return this->appendedMetadata();
+  }
+};  // RunLengthEncoder
+
+/**
+ * Frame of reference encoding: every row holds its offset from the base of the chunk on
+ * the byte width of the column, which keeps rows randomly addressable. The base is the
+ * middle of the value range of the chunk. Appending a value outside of the frame rewrites
+ * the chunk on a new base, and only on a wider offset when the range of the chunk doesn't
+ * fit the declared width anymore, rather than failing the insert.
+ */
+template <typename T>
+class DiffEncoder : public EncodedIntEncoder<T> {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer, const int32_t byte_width)
+      : EncodedIntEncoder<T>(buffer), byte_width_(byte_width) {
+    CHECK(byte_width == 1 || byte_width == 2 || byte_width == 4 || byte_width == 8);
+  }
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo& ti,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    this->startAppend(offset);
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    std::vector<int64_t> values(num_elems_to_append);
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      values[i] = unencoded_data[replicating ? 0 : i];
+      this->validateDataAndUpdateStats(values[i]);
+    }
+    EncodedIntStreamHeader header{0, byte_width_, 0};
+    bool write_header{false};
+    if (this->num_elems_) {
+      header = this->readHeader();
+      if (!fitsWidth(values, header)) {
+        reframe(header);
+        write_header = true;
+      }
+    } else {
+      header = frameOfChunk();
+      write_header = true;
+    }
+    if (write_header) {
+      this->writeHeader(header);
+    }
+    if (!values.empty()) {
+      auto encoded_data = encode(values, header);
+      this->buffer_->write(encoded_data.data(),
+                           encoded_data.size(),
+                           sizeof(EncodedIntStreamHeader) +
+                               this->num_elems_ * header.byte_width);
+    }
+    this->num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+    return this->appendedMetadata();
+  }
+
+ private:
+  using EncodedIntEncoder<T>::isNull;
+
+  static bool fitsWidth(const std::vector<int64_t>& values,
+                        const EncodedIntStreamHeader& header) {
+    const auto null_sentinel = encoded_int_diff_null_sentinel(header.byte_width);
+    for (const auto value : values) {
+      if (isNull(value)) {
+        continue;
+      }
+      int64_t diff;
+      if (__builtin_sub_overflow(value, header.base, &diff)) {
+        return false;
+      }
+      if (header.byte_width < 8 && (diff <= null_sentinel || diff > -null_sentinel - 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static std::vector<int8_t> encode(const std::vector<int64_t>& values,
+                                    const EncodedIntStreamHeader& header) {
+    const auto null_sentinel = encoded_int_diff_null_sentinel(header.byte_width);
+    std::vector<int8_t> encoded_data(values.size() * header.byte_width);
+    auto write_ptr = encoded_data.data();
+    for (const auto value : values) {
+      const int64_t diff = isNull(value) ? null_sentinel : value - header.base;
+      switch (header.byte_width) {
+        case 1:
+          *reinterpret_cast<int8_t*>(write_ptr) = diff;
+          break;
+        case 2:
+          *reinterpret_cast<int16_t*>(write_ptr) = diff;
+          break;
+        case 4:
+          *reinterpret_cast<int32_t*>(write_ptr) = diff;
+          break;
+        default:
+          *reinterpret_cast<int64_t*>(write_ptr) = diff;
+          break;
+      }
+      write_ptr += header.byte_width;
+    }
+    return encoded_data;
+  }
+
+  // The middle of the value range of the chunk (appended rows included) as the base, on
+  // the narrowest width from the declared one up which holds the whole range.
+  EncodedIntStreamHeader frameOfChunk() const {
+    if (this->dataMin > this->dataMax) {
+      // nulls only
+      return {0, byte_width_, 0};
+    }
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(this->dataMax)) -
+                           static_cast<uint64_t>(static_cast<int64_t>(this->dataMin));
+    for (int32_t byte_width = byte_width_; byte_width < 8; byte_width *= 2) {
+      const uint64_t max_offset = -(encoded_int_diff_null_sentinel(byte_width) + 1);
+      if (range <= 2 * max_offset) {
+        return {static_cast<int64_t>(this->dataMin) + static_cast<int64_t>(range / 2),
+                byte_width,
+                0};
+      }
+    }
+    return {0, sizeof(int64_t), 0};
+  }
+
+  // Rewrites the rows of the chunk on the frame of the chunk.
+  void reframe(EncodedIntStreamHeader& header) {
+    std::vector<int64_t> values(this->num_elems_);
+    std::vector<int8_t> stream(this->buffer_->size());
+    this->buffer_->read(stream.data(), stream.size(), 0);
+    decode_encoded_int_stream(
+        stream.data(), this->num_elems_, inline_int_null_value<T>(), values.data());
+    header = frameOfChunk();
+    auto encoded_data = encode(values, header);
+    // a narrower width leaves no stale rows past the end of the chunk
+    this->buffer_->setSize(sizeof(EncodedIntStreamHeader));
+    this->buffer_->write(
+        encoded_data.data(), encoded_data.size(), sizeof(EncodedIntStreamHeader));
+  }
+
+  const int32_t byte_width_;
+};  // DiffEncoder
+
+#endif  // ENCODED_INT_ENCODER_H
@@ -17,6 +17,7 @@
 #include "Encoder.h"
 #include "ArrayNoneEncoder.h"
 #include "DateDaysEncoder.h"
+#include "EncodedIntEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
 #include "Logger/Logger.h"
@@ -197,6 +198,47 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }
       break;
     }
+    case kENCODING_RL: {
+      switch (sqlType.get_type()) {
+        case kTINYINT:
+          return new RunLengthEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new RunLengthEncoder<int16_t>(buffer);
+        case kINT:
+          return new RunLengthEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new RunLengthEncoder<int64_t>(buffer);
+        default: {
+          return 0;
+        }
+      }
+      break;
+    }
+    case kENCODING_DIFF: {
+      const int32_t byte_width = sqlType.get_comp_param() / 8;
+      switch (sqlType.get_type()) {
+        case kSMALLINT:
+          return new DiffEncoder<int16_t>(buffer, byte_width);
+        case kINT:
+          return new DiffEncoder<int32_t>(buffer, byte_width);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new DiffEncoder<int64_t>(buffer, byte_width);
+        default: {
+          return 0;
+        }
+      }
+      break;
+    }
     case kENCODING_GEOINT: {
       switch (sqlType.get_type()) {
         case kPOINT:
@@ -228,4 +270,37 @@ void Encoder::getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) {
   chunkMetadata->sqlType = buffer_->getSqlType();
   chunkMetadata->numBytes = buffer_->size();
   chunkMetadata->numElements = num_elems_;
+  chunkMetadata->bloomFilter =
+      bloom_filter_ ? std::make_shared<const ChunkBloomFilter>(*bloom_filter_) : nullptr;
+}
+
+void Encoder::enableBloomFilter() {
+  if (!bloom_filter_) {
+    bloom_filter_ = std::make_unique<ChunkBloomFilter>();
+  }
+}
+
+void Encoder::saturateBloomFilter() {
+  if (bloom_filter_) {
+    bloom_filter_->saturate();
+  }
+}
+
+void Encoder::copyBloomFilter(const Encoder* copyFromEncoder) {
+  CHECK(copyFromEncoder);
+  if (copyFromEncoder->bloom_filter_) {
+    bloom_filter_ = std::make_unique<ChunkBloomFilter>(*copyFromEncoder->bloom_filter_);
+  } else {
+    bloom_filter_ = nullptr;
+  }
+}
+
+void Encoder::writeBloomFilter(FILE* f) const {
+  CHECK(bloom_filter_);
+  bloom_filter_->write(f);
+}
+
+void Encoder::readBloomFilter(FILE* f) {
+  enableBloomFilter();
+  bloom_filter_->read(f);
 }
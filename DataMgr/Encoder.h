@@ -25,6 +25,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -233,13 +234,46 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  /**
+   * Starts adding the non-null values of the chunk to a bloom filter, which is returned
+   * with the chunk metadata and persisted on the metadata page. Only encoders of integer,
+   * time and dictionary encoded string columns maintain it.
+   */
+  void enableBloomFilter();
+  bool hasBloomFilter() const { return bloom_filter_ != nullptr; }
+
+  /**
+   * Disables pruning on the bloom filter until the chunk is rewritten, for paths which
+   * change values without adding them to the filter.
+   */
+  void saturateBloomFilter();
+
+  void copyBloomFilter(const Encoder* copyFromEncoder);
+  void writeBloomFilter(FILE* f) const;
+  void readBloomFilter(FILE* f);
+
  protected:
+  void addToBloomFilter(const int64_t value) {
+    if (bloom_filter_) {
+      bloom_filter_->add(value);
+    }
+  }
+
+  // only called when all values of the chunk are added again
+  void clearBloomFilter() {
+    if (bloom_filter_) {
+      bloom_filter_->clear();
+    }
+  }
+
   size_t num_elems_;
 
   Data_Namespace::AbstractBuffer* buffer_;
 
   DecimalOverflowValidator decimal_overflow_validator_;
   DateDaysOverflowValidator date_days_overflow_validator_;
+
+  std::unique_ptr<ChunkBloomFilter> bloom_filter_;
 };
 
 #endif  // Encoder_h
@@ -28,13 +28,47 @@
 #include <utility>  // std::pair
 
 #include "DataMgr/FileMgr/FileMgr.h"
+#include "Shared/Compressor.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 
 using namespace std;
 
+// the header, type data and encoder stats take up less than 128 bytes
+static_assert(ChunkBloomFilter::kNumBytes + 128 <= METADATA_PAGE_SIZE,
+              "Chunk bloom filter does not fit on the metadata page");
+
 namespace File_Namespace {
 
+PageCompression page_compression_from_name(const std::string& name) {
+  if (name.empty() || name == "NONE") {
+    return PageCompression::NONE;
+  }
+  if (name == "LZ4") {
+    return PageCompression::LZ4;
+  }
+  if (name == "ZSTD") {
+    return PageCompression::ZSTD;
+  }
+  throw std::runtime_error("Unsupported page compression " + name);
+}
+
+namespace {
+
+const char* blosc_compressor_name(const PageCompression page_compression) {
+  switch (page_compression) {
+    case PageCompression::LZ4:
+      return "lz4";
+    case PageCompression::ZSTD:
+      return "zstd";
+    default:
+      UNREACHABLE();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 FileBuffer::FileBuffer(FileMgr* fm,
                        const size_t pageSize,
                        const ChunkKey& chunkKey,
@@ -43,12 +77,13 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , fm_(fm)
     , metadataPages_(METADATA_PAGE_SIZE)
     , pageSize_(pageSize)
+    , pageCompression_(fm->pageCompression())
     , chunkKey_(chunkKey) {
   // Create a new FileBuffer
   CHECK(fm_);
   calcHeaderBuffer();
   CHECK_GT(pageSize_, reservedHeaderSize_);
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  initPageDataSize();
   //@todo reintroduce initialSize - need to develop easy way of
   // differentiating these pre-allocated pages from "written-to" pages
   /*
@@ -73,10 +108,11 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , fm_(fm)
     , metadataPages_(METADATA_PAGE_SIZE)
     , pageSize_(pageSize)
+    , pageCompression_(fm->pageCompression())
     , chunkKey_(chunkKey) {
   CHECK(fm_);
   calcHeaderBuffer();
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  initPageDataSize();
 }
 
 FileBuffer::FileBuffer(FileMgr* fm,
@@ -87,6 +123,7 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , fm_(fm)
     , metadataPages_(METADATA_PAGE_SIZE)
     , pageSize_(0)
+    , pageCompression_(PageCompression::NONE)
     , chunkKey_(chunkKey) {
   // We are being assigned an existing FileBuffer on disk
 
@@ -239,6 +276,9 @@ struct readThreadDS {
   std::vector<MultiPage> multiPages;  // MultiPages of the FileBuffer passed to the thread
 };
 
+// pages of a run read at once, bounded by the vectors of a single vectored read
+static constexpr size_t kMaxPagesPerRead{512};
+
 static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS) {
   size_t startPage = threadDS.t_startPage;  // start reading at startPage, including it
   size_t endPage = threadDS.t_endPage;      // stop reading at endPage, not including it
@@ -246,34 +286,54 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
   size_t bytesLeft = threadDS.t_bytesLeft;
   size_t totalBytesRead = 0;
   bool isFirstPage = threadDS.t_isFirstPage;
+  std::vector<int8_t> pageData;
 
-  // Traverse the logical pages
-  for (size_t pageNum = startPage; pageNum < endPage; ++pageNum) {
+  // Traverse the logical pages, reading each run of logical pages stored in consecutive
+  // pages of the same file at once
+  for (size_t pageNum = startPage; pageNum < endPage;) {
     CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
     Page page = threadDS.multiPages[pageNum].current().page;
 
     FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
     CHECK(fileInfo);
 
-    // Read the page into the destination (dst) buffer at its
+    // Read the page(s) into the destination (dst) buffer at its
     // current (cur) location
     size_t bytesRead = 0;
-    if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
-              fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
-      isFirstPage = false;
+    const size_t pageOffset = isFirstPage ? threadDS.t_startPageOffset : 0;
+    size_t runEndPage = pageNum + 1;
+    if (fileBuffer->hasCompressedPages()) {
+      bytesRead = min(fileBuffer->pageDataSize() - pageOffset, bytesLeft);
+      if (bytesRead == fileBuffer->pageDataSize()) {
+        fileBuffer->readCompressedPage(page, curPtr);
+      } else {
+        pageData.resize(fileBuffer->pageDataSize());
+        fileBuffer->readCompressedPage(page, pageData.data());
+        memcpy(curPtr, pageData.data() + pageOffset, bytesRead);
+      }
     } else {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize(), bytesLeft),
+      while (runEndPage < endPage && runEndPage - pageNum < kMaxPagesPerRead) {
+        const auto& nextPage = threadDS.multiPages[runEndPage].current().page;
+        if (nextPage.fileId != page.fileId ||
+            nextPage.pageNum != page.pageNum + (runEndPage - pageNum)) {
+          break;
+        }
+        CHECK(threadDS.multiPages[runEndPage].pageSize == fileBuffer->pageSize());
+        ++runEndPage;
+      }
+      bytesRead = fileInfo->readPages(
+          page.pageNum,
+          fileBuffer->reservedHeaderSize(),
+          pageOffset,
+          min((runEndPage - pageNum) * fileBuffer->pageDataSize() - pageOffset,
+              bytesLeft),
           curPtr);
     }
+    isFirstPage = false;
     curPtr += bytesRead;
     bytesLeft -= bytesRead;
     totalBytesRead += bytesRead;
+    pageNum = runEndPage;
   }
   CHECK(bytesLeft == 0);
 
@@ -440,7 +500,17 @@ void FileBuffer::readMetadata(const Page& page) {
                       // encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
   int32_t version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  // add backward compatibility code here
+  CHECK(version == METADATA_VERSION || version == METADATA_VERSION_BLOOM_FILTER ||
+        version == METADATA_VERSION_PAGE_COMPRESSION);
+  bool has_bloom_filter = version == METADATA_VERSION_BLOOM_FILTER;
+  pageCompression_ = PageCompression::NONE;
+  if (version == METADATA_VERSION_PAGE_COMPRESSION) {
+    int32_t flags[2];  // has bloom filter, page compression
+    fread((int8_t*)flags, sizeof(int32_t), 2, f);
+    has_bloom_filter = static_cast<bool>(flags[0]);
+    pageCompression_ = static_cast<PageCompression>(flags[1]);
+  }
   bool has_encoder = static_cast<bool>(typeData[1]);
   if (has_encoder) {
     sql_type_.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -453,6 +523,9 @@ void FileBuffer::readMetadata(const Page& page) {
     sql_type_.set_size(typeData[9]);
     initEncoder(sql_type_);
     encoder_->readMetadata(f);
+    if (has_bloom_filter) {
+      encoder_->readBloomFilter(f);
+    }
   }
 }
 
@@ -468,7 +541,12 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   vector<int32_t> typeData(
       NUM_METADATA);  // assumes we will encode hasEncoder, bufferType,
                       // encodingType, encodingBits all as int32_t
-  typeData[0] = METADATA_VERSION;
+  const bool has_bloom_filter = hasEncoder() && encoder_->hasBloomFilter();
+  if (hasCompressedPages()) {
+    typeData[0] = METADATA_VERSION_PAGE_COMPRESSION;
+  } else {
+    typeData[0] = has_bloom_filter ? METADATA_VERSION_BLOOM_FILTER : METADATA_VERSION;
+  }
   typeData[1] = static_cast<int32_t>(hasEncoder());
   if (hasEncoder()) {
     typeData[2] = static_cast<int32_t>(sql_type_.get_type());
@@ -481,8 +559,16 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
     typeData[9] = sql_type_.get_size();
   }
   fwrite((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
+  if (hasCompressedPages()) {
+    const int32_t flags[2] = {static_cast<int32_t>(has_bloom_filter),
+                              static_cast<int32_t>(pageCompression_)};
+    fwrite((int8_t*)flags, sizeof(int32_t), 2, f);
+  }
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
+    if (has_bloom_filter) {
+      encoder_->writeBloomFilter(f);
+    }
   }
   metadataPages_.push(page, epoch);
 }
@@ -493,6 +579,13 @@ void FileBuffer::append(int8_t* src,
                         const int32_t deviceId) {
   setAppended();
 
+  if (hasCompressedPages()) {
+    const size_t offset = size_;
+    size_ = size_ + numBytes;
+    writeCompressed(src, numBytes, offset);
+    return;
+  }
+
   size_t startPage = size_ / pageDataSize_;
   size_t startPageOffset = size_ % pageDataSize_;
   size_t numPagesToWrite =
@@ -550,6 +643,11 @@ void FileBuffer::write(int8_t* src,
     size_ = offset + numBytes;
   }
 
+  if (hasCompressedPages()) {
+    writeCompressed(src, numBytes, offset);
+    return;
+  }
+
   size_t startPage = offset / pageDataSize_;
   size_t startPageOffset = offset % pageDataSize_;
   size_t numPagesToWrite =
@@ -621,6 +719,110 @@ void FileBuffer::write(int8_t* src,
   CHECK(bytesLeft == 0);
 }
 
+void FileBuffer::writeCompressed(int8_t* src,
+                                 const size_t numBytes,
+                                 const size_t offset) {
+  size_t startPage = offset / pageDataSize_;
+  size_t startPageOffset = offset % pageDataSize_;
+  size_t numPagesToWrite =
+      (numBytes + startPageOffset + pageDataSize_ - 1) / pageDataSize_;
+  size_t bytesLeft = numBytes;
+  int8_t* curPtr = src;  // a pointer to the current location in src being written from
+  size_t initialNumPages = multiPages_.size();
+  auto epoch = getFileMgrEpoch();
+
+  // pages in a gap hold no data, but must still hold a valid (empty) frame
+  for (size_t pageNum = initialNumPages; pageNum < startPage; ++pageNum) {
+    Page page = addNewMultiPage(epoch);
+    writeHeader(page, pageNum, epoch);
+    writeCompressedPage(page, src, 0);
+  }
+  std::vector<int8_t> pageData(pageDataSize_);
+  for (size_t pageNum = startPage; pageNum < startPage + numPagesToWrite; ++pageNum) {
+    const size_t pageOffset = pageNum == startPage ? startPageOffset : 0;
+    const size_t bytesToWrite = min(pageDataSize_ - pageOffset, bytesLeft);
+    // A page is compressed as a whole, so a partial write (including an append to the
+    // last page) merges with the current content of the page. Unlike uncompressed pages,
+    // which are appended to in place, the result always goes to a page of the current
+    // epoch so that the checkpointed version stays intact for rollbacks.
+    size_t pageBytes = 0;
+    if (pageNum < initialNumPages && bytesToWrite < pageDataSize_) {
+      pageBytes =
+          readCompressedPage(multiPages_[pageNum].current().page, pageData.data());
+    } else {
+      std::fill(pageData.begin(), pageData.begin() + pageOffset, 0);
+    }
+    memcpy(pageData.data() + pageOffset, curPtr, bytesToWrite);
+    pageBytes = std::max(pageBytes, pageOffset + bytesToWrite);
+
+    Page page;
+    if (pageNum >= initialNumPages) {
+      page = addNewMultiPage(epoch);
+      writeHeader(page, pageNum, epoch);
+    } else if (multiPages_[pageNum].current().epoch < epoch) {
+      page = fm_->requestFreePage(pageSize_, false);
+      multiPages_[pageNum].push(page, epoch);
+      writeHeader(page, pageNum, epoch);
+    } else {
+      page = multiPages_[pageNum].current().page;
+    }
+    CHECK(page.fileId >= 0);  // make sure page was initialized
+    writeCompressedPage(page, pageData.data(), pageBytes);
+    curPtr += bytesToWrite;
+    bytesLeft -= bytesToWrite;
+  }
+  CHECK(bytesLeft == 0);
+}
+
+void FileBuffer::writeCompressedPage(const Page& page,
+                                     const int8_t* src,
+                                     const size_t numBytes) {
+  CHECK_LE(numBytes, pageDataSize_);
+  std::vector<int8_t> compressed(pageSize_ - reservedHeaderSize_);
+  const auto compressedSize =
+      BloscCompressor::compressWithContext(src,
+                                           numBytes,
+                                           compressed.data(),
+                                           compressed.size(),
+                                           blosc_compressor_name(pageCompression_),
+                                           compressionTypeSize());
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  size_t bytesWritten = fileInfo->write(
+      page.pageNum * pageSize_ + reservedHeaderSize_, compressedSize, compressed.data());
+  CHECK(bytesWritten == compressedSize);
+}
+
+size_t FileBuffer::readCompressedPage(const Page& page, int8_t* const dst) const {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  CHECK(fileInfo);
+  const size_t pageStart = page.pageNum * pageSize_ + reservedHeaderSize_;
+  std::vector<int8_t> compressed(pageSize_ - reservedHeaderSize_);
+  // the frame header holds the compressed size, read the rest of the frame only
+  size_t bytesRead =
+      fileInfo->read(pageStart, BloscCompressor::kMaxOverhead, compressed.data());
+  CHECK(bytesRead == BloscCompressor::kMaxOverhead);
+  const auto compressedSize = BloscCompressor::getCompressedSize(compressed.data());
+  CHECK_GE(compressedSize, BloscCompressor::kMaxOverhead);
+  CHECK_LE(compressedSize, compressed.size());
+  const size_t frameBytesLeft = compressedSize - BloscCompressor::kMaxOverhead;
+  if (frameBytesLeft > 0) {
+    bytesRead = fileInfo->read(pageStart + BloscCompressor::kMaxOverhead,
+                               frameBytesLeft,
+                               compressed.data() + BloscCompressor::kMaxOverhead);
+    CHECK(bytesRead == frameBytesLeft);
+  }
+  const auto pageBytes =
+      BloscCompressor::decompressWithContext(compressed.data(), dst, pageDataSize_);
+  std::fill(dst + pageBytes, dst + pageDataSize_, 0);
+  return pageBytes;
+}
+
+size_t FileBuffer::compressionTypeSize() const {
+  // shuffling by the width of fixed length values groups their bytes of equal weight
+  const auto type_size = sql_type_.get_size();
+  return !sql_type_.is_varlen() && type_size > 1 && type_size <= 8 ? type_size : 1;
+}
+
 int32_t FileBuffer::getFileMgrEpoch() {
   auto [db_id, tb_id] = get_table_prefix(chunkKey_);
   return fm_->epoch(db_id, tb_id);
@@ -637,7 +839,13 @@ std::string FileBuffer::dump() const {
 void FileBuffer::initMetadataAndPageDataSize() {
   CHECK(metadataPages_.current().page.fileId != -1);  // was initialized
   readMetadata(metadataPages_.current().page);
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  initPageDataSize();
+}
+
+void FileBuffer::initPageDataSize() {
+  // compressed pages reserve room for incompressible data plus the frame header
+  pageDataSize_ = pageSize_ - reservedHeaderSize_ -
+                  (hasCompressedPages() ? BloscCompressor::kMaxOverhead : 0);
 }
 
 bool FileBuffer::isMissingPages() const {
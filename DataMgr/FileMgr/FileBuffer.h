@@ -34,10 +34,20 @@ using namespace Data_Namespace;
 
 #define NUM_METADATA 10
 #define METADATA_VERSION 0
+// metadata pages followed by the bloom filter of the chunk, see ChunkBloomFilter
+#define METADATA_VERSION_BLOOM_FILTER 1
+// metadata pages followed by the bloom filter flag and the page compression of the chunk
+#define METADATA_VERSION_PAGE_COMPRESSION 2
 #define METADATA_PAGE_SIZE 4096
 
 namespace File_Namespace {
 
+/// Codec of the data pages of a chunk, recorded on its metadata page.
+enum class PageCompression : int32_t { NONE = 0, LZ4 = 1, ZSTD = 2 };
+
+/// Maps a PAGE_COMPRESSION table option value, empty for none, to its codec.
+PageCompression page_compression_from_name(const std::string& name);
+
 // forward declarations
 class FileMgr;
 class CachingFileMgr;
@@ -144,6 +154,16 @@ class FileBuffer : public AbstractBuffer {
   /// FileBuffer.
   inline virtual size_t reservedHeaderSize() const { return reservedHeaderSize_; }
 
+  /// Returns whether the data pages of the FileBuffer are compressed, in which case each
+  /// page holds a single compressed frame of up to pageDataSize() bytes.
+  inline bool hasCompressedPages() const {
+    return pageCompression_ != PageCompression::NONE;
+  }
+
+  /// Decompresses the given data page into dst, which must hold pageDataSize() bytes.
+  /// Bytes past the written part of the page are zeroed. Returns the written size.
+  size_t readCompressedPage(const Page& page, int8_t* const dst) const;
+
   /// Returns vector of MultiPages in the FileBuffer.
   inline virtual std::vector<MultiPage> getMultiPage() const { return multiPages_; }
   inline MultiPage getMetadataPage() const { return metadataPages_; }
@@ -186,8 +206,13 @@ class FileBuffer : public AbstractBuffer {
                                         const int32_t targetEpoch,
                                         const int32_t currentEpoch);
   void initMetadataAndPageDataSize();
+  void initPageDataSize();
   int32_t getFileMgrEpoch();
 
+  void writeCompressed(int8_t* src, const size_t numBytes, const size_t offset);
+  void writeCompressedPage(const Page& page, const int8_t* src, const size_t numBytes);
+  size_t compressionTypeSize() const;
+
   FileMgr* fm_;  // a reference to FileMgr is needed for writing to new pages in available
                  // files
   MultiPage metadataPages_;
@@ -195,6 +220,7 @@ class FileBuffer : public AbstractBuffer {
   size_t pageSize_;
   size_t pageDataSize_;
   size_t reservedHeaderSize_;  // lets make this a constant now for simplicity - 128 bytes
+  PageCompression pageCompression_;
   ChunkKey chunkKey_;
 };
 
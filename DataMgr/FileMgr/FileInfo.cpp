@@ -20,11 +20,120 @@
 #include "FileMgr.h"
 #include "Page.h"
 
+#include <cstdlib>
+#include <memory>
 #include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
 using namespace std;
 
+bool g_enable_direct_io_reads{false};
+
 namespace File_Namespace {
 
+namespace {
+
+struct ReadSegment {
+  size_t file_offset;
+  size_t size;
+  int8_t* dst;
+};
+
+#ifdef __linux__
+constexpr size_t kDirectIoAlignment{4096};
+constexpr size_t kMaxDirectIoReadSize{64 * 1024 * 1024};
+
+void read_fully(const int fd, int8_t* buf, size_t size, size_t offset) {
+  while (size > 0) {
+    const auto bytes_read = ::pread(fd, buf, size, offset);
+    if (bytes_read < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes_read <= 0) {
+      LOG(FATAL) << "Error trying to read from file, the error was: "
+                 << (bytes_read ? std::strerror(errno) : "unexpected end of file");
+    }
+    buf += bytes_read;
+    size -= bytes_read;
+    offset += bytes_read;
+  }
+}
+
+// Reads segments separated by gap_size bytes of the file with vectored reads, the gaps
+// going to a scratch buffer.
+void read_vectored(const int fd,
+                   const std::vector<ReadSegment>& segments,
+                   const size_t gap_size) {
+  std::vector<int8_t> gap(gap_size);
+  std::vector<iovec> iov;
+  iov.reserve(2 * segments.size());
+  for (const auto& segment : segments) {
+    if (!iov.empty()) {
+      iov.push_back({gap.data(), gap_size});
+    }
+    iov.push_back({segment.dst, segment.size});
+  }
+  size_t offset = segments.front().file_offset;
+  size_t first = 0;
+  while (first < iov.size()) {
+    const int count = std::min(iov.size() - first, static_cast<size_t>(IOV_MAX));
+    const auto bytes_read = ::preadv(fd, &iov[first], count, offset);
+    if (bytes_read < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes_read <= 0) {
+      LOG(FATAL) << "Error trying to read from file, the error was: "
+                 << (bytes_read ? std::strerror(errno) : "unexpected end of file");
+    }
+    offset += bytes_read;
+    // skip the filled vectors and resume a short read within a partially filled one
+    size_t bytes_left = bytes_read;
+    while (first < iov.size() && bytes_left >= iov[first].iov_len) {
+      bytes_left -= iov[first].iov_len;
+      ++first;
+    }
+    if (bytes_left > 0) {
+      iov[first].iov_base = static_cast<int8_t*>(iov[first].iov_base) + bytes_left;
+      iov[first].iov_len -= bytes_left;
+    }
+  }
+}
+
+// Reads the block aligned span covering the segments through an aligned bounce buffer.
+void read_direct(const int fd, const std::vector<ReadSegment>& segments) {
+  const auto& last = segments.back();
+  const size_t begin =
+      segments.front().file_offset / kDirectIoAlignment * kDirectIoAlignment;
+  const size_t end = (last.file_offset + last.size + kDirectIoAlignment - 1) /
+                     kDirectIoAlignment * kDirectIoAlignment;
+  const size_t window_size = std::min(end - begin, kMaxDirectIoReadSize);
+  std::unique_ptr<int8_t, decltype(&free)> window(
+      static_cast<int8_t*>(aligned_alloc(kDirectIoAlignment, window_size)), &free);
+  CHECK(window);
+  for (size_t window_begin = begin; window_begin < end; window_begin += window_size) {
+    const size_t window_end = std::min(window_begin + window_size, end);
+    read_fully(fd, window.get(), window_end - window_begin, window_begin);
+    for (const auto& segment : segments) {
+      const size_t copy_begin = std::max(segment.file_offset, window_begin);
+      const size_t copy_end = std::min(segment.file_offset + segment.size, window_end);
+      if (copy_begin < copy_end) {
+        memcpy(segment.dst + (copy_begin - segment.file_offset),
+               window.get() + (copy_begin - window_begin),
+               copy_end - copy_begin);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace
+
 FileInfo::FileInfo(FileMgr* fileMgr,
                    const int32_t fileId,
                    FILE* f,
@@ -42,6 +151,11 @@ FileInfo::~FileInfo() {
   if (f) {
     close(f);
   }
+#ifdef __linux__
+  if (directIoFd >= 0) {
+    ::close(directIoFd);
+  }
+#endif
 }
 
 void FileInfo::initNewFile() {
@@ -68,6 +182,58 @@ size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
   return File_Namespace::read(f, offset, size, buf);
 }
 
+size_t FileInfo::readPages(const size_t pageNum,
+                           const size_t headerSize,
+                           const size_t offset,
+                           const size_t size,
+                           int8_t* buf) {
+  const size_t pageDataSize = pageSize - headerSize;
+  CHECK_LT(offset, pageDataSize);
+  std::vector<ReadSegment> segments;
+  size_t fileOffset = pageNum * pageSize + headerSize + offset;
+  size_t pageOffset = offset;
+  for (size_t bytesLeft = size; bytesLeft > 0; pageOffset = 0) {
+    const size_t segmentSize = std::min(pageDataSize - pageOffset, bytesLeft);
+    segments.push_back({fileOffset, segmentSize, buf + (size - bytesLeft)});
+    fileOffset += segmentSize + headerSize;
+    bytesLeft -= segmentSize;
+  }
+  if (segments.empty()) {
+    return 0;
+  }
+#ifdef __linux__
+  int directFd;
+  {
+    std::lock_guard<std::mutex> lock(readWriteMutex_);
+    // reads below bypass the stream, so writes it still buffers must reach the file
+    CHECK_EQ(fflush(f), 0);
+    if (g_enable_direct_io_reads && directIoFd == -1) {
+      directIoFd = -2;
+      if (pageSize % kDirectIoAlignment == 0) {
+        const auto path = "/proc/self/fd/" + std::to_string(fileno(f));
+        directIoFd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+        if (directIoFd < 0) {
+          LOG(WARNING) << "Direct IO reads not supported for file " << fileId
+                       << ", the error was: " << std::strerror(errno);
+          directIoFd = -2;
+        }
+      }
+    }
+    directFd = g_enable_direct_io_reads ? directIoFd : -1;
+  }
+  if (directFd >= 0) {
+    read_direct(directFd, segments);
+  } else {
+    read_vectored(fileno(f), segments, headerSize);
+  }
+#else
+  for (const auto& segment : segments) {
+    read(segment.file_offset, segment.size, segment.dst);
+  }
+#endif
+  return size;
+}
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec) {
   // HeaderInfo is defined in Page.h
 
@@ -62,6 +62,7 @@ struct FileInfo {
   std::set<size_t> freePages;  /// set of page numbers of free pages
   std::mutex freePagesMutex_;
   std::mutex readWriteMutex_;
+  int directIoFd{-1};  /// O_DIRECT descriptor for reads, -2 if unsupported
 
   /// Constructor
   FileInfo(FileMgr* fileMgr,
@@ -84,6 +85,21 @@ struct FileInfo {
   size_t write(const size_t offset, const size_t size, const int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
+  /**
+   * @brief Reads size bytes of page data starting offset bytes into the data of page
+   * pageNum, continuing into the data of the following pages of the file, i.e. skipping
+   * the first headerSize bytes of each of them.
+   *
+   * The whole run is read with a single vectored read instead of one read per page.
+   * With --enable-direct-io-reads, files with block aligned pages are read past the page
+   * cache, as fetched chunks are cached by the CPU buffer pool anyway.
+   */
+  size_t readPages(const size_t pageNum,
+                   const size_t headerSize,
+                   const size_t offset,
+                   const size_t size,
+                   int8_t* buf);
+
   void openExistingFile(std::vector<HeaderInfo>& headerVec);
   /// Prints a summary of the file to stdout
   void print(bool pagesummary);
@@ -298,6 +298,15 @@ class FileMgr : public AbstractBufferMgr {  // implements
    */
   inline int32_t maxRollbackEpochs() { return maxRollbackEpochs_; }
 
+  /**
+   * @brief Returns the codec of the data pages of buffers created from now on. Existing
+   * buffers keep the codec recorded on their metadata page.
+   */
+  inline PageCompression pageCompression() const { return pageCompression_; }
+  inline void setPageCompression(const PageCompression page_compression) {
+    pageCompression_ = page_compression;
+  }
+
   /**
    * @brief Returns number of threads defined by parameter num-reader-threads
    * which should be used during initial load and consequent read of data.
@@ -381,6 +390,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   FileMgr();
 
   int32_t maxRollbackEpochs_;
+  PageCompression pageCompression_{PageCompression::NONE};
   std::string fileMgrBasePath_;  /// The OS file system path containing files related to
                                  /// this FileMgr
   std::map<int32_t, FileInfo*>
@@ -170,9 +170,13 @@ void GlobalFileMgr::setFileMgrParams(const int32_t db_id,
       num_reader_threads_,
       file_mgr_params.epoch != -1 ? file_mgr_params.epoch : epoch_,
       defaultPageSize_);
+  const auto page_compression =
+      page_compression_from_name(file_mgr_params.page_compression);
+  s->setPageCompression(page_compression);
   CHECK(ownedFileMgrs_.insert(std::make_pair(file_mgr_key, s)).second);
   CHECK(allFileMgrs_.insert(std::make_pair(file_mgr_key, s.get())).second);
   max_rollback_epochs_per_table_[{db_id, tb_id}] = max_rollback_epochs;
+  page_compression_per_table_[{db_id, tb_id}] = page_compression;
   return;
 }
 
@@ -210,6 +214,10 @@ AbstractBufferMgr* GlobalFileMgr::getFileMgr(const int32_t db_id, const int32_t
                                          num_reader_threads_,
                                          epoch_,
                                          defaultPageSize_);
+      if (const auto it = page_compression_per_table_.find(file_mgr_key);
+          it != page_compression_per_table_.end()) {
+        s->setPageCompression(it->second);
+      }
       CHECK(ownedFileMgrs_.insert(std::make_pair(file_mgr_key, s)).second);
       CHECK(allFileMgrs_.insert(std::make_pair(file_mgr_key, s.get())).second);
       return s.get();
@@ -269,6 +277,7 @@ void GlobalFileMgr::removeTableRelatedDS(const int32_t db_id, const int32_t tb_i
 
   deleteFileMgr(db_id, tb_id);
   max_rollback_epochs_per_table_.erase({db_id, tb_id});
+  page_compression_per_table_.erase({db_id, tb_id});
 }
 
 void GlobalFileMgr::setTableEpoch(const int32_t db_id,
@@ -46,6 +46,7 @@ struct FileMgrParams {
   FileMgrParams() : epoch(-1), max_rollback_epochs(-1) {}
   int32_t epoch;
   int32_t max_rollback_epochs;
+  std::string page_compression;  // table option, empty for uncompressed pages
 };
 
 /**
@@ -216,6 +217,7 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   std::map<TablePair, std::shared_ptr<FileMgr>> ownedFileMgrs_;
   std::map<TablePair, AbstractBufferMgr*> allFileMgrs_;
   std::map<TablePair, int32_t> max_rollback_epochs_per_table_;
+  std::map<TablePair, PageCompression> page_compression_per_table_;
   std::shared_ptr<ForeignStorageInterface> fsi_;
 
   mapd_shared_mutex fileMgrs_mutex_;
@@ -45,6 +45,7 @@ class FixedLengthEncoder : public Encoder {
         num_elems_to_append >=
             num_elems_) {  // we're rewriting entire buffer so fully recompute metadata
       resetChunkStats();
+      clearBloomFilter();
     }
 
     T* unencoded_data = reinterpret_cast<T*>(src_data);
@@ -143,6 +144,13 @@ class FixedLengthEncoder : public Encoder {
                             std::max(lhs_max, rhs_max),
                             lhs_nulls || rhs_nulls);
         });
+    if (bloom_filter_) {
+      for (size_t i = 0; i < num_elements; i++) {
+        if (data[i] != std::numeric_limits<V>::min()) {
+          addToBloomFilter(data[i]);
+        }
+      }
+    }
   }
 
   void updateStats(const std::vector<std::string>* const src_data,
@@ -159,7 +167,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
@@ -232,6 +240,7 @@ class FixedLengthEncoder : public Encoder {
         decimal_overflow_validator_.validate(data);
         dataMin = std::min(dataMin, data);
         dataMax = std::max(dataMax, data);
+        addToBloomFilter(data);
       }
     }
     return encoded_data;
@@ -46,6 +46,7 @@ class NoneEncoder : public Encoder {
                                             const int64_t offset = -1) override {
     if (offset == 0 && num_elems_to_append >= num_elems_) {
       resetChunkStats();
+      clearBloomFilter();
     }
     T* unencodedData = reinterpret_cast<T*>(src_data);
     std::vector<T> encoded_data;
@@ -147,6 +148,15 @@ class NoneEncoder : public Encoder {
                             std::max(lhs_max, rhs_max),
                             lhs_nulls || rhs_nulls);
         });
+    if constexpr (std::is_integral<T>::value) {
+      if (bloom_filter_) {
+        for (size_t i = 0; i < num_elements; i++) {
+          if (data[i] != none_encoded_null_value<T>()) {
+            addToBloomFilter(data[i]);
+          }
+        }
+      }
+    }
   }
 
   void updateStats(const std::vector<std::string>* const src_data,
@@ -163,7 +173,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const NoneEncoder&>(that);
+    const auto& that_typed = static_cast<const NoneEncoder&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
@@ -227,6 +237,9 @@ class NoneEncoder : public Encoder {
       decimal_overflow_validator_.validate(unencoded_data);
       dataMin = std::min(dataMin, unencoded_data);
       dataMax = std::max(dataMax, unencoded_data);
+      if constexpr (std::is_integral<T>::value) {
+        addToBloomFilter(unencoded_data);
+      }
     }
     return unencoded_data;
   }
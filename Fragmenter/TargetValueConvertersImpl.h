@@ -207,9 +207,11 @@ struct DictionaryValueConverter : public NumericValueConverter<int64_t, TARGET_T
       CHECK(source_dict_desc_);
     } else {
       if (literals_dict) {
-        for (auto& entry : literals_dict->getTransientMapping()) {
-          auto newId = target_dict_desc_->stringDict->getOrAdd(entry.second);
-          literals_lookup_[entry.first] = newId;
+        const auto transient_strings = literals_dict->getTransientStrings();
+        for (size_t index = 0; index < transient_strings.size(); ++index) {
+          auto newId = target_dict_desc_->stringDict->getOrAdd(
+              std::string(transient_strings[index]));
+          literals_lookup_[StringDictionaryProxy::transientIndexToId(index)] = newId;
         }
       }
 
@@ -310,7 +312,7 @@ struct DictionaryValueConverter : public NumericValueConverter<int64_t, TARGET_T
               target_dict_desc_->stringDict.get(),
               *bufferPtr,
               source_dict_desc_->stringDict.get(),
-              source_dict_proxy_->getTransientMapping());
+              source_dict_proxy_->getTransientStrings());
         } else {
           StringDictionary::populate_string_ids(dest_ids,
                                                 target_dict_desc_->stringDict.get(),
@@ -28,6 +28,7 @@
 #include "LockMgr/LockMgr.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/DateConverters.h"
+#include "Shared/EncodedIntStream.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/thread_count.h"
 #include "TargetValueConvertersFactories.h"
@@ -264,6 +265,46 @@ struct DateChunkConverter : public ChunkToInsertDataConverter {
   }
 };
 
+template <typename INSERT_DATA_TYPE>
+struct EncodedIntChunkConverter : public ChunkToInsertDataConverter {
+  using ColumnDataPtr =
+      std::unique_ptr<INSERT_DATA_TYPE, CheckedMallocDeleter<INSERT_DATA_TYPE>>;
+
+  const Chunk_NS::Chunk* chunk_;
+  ColumnDataPtr column_data_;
+  const ColumnDescriptor* column_descriptor_;
+  std::vector<int64_t> decoded_values_;
+
+  // RL and DIFF encoded chunks can't be written in place by row, decode them upfront
+  EncodedIntChunkConverter(const size_t num_rows, const Chunk_NS::Chunk* chunk)
+      : chunk_(chunk), column_descriptor_(chunk->getColumnDesc()) {
+    column_data_ = ColumnDataPtr(reinterpret_cast<INSERT_DATA_TYPE*>(
+        checked_malloc(num_rows * sizeof(INSERT_DATA_TYPE))));
+    const auto buffer = chunk->getBuffer();
+    const auto null_val = inline_fixed_encoding_null_val(column_descriptor_->columnType);
+    decoded_values_.resize(buffer->getEncoder()->getNumElems());
+    decode_encoded_int_stream(buffer->getMemoryPtr(),
+                              decoded_values_.size(),
+                              null_val,
+                              decoded_values_.data());
+  }
+
+  ~EncodedIntChunkConverter() override {}
+
+  void convertToColumnarFormat(size_t row, size_t indexInFragment) override {
+    CHECK_LT(indexInFragment, decoded_values_.size());
+    column_data_.get()[row] =
+        static_cast<INSERT_DATA_TYPE>(decoded_values_[indexInFragment]);
+  }
+
+  void addDataBlocksToInsertData(Fragmenter_Namespace::InsertData& insertData) override {
+    DataBlockPtr dataBlock;
+    dataBlock.numbersPtr = reinterpret_cast<int8_t*>(column_data_.get());
+    insertData.data.push_back(dataBlock);
+    insertData.columnIds.push_back(column_descriptor_->columnId);
+  }
+};
+
 void InsertOrderFragmenter::updateColumns(
     const Catalog_Namespace::Catalog* catalog,
     const TableDescriptor* td,
@@ -396,6 +437,29 @@ void InsertOrderFragmenter::updateColumns(
           CHECK(false);
         }
         chunkConverters.push_back(std::move(converter));
+      } else if (chunk_cd->columnType.is_rl_or_diff_encoded()) {
+        std::unique_ptr<ChunkToInsertDataConverter> converter;
+        switch (chunk_cd->columnType.get_logical_size()) {
+          case 1:
+            converter =
+                std::make_unique<EncodedIntChunkConverter<int8_t>>(num_rows, chunk.get());
+            break;
+          case 2:
+            converter = std::make_unique<EncodedIntChunkConverter<int16_t>>(num_rows,
+                                                                            chunk.get());
+            break;
+          case 4:
+            converter = std::make_unique<EncodedIntChunkConverter<int32_t>>(num_rows,
+                                                                            chunk.get());
+            break;
+          case 8:
+            converter = std::make_unique<EncodedIntChunkConverter<int64_t>>(num_rows,
+                                                                            chunk.get());
+            break;
+          default:
+            CHECK(false);
+        }
+        chunkConverters.push_back(std::move(converter));
       } else {
         std::unique_ptr<ChunkToInsertDataConverter> converter;
         SQLTypeInfo logical_type = get_logical_type_info(chunk_cd->columnType);
@@ -649,6 +713,12 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
   updel_roll.memoryLevel = memory_level;
 
+  if (cd->columnType.is_rl_or_diff_encoded()) {
+    // updated by the variable length update path instead
+    throw std::runtime_error("In place UPDATE of RL or DIFF encoded column " +
+                             cd->columnName + " not supported.");
+  }
+
   const size_t ncore = cpu_threads();
   const auto nrow = frag_offsets.size();
   const auto n_rhs_values = rhs_values.size();
@@ -959,6 +1029,9 @@ void InsertOrderFragmenter::updateColumnMetadata(
   const auto& lhs_type = cd->columnType;
 
   auto encoder = buffer->getEncoder();
+  // only the range of the new values is known here, so the bloom filter of the chunk can
+  // no longer rule out any value
+  encoder->saturateBloomFilter();
   auto update_stats = [&encoder](auto min, auto max, auto has_null) {
     static_assert(std::is_same<decltype(min), decltype(max)>::value,
                   "Type mismatch on min/max");
@@ -1376,6 +1449,50 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
           }
         };
 
+    // RL and DIFF encoded chunks can't be written in place by row, rewrite them from the
+    // decoded rows to keep
+    auto encoded_vacuum = [=, &updel_roll, &frag_offsets, &fragment] {
+      std::vector<int64_t> values(nrows_in_fragment);
+      decode_encoded_int_stream(data_addr,
+                                nrows_in_fragment,
+                                inline_fixed_encoding_null_val(col_type),
+                                values.data());
+      const auto logical_size = col_type.get_logical_size();
+      std::vector<int8_t> data_to_keep(nrows_to_keep * logical_size);
+      size_t irow_to_fill = 0;
+      auto frag_offset_it = frag_offsets.begin();
+      for (size_t irow = 0; irow < nrows_in_fragment; ++irow) {
+        if (frag_offset_it != frag_offsets.end() && *frag_offset_it == irow) {
+          ++frag_offset_it;
+          continue;
+        }
+        const auto value = values[irow];
+        auto fill_addr = data_to_keep.data() + irow_to_fill++ * logical_size;
+        switch (logical_size) {
+          case 1:
+            *reinterpret_cast<int8_t*>(fill_addr) = value;
+            break;
+          case 2:
+            *reinterpret_cast<int16_t*>(fill_addr) = value;
+            break;
+          case 4:
+            *reinterpret_cast<int32_t*>(fill_addr) = value;
+            break;
+          default:
+            *reinterpret_cast<int64_t*>(fill_addr) = value;
+            break;
+        }
+      }
+      CHECK_EQ(irow_to_fill, nrows_to_keep);
+
+      // the rewrite recomputes the stats and the bloom filter of the chunk
+      auto fill_ptr = data_to_keep.data();
+      data_buffer->getEncoder()->appendData(fill_ptr, nrows_to_keep, col_type, false, 0);
+      data_buffer->setUpdated();
+
+      set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+    };
+
     auto varlen_vacuum = [=, &updel_roll, &frag_offsets, &fragment] {
       size_t nbytes_var_data_to_keep;
       if (nrows_to_keep == 0) {
@@ -1397,6 +1514,8 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
 
     if (is_varlen) {
       threads.emplace_back(std::async(std::launch::async, varlen_vacuum));
+    } else if (col_type.is_rl_or_diff_encoded()) {
+      threads.emplace_back(std::async(std::launch::async, encoded_vacuum));
     } else {
       threads.emplace_back(std::async(std::launch::async, fixlen_vacuum));
     }
@@ -1412,7 +1531,11 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
   for (size_t ci = 0; ci < chunks.size(); ++ci) {
     auto chunk = chunks[ci];
     auto cd = chunk->getColumnDesc();
-    if (!cd->columnType.is_fixlen_array()) {
+    if (cd->columnType.is_rl_or_diff_encoded()) {
+      std::lock_guard<std::mutex> lck(updel_roll.mutex);
+      chunk->getBuffer()->getEncoder()->getMetadata(
+          updel_roll.chunkMetadata[key][cd->columnId]);
+    } else if (!cd->columnType.is_fixlen_array()) {
       // For DATE_IN_DAYS encoded columns, data is stored in days but the metadata is
       // stored in seconds. Do the metadata conversion here before updating the chunk
       // stats.
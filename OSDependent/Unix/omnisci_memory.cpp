@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/omnisci_memory.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace omnisci {
+
+namespace {
+
+uintptr_t round_up(const uintptr_t value, const uintptr_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+size_t read_huge_page_size() {
+  constexpr size_t kDefaultHugePageSize{2 * 1024 * 1024};
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key;
+  size_t size_kb;
+  while (meminfo >> key) {
+    if (key == "Hugepagesize:" && meminfo >> size_kb && size_kb) {
+      return size_kb * 1024;
+    }
+    std::getline(meminfo, key);
+  }
+  return kDefaultHugePageSize;
+}
+
+}  // namespace
+
+size_t get_huge_page_size() {
+  static const size_t huge_page_size = read_huge_page_size();
+  return huge_page_size;
+}
+
+void* map_huge_pages(const size_t length, const bool explicit_huge_pages) {
+#ifdef __linux__
+  const uintptr_t huge_page_size = get_huge_page_size();
+  const uintptr_t mapped_length = round_up(length, huge_page_size);
+  if (explicit_huge_pages) {
+#ifdef MAP_HUGETLB
+    auto ptr = mmap(nullptr,
+                    mapped_length,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                    -1,
+                    0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+    return nullptr;
+#endif
+  }
+#ifdef MADV_HUGEPAGE
+  // transparent huge pages only back aligned ranges, so over map and trim both ends
+  auto ptr = mmap(nullptr,
+                  mapped_length + huge_page_size,
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS,
+                  -1,
+                  0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto begin = reinterpret_cast<uintptr_t>(ptr);
+  const auto aligned_begin = round_up(begin, huge_page_size);
+  if (aligned_begin > begin) {
+    munmap(ptr, aligned_begin - begin);
+  }
+  const auto end = begin + mapped_length + huge_page_size;
+  const auto aligned_end = aligned_begin + mapped_length;
+  if (end > aligned_end) {
+    munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+  }
+  // fails if transparent huge pages are disabled, the range then uses regular pages
+  madvise(reinterpret_cast<void*>(aligned_begin), mapped_length, MADV_HUGEPAGE);
+  return reinterpret_cast<void*>(aligned_begin);
+#endif
+#endif
+  return nullptr;
+}
+
+void unmap_huge_pages(void* addr, const size_t length) {
+  munmap(addr, round_up(length, get_huge_page_size()));
+}
+
+bool prefault_memory(void* addr, const size_t length) {
+#ifdef __linux__
+  constexpr int kMadvPopulateWrite{23};  // since Linux 5.14
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const auto begin = round_up(reinterpret_cast<uintptr_t>(addr), page_size);
+  const auto end = (reinterpret_cast<uintptr_t>(addr) + length) & ~(page_size - 1);
+  if (end <= begin) {
+    return true;
+  }
+  return madvise(reinterpret_cast<void*>(begin), end - begin, kMadvPopulateWrite) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace omnisci
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/omnisci_numa.h"
+
+#include <dirent.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace omnisci {
+
+namespace {
+
+struct NumaNode {
+  int id;
+  std::vector<int> cpus;
+};
+
+// Parses a cpu list of the form "0-3,8,10-11".
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+  std::vector<int> cpus;
+  size_t pos = 0;
+  while (pos < cpu_list.size()) {
+    auto end = cpu_list.find(',', pos);
+    if (end == std::string::npos) {
+      end = cpu_list.size();
+    }
+    const auto range = cpu_list.substr(pos, end - pos);
+    const auto dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      // trailing newline or garbage
+    }
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+std::vector<NumaNode> read_numa_topology() {
+  std::vector<NumaNode> nodes;
+#ifdef __linux__
+  const std::string node_dir{"/sys/devices/system/node"};
+  auto dir = opendir(node_dir.c_str());
+  if (!dir) {
+    return nodes;
+  }
+  while (auto entry = readdir(dir)) {
+    const std::string name{entry->d_name};
+    if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+      continue;
+    }
+    std::ifstream cpu_list_file(node_dir + "/" + name + "/cpulist");
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    auto cpus = parse_cpu_list(cpu_list);
+    if (!cpus.empty()) {
+      // memory only nodes cannot run kernels and are left alone
+      nodes.push_back({std::stoi(name.substr(4)), std::move(cpus)});
+    }
+  }
+  closedir(dir);
+  std::sort(nodes.begin(), nodes.end(), [](const NumaNode& lhs, const NumaNode& rhs) {
+    return lhs.id < rhs.id;
+  });
+#endif
+  return nodes;
+}
+
+const std::vector<NumaNode>& get_numa_topology() {
+  static const auto nodes = read_numa_topology();
+  return nodes;
+}
+
+}  // namespace
+
+size_t get_numa_node_count() {
+  return std::max(get_numa_topology().size(), size_t(1));
+}
+
+bool bind_memory_to_numa_node(void* addr, const size_t length, const size_t numa_node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  const auto& nodes = get_numa_topology();
+  if (numa_node >= nodes.size()) {
+    return false;
+  }
+  // the policy applies to whole pages only, partial pages at the ends are left alone
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const uintptr_t begin =
+      (reinterpret_cast<uintptr_t>(addr) + page_size - 1) & ~(page_size - 1);
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + length) & ~(page_size - 1);
+  if (end <= begin) {
+    return true;
+  }
+  constexpr size_t kMaxNodes{1024};
+  constexpr size_t kBitsPerWord{8 * sizeof(unsigned long)};
+  std::vector<unsigned long> node_mask(kMaxNodes / kBitsPerWord);
+  const size_t node_id = nodes[numa_node].id;
+  if (node_id >= kMaxNodes) {
+    return false;
+  }
+  node_mask[node_id / kBitsPerWord] |= 1UL << (node_id % kBitsPerWord);
+  constexpr int kMpolBind{2};
+  // the kernel reads one bit less than the given maximum node, like numactl we add one
+  return syscall(SYS_mbind,
+                 begin,
+                 end - begin,
+                 kMpolBind,
+                 node_mask.data(),
+                 kMaxNodes + 1,
+                 0) == 0;
+#else
+  return false;
+#endif
+}
+
+NumaNodeThreadBinding::NumaNodeThreadBinding(const size_t numa_node) {
+#ifdef __linux__
+  const auto& nodes = get_numa_topology();
+  if (numa_node >= nodes.size()) {
+    return;
+  }
+  cpu_set_t affinity;
+  if (sched_getaffinity(0, sizeof(affinity), &affinity)) {
+    return;
+  }
+  cpu_set_t node_affinity;
+  CPU_ZERO(&node_affinity);
+  for (const auto cpu : nodes[numa_node].cpus) {
+    // keep the cpus the process is restricted to, e.g. by a cgroup or taskset
+    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &affinity)) {
+      CPU_SET(cpu, &node_affinity);
+    }
+  }
+  if (!CPU_COUNT(&node_affinity) ||
+      sched_setaffinity(0, sizeof(node_affinity), &node_affinity)) {
+    return;
+  }
+  saved_affinity_.resize(sizeof(affinity));
+  std::memcpy(saved_affinity_.data(), &affinity, sizeof(affinity));
+#endif
+}
+
+NumaNodeThreadBinding::~NumaNodeThreadBinding() {
+#ifdef __linux__
+  if (!saved_affinity_.empty()) {
+    cpu_set_t affinity;
+    std::memcpy(&affinity, saved_affinity_.data(), sizeof(affinity));
+    sched_setaffinity(0, sizeof(affinity), &affinity);
+  }
+#endif
+}
+
+}  // namespace omnisci
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/omnisci_memory.h"
+
+namespace omnisci {
+
+size_t get_huge_page_size() {
+  return 2 * 1024 * 1024;
+}
+
+void* map_huge_pages(const size_t length, const bool explicit_huge_pages) {
+  return nullptr;
+}
+
+void unmap_huge_pages(void* addr, const size_t length) {}
+
+bool prefault_memory(void* addr, const size_t length) {
+  return false;
+}
+
+}  // namespace omnisci
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace omnisci {
+
+// Size of the default huge pages, 2MB where it is not known.
+size_t get_huge_page_size();
+
+// Maps anonymous memory backed by huge pages, aligned to the huge page size. Explicit
+// huge pages are taken from the pool reserved in /proc/sys/vm/nr_hugepages, otherwise
+// the range is advised for transparent huge pages. Returns nullptr if the memory could
+// not be mapped, e.g. because the pool is exhausted.
+void* map_huge_pages(const size_t length, const bool explicit_huge_pages);
+
+void unmap_huge_pages(void* addr, const size_t length);
+
+// Backs the whole pages of the range with writable memory without changing its contents,
+// so the range can be written concurrently. Returns false if the OS does not support it.
+bool prefault_memory(void* addr, const size_t length);
+
+}  // namespace omnisci
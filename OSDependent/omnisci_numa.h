@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+namespace omnisci {
+
+// NUMA nodes are numbered from zero to the node count, which is one where the topology is
+// not known.
+size_t get_numa_node_count();
+
+// Places the pages of the range on the given node when they are first touched. Returns
+// false if the memory policy could not be set.
+bool bind_memory_to_numa_node(void* addr, const size_t length, const size_t numa_node);
+
+// Restricts the calling thread to the cpus of a NUMA node for the lifetime of the object.
+class NumaNodeThreadBinding {
+ public:
+  explicit NumaNodeThreadBinding(const size_t numa_node);
+  ~NumaNodeThreadBinding();
+
+ private:
+  std::vector<char> saved_affinity_;
+};
+
+}  // namespace omnisci
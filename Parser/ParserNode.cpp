@@ -2183,6 +2183,47 @@ decltype(auto) get_max_rollback_epochs_def(TableDescriptor& td,
       p, assignment);
 }
 
+decltype(auto) get_page_compression_def(TableDescriptor& td,
+                                        const NameValueAssign* p,
+                                        const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td](const auto codec_uc) {
+    if (codec_uc != "LZ4" && codec_uc != "ZSTD" && codec_uc != "NONE") {
+      throw std::runtime_error("PAGE_COMPRESSION must be LZ4, ZSTD or NONE");
+    }
+    td.pageCompression = codec_uc == "NONE" ? "" : codec_uc;
+  });
+}
+
+// Handled apart from the other table options since it modifies the column descriptors.
+void set_bloom_filter_columns(const NameValueAssign* p,
+                              std::list<ColumnDescriptor>& columns) {
+  get_property_value<StringLiteral>(p, [&columns](const auto names_upper) {
+    std::vector<std::string> names;
+    boost::split(names, names_upper, boost::is_any_of(","));
+    for (auto& name : names) {
+      boost::trim(name);
+      auto cd_it = std::find_if(
+          columns.begin(), columns.end(), [&name](const ColumnDescriptor& cd) {
+            return boost::to_upper_copy<std::string>(cd.columnName) == name;
+          });
+      if (cd_it == columns.end()) {
+        throw std::runtime_error("Specified bloom filter column " + name +
+                                 " doesn't exist");
+      }
+      const auto& ti = cd_it->columnType;
+      if (ti.is_array() ||
+          !(ti.is_integer() || ti.is_time() ||
+            (ti.is_string() && ti.get_compression() == kENCODING_DICT))) {
+        throw std::runtime_error(
+            "BLOOM_FILTER is only supported on integer, date / time and dictionary "
+            "encoded string columns, column " +
+            cd_it->columnName + " is of type " + ti.get_type_name());
+      }
+      cd_it->hasBloomFilter = true;
+    }
+  });
+}
+
 static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap = {
     {"fragment_size"s, get_frag_size_def},
     {"max_chunk_size"s, get_max_chunk_size_def},
@@ -2193,7 +2234,8 @@ static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap
     {"vacuum"s, get_vacuum_def},
     {"sort_column"s, get_sort_column_def},
     {"storage_type"s, get_storage_type},
-    {"max_rollback_epochs", get_max_rollback_epochs_def}};
+    {"max_rollback_epochs", get_max_rollback_epochs_def},
+    {"page_compression"s, get_page_compression_def}};
 
 void get_table_definitions(TableDescriptor& td,
                            const std::unique_ptr<NameValueAssign>& p,
@@ -2204,7 +2246,8 @@ void get_table_definitions(TableDescriptor& td,
         "Invalid CREATE TABLE option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE, BLOOM_FILTER, "
+        "PAGE_COMPRESSION.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -2218,8 +2261,8 @@ void get_table_definitions_for_ctas(TableDescriptor& td,
         "Invalid CREATE TABLE AS option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE or "
-        "USE_SHARED_DICTIONARIES.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE, BLOOM_FILTER, "
+        "PAGE_COMPRESSION or USE_SHARED_DICTIONARIES.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -2454,6 +2497,10 @@ void CreateTableStmt::executeDryRun(const Catalog_Namespace::SessionInfo& sessio
   }
   if (!storage_options_.empty()) {
     for (auto& p : storage_options_) {
+      if (boost::iequals(*p->get_name(), "bloom_filter")) {
+        set_bloom_filter_columns(p.get(), columns);
+        continue;
+      }
       get_table_definitions(td, p, columns);
     }
   }
@@ -3438,7 +3485,7 @@ void CreateTableAsSelectStmt::execute(const Catalog_Namespace::SessionInfo& sess
     auto validate_result = local_connector.query(
         query_state->createQueryStateProxy(), select_query_, {}, true, false);
 
-    const auto column_descriptors_for_create =
+    auto column_descriptors_for_create =
         local_connector.getColumnDescriptors(validate_result, true);
 
     // some validation as the QE might return some out of range column types
@@ -3480,6 +3527,8 @@ void CreateTableAsSelectStmt::execute(const Catalog_Namespace::SessionInfo& sess
           }
           std::string val = boost::to_lower_copy<std::string>(*literal->get_stringval());
           use_shared_dictionaries = val == "true" || val == "1" || val == "t";
+        } else if (boost::iequals(*p->get_name(), "bloom_filter")) {
+          set_bloom_filter_columns(p.get(), column_descriptors_for_create);
         } else {
           get_table_definitions_for_ctas(td, p, column_descriptors_for_create);
         }
@@ -3631,10 +3680,12 @@ void DropTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
 
   auto table_data_write_lock =
       lockmgr::TableDataLockMgr::getWriteLockForTable(catalog, *table);
+  const auto table_id = td->tableId;
   catalog.dropTable(td);
 
   // invalidate cached hashtable
-  DeleteTriggeredCacheInvalidator::invalidateCaches();
+  DeleteTriggeredCacheInvalidator::invalidateCachesByTable(catalog.getDatabaseId(),
+                                                           table_id);
 }
 
 void AlterTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {}
@@ -3860,7 +3911,8 @@ void TruncateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   catalog.truncateTable(td);
 
   // invalidate cached hashtable
-  DeleteTriggeredCacheInvalidator::invalidateCaches();
+  DeleteTriggeredCacheInvalidator::invalidateCachesByTable(catalog.getDatabaseId(),
+                                                           td->tableId);
 }
 
 void check_alter_table_privilege(const Catalog_Namespace::SessionInfo& session,
@@ -4346,7 +4398,8 @@ void DropColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   }
 
   // invalidate cached hashtable
-  DeleteTriggeredCacheInvalidator::invalidateCaches();
+  DeleteTriggeredCacheInvalidator::invalidateCachesByTable(catalog.getDatabaseId(),
+                                                           td->tableId);
 }
 
 void RenameColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
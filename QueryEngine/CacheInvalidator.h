@@ -22,6 +22,11 @@ class CacheInvalidator {
  public:
   static void invalidateCaches() { internalInvalidateCache<CACHE_HOLDING_TYPES...>(); }
 
+  // Only drops the entries built over the given table, e.g. after its epoch changed.
+  static void invalidateCachesByTable(const int db_id, const int table_id) {
+    internalInvalidateCacheByTable<CACHE_HOLDING_TYPES...>(db_id, table_id);
+  }
+
  private:
   CacheInvalidator() = delete;
   ~CacheInvalidator() = delete;
@@ -39,6 +44,20 @@ class CacheInvalidator {
     internalInvalidateCache<SECOND_CACHE_HOLDING_TYPE,
                             REMAINING_CACHE_HOLDING_TYPES...>();
   }
+
+  template <typename CACHE_HOLDING_TYPE>
+  static void internalInvalidateCacheByTable(const int db_id, const int table_id) {
+    CACHE_HOLDING_TYPE::getTableCacheInvalidator()(db_id, table_id);
+  }
+
+  template <typename FIRST_CACHE_HOLDING_TYPE,
+            typename SECOND_CACHE_HOLDING_TYPE,
+            typename... REMAINING_CACHE_HOLDING_TYPES>
+  static void internalInvalidateCacheByTable(const int db_id, const int table_id) {
+    FIRST_CACHE_HOLDING_TYPE::getTableCacheInvalidator()(db_id, table_id);
+    internalInvalidateCacheByTable<SECOND_CACHE_HOLDING_TYPE,
+                                   REMAINING_CACHE_HOLDING_TYPES...>(db_id, table_id);
+  }
 };
 
 #endif
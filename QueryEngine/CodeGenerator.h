@@ -70,10 +70,16 @@ class CodeGenerator {
       const std::vector<llvm::Function*>& roots,
       const std::vector<llvm::Function*>& leaves);
 
+  // If object_cache provides the object code for the module (has_cached_object), it is
+  // loaded instead of generating code. baseline_code skips IR optimization and compiles
+  // without code generation optimizations.
   static ExecutionEngineWrapper generateNativeCPUCode(
       llvm::Function* func,
       const std::unordered_set<llvm::Function*>& live_funcs,
-      const CompilationOptions& co);
+      const CompilationOptions& co,
+      llvm::ObjectCache* object_cache = nullptr,
+      const bool has_cached_object = false,
+      const bool baseline_code = false);
 
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
@@ -100,3 +100,16 @@ llvm::Instruction* FixedWidthSmallDate::codegenDecode(llvm::Value* byte_stream,
       pos};
   return llvm::CallInst::Create(f, args);
 }
+
+EncodedInt::EncodedInt(const int64_t null_val) : null_val_{null_val} {}
+
+llvm::Instruction* EncodedInt::codegenDecode(llvm::Value* byte_stream,
+                                             llvm::Value* pos,
+                                             llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("encoded_int_decode");
+  CHECK(f);
+  auto null_val = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_);
+  llvm::Value* args[] = {byte_stream, null_val, pos};
+  return llvm::CallInst::Create(f, args);
+}
@@ -89,4 +89,16 @@ class FixedWidthSmallDate : public Decoder {
   static constexpr int64_t ret_null_val_ = NULL_BIGINT;
 };
 
+// Decodes RL and DIFF encoded chunks, whose layout is described by their header.
+class EncodedInt : public Decoder {
+ public:
+  EncodedInt(const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const int64_t null_val_;
+};
+
 #endif  // QUERYENGINE_CODEC_H
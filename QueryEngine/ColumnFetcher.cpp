@@ -301,6 +301,9 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
     std::lock_guard<std::mutex> columnar_conversion_guard(columnar_fetch_mutex_);
     auto column_it = columnarized_scan_table_cache_.find(col_desc);
     if (column_it == columnarized_scan_table_cache_.end()) {
+      std::vector<std::pair<const int8_t*, size_t>> encoded_chunks;
+      std::list<std::shared_ptr<Chunk_NS::Chunk>> encoded_chunk_holder;
+      std::optional<SQLTypeInfo> encoded_type;
       for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
         if (g_enable_non_kernel_time_query_interrupt && check_interrupt()) {
           throw QueryExecutionError(Executor::ERR_INTERRUPTED);
@@ -322,6 +325,13 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                                     Data_Namespace::CPU_LEVEL,
                                                     int(0),
                                                     device_allocator);
+        if (chunk_meta_it->second->sqlType.is_rl_or_diff_encoded()) {
+          // every chunk has its own header, decoded and concatenated below
+          encoded_chunk_holder.splice(encoded_chunk_holder.end(), chunk_holder);
+          encoded_chunks.emplace_back(col_buffer, fragment.getNumTuples());
+          encoded_type = chunk_meta_it->second->sqlType;
+          continue;
+        }
         column_frags.push_back(
             std::make_unique<ColumnarResults>(executor_->row_set_mem_owner_,
                                               col_buffer,
@@ -330,7 +340,10 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                               thread_idx));
       }
       auto merged_results =
-          ColumnarResults::mergeResults(executor_->row_set_mem_owner_, column_frags);
+          encoded_type ? ColumnarResults::mergeEncodedIntChunks(
+                             executor_->row_set_mem_owner_, encoded_chunks, *encoded_type)
+                       : ColumnarResults::mergeResults(executor_->row_set_mem_owner_,
+                                                       column_frags);
       table_column = merged_results.get();
       columnarized_scan_table_cache_.emplace(col_desc, std::move(merged_results));
     } else {
@@ -909,7 +922,10 @@ const int8_t* ColumnFetcher::transferColumnIfNeeded(
   CHECK_LT(static_cast<size_t>(col_id), col_buffers.size());
   if (memory_level == Data_Namespace::GPU_LEVEL) {
     const auto& col_ti = columnar_results->getColumnType(col_id);
-    const auto num_bytes = columnar_results->size() * col_ti.get_size();
+    const auto num_bytes =
+        col_ti.is_rl_or_diff_encoded()
+            ? linearized_encoded_int_stream_size(columnar_results->size())
+            : columnar_results->size() * col_ti.get_size();
     CHECK(device_allocator);
     auto gpu_col_buffer = device_allocator->alloc(num_bytes);
     device_allocator->copyToDevice(gpu_col_buffer, col_buffers[col_id], num_bytes);
@@ -73,6 +73,9 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       return col_var->get_comp_param() == 16 ? std::make_shared<FixedWidthSmallDate>(2)
                                              : std::make_shared<FixedWidthSmallDate>(4);
     }
+    case kENCODING_RL:
+    case kENCODING_DIFF:
+      return std::make_shared<EncodedInt>(inline_fixed_encoding_null_val(ti));
     default:
       abort();
   }
@@ -18,6 +18,7 @@
 #include "Descriptors/RowSetMemoryOwner.h"
 #include "ErrorHandling.h"
 #include "Execute.h"
+#include "Shared/EncodedIntStream.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
 #include "Shared/thread_count.h"
@@ -149,6 +150,40 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
   return merged_results;
 }
 
+std::unique_ptr<ColumnarResults> ColumnarResults::mergeEncodedIntChunks(
+    const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    const std::vector<std::pair<const int8_t*, size_t>>& chunks,
+    const SQLTypeInfo& target_type) {
+  CHECK(target_type.is_rl_or_diff_encoded());
+  const auto total_row_count =
+      std::accumulate(chunks.begin(),
+                      chunks.end(),
+                      size_t(0),
+                      [](const size_t init,
+                         const std::pair<const int8_t*, size_t>& chunk) {
+                        return init + chunk.second;
+                      });
+  if (!total_row_count) {
+    return nullptr;
+  }
+  std::unique_ptr<ColumnarResults> merged_results(
+      new ColumnarResults(total_row_count, {target_type}));
+  auto write_ptr = row_set_mem_owner->allocate(
+      linearized_encoded_int_stream_size(total_row_count));
+  merged_results->column_buffers_.push_back(write_ptr);
+  auto header = reinterpret_cast<EncodedIntStreamHeader*>(write_ptr);
+  header->base = 0;
+  header->byte_width = sizeof(int64_t);
+  header->num_runs = 0;
+  auto values = reinterpret_cast<int64_t*>(write_ptr + sizeof(EncodedIntStreamHeader));
+  const auto null_sentinel = encoded_int_diff_null_sentinel(sizeof(int64_t));
+  for (const auto& chunk : chunks) {
+    decode_encoded_int_stream(chunk.first, chunk.second, null_sentinel, values);
+    values += chunk.second;
+  }
+  return merged_results;
+}
+
 /**
  * This function iterates through the result set (using the getRowAtNoTranslation and
  * getNextRow family of functions) and writes back the results into output column buffers.
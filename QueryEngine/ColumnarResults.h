@@ -77,6 +77,13 @@ class ColumnarResults {
       const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
       const std::vector<std::unique_ptr<ColumnarResults>>& sub_results);
 
+  // Concatenates the chunks of an RL or DIFF encoded column into a single DIFF stream,
+  // see Shared/EncodedIntStream.h. Takes the chunk buffers and their element counts.
+  static std::unique_ptr<ColumnarResults> mergeEncodedIntChunks(
+      const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+      const std::vector<std::pair<const int8_t*, size_t>>& chunks,
+      const SQLTypeInfo& target_type);
+
   const std::vector<int8_t*>& getColumnBuffers() const { return column_buffers_; }
 
   const size_t size() const { return num_rows_; }
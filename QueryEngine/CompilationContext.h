@@ -18,6 +18,7 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
 #include <memory>
@@ -63,6 +64,12 @@ class CpuCompilationContext : public CompilationContext {
   CpuCompilationContext(ExecutionEngineWrapper&& execution_engine)
       : execution_engine_(std::move(execution_engine)) {}
 
+  // For code compiled outside of the global LLVM context, e.g. on a background thread.
+  CpuCompilationContext(ExecutionEngineWrapper&& execution_engine,
+                        std::unique_ptr<llvm::LLVMContext>&& llvm_context)
+      : llvm_context_(std::move(llvm_context))
+      , execution_engine_(std::move(execution_engine)) {}
+
   void setFunctionPointer(llvm::Function* function) {
     func_ = execution_engine_->getPointerToFunction(function);
     CHECK(func_);
@@ -72,5 +79,7 @@ class CpuCompilationContext : public CompilationContext {
 
  private:
   void* func_{nullptr};
+  // must outlive the execution engine, which owns a module created in this context
+  std::unique_ptr<llvm::LLVMContext> llvm_context_;
   ExecutionEngineWrapper execution_engine_;
 };
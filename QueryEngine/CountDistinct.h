@@ -25,6 +25,7 @@
 #ifndef QUERYENGINE_COUNTDISTINCT_H
 #define QUERYENGINE_COUNTDISTINCT_H
 
+#include "CountDistinctSet.h"
 #include "Descriptors/CountDistinctDescriptor.h"
 #include "HyperLogLog.h"
 
@@ -93,8 +94,8 @@ inline int64_t count_distinct_set_size(
     }
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
-  CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
-  return reinterpret_cast<std::set<int64_t>*>(set_handle)->size();
+  CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::CompactSet);
+  return reinterpret_cast<CountDistinctSet*>(set_handle)->size();
 }
 
 inline void count_distinct_set_union(
@@ -142,11 +143,11 @@ inline void count_distinct_set_union(
       bitmap_set_union(new_set, old_set, bitmap_byte_sz);
     }
   } else {
-    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
-    auto old_set = reinterpret_cast<std::set<int64_t>*>(old_set_handle);
-    auto new_set = reinterpret_cast<std::set<int64_t>*>(new_set_handle);
-    new_set->insert(old_set->begin(), old_set->end());
-    old_set->insert(new_set->begin(), new_set->end());
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::CompactSet);
+    auto old_set = reinterpret_cast<CountDistinctSet*>(old_set_handle);
+    auto new_set = reinterpret_cast<CountDistinctSet*>(new_set_handle);
+    old_set->merge(*new_set);
+    *new_set = *old_set;
   }
 }
 
@@ -0,0 +1,399 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/CountDistinctSet.h"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+namespace {
+
+constexpr size_t kMaxSortedArraySize{16};
+constexpr size_t kMinHashSetCapacity{64};
+// smaller hash sets are not worth estimating the size of the bitmap for
+constexpr size_t kMinBitmapSize{4096};
+
+}  // namespace
+
+struct CountDistinctSet::RoaringBitmap {
+  static constexpr size_t kMaxArrayContainerSize{4096};
+  static constexpr size_t kBitmapContainerWords{(1 << 16) / 64};
+
+  // The values of a chunk of 64K values, as offsets from the start of the chunk
+  struct Container {
+    std::vector<uint16_t> offsets;  // sorted, empty for bitmap containers
+    std::vector<uint64_t> words;    // empty for array containers
+    size_t cardinality{0};
+
+    bool isBitmap() const { return !words.empty(); }
+
+    bool contains(const uint16_t offset) const {
+      if (isBitmap()) {
+        return (words[offset >> 6] >> (offset & 63)) & 1;
+      }
+      return std::binary_search(offsets.begin(), offsets.end(), offset);
+    }
+
+    bool insert(const uint16_t offset) {
+      if (isBitmap()) {
+        auto& word = words[offset >> 6];
+        const auto bit = uint64_t(1) << (offset & 63);
+        if (word & bit) {
+          return false;
+        }
+        word |= bit;
+        ++cardinality;
+        return true;
+      }
+      auto it = std::lower_bound(offsets.begin(), offsets.end(), offset);
+      if (it != offsets.end() && *it == offset) {
+        return false;
+      }
+      if (offsets.size() == kMaxArrayContainerSize) {
+        toBitmap();
+        return insert(offset);
+      }
+      offsets.insert(it, offset);
+      ++cardinality;
+      return true;
+    }
+
+    void toBitmap() {
+      words.assign(kBitmapContainerWords, 0);
+      for (const auto offset : offsets) {
+        words[offset >> 6] |= uint64_t(1) << (offset & 63);
+      }
+      std::vector<uint16_t>().swap(offsets);
+    }
+
+    void merge(const Container& other) {
+      if (!isBitmap() && !other.isBitmap()) {
+        std::vector<uint16_t> merged;
+        merged.reserve(offsets.size() + other.offsets.size());
+        std::set_union(offsets.begin(),
+                       offsets.end(),
+                       other.offsets.begin(),
+                       other.offsets.end(),
+                       std::back_inserter(merged));
+        offsets = std::move(merged);
+        cardinality = offsets.size();
+        if (cardinality > kMaxArrayContainerSize) {
+          toBitmap();
+        }
+        return;
+      }
+      if (!isBitmap()) {
+        toBitmap();
+      }
+      if (!other.isBitmap()) {
+        for (const auto offset : other.offsets) {
+          insert(offset);
+        }
+        return;
+      }
+      // a word at a time without aliasing, which the compiler vectorizes
+      uint64_t* __restrict dst = words.data();
+      const uint64_t* __restrict src = other.words.data();
+      for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+        dst[i] |= src[i];
+      }
+      cardinality = 0;
+      for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+        cardinality += std::bitset<64>(dst[i]).count();
+      }
+    }
+
+    template <typename FUNC>
+    void forEachOffset(FUNC func) const {
+      if (!isBitmap()) {
+        std::for_each(offsets.begin(), offsets.end(), func);
+        return;
+      }
+      for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+        for (auto word = words[i]; word; word &= word - 1) {
+          // index of the lowest set bit
+          func(i * 64 + std::bitset<64>((word & -word) - 1).count());
+        }
+      }
+    }
+
+    size_t memoryUsage() const {
+      return offsets.capacity() * sizeof(uint16_t) + words.capacity() * sizeof(uint64_t);
+    }
+  };
+
+  static uint64_t chunkOf(const int64_t val) { return static_cast<uint64_t>(val) >> 16; }
+
+  bool contains(const int64_t val) const {
+    const auto it = std::lower_bound(chunks.begin(), chunks.end(), chunkOf(val));
+    return it != chunks.end() && *it == chunkOf(val) &&
+           containers[it - chunks.begin()].contains(static_cast<uint16_t>(val));
+  }
+
+  bool insert(const int64_t val) {
+    const auto chunk = chunkOf(val);
+    auto it = std::lower_bound(chunks.begin(), chunks.end(), chunk);
+    const size_t idx = it - chunks.begin();
+    if (it == chunks.end() || *it != chunk) {
+      chunks.insert(it, chunk);
+      containers.emplace(containers.begin() + idx);
+    }
+    return containers[idx].insert(static_cast<uint16_t>(val));
+  }
+
+  void merge(const RoaringBitmap& other) {
+    std::vector<uint64_t> merged_chunks;
+    std::vector<Container> merged_containers;
+    merged_chunks.reserve(chunks.size() + other.chunks.size());
+    merged_containers.reserve(chunks.size() + other.chunks.size());
+    size_t idx = 0, other_idx = 0;
+    while (idx < chunks.size() || other_idx < other.chunks.size()) {
+      if (other_idx == other.chunks.size() ||
+          (idx < chunks.size() && chunks[idx] < other.chunks[other_idx])) {
+        merged_chunks.push_back(chunks[idx]);
+        merged_containers.push_back(std::move(containers[idx++]));
+      } else if (idx == chunks.size() || other.chunks[other_idx] < chunks[idx]) {
+        merged_chunks.push_back(other.chunks[other_idx]);
+        merged_containers.push_back(other.containers[other_idx++]);
+      } else {
+        containers[idx].merge(other.containers[other_idx++]);
+        merged_chunks.push_back(chunks[idx]);
+        merged_containers.push_back(std::move(containers[idx++]));
+      }
+    }
+    chunks = std::move(merged_chunks);
+    containers = std::move(merged_containers);
+  }
+
+  template <typename FUNC>
+  void forEachValue(FUNC func) const {
+    for (size_t idx = 0; idx < chunks.size(); ++idx) {
+      const auto chunk_start = chunks[idx] << 16;
+      containers[idx].forEachOffset([&func, chunk_start](const uint64_t offset) {
+        func(static_cast<int64_t>(chunk_start | offset));
+      });
+    }
+  }
+
+  size_t cardinality() const {
+    size_t cardinality = 0;
+    for (const auto& container : containers) {
+      cardinality += container.cardinality;
+    }
+    return cardinality;
+  }
+
+  size_t memoryUsage() const {
+    size_t memory_usage =
+        chunks.capacity() * sizeof(uint64_t) + containers.capacity() * sizeof(Container);
+    for (const auto& container : containers) {
+      memory_usage += container.memoryUsage();
+    }
+    return memory_usage;
+  }
+
+  std::vector<uint64_t> chunks;  // sorted
+  std::vector<Container> containers;
+};
+
+CountDistinctSet::CountDistinctSet() = default;
+
+CountDistinctSet::CountDistinctSet(const CountDistinctSet& other)
+    : layout_(other.layout_)
+    , has_empty_slot_value_(other.has_empty_slot_value_)
+    , size_(other.size_)
+    , values_(other.values_)
+    , bitmap_(other.bitmap_ ? std::make_unique<RoaringBitmap>(*other.bitmap_)
+                            : nullptr) {}
+
+CountDistinctSet& CountDistinctSet::operator=(const CountDistinctSet& other) {
+  if (this != &other) {
+    layout_ = other.layout_;
+    has_empty_slot_value_ = other.has_empty_slot_value_;
+    size_ = other.size_;
+    values_ = other.values_;
+    bitmap_ = other.bitmap_ ? std::make_unique<RoaringBitmap>(*other.bitmap_) : nullptr;
+  }
+  return *this;
+}
+
+CountDistinctSet::~CountDistinctSet() = default;
+
+template <typename FUNC>
+void CountDistinctSet::forEachValue(FUNC func) const {
+  switch (layout_) {
+    case Layout::kSortedArray:
+      std::for_each(values_.begin(), values_.end(), func);
+      return;
+    case Layout::kHashSet:
+      if (has_empty_slot_value_) {
+        func(kEmptySlot);
+      }
+      for (const auto val : values_) {
+        if (val != kEmptySlot) {
+          func(val);
+        }
+      }
+      return;
+    case Layout::kBitmap:
+      bitmap_->forEachValue(func);
+      return;
+  }
+}
+
+bool CountDistinctSet::contains(const int64_t val) const {
+  switch (layout_) {
+    case Layout::kSortedArray:
+      return std::binary_search(values_.begin(), values_.end(), val);
+    case Layout::kHashSet: {
+      if (val == kEmptySlot) {
+        return has_empty_slot_value_;
+      }
+      const size_t mask = values_.size() - 1;
+      for (size_t slot = hash(val) & mask; values_[slot] != kEmptySlot;
+           slot = (slot + 1) & mask) {
+        if (values_[slot] == val) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case Layout::kBitmap:
+      return bitmap_->contains(val);
+  }
+  return false;
+}
+
+void CountDistinctSet::merge(const CountDistinctSet& other) {
+  if (this == &other || !other.size_) {
+    return;
+  }
+  if (layout_ == Layout::kBitmap || other.layout_ == Layout::kBitmap) {
+    if (layout_ != Layout::kBitmap) {
+      convertToBitmap();
+    }
+    if (other.layout_ == Layout::kBitmap) {
+      bitmap_->merge(*other.bitmap_);
+    } else {
+      other.forEachValue([this](const int64_t val) { bitmap_->insert(val); });
+    }
+    size_ = bitmap_->cardinality();
+    return;
+  }
+  if (layout_ == Layout::kSortedArray && other.layout_ == Layout::kSortedArray &&
+      size_ + other.size_ <= kMaxSortedArraySize) {
+    std::vector<int64_t> merged;
+    merged.reserve(size_ + other.size_);
+    std::set_union(values_.begin(),
+                   values_.end(),
+                   other.values_.begin(),
+                   other.values_.end(),
+                   std::back_inserter(merged));
+    values_ = std::move(merged);
+    size_ = values_.size();
+    return;
+  }
+  other.forEachValue([this](const int64_t val) { insert(val); });
+}
+
+size_t CountDistinctSet::memoryUsage() const {
+  return values_.capacity() * sizeof(int64_t) +
+         (bitmap_ ? sizeof(RoaringBitmap) + bitmap_->memoryUsage() : 0);
+}
+
+void CountDistinctSet::insertSlow(const int64_t val) {
+  switch (layout_) {
+    case Layout::kSortedArray: {
+      auto it = std::lower_bound(values_.begin(), values_.end(), val);
+      if (it != values_.end() && *it == val) {
+        return;
+      }
+      if (size_ < kMaxSortedArraySize) {
+        values_.insert(it, val);
+        ++size_;
+        return;
+      }
+      rehash(kMinHashSetCapacity);
+      insertIntoHashSet(val);
+      return;
+    }
+    case Layout::kHashSet:
+      // a full hash set only grows for new values
+      if (!contains(val)) {
+        growHashSet();
+        insert(val);
+      }
+      return;
+    case Layout::kBitmap:
+      if (bitmap_->insert(val)) {
+        ++size_;
+      }
+      return;
+  }
+}
+
+void CountDistinctSet::growHashSet() {
+  if (size_ >= kMinBitmapSize && isBitmapSmaller()) {
+    convertToBitmap();
+    return;
+  }
+  rehash(values_.size() * 2);
+}
+
+void CountDistinctSet::rehash(const size_t capacity) {
+  std::vector<int64_t> old_values(capacity, kEmptySlot);
+  values_.swap(old_values);
+  const bool was_hash_set = layout_ == Layout::kHashSet;
+  layout_ = Layout::kHashSet;
+  size_ = has_empty_slot_value_ ? 1 : 0;
+  for (const auto val : old_values) {
+    if (!was_hash_set || val != kEmptySlot) {
+      insertIntoHashSet(val);
+    }
+  }
+}
+
+bool CountDistinctSet::isBitmapSmaller() const {
+  std::vector<uint64_t> chunks;
+  chunks.reserve(size_);
+  forEachValue(
+      [&chunks](const int64_t val) { chunks.push_back(RoaringBitmap::chunkOf(val)); });
+  std::sort(chunks.begin(), chunks.end());
+  const size_t num_chunks = std::unique(chunks.begin(), chunks.end()) - chunks.begin();
+  // assumes array containers, bitmap containers of dense chunks are even smaller
+  const size_t bitmap_size =
+      num_chunks * (sizeof(uint64_t) + sizeof(RoaringBitmap::Container)) +
+      size_ * sizeof(uint16_t);
+  return bitmap_size < 2 * values_.size() * sizeof(int64_t);
+}
+
+void CountDistinctSet::convertToBitmap() {
+  std::vector<int64_t> values;
+  values.reserve(size_);
+  forEachValue([&values](const int64_t val) { values.push_back(val); });
+  // in chunk order, so that chunks and offsets are appended
+  std::sort(values.begin(), values.end(), [](const int64_t lhs, const int64_t rhs) {
+    return static_cast<uint64_t>(lhs) < static_cast<uint64_t>(rhs);
+  });
+  bitmap_ = std::make_unique<RoaringBitmap>();
+  for (const auto val : values) {
+    bitmap_->insert(val);
+  }
+  std::vector<int64_t>().swap(values_);
+  has_empty_slot_value_ = false;
+  layout_ = Layout::kBitmap;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CountDistinctSet.h
+ * @brief   Exact COUNT(DISTINCT) set for values too spread out for a bitmap.
+ *
+ * The layout of the set adapts to its size. Small sets are a sorted array. Larger sets
+ * are an open addressing hash set, and switch to a roaring bitmap once that is smaller:
+ * the values are split in chunks of 64K values, each stored as a sorted array of 16 bit
+ * offsets or as a bitmap. Most groups of a high cardinality group by only see a few
+ * values and stay in the array layout.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class CountDistinctSet {
+ public:
+  CountDistinctSet();
+  CountDistinctSet(const CountDistinctSet& other);
+  CountDistinctSet& operator=(const CountDistinctSet& other);
+  ~CountDistinctSet();
+
+  void insert(const int64_t val) {
+    if (layout_ != Layout::kHashSet || (size_ + 1) * 2 > values_.size()) {
+      insertSlow(val);
+      return;
+    }
+    insertIntoHashSet(val);
+  }
+
+  bool contains(const int64_t val) const;
+
+  size_t size() const { return size_; }
+
+  //! Adds the values of `other` to the set.
+  void merge(const CountDistinctSet& other);
+
+  //! Heap memory held by the set.
+  size_t memoryUsage() const;
+
+ private:
+  enum class Layout : uint8_t { kSortedArray, kHashSet, kBitmap };
+
+  struct RoaringBitmap;
+
+  static constexpr int64_t kEmptySlot{std::numeric_limits<int64_t>::min()};
+
+  static size_t hash(const int64_t val) {
+    // finalizer of murmur3, spreads sequential values over the slots
+    auto h = static_cast<uint64_t>(val);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  void insertIntoHashSet(const int64_t val) {
+    if (val == kEmptySlot) {
+      if (!has_empty_slot_value_) {
+        has_empty_slot_value_ = true;
+        ++size_;
+      }
+      return;
+    }
+    const size_t mask = values_.size() - 1;
+    for (size_t slot = hash(val) & mask;; slot = (slot + 1) & mask) {
+      if (values_[slot] == val) {
+        return;
+      }
+      if (values_[slot] == kEmptySlot) {
+        values_[slot] = val;
+        ++size_;
+        return;
+      }
+    }
+  }
+
+  void insertSlow(const int64_t val);
+  void growHashSet();
+  void rehash(const size_t capacity);
+  bool isBitmapSmaller() const;
+  void convertToBitmap();
+  template <typename FUNC>
+  void forEachValue(FUNC func) const;
+
+  Layout layout_{Layout::kSortedArray};
+  bool has_empty_slot_value_{false};  // kEmptySlot itself is in the hash set
+  size_t size_{0};
+  // the values for the sorted array layout, the slots for the hash set layout
+  std::vector<int64_t> values_;
+  std::unique_ptr<RoaringBitmap> bitmap_;
+};
@@ -25,6 +25,7 @@
 #define QUERYENGINE_DECODERSIMPL_H
 
 #include <cstdint>
+#include "../Shared/EncodedIntStream.h"
 #include "../Shared/funcannotations.h"
 
 extern "C" DEVICE ALWAYS_INLINE int64_t
@@ -155,6 +156,45 @@ SUFFIX(fixed_width_small_date_decode_noinline)(const int8_t* byte_stream,
       byte_stream, byte_width, null_val, ret_null_val, pos);
 }
 
+// Decodes a row of an RL or DIFF encoded chunk, see Shared/EncodedIntStream.h. Run
+// length streams are searched for the run holding the row, the generated code being
+// row-at-a-time.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(encoded_int_decode)(const int8_t* byte_stream,
+                           const int64_t null_val,
+                           const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto header = reinterpret_cast<const EncodedIntStreamHeader*>(byte_stream);
+  if (header->byte_width) {
+    const auto offset = SUFFIX(fixed_width_int_decode)(
+        byte_stream + sizeof(EncodedIntStreamHeader), header->byte_width, pos);
+    return offset == encoded_int_diff_null_sentinel(header->byte_width)
+               ? null_val
+               : header->base + offset;
+  }
+  const auto runs = encoded_int_runs(byte_stream);
+  int32_t lo = 0;
+  int32_t hi = header->num_runs - 1;
+  while (lo < hi) {
+    const int32_t mid = lo + (hi - lo) / 2;
+    if (runs[mid].end <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return runs[lo].value;
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(encoded_int_decode_noinline)(const int8_t* byte_stream,
+                                    const int64_t null_val,
+                                    const int64_t pos) {
+  return SUFFIX(encoded_int_decode)(byte_stream, null_val, pos);
+}
+
 #undef SUFFIX
 
 #endif  // QUERYENGINE_DECODERSIMPL_H
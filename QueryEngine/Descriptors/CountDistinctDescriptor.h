@@ -38,7 +38,8 @@ inline size_t bitmap_bits_to_bytes(const size_t bitmap_sz) {
   return bitmap_byte_sz;
 }
 
-enum class CountDistinctImplType { Invalid, Bitmap, StdSet };
+// CompactSet is a CountDistinctSet, for value ranges too wide for a bitmap
+enum class CountDistinctImplType { Invalid, Bitmap, CompactSet };
 
 struct CountDistinctDescriptor {
   CountDistinctImplType impl_type_;
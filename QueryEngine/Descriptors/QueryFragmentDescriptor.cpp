@@ -152,8 +152,12 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     }
 
     const auto& fragment = (*fragments)[i];
-    const auto skip_frag = executor->skipFragment(
-        table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
+    const auto skip_frag = executor->skipFragment(table_desc,
+                                                  fragment,
+                                                  ra_exe_unit.simple_quals,
+                                                  ra_exe_unit.quals,
+                                                  frag_offsets,
+                                                  i);
     if (skip_frag.first) {
       continue;
     }
@@ -365,6 +369,9 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
   outer_fragments_size_ = outer_fragments->size();
 
   const auto inner_table_id_to_join_condition = executor->getInnerTabIdToJoinCond();
+  const auto join_key_filters = enable_inner_join_fragment_skipping
+                                    ? executor->buildJoinKeyBloomFilters(ra_exe_unit)
+                                    : std::vector<Executor::JoinKeyBloomFilter>{};
 
   for (size_t outer_frag_id = 0; outer_frag_id < outer_fragments->size();
        ++outer_frag_id) {
@@ -380,12 +387,17 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     auto skip_frag = executor->skipFragment(outer_table_desc,
                                             fragment,
                                             ra_exe_unit.simple_quals,
+                                            ra_exe_unit.quals,
                                             frag_offsets,
                                             outer_frag_id);
     if (enable_inner_join_fragment_skipping &&
         (skip_frag == std::pair<bool, int64_t>(false, -1))) {
-      skip_frag = executor->skipFragmentInnerJoins(
-          outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
+      skip_frag = executor->skipFragmentInnerJoins(outer_table_desc,
+                                                   ra_exe_unit,
+                                                   fragment,
+                                                   frag_offsets,
+                                                   outer_frag_id,
+                                                   join_key_filters);
     }
     if (skip_frag.first) {
       continue;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -30,8 +31,10 @@
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
+#include "QueryEngine/CountDistinctSet.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "Shared/quantile.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
 class ResultSet;
@@ -43,29 +46,30 @@ class ResultSet;
 class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
  public:
   RowSetMemoryOwner(const size_t arena_block_size, const size_t num_kernel_threads = 0)
-      : arena_block_size_(arena_block_size) {
+      : arena_block_size_(arena_block_size), shared_allocator_(arena_block_size) {
     for (size_t i = 0; i < num_kernel_threads + 1; i++) {
-      allocators_.emplace_back(std::make_unique<Arena>(arena_block_size));
+      allocators_.emplace_back(std::make_unique<ThreadAllocator>(arena_block_size));
     }
     CHECK(!allocators_.empty());
   }
 
   int8_t* allocate(const size_t num_bytes, const size_t thread_idx = 0) override {
-    CHECK_LT(thread_idx, allocators_.size());
-    auto allocator = allocators_[thread_idx].get();
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    return reinterpret_cast<int8_t*>(allocator->allocate(num_bytes));
+    return allocateFromThreadArena(
+        thread_idx, [num_bytes](Arena& arena, std::vector<CountDistinctBitmapBuffer>&) {
+          return reinterpret_cast<int8_t*>(arena.allocate(num_bytes));
+        });
   }
 
   int8_t* allocateCountDistinctBuffer(const size_t num_bytes,
                                       const size_t thread_idx = 0) {
-    CHECK_LT(thread_idx, allocators_.size());
-    auto allocator = allocators_[thread_idx].get();
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    auto ret = reinterpret_cast<int8_t*>(allocator->allocateAndZero(num_bytes));
-    count_distinct_bitmaps_.emplace_back(
-        CountDistinctBitmapBuffer{ret, num_bytes, /*physical_buffer=*/true});
-    return ret;
+    return allocateFromThreadArena(
+        thread_idx,
+        [num_bytes](Arena& arena, std::vector<CountDistinctBitmapBuffer>& bitmaps) {
+          auto ret = reinterpret_cast<int8_t*>(arena.allocateAndZero(num_bytes));
+          bitmaps.emplace_back(
+              CountDistinctBitmapBuffer{ret, num_bytes, /*physical_buffer=*/true});
+          return ret;
+        });
   }
 
   void addCountDistinctBuffer(int8_t* count_distinct_buffer,
@@ -76,7 +80,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(std::set<int64_t>* count_distinct_set) {
+  void addCountDistinctSet(CountDistinctSet* count_distinct_set) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     count_distinct_sets_.push_back(count_distinct_set);
   }
@@ -185,6 +189,28 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     return rtn;
   }
 
+  // Owner for the allocations of one partition of a query executed in partitions, which
+  // shares the string dictionary data with this one and frees the rest when it's done.
+  std::shared_ptr<RowSetMemoryOwner> clonePartitionOwner(
+      const size_t num_kernel_threads) {
+    auto rtn = std::make_shared<RowSetMemoryOwner>(arena_block_size_, num_kernel_threads);
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    rtn->str_dict_proxy_owned_ = str_dict_proxy_owned_;
+    rtn->lit_str_dict_proxy_ = lit_str_dict_proxy_;
+    rtn->string_dictionary_generations_ = string_dictionary_generations_;
+    return rtn;
+  }
+
+  // Takes over the string dictionary proxies added by a partition owner.
+  void addStrDictData(const RowSetMemoryOwner& partition_owner) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    str_dict_proxy_owned_.insert(partition_owner.str_dict_proxy_owned_.begin(),
+                                 partition_owner.str_dict_proxy_owned_.end());
+    if (!lit_str_dict_proxy_) {
+      lit_str_dict_proxy_ = partition_owner.lit_str_dict_proxy_;
+    }
+  }
+
   void setDictionaryGenerations(StringDictionaryGenerations generations) {
     string_dictionary_generations_ = generations;
   }
@@ -203,7 +229,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   };
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<std::set<int64_t>*> count_distinct_sets_;
+  std::vector<CountDistinctSet*> count_distinct_sets_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -215,8 +241,42 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
 
+  /**
+   * Arena and count distinct bitmaps of a kernel thread, only touched by the thread
+   * holding `in_use`. Cache line aligned so the flags of neighbouring threads do not
+   * false share.
+   */
+  struct alignas(64) ThreadAllocator {
+    explicit ThreadAllocator(const size_t arena_block_size) : arena(arena_block_size) {}
+
+    Arena arena;
+    std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps;
+    std::atomic_flag in_use = ATOMIC_FLAG_INIT;
+  };
+
+  /**
+   * Runs `allocate` on the arena of `thread_idx` without taking a lock if no other thread
+   * is allocating from it, which is the case for kernels on their own thread index.
+   * Threads sharing an index, e.g. callers outside of kernels using the default index,
+   * fall back to the shared arena under the state mutex rather than waiting on the flag.
+   */
+  template <typename ALLOCATE>
+  int8_t* allocateFromThreadArena(const size_t thread_idx, ALLOCATE allocate) {
+    CHECK_LT(thread_idx, allocators_.size());
+    auto& allocator = *allocators_[thread_idx];
+    if (!allocator.in_use.test_and_set(std::memory_order_acquire)) {
+      ScopeGuard release_allocator = [&allocator] {
+        allocator.in_use.clear(std::memory_order_release);
+      };
+      return allocate(allocator.arena, allocator.count_distinct_bitmaps);
+    }
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return allocate(shared_allocator_, count_distinct_bitmaps_);
+  }
+
   size_t arena_block_size_;  // for cloning
-  std::vector<std::unique_ptr<Arena>> allocators_;
+  std::vector<std::unique_ptr<ThreadAllocator>> allocators_;
+  Arena shared_allocator_;
 
   mutable std::mutex state_mutex_;
 
@@ -44,6 +44,8 @@
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "OSDependent/omnisci_numa.h"
 #include "Parser/ParserNode.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/TypedDataAccessors.h"
@@ -97,8 +99,13 @@ bool g_enable_overlaps_hashjoin{true};
 bool g_enable_hashjoin_many_to_many{false};
 size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
 double g_overlaps_target_entries_per_bin{1.3};
+bool g_enable_radix_partitioned_hash_join_build{false};
+size_t g_hash_join_build_partition_bytes{512 * 1024};
+bool g_enable_hash_join_probe_prefetch{true};
+size_t g_hash_join_probe_prefetch_min_bytes{1024 * 1024};
 bool g_strip_join_covered_quals{false};
 size_t g_constrained_by_in_threshold{10};
+size_t g_in_values_max_bitmap_to_hash_set_ratio{4};
 size_t g_default_max_groups_buffer_entry_guess{16384};
 size_t g_big_group_threshold{g_default_max_groups_buffer_entry_guess};
 bool g_enable_window_functions{true};
@@ -112,6 +119,14 @@ double g_bump_allocator_step_reduction{0.75};
 bool g_enable_direct_columnarization{true};
 extern bool g_enable_experimental_string_functions;
 bool g_enable_lazy_fetch{true};
+bool g_enable_cpu_morsels{false};
+size_t g_cpu_morsel_min_rows{1000000};
+bool g_enable_persistent_code_cache{false};
+bool g_enable_tiered_compilation{false};
+size_t g_persistent_code_cache_max_size{1024 * 1024 * 1024};
+bool g_enable_result_set_recycler{false};
+size_t g_result_set_recycler_max_size{512 * 1024 * 1024};
+size_t g_join_hash_table_cache_max_size{size_t(4) * 1024 * 1024 * 1024};
 bool g_enable_runtime_query_interrupt{false};
 bool g_enable_non_kernel_time_query_interrupt{true};
 bool g_use_estimator_result_cache{true};
@@ -139,6 +154,7 @@ size_t g_approx_quantile_centroids{300};
 bool g_enable_automatic_ir_metadata{true};
 
 extern bool g_cache_string_hash;
+extern bool g_enable_numa_affinity;
 
 int const Executor::max_gpu_count;
 
@@ -1528,16 +1544,16 @@ ResultSetPtr Executor::executeWorkUnitImpl(
         if (g_use_tbb_pool) {
 #ifdef HAVE_TBB
           VLOG(1) << "Using TBB thread pool for kernel dispatch.";
-          launchKernels<threadpool::TbbThreadPool<void>>(shared_context,
-                                                         std::move(kernels));
+          launchKernels<threadpool::TbbThreadPool<void>>(
+              shared_context, std::move(kernels), device_type);
 #else
           throw std::runtime_error(
               "This build is not TBB enabled. Restart the server with "
               "\"enable-modern-thread-pool\" disabled.");
 #endif
         } else {
-          launchKernels<threadpool::FuturesThreadPool<void>>(shared_context,
-                                                             std::move(kernels));
+          launchKernels<threadpool::FuturesThreadPool<void>>(
+              shared_context, std::move(kernels), device_type);
         }
       } catch (QueryExecutionError& e) {
         if (eo.with_dynamic_watchdog && interrupted_.load() &&
@@ -1879,8 +1895,8 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_buffer));
         continue;
       }
-      if (count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet) {
-        auto count_distinct_set = new std::set<int64_t>();
+      if (count_distinct_desc.impl_type_ == CountDistinctImplType::CompactSet) {
+        auto count_distinct_set = new CountDistinctSet();
         CHECK(row_set_mem_owner);
         row_set_mem_owner->addCountDistinctSet(count_distinct_set);
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
@@ -2143,6 +2159,58 @@ bool has_lazy_fetched_columns(const std::vector<ColumnLazyFetchInfo>& fetched_co
 
 }  // namespace
 
+namespace {
+
+// Morsel counts are chosen so every CPU thread gets several morsels to balance skew.
+constexpr size_t kMorselsPerThread{4};
+// Each morsel owns a private output buffer, reduced with all others at the end of the
+// step. Above this size the extra buffers and reduction work outweigh the balancing.
+constexpr size_t kMaxMorselOutputBufferBytes{size_t(16) << 20};
+
+bool can_split_kernels_into_morsels(const RelAlgExecutionUnit& ra_exe_unit,
+                                    const QueryMemoryDescriptor& query_mem_desc,
+                                    const ExecutionOptions& eo,
+                                    const ExecutorDeviceType device_type,
+                                    const std::vector<InputTableInfo>& table_infos) {
+  if (!g_enable_cpu_morsels || device_type != ExecutorDeviceType::CPU ||
+      eo.executor_type != ExecutorType::Native || ra_exe_unit.union_all ||
+      ra_exe_unit.estimator || table_infos.empty() ||
+      table_infos.front().table_id < 0) {
+    return false;
+  }
+  // Projections size their output by the fragment, splitting them only multiplies memory.
+  switch (query_mem_desc.getQueryDescriptionType()) {
+    case QueryDescriptionType::NonGroupedAggregate:
+    case QueryDescriptionType::GroupByPerfectHash:
+    case QueryDescriptionType::GroupByBaselineHash:
+      break;
+    default:
+      return false;
+  }
+  return !query_mem_desc.useStreamingTopN() &&
+         query_mem_desc.countDistinctDescriptorsLogicallyEmpty() &&
+         query_mem_desc.getBufferSizeBytes(device_type) <= kMaxMorselOutputBufferBytes;
+}
+
+// Returns the number of rows per morsel, or zero if the outer table has enough fragments
+// to keep all threads busy on its own.
+size_t get_morsel_row_count(const std::vector<InputTableInfo>& table_infos,
+                            const size_t thread_count) {
+  const auto& fragments = table_infos.front().info.fragments;
+  const size_t target_morsel_count = thread_count * kMorselsPerThread;
+  if (fragments.size() >= target_morsel_count) {
+    return 0;
+  }
+  size_t total_row_count{0};
+  for (const auto& fragment : fragments) {
+    total_row_count += fragment.getNumTuples();
+  }
+  return std::max(g_cpu_morsel_min_rows,
+                  (total_row_count + target_morsel_count - 1) / target_morsel_count);
+}
+
+}  // namespace
+
 std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
     SharedKernelContext& shared_context,
     const RelAlgExecutionUnit& ra_exe_unit,
@@ -2238,6 +2306,12 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
       }
     }
 
+    const size_t morsel_row_count =
+        can_split_kernels_into_morsels(
+            ra_exe_unit, query_mem_desc, eo, device_type, table_infos)
+            ? get_morsel_row_count(table_infos, cpu_threads())
+            : 0;
+
     size_t frag_list_idx{0};
     auto fragment_per_kernel_dispatch = [&ra_exe_unit,
                                          &execution_kernels,
@@ -2247,6 +2321,8 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
                                          &device_type,
                                          &query_comp_desc,
                                          &query_mem_desc,
+                                         &table_infos,
+                                         morsel_row_count,
                                          render_info](const int device_id,
                                                       const FragmentsList& frag_list,
                                                       const int64_t rowid_lookup_key) {
@@ -2255,6 +2331,37 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
       }
       CHECK_GE(device_id, 0);
 
+      if (morsel_row_count && rowid_lookup_key < 0 &&
+          frag_list.front().fragment_ids.size() == 1) {
+        const auto outer_frag_idx = frag_list.front().fragment_ids.front();
+        const auto& outer_fragments = table_infos.front().info.fragments;
+        CHECK_LT(outer_frag_idx, outer_fragments.size());
+        const size_t frag_row_count = outer_fragments[outer_frag_idx].getNumTuples();
+        const size_t morsel_count =
+            (frag_row_count + morsel_row_count - 1) / morsel_row_count;
+        if (morsel_count > 1) {
+          // spread the rows evenly instead of leaving a small trailing morsel
+          const size_t step = (frag_row_count + morsel_count - 1) / morsel_count;
+          for (size_t start = 0; start < frag_row_count; start += step) {
+            execution_kernels.emplace_back(std::make_unique<ExecutionKernel>(
+                ra_exe_unit,
+                device_type,
+                device_id,
+                eo,
+                column_fetcher,
+                query_comp_desc,
+                query_mem_desc,
+                frag_list,
+                ExecutorDispatchMode::KernelPerFragment,
+                render_info,
+                rowid_lookup_key,
+                FragmentRowRange{start, std::min(frag_row_count, start + step)}));
+          }
+          ++frag_list_idx;
+          return;
+        }
+      }
+
       execution_kernels.emplace_back(
           std::make_unique<ExecutionKernel>(ra_exe_unit,
                                             device_type,
@@ -2277,29 +2384,135 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+namespace {
+
+// NUMA node holding the chunks of the outer fragment of a kernel, -1 for any node.
+int get_kernel_numa_node(const ExecutionKernel& kernel,
+                         const std::vector<InputTableInfo>& query_infos) {
+  const auto& frag_list = kernel.getFragments();
+  if (frag_list.empty() || frag_list.front().fragment_ids.empty()) {
+    return -1;
+  }
+  const auto& outer_frags = frag_list.front();
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id == outer_frags.table_id) {
+      const auto& fragments = query_info.info.fragments;
+      const auto frag_idx = outer_frags.fragment_ids.front();
+      return frag_idx < fragments.size()
+                 ? Buffer_Namespace::CpuBufferMgr::getNumaNodeForFragment(
+                       fragments[frag_idx].fragmentId)
+                 : -1;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
 template <typename THREAD_POOL>
 void Executor::launchKernels(SharedKernelContext& shared_context,
-                             std::vector<std::unique_ptr<ExecutionKernel>>&& kernels) {
+                             std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                             const ExecutorDeviceType device_type) {
   auto clock_begin = timer_start();
   std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
   kernel_queue_time_ms_ += timer_stop(clock_begin);
 
   THREAD_POOL thread_pool;
   VLOG(1) << "Launching " << kernels.size() << " kernels for query.";
-  size_t kernel_idx = 1;
-  for (auto& kernel : kernels) {
+  if (device_type == ExecutorDeviceType::GPU) {
+    size_t kernel_idx = 1;
+    for (auto& kernel : kernels) {
+      thread_pool.spawn(
+          [this, &shared_context, parent_thread_id = logger::thread_id()](
+              ExecutionKernel* kernel, const size_t crt_kernel_idx) {
+            CHECK(kernel);
+            DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+            const size_t thread_idx = crt_kernel_idx % cpu_threads();
+            kernel->run(this, thread_idx, shared_context);
+          },
+          kernel.get(),
+          kernel_idx++);
+    }
+    thread_pool.join();
+    return;
+  }
+
+  // CPU kernels are claimed dynamically by one worker per CPU thread. Workers which
+  // finish cheap kernels (or morsels of a fragment) keep pulling work until the queue is
+  // drained, so skewed fragments no longer leave cores idle near the end of a query.
+  // On NUMA machines there is a queue per node, holding the kernels whose outer fragment
+  // the CPU buffer pool keeps on the node. Workers are bound to a node, drain its queue
+  // first and then help out with the queues of the other nodes.
+  const size_t num_workers =
+      std::min(kernels.size(), static_cast<size_t>(std::max(cpu_threads(), 1)));
+  const size_t num_numa_nodes =
+      g_enable_numa_affinity ? omnisci::get_numa_node_count() : size_t(1);
+  std::vector<std::vector<size_t>> numa_node_kernel_ids(num_numa_nodes);
+  for (size_t kernel_idx = 0; kernel_idx < kernels.size(); ++kernel_idx) {
+    const int numa_node =
+        num_numa_nodes > 1
+            ? get_kernel_numa_node(*kernels[kernel_idx], shared_context.getQueryInfos())
+            : -1;
+    numa_node_kernel_ids[numa_node >= 0 ? numa_node : kernel_idx % num_numa_nodes]
+        .push_back(kernel_idx);
+  }
+  std::vector<std::atomic<size_t>> next_kernel_idx(num_numa_nodes);
+  std::atomic<bool> kernel_failed{false};
+  std::vector<std::chrono::steady_clock::time_point> worker_finish_times(num_workers);
+  for (size_t worker_idx = 0; worker_idx < num_workers; ++worker_idx) {
     thread_pool.spawn(
-        [this, &shared_context, parent_thread_id = logger::thread_id()](
-            ExecutionKernel* kernel, const size_t crt_kernel_idx) {
-          CHECK(kernel);
+        [this,
+         &shared_context,
+         &kernels,
+         &numa_node_kernel_ids,
+         &next_kernel_idx,
+         &kernel_failed,
+         &worker_finish_times,
+         parent_thread_id = logger::thread_id()](const size_t thread_idx) {
           DEBUG_TIMER_NEW_THREAD(parent_thread_id);
-          const size_t thread_idx = crt_kernel_idx % cpu_threads();
-          kernel->run(this, thread_idx, shared_context);
+          ScopeGuard record_finish_time = [&worker_finish_times, thread_idx] {
+            worker_finish_times[thread_idx] = std::chrono::steady_clock::now();
+          };
+          const size_t num_numa_nodes = numa_node_kernel_ids.size();
+          const size_t home_numa_node = thread_idx % num_numa_nodes;
+          std::optional<omnisci::NumaNodeThreadBinding> numa_node_binding;
+          if (num_numa_nodes > 1) {
+            numa_node_binding.emplace(home_numa_node);
+          }
+          for (size_t i = 0; i < num_numa_nodes; ++i) {
+            const size_t numa_node = (home_numa_node + i) % num_numa_nodes;
+            const auto& kernel_ids = numa_node_kernel_ids[numa_node];
+            while (!kernel_failed.load()) {
+              const size_t kernel_id_idx = next_kernel_idx[numa_node].fetch_add(1);
+              if (kernel_id_idx >= kernel_ids.size()) {
+                break;
+              }
+              auto& kernel = kernels[kernel_ids[kernel_id_idx]];
+              CHECK(kernel);
+              try {
+                kernel->run(this, thread_idx, shared_context);
+              } catch (...) {
+                // stop the remaining workers early, the query fails anyway
+                kernel_failed = true;
+                throw;
+              }
+            }
+          }
         },
-        kernel.get(),
-        kernel_idx++);
+        worker_idx);
   }
   thread_pool.join();
+
+  const auto launch_finish_time = std::chrono::steady_clock::now();
+  int64_t tail_idle_time_ms{0};
+  for (const auto& worker_finish_time : worker_finish_times) {
+    tail_idle_time_ms += std::chrono::duration_cast<std::chrono::milliseconds>(
+                             launch_finish_time - worker_finish_time)
+                             .count();
+  }
+  kernel_tail_idle_time_ms_ += tail_idle_time_ms;
+  VLOG(1) << "Kernel workers were idle for " << tail_idle_time_ms
+          << " ms while waiting for the last kernel of the query to finish.";
 }
 
 std::vector<size_t> Executor::getTableFragmentIndices(
@@ -2949,6 +3162,7 @@ int32_t Executor::executePlanWithoutGroupBy(
     Data_Namespace::DataMgr* data_mgr,
     const int device_id,
     const uint32_t start_rowid,
+    const bool is_rowid_lookup,
     const uint32_t num_tables,
     const bool allow_runtime_interrupt,
     RenderInfo* render_info) {
@@ -3001,6 +3215,7 @@ int32_t Executor::executePlanWithoutGroupBy(
                                                frag_offsets,
                                                0,
                                                &error_code,
+                                               is_rowid_lookup,
                                                num_tables,
                                                join_hash_table_ptrs);
     output_memory_scope.reset(new OutVecOwner(out_vec));
@@ -3164,6 +3379,7 @@ int32_t Executor::executePlanWithGroupBy(
     const int outer_table_id,
     const int64_t scan_limit,
     const uint32_t start_rowid,
+    const bool is_rowid_lookup,
     const uint32_t num_tables,
     const bool allow_runtime_interrupt,
     RenderInfo* render_info) {
@@ -3254,6 +3470,7 @@ int32_t Executor::executePlanWithGroupBy(
         frag_offsets,
         ra_exe_unit_copy.union_all ? ra_exe_unit_copy.scan_limit : scan_limit,
         &error_code,
+        is_rowid_lookup,
         num_tables,
         join_hash_table_ptrs);
   } else {
@@ -3648,6 +3865,7 @@ std::pair<bool, int64_t> Executor::skipFragment(
     const InputDescriptor& table_desc,
     const Fragmenter_Namespace::FragmentInfo& fragment,
     const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
     const std::vector<uint64_t>& frag_offsets,
     const size_t frag_idx) {
   const int table_id = table_desc.getTableId();
@@ -3688,6 +3906,21 @@ std::pair<bool, int64_t> Executor::skipFragment(
       // is this possible?
       return {false, -1};
     }
+    if (lhs == lhs_col && lhs_col->get_type_info().is_dict_encoded_string() &&
+        comp_expr->get_optype() == kEQ) {
+      const auto chunk_meta_it =
+          fragment.getChunkMetadataMap().find(lhs_col->get_column_id());
+      if (chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+          chunk_meta_it->second->bloomFilter) {
+        const auto string_id =
+            getStringIdForBloomFilter(lhs_col->get_type_info(), rhs_const);
+        if (string_id && (*string_id == StringDictionary::INVALID_STR_ID ||
+                          !chunk_meta_it->second->bloomFilter->mayContain(*string_id))) {
+          return {true, -1};
+        }
+      }
+      continue;
+    }
     if (!lhs->get_type_info().is_integer() && !lhs->get_type_info().is_time()) {
       continue;
     }
@@ -3777,15 +4010,201 @@ std::pair<bool, int64_t> Executor::skipFragment(
           return {true, -1};
         } else if (is_rowid) {
           return {false, rhs_val - start_rowid};
+        } else if (lhs == lhs_col &&
+                   chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+                   lhs_col->get_type_info().get_dimension() ==
+                       rhs_const->get_type_info().get_dimension() &&
+                   chunk_meta_it->second->bloomFilter &&
+                   !chunk_meta_it->second->bloomFilter->mayContain(rhs_val)) {
+          return {true, -1};
         }
         break;
       default:
         break;
     }
   }
+  for (const auto& qual : quals) {
+    if (skipFragmentInValues(fragment, qual.get())) {
+      return {true, -1};
+    }
+  }
   return {false, -1};
 }
 
+bool Executor::skipFragmentInValues(const Fragmenter_Namespace::FragmentInfo& fragment,
+                                    const Analyzer::Expr* qual) {
+  const auto in_values = dynamic_cast<const Analyzer::InValues*>(qual);
+  if (!in_values) {
+    return false;
+  }
+  const auto arg_col = dynamic_cast<const Analyzer::ColumnVar*>(in_values->get_arg());
+  if (!arg_col || arg_col->get_table_id() <= 0 || arg_col->get_rte_idx()) {
+    return false;
+  }
+  const auto& arg_ti = arg_col->get_type_info();
+  if (!arg_ti.is_integer() && !arg_ti.is_time() && !arg_ti.is_dict_encoded_string()) {
+    return false;
+  }
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(arg_col->get_column_id());
+  if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+    return false;
+  }
+  const auto& chunk_metadata = chunk_meta_it->second;
+  if (arg_ti.is_dict_encoded_string()) {
+    if (!chunk_metadata->bloomFilter) {
+      return false;
+    }
+    for (const auto& value : in_values->get_value_list()) {
+      const auto value_const = dynamic_cast<const Analyzer::Constant*>(value.get());
+      if (!value_const) {
+        return false;
+      }
+      if (value_const->get_is_null()) {
+        continue;
+      }
+      const auto string_id = getStringIdForBloomFilter(arg_ti, value_const);
+      if (!string_id) {
+        return false;
+      }
+      if (*string_id != StringDictionary::INVALID_STR_ID &&
+          chunk_metadata->bloomFilter->mayContain(*string_id)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  const int64_t chunk_min = extract_min_stat(chunk_metadata->chunkStats, arg_ti);
+  const int64_t chunk_max = extract_max_stat(chunk_metadata->chunkStats, arg_ti);
+  if (chunk_min > chunk_max) {
+    return false;
+  }
+  llvm::LLVMContext local_context;
+  CgenState local_cgen_state(local_context);
+  for (const auto& value : in_values->get_value_list()) {
+    const auto value_const = dynamic_cast<const Analyzer::Constant*>(value.get());
+    if (!value_const) {
+      return false;
+    }
+    if (value_const->get_is_null()) {
+      // never matches
+      continue;
+    }
+    const auto& value_ti = value_const->get_type_info();
+    if (!(value_ti.is_integer() && arg_ti.is_integer()) &&
+        (value_ti.get_type() != arg_ti.get_type() ||
+         value_ti.get_dimension() != arg_ti.get_dimension())) {
+      return false;
+    }
+    const auto val =
+        CodeGenerator::codegenIntConst(value_const, &local_cgen_state)->getSExtValue();
+    if (val < chunk_min || val > chunk_max) {
+      continue;
+    }
+    if (!chunk_metadata->bloomFilter || chunk_metadata->bloomFilter->mayContain(val)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<int32_t> Executor::getStringIdForBloomFilter(
+    const SQLTypeInfo& col_ti,
+    const Analyzer::Constant* constant) const {
+  CHECK(col_ti.is_dict_encoded_string());
+  if (!constant->get_type_info().is_string() || constant->get_is_null() ||
+      !constant->get_constval().stringval) {
+    return std::nullopt;
+  }
+  CHECK(catalog_);
+  const auto dd = catalog_->getMetadataForDict(col_ti.get_comp_param());
+  if (!dd || !dd->stringDict) {
+    return std::nullopt;
+  }
+  return dd->stringDict->getIdOfString(*constant->get_constval().stringval);
+}
+
+std::vector<Executor::JoinKeyBloomFilter> Executor::buildJoinKeyBloomFilters(
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  std::vector<JoinKeyBloomFilter> join_key_filters;
+  for (const auto& inner_join : ra_exe_unit.join_quals) {
+    if (inner_join.type != JoinType::INNER) {
+      continue;
+    }
+    for (const auto& qual : inner_join.quals) {
+      for (const auto& conjunct : qual_to_conjunctive_form(qual).quals) {
+        auto join_key_filter = buildJoinKeyBloomFilter(conjunct.get());
+        if (join_key_filter) {
+          join_key_filters.push_back(std::move(*join_key_filter));
+        }
+      }
+    }
+  }
+  return join_key_filters;
+}
+
+std::optional<Executor::JoinKeyBloomFilter> Executor::buildJoinKeyBloomFilter(
+    const Analyzer::Expr* qual) {
+  const auto comp_expr = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!comp_expr || comp_expr->get_optype() != kEQ) {
+    return std::nullopt;
+  }
+  auto outer_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(comp_expr->get_left_operand());
+  auto inner_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(comp_expr->get_right_operand());
+  if (!outer_col || !inner_col) {
+    return std::nullopt;
+  }
+  if (outer_col->get_rte_idx()) {
+    std::swap(outer_col, inner_col);
+  }
+  if (outer_col->get_rte_idx() || !inner_col->get_rte_idx() ||
+      outer_col->get_table_id() <= 0 || inner_col->get_table_id() <= 0) {
+    return std::nullopt;
+  }
+  const auto& outer_ti = outer_col->get_type_info();
+  const auto& inner_ti = inner_col->get_type_info();
+  // the filters hold the values as stored, hence the join keys need the same
+  // representation on both sides, which dictionary encoded strings only have when they
+  // share their dictionary
+  const bool same_ints = outer_ti.is_integer() && inner_ti.is_integer();
+  const bool same_times = outer_ti.is_time() &&
+                          outer_ti.get_type() == inner_ti.get_type() &&
+                          outer_ti.get_dimension() == inner_ti.get_dimension();
+  const bool same_dicts = outer_ti.is_dict_encoded_string() &&
+                          inner_ti.is_dict_encoded_string() &&
+                          outer_ti.get_comp_param() == inner_ti.get_comp_param();
+  if (!same_ints && !same_times && !same_dicts) {
+    return std::nullopt;
+  }
+  JoinKeyBloomFilter join_key_filter{outer_col->get_column_id(), {}};
+  const auto inner_table_info = getTableInfo(inner_col->get_table_id());
+  for (const auto& inner_fragment : inner_table_info.fragments) {
+    const auto& inner_metadata_map = inner_fragment.getChunkMetadataMap();
+    auto inner_meta_it = inner_metadata_map.find(inner_col->get_column_id());
+    if (inner_meta_it == inner_metadata_map.end() ||
+        !inner_meta_it->second->bloomFilter) {
+      return std::nullopt;
+    }
+    join_key_filter.inner_filter.merge(*inner_meta_it->second->bloomFilter);
+    if (join_key_filter.inner_filter.isSaturated()) {
+      return std::nullopt;
+    }
+  }
+  return join_key_filter;
+}
+
+bool Executor::skipFragmentJoinKeys(const Fragmenter_Namespace::FragmentInfo& fragment,
+                                    const JoinKeyBloomFilter& join_key_filter) const {
+  const auto& metadata_map = fragment.getChunkMetadataMap();
+  auto outer_meta_it = metadata_map.find(join_key_filter.outer_column_id);
+  if (outer_meta_it == metadata_map.end() || !outer_meta_it->second->bloomFilter ||
+      outer_meta_it->second->bloomFilter->isSaturated()) {
+    return false;
+  }
+  return !outer_meta_it->second->bloomFilter->mayIntersect(join_key_filter.inner_filter);
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
@@ -3815,7 +4234,8 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     const RelAlgExecutionUnit& ra_exe_unit,
     const Fragmenter_Namespace::FragmentInfo& fragment,
     const std::vector<uint64_t>& frag_offsets,
-    const size_t frag_idx) {
+    const size_t frag_idx,
+    const std::vector<JoinKeyBloomFilter>& join_key_filters) {
   std::pair<bool, int64_t> skip_frag{false, -1};
   for (auto& inner_join : ra_exe_unit.join_quals) {
     if (inner_join.type != JoinType::INNER) {
@@ -3825,14 +4245,21 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     // extracting all the conjunctive simple_quals from the quals stored for the inner
     // join
     std::list<std::shared_ptr<Analyzer::Expr>> inner_join_simple_quals;
+    std::list<std::shared_ptr<Analyzer::Expr>> inner_join_quals;
     for (auto& qual : inner_join.quals) {
       auto temp_qual = qual_to_conjunctive_form(qual);
       inner_join_simple_quals.insert(inner_join_simple_quals.begin(),
                                      temp_qual.simple_quals.begin(),
                                      temp_qual.simple_quals.end());
+      inner_join_quals.insert(
+          inner_join_quals.end(), temp_qual.quals.begin(), temp_qual.quals.end());
     }
-    auto temp_skip_frag = skipFragment(
-        table_desc, fragment, inner_join_simple_quals, frag_offsets, frag_idx);
+    auto temp_skip_frag = skipFragment(table_desc,
+                                       fragment,
+                                       inner_join_simple_quals,
+                                       inner_join_quals,
+                                       frag_offsets,
+                                       frag_idx);
     if (temp_skip_frag.second != -1) {
       skip_frag.second = temp_skip_frag.second;
       return skip_frag;
@@ -3840,6 +4267,13 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
       skip_frag.first = skip_frag.first || temp_skip_frag.first;
     }
   }
+  // the join keys of the outer fragment can't match any row of the inner table
+  for (const auto& join_key_filter : join_key_filters) {
+    if (skip_frag.first) {
+      break;
+    }
+    skip_frag.first = skipFragmentJoinKeys(fragment, join_key_filter);
+  }
   return skip_frag;
 }
 
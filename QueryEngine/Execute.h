@@ -27,6 +27,7 @@
 #include <limits>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
@@ -389,6 +390,10 @@ class Executor {
 
   static size_t getArenaBlockSize();
 
+  // Waits until the optimized code of the queries which ran on baseline code is ready,
+  // returns the number of queries compiled in the background so far.
+  static size_t waitForTieredCompilation();
+
   /**
    * Returns pointer to the intermediate tables vector currently stored by this executor.
    */
@@ -426,6 +431,9 @@ class Executor {
 
   const std::shared_ptr<RowSetMemoryOwner> getRowSetMemoryOwner() const;
 
+  // Total time CPU kernel workers spent idle waiting for the slowest kernel of a step.
+  int64_t getKernelTailIdleTimeMs() const { return kernel_tail_idle_time_ms_; }
+
   const TemporaryTables* getTemporaryTables() const;
 
   Fragmenter_Namespace::TableInfo getTableInfo(const int table_id) const;
@@ -608,7 +616,8 @@ class Executor {
    */
   template <typename THREAD_POOL>
   void launchKernels(SharedKernelContext& shared_context,
-                     std::vector<std::unique_ptr<ExecutionKernel>>&& kernels);
+                     std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                     const ExecutorDeviceType device_type);
 
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -693,6 +702,7 @@ class Executor {
                                  const int outer_table_id,
                                  const int64_t limit,
                                  const uint32_t start_rowid,
+                                 const bool is_rowid_lookup,
                                  const uint32_t num_tables,
                                  const bool allow_runtime_interrupt,
                                  RenderInfo* render_info);
@@ -710,6 +720,7 @@ class Executor {
       Data_Namespace::DataMgr* data_mgr,
       const int device_id,
       const uint32_t start_rowid,
+      const bool is_rowid_lookup,
       const uint32_t num_tables,
       const bool allow_runtime_interrupt,
       RenderInfo* render_info);
@@ -905,15 +916,43 @@ class Executor {
       const InputDescriptor& table_desc,
       const Fragmenter_Namespace::FragmentInfo& frag_info,
       const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // IN lists on columns with chunk bloom filters, see ChunkBloomFilter
+  bool skipFragmentInValues(const Fragmenter_Namespace::FragmentInfo& fragment,
+                            const Analyzer::Expr* qual);
+
+  // dictionary id of a string constant compared to a dictionary encoded column, for
+  // the chunk bloom filters; INVALID_STR_ID if the dictionary doesn't have the string
+  std::optional<int32_t> getStringIdForBloomFilter(
+      const SQLTypeInfo& col_ti,
+      const Analyzer::Constant* constant) const;
+
+  // union of the bloom filters of all inner fragments for an equi-join key
+  struct JoinKeyBloomFilter {
+    int outer_column_id;
+    ChunkBloomFilter inner_filter;
+  };
+
+  // built once per query, before the outer fragments are considered for skipping
+  std::vector<JoinKeyBloomFilter> buildJoinKeyBloomFilters(
+      const RelAlgExecutionUnit& ra_exe_unit);
+
+  std::optional<JoinKeyBloomFilter> buildJoinKeyBloomFilter(const Analyzer::Expr* qual);
+
+  // equi-join keys whose bloom filters don't intersect with any inner fragment
+  bool skipFragmentJoinKeys(const Fragmenter_Namespace::FragmentInfo& fragment,
+                            const JoinKeyBloomFilter& join_key_filter) const;
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
       const Fragmenter_Namespace::FragmentInfo& fragment,
       const std::vector<uint64_t>& frag_offsets,
-      const size_t frag_idx);
+      const size_t frag_idx,
+      const std::vector<JoinKeyBloomFilter>& join_key_filters);
 
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
@@ -1028,6 +1067,8 @@ class Executor {
 
   std::unique_ptr<PlanState> plan_state_;
   std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner_;
+  // set while a pass of a partitioned hash join runs
+  std::optional<HashJoinPartition> hash_join_partition_;
 
   static const int max_gpu_count{16};
   std::mutex gpu_exec_mutex_[max_gpu_count];
@@ -1060,6 +1101,7 @@ class Executor {
 
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
+  std::atomic<int64_t> kernel_tail_idle_time_ms_{0};
 
   // Singleton instance used for an execution unit which is a project with window
   // functions.
@@ -184,6 +184,15 @@ void ExecutionKernel::runImpl(Executor* executor,
     if (fetch_result.num_rows.empty()) {
       return;
     }
+    if (row_range_) {
+      // the outer table always comes first in the per fragment row counts
+      CHECK(chosen_device_type == ExecutorDeviceType::CPU);
+      for (auto& frag_num_rows : fetch_result.num_rows) {
+        CHECK(!frag_num_rows.empty());
+        frag_num_rows[0] =
+            std::min(frag_num_rows[0], static_cast<int64_t>(row_range_->end));
+      }
+    }
     if (eo.with_dynamic_watchdog &&
         !shared_context.dynamic_watchdog_set.test_and_set(std::memory_order_acquire)) {
       CHECK_GT(eo.dynamic_watchdog_time_limit, 0u);
@@ -278,12 +287,15 @@ void ExecutionKernel::runImpl(Executor* executor,
   CHECK(query_exe_context);
   int32_t err{0};
   uint32_t start_rowid{0};
-  if (rowid_lookup_key >= 0) {
+  const bool is_rowid_lookup = rowid_lookup_key >= 0;
+  if (is_rowid_lookup) {
     if (!frag_list.empty()) {
       const auto& all_frag_row_offsets = shared_context.getFragOffsets();
       start_rowid = rowid_lookup_key -
                     all_frag_row_offsets[frag_list.begin()->fragment_ids.front()];
     }
+  } else if (row_range_) {
+    start_rowid = row_range_->start;
   }
 
   if (ra_exe_unit_.groupby_exprs.empty()) {
@@ -300,6 +312,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                                               &catalog->getDataMgr(),
                                               chosen_device_id,
                                               start_rowid,
+                                              is_rowid_lookup,
                                               ra_exe_unit_.input_descs.size(),
                                               eo.allow_runtime_query_interrupt,
                                               do_render ? render_info_ : nullptr);
@@ -323,6 +336,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            outer_table_id,
                                            ra_exe_unit_.scan_limit,
                                            start_rowid,
+                                           is_rowid_lookup,
                                            ra_exe_unit_.input_descs.size(),
                                            eo.allow_runtime_query_interrupt,
                                            do_render ? render_info_ : nullptr);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
@@ -46,6 +48,16 @@ class SharedKernelContext {
   const RegisteredQueryHint query_hint_;
 };
 
+/**
+ * Half-open range of rows within the outer fragment of a CPU kernel. Large fragments are
+ * split into several such morsels, which lets threads that finish early pick up the
+ * remainder of a skewed scan instead of idling until the slowest fragment completes.
+ */
+struct FragmentRowRange {
+  size_t start;
+  size_t end;
+};
+
 class ExecutionKernel {
  public:
   ExecutionKernel(const RelAlgExecutionUnit& ra_exe_unit,
@@ -58,7 +70,8 @@ class ExecutionKernel {
                   const FragmentsList& frag_list,
                   const ExecutorDispatchMode kernel_dispatch_mode,
                   RenderInfo* render_info,
-                  const int64_t rowid_lookup_key)
+                  const int64_t rowid_lookup_key,
+                  const std::optional<FragmentRowRange>& row_range = std::nullopt)
       : ra_exe_unit_(ra_exe_unit)
       , chosen_device_type(chosen_device_type)
       , chosen_device_id(chosen_device_id)
@@ -69,12 +82,15 @@ class ExecutionKernel {
       , frag_list(frag_list)
       , kernel_dispatch_mode(kernel_dispatch_mode)
       , render_info_(render_info)
-      , rowid_lookup_key(rowid_lookup_key) {}
+      , rowid_lookup_key(rowid_lookup_key)
+      , row_range_(row_range) {}
 
   void run(Executor* executor,
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  const FragmentsList& getFragments() const { return frag_list; }
+
  private:
   const RelAlgExecutionUnit& ra_exe_unit_;
   const ExecutorDeviceType chosen_device_type;
@@ -87,6 +103,7 @@ class ExecutionKernel {
   const ExecutorDispatchMode kernel_dispatch_mode;
   RenderInfo* render_info_;
   const int64_t rowid_lookup_key;
+  const std::optional<FragmentRowRange> row_range_;
 
   ResultSetPtr device_results_;
 
@@ -28,15 +28,18 @@
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JoinHashTable/PerfectJoinHashTable.h"
+#include "ResultSetRecycler.h"
 
-using UpdateTriggeredCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using UpdateTriggeredCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                         BaselineJoinHashTable,
+                                                         PerfectJoinHashTable,
+                                                         ResultSetRecycler>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
-// Note that this is functionally the same as the above two invalidators. The
-// JoinHashTableCacheInvalidator is a generic invalidator used during `clear_cpu` calls.
-// The above cache invalidators are specific invalidators called during update/delete and
-// will likely be extended in the future.
+// Note that this is functionally the same as the above two invalidators, minus the
+// recycled query results. The JoinHashTableCacheInvalidator is a generic invalidator used
+// during `clear_cpu` calls. The above cache invalidators are specific invalidators called
+// during update/delete and will likely be extended in the future.
 using JoinHashTableCacheInvalidator =
     CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
 
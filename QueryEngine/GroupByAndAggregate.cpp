@@ -19,6 +19,7 @@
 
 #include "CardinalityEstimator.h"
 #include "CodeGenerator.h"
+#include "CountDistinctSet.h"
 #include "Descriptors/QueryMemoryDescriptor.h"
 #include "ExpressionRange.h"
 #include "ExpressionRewrite.h"
@@ -593,7 +594,7 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           arg_ti.is_fp() ? no_range_info
                          : get_expr_range_info(
                                ra_exe_unit, query_infos, agg_expr->get_arg(), executor);
-      CountDistinctImplType count_distinct_impl_type{CountDistinctImplType::StdSet};
+      CountDistinctImplType count_distinct_impl_type{CountDistinctImplType::CompactSet};
       int64_t bitmap_sz_bits{0};
       if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
         const auto error_rate = agg_expr->get_error_rate();
@@ -623,18 +624,18 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           bitmap_sz_bits = arg_range_info.max - arg_range_info.min + 1;
           const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
           if (bitmap_sz_bits <= 0 || bitmap_sz_bits > MAX_BITMAP_BITS) {
-            count_distinct_impl_type = CountDistinctImplType::StdSet;
+            count_distinct_impl_type = CountDistinctImplType::CompactSet;
           }
         }
       }
       if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT &&
-          count_distinct_impl_type == CountDistinctImplType::StdSet &&
+          count_distinct_impl_type == CountDistinctImplType::CompactSet &&
           !(arg_ti.is_array() || arg_ti.is_geometry())) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
 
       if (g_enable_watchdog && !(arg_range_info.isEmpty()) &&
-          count_distinct_impl_type == CountDistinctImplType::StdSet) {
+          count_distinct_impl_type == CountDistinctImplType::CompactSet) {
         throw WatchdogException("Cannot use a fast path for COUNT distinct");
       }
       const auto sub_bitmap_count =
@@ -1585,7 +1586,7 @@ void GroupByAndAggregate::codegenEstimator(std::stack<llvm::BasicBlock*>& array_
 }
 
 extern "C" RUNTIME_EXPORT void agg_count_distinct(int64_t* agg, const int64_t val) {
-  reinterpret_cast<std::set<int64_t>*>(*agg)->insert(val);
+  reinterpret_cast<CountDistinctSet*>(*agg)->insert(val);
 }
 
 extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
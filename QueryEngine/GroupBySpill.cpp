@@ -0,0 +1,256 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/GroupBySpill.h"
+
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+#include "QueryEngine/ResultSetStorage.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <atomic>
+
+bool g_enable_group_by_spill{false};
+// groups buffer entries per partition
+size_t g_group_by_spill_partition_size{1UL << 26};
+
+namespace {
+
+// every partition is a pass over the input
+constexpr size_t kMaxPartitionCount{1024};
+
+std::atomic<size_t> executed_partition_count{0};
+
+std::shared_ptr<Analyzer::Expr> make_bigint_constant(const int64_t val) {
+  Datum d;
+  d.bigintval = val;
+  return makeExpr<Analyzer::Constant>(kBIGINT, false, d);
+}
+
+std::shared_ptr<Analyzer::Expr> make_bigint_modulo(
+    const std::shared_ptr<Analyzer::Expr>& lhs,
+    const int64_t divisor,
+    const bool notnull) {
+  return makeExpr<Analyzer::BinOper>(SQLTypeInfo(kBIGINT, notnull),
+                                     false,
+                                     kMODULO,
+                                     kONE,
+                                     lhs,
+                                     make_bigint_constant(divisor));
+}
+
+// Two rounds of multiplicative hashing modulo the Mersenne prime 2^31 - 1, on the
+// arithmetic of the executor: the products stay below 2^63 and never trip its overflow
+// checks. Unlike the remainder of the key itself, keys strided by a power of two (or any
+// stride but a multiple of the prime) spread over all the partitions.
+std::shared_ptr<Analyzer::Expr> make_partition_hash(
+    const std::shared_ptr<Analyzer::Expr>& partition_key) {
+  constexpr int64_t kPrime{2147483647};
+  constexpr int64_t kMultiplier{2654435761};
+  const bool notnull = partition_key->get_type_info().get_notnull();
+  auto hash = make_bigint_modulo(
+      partition_key->add_cast(SQLTypeInfo(kBIGINT, notnull)), kPrime, notnull);
+  for (int round = 0; round < 2; ++round) {
+    const auto product =
+        makeExpr<Analyzer::BinOper>(SQLTypeInfo(kBIGINT, notnull),
+                                    false,
+                                    kMULTIPLY,
+                                    kONE,
+                                    hash,
+                                    make_bigint_constant(kMultiplier));
+    hash = make_bigint_modulo(product, kPrime, notnull);
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::shared_ptr<Analyzer::Expr> get_group_by_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  // partial results of a top n or a limit don't add up to the result of the query
+  if (ra_exe_unit.estimator || ra_exe_unit.scan_limit || ra_exe_unit.union_all ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::Default) {
+    return nullptr;
+  }
+  std::shared_ptr<Analyzer::Expr> partition_key;
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (!groupby_expr || !groupby_expr->get_type_info().is_integer()) {
+      continue;
+    }
+    // the widest key is the most likely to spread the groups evenly
+    if (!partition_key || groupby_expr->get_type_info().get_size() >
+                              partition_key->get_type_info().get_size()) {
+      partition_key = groupby_expr;
+    }
+  }
+  return partition_key;
+}
+
+size_t get_group_by_partition_count(const size_t max_groups_buffer_entry_guess) {
+  CHECK_GT(g_group_by_spill_partition_size, size_t(0));
+  size_t partition_count{1};
+  while (partition_count < kMaxPartitionCount &&
+         partition_count * g_group_by_spill_partition_size <
+             max_groups_buffer_entry_guess) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
+size_t get_executed_group_by_partition_count() {
+  return executed_partition_count;
+}
+
+void add_executed_group_by_partition() {
+  ++executed_partition_count;
+}
+
+RelAlgExecutionUnit create_group_by_partition_execution_unit(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const size_t partition_idx,
+    const size_t partition_count) {
+  CHECK(partition_key);
+  CHECK_LT(partition_idx, partition_count);
+  const auto& key_ti = partition_key->get_type_info();
+  const auto remainder = make_bigint_modulo(
+      make_partition_hash(partition_key), partition_count, key_ti.get_notnull());
+  // the hash of a negative key is negative; the partition count and index are hoisted
+  // literals, all the partitions share the compiled code
+  std::list<std::shared_ptr<Analyzer::Expr>> partition_remainders{
+      make_bigint_constant(partition_idx)};
+  if (partition_idx) {
+    partition_remainders.push_back(
+        make_bigint_constant(static_cast<int64_t>(partition_idx) - partition_count));
+  }
+  std::shared_ptr<Analyzer::Expr> partition_qual =
+      makeExpr<Analyzer::InValues>(remainder, partition_remainders);
+  if (!partition_idx && !key_ti.get_notnull()) {
+    partition_qual = makeExpr<Analyzer::BinOper>(
+        kBOOLEAN,
+        kOR,
+        kONE,
+        partition_qual,
+        makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, partition_key));
+  }
+  auto partition_exe_unit = ra_exe_unit;
+  partition_exe_unit.quals.push_back(partition_qual);
+  return partition_exe_unit;
+}
+
+bool can_spill_group_by_result(const ResultSet& result) {
+  const auto& query_mem_desc = result.getQueryMemDesc();
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash ||
+      query_mem_desc.didOutputColumnar() ||
+      result.getDeviceType() != ExecutorDeviceType::CPU) {
+    return false;
+  }
+  for (const auto& target : result.getTargetInfos()) {
+    // count distinct sets and bitmaps, digests and variable length values live in memory
+    // of the owner of the result
+    if (target.is_distinct || target.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        target.agg_kind == kAPPROX_MEDIAN || target.sql_type.is_varlen()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GroupBySpillFile::GroupBySpillFile()
+    : path_(boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("omnisci_group_by_spill_%%%%-%%%%-%%%%")) {
+  file_.open(path_.string(),
+             std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+  if (!file_) {
+    throw std::runtime_error("Failed to create group by spill file " + path_.string());
+  }
+}
+
+GroupBySpillFile::~GroupBySpillFile() {
+  file_.close();
+  boost::system::error_code ec;
+  boost::filesystem::remove(path_, ec);
+}
+
+void GroupBySpillFile::spill(const ResultSet& result) {
+  CHECK(can_spill_group_by_result(result));
+  const auto storage = result.getStorage();
+  if (!storage) {
+    return;
+  }
+  const auto& query_mem_desc = result.getQueryMemDesc();
+  if (!query_mem_desc_) {
+    targets_ = result.getTargetInfos();
+    query_mem_desc_ = query_mem_desc;
+    target_init_vals_ = result.getTargetInitVals();
+  }
+  const auto row_size = query_mem_desc.getRowSize();
+  CHECK_EQ(row_size, query_mem_desc_->getRowSize());
+  const auto buff = reinterpret_cast<const char*>(storage->getUnderlyingBuffer());
+  const auto entry_count = result.entryCount();
+  // the empty entries of the hash table are left out, runs of used ones written at once
+  size_t spilled_entry_count{0};
+  size_t run_begin{0};
+  for (size_t entry_idx = 0; entry_idx <= entry_count; ++entry_idx) {
+    if (entry_idx < entry_count && !result.isRowAtEmpty(entry_idx)) {
+      continue;
+    }
+    if (entry_idx > run_begin) {
+      file_.write(buff + run_begin * row_size, (entry_idx - run_begin) * row_size);
+      spilled_entry_count += entry_idx - run_begin;
+    }
+    run_begin = entry_idx + 1;
+  }
+  if (!file_) {
+    throw std::runtime_error("Failed to write group by spill file " + path_.string());
+  }
+  if (spilled_entry_count) {
+    partition_entry_counts_.push_back(spilled_entry_count);
+  }
+}
+
+ResultSetPtr GroupBySpillFile::load(
+    const size_t partition_idx,
+    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+    const Catalog_Namespace::Catalog* catalog,
+    const unsigned block_size,
+    const unsigned grid_size) {
+  CHECK(query_mem_desc_);
+  CHECK_LT(partition_idx, partition_entry_counts_.size());
+  size_t partition_offset{0};
+  for (size_t i = 0; i < partition_idx; ++i) {
+    partition_offset += partition_entry_counts_[i] * query_mem_desc_->getRowSize();
+  }
+  auto query_mem_desc = *query_mem_desc_;
+  query_mem_desc.setEntryCount(partition_entry_counts_[partition_idx]);
+  auto result = std::make_shared<ResultSet>(targets_,
+                                            ExecutorDeviceType::CPU,
+                                            query_mem_desc,
+                                            row_set_mem_owner,
+                                            catalog,
+                                            block_size,
+                                            grid_size);
+  const auto num_bytes = query_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU);
+  auto buff = row_set_mem_owner->allocate(num_bytes);
+  file_.seekg(partition_offset);
+  file_.read(reinterpret_cast<char*>(buff), num_bytes);
+  if (!file_) {
+    throw std::runtime_error("Failed to read group by spill file " + path_.string());
+  }
+  result->allocateStorage(buff, target_init_vals_);
+  return result;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    GroupBySpill.h
+ * @brief   Partitioned execution of group by queries with more groups than fit in memory.
+ *
+ * The groups are split in partitions on a hash of an integer group by key, and each
+ * partition is aggregated in its own pass over the input. Only the hash table of one
+ * partition is in memory at a time: the results of finished partitions are written to a
+ * temporary file and read back, one partition at a time, once all of them are done.
+ *
+ * Every partition scans the whole input, hence the path is off by default.
+ */
+
+#pragma once
+
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "QueryEngine/ResultSet.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <optional>
+
+extern bool g_enable_group_by_spill;
+extern size_t g_group_by_spill_partition_size;
+
+// The group by key to partition on, nullptr if the query can't run in partitions.
+std::shared_ptr<Analyzer::Expr> get_group_by_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit);
+
+// Number of partitions for the given groups buffer entry count, a power of two.
+size_t get_group_by_partition_count(const size_t max_groups_buffer_entry_guess);
+
+// Number of group by partitions executed so far, for tests.
+size_t get_executed_group_by_partition_count();
+
+void add_executed_group_by_partition();
+
+// The execution unit restricted to the groups of the partition.
+RelAlgExecutionUnit create_group_by_partition_execution_unit(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const size_t partition_idx,
+    const size_t partition_count);
+
+// Whether the result is a row-wise baseline hash buffer of fixed width values only,
+// which can be written out without the memory of its owner.
+bool can_spill_group_by_result(const ResultSet& result);
+
+class GroupBySpillFile {
+ public:
+  GroupBySpillFile();
+
+  ~GroupBySpillFile();
+
+  // Appends the non-empty entries of the result of a partition to the file.
+  void spill(const ResultSet& result);
+
+  // Reads the entries of a spilled partition back in a result set owned by
+  // row_set_mem_owner.
+  ResultSetPtr load(const size_t partition_idx,
+                    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+                    const Catalog_Namespace::Catalog* catalog,
+                    const unsigned block_size,
+                    const unsigned grid_size);
+
+  // Partitions with at least one spilled entry.
+  size_t getSpilledPartitionCount() const { return partition_entry_counts_.size(); }
+
+ private:
+  boost::filesystem::path path_;
+  std::fstream file_;
+  // the layout of the first spilled result, the others only differ in entry count
+  std::vector<TargetInfo> targets_;
+  std::optional<QueryMemoryDescriptor> query_mem_desc_;
+  std::vector<int64_t> target_init_vals_;
+  std::vector<size_t> partition_entry_counts_;
+};
@@ -26,15 +26,44 @@
 #include "Logger/Logger.h"
 #include "RuntimeFunctions.h"
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <cstring>
 #include <limits>
 
-using checked_int64_t = boost::multiprecision::number<
-    boost::multiprecision::cpp_int_backend<64,
-                                           64,
-                                           boost::multiprecision::signed_magnitude,
-                                           boost::multiprecision::checked,
-                                           void>>;
+extern size_t g_in_values_max_bitmap_to_hash_set_ratio;
+
+namespace {
+
+// Builds the hash set of the non-null values, which is doubled whenever it gets half
+// full, so that duplicate values don't make it bigger than the distinct ones need.
+std::vector<int64_t> build_hash_set(const std::vector<int64_t>& values,
+                                    const int64_t null_val,
+                                    int64_t& hash_set_bits) {
+  hash_set_bits = 4;
+  std::vector<int64_t> hash_set(size_t(1) << hash_set_bits, null_val);
+  size_t distinct_count{0};
+  for (const auto value : values) {
+    if (value == null_val) {
+      continue;
+    }
+    if (!hash_set_insert(hash_set.data(), value, hash_set_bits, null_val)) {
+      continue;
+    }
+    if (++distinct_count * 2 <= hash_set.size()) {
+      continue;
+    }
+    std::vector<int64_t> grown_hash_set(hash_set.size() * 2, null_val);
+    ++hash_set_bits;
+    for (const auto slot_value : hash_set) {
+      if (slot_value != null_val) {
+        hash_set_insert(grown_hash_set.data(), slot_value, hash_set_bits, null_val);
+      }
+    }
+    hash_set.swap(grown_hash_set);
+  }
+  return hash_set;
+}
+
+}  // namespace
 
 InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
                                const int64_t null_val,
@@ -42,6 +71,7 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
                                const int device_count,
                                Data_Namespace::DataMgr* data_mgr)
     : rhs_has_null_(false)
+    , hash_set_bits_(0)
     , null_val_(null_val)
     , memory_level_(memory_level)
     , device_count_(device_count)
@@ -75,19 +105,31 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
     CHECK(rhs_has_null_);
     return;
   }
-  const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
-  const auto bitmap_sz_bits =
-      static_cast<int64_t>(checked_int64_t(max_val_) - min_val_ + 1);
-  if (bitmap_sz_bits > MAX_BITMAP_BITS) {
-    throw FailedToCreateBitmap();
-  }
-  const auto bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
-  auto cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
-  for (const auto value : values) {
-    if (value == null_val) {
-      continue;
+  const uint64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
+  // the range of 64-bit values can overflow a signed difference
+  const uint64_t bitmap_sz_bits = static_cast<uint64_t>(max_val_) - min_val_ + 1;
+  // a sparse set of values is probed in a hash set of about twice their size instead
+  // of a bitmap spanning their whole range
+  const uint64_t hash_set_sz_bytes = 2 * values.size() * sizeof(int64_t);
+  int8_t* cpu_bitset{nullptr};
+  size_t bitmap_sz_bytes{0};
+  if (bitmap_sz_bits > MAX_BITMAP_BITS ||
+      bitmap_bits_to_bytes(bitmap_sz_bits) >
+          g_in_values_max_bitmap_to_hash_set_ratio * hash_set_sz_bytes) {
+    const auto hash_set = build_hash_set(values, null_val, hash_set_bits_);
+    bitmap_sz_bytes = hash_set.size() * sizeof(int64_t);
+    cpu_bitset = static_cast<int8_t*>(checked_malloc(bitmap_sz_bytes));
+    std::memcpy(cpu_bitset, hash_set.data(), bitmap_sz_bytes);
+  } else {
+    bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
+    cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
+    for (const auto value : values) {
+      if (value == null_val) {
+        continue;
+      }
+      agg_count_distinct_bitmap(
+          reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
     }
-    agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
   }
 #ifdef HAVE_CUDA
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
@@ -156,6 +198,17 @@ llvm::Value* InValuesBitmap::codegen(llvm::Value* needle, Executor* executor) co
   const auto bitset_handle_lvs =
       code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
   CHECK_EQ(size_t(1), bitset_handle_lvs.size());
+  if (hash_set_bits_) {
+    return executor->cgen_state_->emitCall(
+        "hash_set_contains",
+        {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
+         needle_i64,
+         executor->cgen_state_->llInt(min_val_),
+         executor->cgen_state_->llInt(max_val_),
+         executor->cgen_state_->llInt(hash_set_bits_),
+         executor->cgen_state_->llInt(null_val_),
+         executor->cgen_state_->llInt(null_bool_val)});
+  }
   return executor->cgen_state_->emitCall(
       "bit_is_set",
       {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
@@ -34,11 +34,6 @@
 
 class Executor;
 
-class FailedToCreateBitmap : public std::runtime_error {
- public:
-  FailedToCreateBitmap() : std::runtime_error("FailedToCreateBitmap") {}
-};
-
 class InValuesBitmap {
  public:
   InValuesBitmap(const std::vector<int64_t>& values,
@@ -58,8 +53,11 @@ class InValuesBitmap {
 
  private:
   std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
+  // bitmaps of the values, or hash sets of them if their range is too wide
   std::vector<int8_t*> bitsets_;
   bool rhs_has_null_;
+  // log2 of the slot count of the hash sets, zero for bitmaps
+  int64_t hash_set_bits_;
   int64_t min_val_;
   int64_t max_val_;
   const int64_t null_val_;
@@ -43,7 +43,8 @@ std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
     const HashType preferred_hash_type,
     const int device_count,
     ColumnCacheMap& column_cache,
-    Executor* executor) {
+    Executor* executor,
+    const std::optional<HashJoinPartition>& partition) {
   decltype(std::chrono::steady_clock::now()) ts1, ts2;
 
   if (VLOGGING(1)) {
@@ -62,7 +63,8 @@ std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
                                                                        column_cache,
                                                                        executor,
                                                                        inner_outer_pairs,
-                                                                       device_count));
+                                                                       device_count,
+                                                                       partition));
   try {
     join_hash_table->reify(preferred_hash_type);
   } catch (const TableMustBeReplicated& e) {
@@ -106,7 +108,8 @@ BaselineJoinHashTable::BaselineJoinHashTable(
     ColumnCacheMap& column_cache,
     Executor* executor,
     const std::vector<InnerOuter>& inner_outer_pairs,
-    const int device_count)
+    const int device_count,
+    const std::optional<HashJoinPartition>& partition)
     : condition_(condition)
     , join_type_(join_type)
     , query_infos_(query_infos)
@@ -115,8 +118,12 @@ BaselineJoinHashTable::BaselineJoinHashTable(
     , column_cache_(column_cache)
     , inner_outer_pairs_(inner_outer_pairs)
     , catalog_(executor->getCatalog())
-    , device_count_(device_count) {
+    , device_count_(device_count)
+    , partition_(partition) {
   CHECK_GT(device_count_, 0);
+  if (partition_) {
+    CHECK_EQ(memory_level_, Data_Namespace::MemoryLevel::CPU_LEVEL);
+  }
   hash_tables_for_device_.resize(std::max(device_count_, 1));
 }
 
@@ -260,7 +267,9 @@ void BaselineJoinHashTable::reifyWithLayout(const HashType layout) {
     return;
   }
 
-  const auto total_entries = 2 * query_info.getNumTuplesUpperBound();
+  const auto partition_count = partition_ ? partition_->partition_count : size_t(1);
+  const auto total_entries =
+      2 * ((query_info.getNumTuplesUpperBound() + partition_count - 1) / partition_count);
   if (total_entries > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
     throw TooManyHashEntries();
   }
@@ -349,7 +358,9 @@ std::pair<size_t, size_t> BaselineJoinHashTable::approximateTupleCount(
                                 composite_key_info.cache_key_chunks,
                                 condition_->get_optype(),
                                 join_type_};
-    const auto cached_count_info = getApproximateTupleCountFromCache(cache_key);
+    const auto cached_count_info =
+        partition_ ? std::make_pair(std::optional<size_t>{}, size_t(0))
+                   : getApproximateTupleCountFromCache(cache_key);
     if (cached_count_info.first) {
       VLOG(1) << "Using a cached tuple count: " << *cached_count_info.first
               << ", emitted keys count: " << cached_count_info.second;
@@ -403,6 +414,7 @@ std::pair<size_t, size_t> BaselineJoinHashTable::approximateTupleCount(
                                 join_columns_gpu,
                                 join_column_types_gpu,
                                 nullptr,
+                                nullptr,
                                 nullptr);
           const auto key_handler_gpu =
               transfer_flat_object_to_gpu(key_handler, allocator);
@@ -450,6 +462,8 @@ ColumnsForDevice BaselineJoinHashTable::fetchColumnsForDevice(
   std::vector<JoinColumnTypeInfo> join_column_types;
   std::vector<JoinBucketInfo> join_bucket_info;
   std::vector<std::shared_ptr<void>> malloc_owner;
+  const auto partition_count = partition_ ? partition_->partition_count : size_t(1);
+  const auto partition_idx = partition_ ? partition_->partition_idx : size_t(0);
   for (const auto& inner_outer_pair : inner_outer_pairs_) {
     const auto inner_col = inner_outer_pair.first;
     const auto inner_cd = get_column_descriptor_maybe(
@@ -473,7 +487,9 @@ ColumnsForDevice BaselineJoinHashTable::fetchColumnsForDevice(
                                                       inline_fixed_encoding_null_val(ti),
                                                       isBitwiseEq(),
                                                       0,
-                                                      get_join_column_type_kind(ti)});
+                                                      get_join_column_type_kind(ti),
+                                                      partition_count,
+                                                      partition_idx});
   }
   return {join_columns, join_column_types, chunks_owner, join_bucket_info, malloc_owner};
 }
@@ -552,7 +568,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
   if (effective_memory_level == Data_Namespace::CPU_LEVEL) {
     std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
 
-    const auto composite_key_info =
+    auto composite_key_info =
         HashJoin::getCompositeKeyInfo(inner_outer_pairs_, executor_);
 
     CHECK(!join_columns.empty());
@@ -566,19 +582,33 @@ int BaselineJoinHashTable::initHashTableForDevice(
     }
     CHECK_LT(static_cast<size_t>(device_id), hash_tables_for_device_.size());
 
-    auto hash_table = initHashTableOnCpuFromCache(cache_key);
+    // the partitions of a partitioned join are built once each, one at a time
+    auto hash_table = partition_ ? nullptr : initHashTableOnCpuFromCache(cache_key);
     if (hash_table) {
       hash_tables_for_device_[device_id] = hash_table;
     } else {
       BaselineJoinHashTableBuilder builder(catalog_);
 
+      const auto build_clock = timer_start();
+      for (size_t i = 0; i < composite_key_info.sd_inner_proxy_per_key.size(); ++i) {
+        const auto sd_inner_proxy = static_cast<const StringDictionaryProxy*>(
+            composite_key_info.sd_inner_proxy_per_key[i]);
+        if (sd_inner_proxy) {
+          composite_key_info.sd_translation_map_per_key[i] =
+              sd_inner_proxy->getTranslationMap(
+                  static_cast<const StringDictionaryProxy*>(
+                      composite_key_info.sd_outer_proxy_per_key[i]),
+                  join_columns[i].num_elems);
+        }
+      }
       const auto key_handler =
           GenericKeyHandler(key_component_count,
                             true,
                             &join_columns[0],
                             &join_column_types[0],
                             &composite_key_info.sd_inner_proxy_per_key[0],
-                            &composite_key_info.sd_outer_proxy_per_key[0]);
+                            &composite_key_info.sd_outer_proxy_per_key[0],
+                            &composite_key_info.sd_translation_map_per_key[0]);
       err = builder.initHashTableOnCpu(&key_handler,
                                        composite_key_info,
                                        join_columns,
@@ -591,10 +621,12 @@ int BaselineJoinHashTable::initHashTableForDevice(
                                        getKeyComponentWidth(),
                                        getKeyComponentCount());
       hash_tables_for_device_[device_id] = builder.getHashTable();
+      const auto build_cost_ms = timer_stop(build_clock);
 
-      if (!err) {
+      if (!err && !partition_) {
         if (getInnerTableId() > 0) {
-          putHashTableOnCpuToCache(cache_key, hash_tables_for_device_[device_id]);
+          putHashTableOnCpuToCache(
+              cache_key, hash_tables_for_device_[device_id], build_cost_ms);
         }
       }
     }
@@ -646,6 +678,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
                                                join_columns_gpu,
                                                join_column_types_gpu,
                                                nullptr,
+                                               nullptr,
                                                nullptr);
 
     err = builder.initHashTableOnGpu(&key_handler,
@@ -684,6 +717,8 @@ llvm::Value* BaselineJoinHashTable::codegenSlot(const CompilationOptions& co,
       LL_BUILDER.CreatePointerCast(key_buff_lv, llvm::Type::getInt8PtrTy(LL_CONTEXT));
   const auto key_size_lv = LL_INT(getKeyComponentCount() * key_component_width);
   const auto hash_table = getHashTableForDevice(size_t(0));
+  codegenProbePrefetch(
+      hash_ptr, (getKeyComponentCount() + 1) * key_component_width, co);
   return executor_->cgen_state_->emitExternalCall(
       "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
@@ -708,6 +743,10 @@ HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
           ? LL_BUILDER.CreatePointerCast(hash_ptr, composite_dict_ptr_type)
           : LL_BUILDER.CreateIntToPtr(hash_ptr, composite_dict_ptr_type);
   const auto key_component_count = getKeyComponentCount();
+  codegenProbePrefetch(LL_BUILDER.CreatePointerCast(
+                           composite_key_dict, llvm::Type::getInt8PtrTy(LL_CONTEXT)),
+                       key_component_count * key_component_width,
+                       co);
   const auto key = executor_->cgen_state_->emitExternalCall(
       "get_composite_key_index_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
@@ -829,6 +868,25 @@ llvm::Value* BaselineJoinHashTable::hashPtr(const size_t index) {
              : LL_BUILDER.CreateIntToPtr(hash_ptr, pi8_type);
 }
 
+void BaselineJoinHashTable::codegenProbePrefetch(llvm::Value* hash_ptr,
+                                                 const size_t entry_size,
+                                                 const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  // the slots of composite keys are hashed from the whole key, only single column keys
+  // can be hashed from the outer column alone
+  if (getKeyComponentCount() != 1) {
+    return;
+  }
+  const auto entry_count = getHashTableForDevice(size_t(0))->getEntryCount();
+  HashJoin::codegenProbePrefetch(
+      "prefetch_baseline_hash_join_slots_" + std::to_string(getKeyComponentWidth() * 8),
+      inner_outer_pairs_.front().second,
+      entry_count * entry_size,
+      {hash_ptr, LL_INT(static_cast<int64_t>(entry_count)), LL_INT(int64_t(entry_size))},
+      co,
+      executor_);
+}
+
 #undef ROW_FUNC
 #undef LL_INT
 #undef LL_BUILDER
@@ -877,7 +935,8 @@ std::shared_ptr<HashTable> BaselineJoinHashTable::initHashTableOnCpuFromCache(
 
 void BaselineJoinHashTable::putHashTableOnCpuToCache(
     const HashTableCacheKey& key,
-    std::shared_ptr<HashTable>& hash_table) {
+    std::shared_ptr<HashTable>& hash_table,
+    const double build_cost_ms) {
   for (auto chunk_key : key.chunk_keys) {
     CHECK_GE(chunk_key.size(), size_t(2));
     if (chunk_key[1] < 0) {
@@ -885,7 +944,11 @@ void BaselineJoinHashTable::putHashTableOnCpuToCache(
     }
   }
   CHECK(hash_table_cache_);
-  hash_table_cache_->insert(key, hash_table);
+  CHECK(hash_table);
+  hash_table_cache_->insert(key,
+                            hash_table,
+                            hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU),
+                            build_cost_ms);
 }
 
 std::pair<std::optional<size_t>, size_t>
@@ -940,3 +1003,20 @@ void HashTypeCache::clear() {
   std::lock_guard<std::mutex> hash_type_cache_lock(hash_type_cache_mutex_);
   hash_type_cache_.clear();
 }
+
+void HashTypeCache::invalidateTable(const int db_id, const int table_id) {
+  std::lock_guard<std::mutex> hash_type_cache_lock(hash_type_cache_mutex_);
+  for (auto it = hash_type_cache_.begin(); it != hash_type_cache_.end();) {
+    const auto& chunk_keys = it->first;
+    if (std::any_of(chunk_keys.begin(),
+                    chunk_keys.end(),
+                    [db_id, table_id](const ChunkKey& chunk_key) {
+                      return chunk_key[CHUNK_KEY_DB_IDX] == db_id &&
+                             chunk_key[CHUNK_KEY_TABLE_IDX] == table_id;
+                    })) {
+      it = hash_type_cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
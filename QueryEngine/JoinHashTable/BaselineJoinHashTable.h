@@ -19,6 +19,9 @@
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <cstdint>
 #include <map>
 #include <mutex>
@@ -48,6 +51,22 @@ struct HashTableCacheKey {
     return num_elements == that.num_elements && chunk_keys == that.chunk_keys &&
            optype == that.optype && join_type == that.join_type;
   }
+
+  size_t hash() const {
+    size_t seed = boost::hash_value(chunk_keys);
+    boost::hash_combine(seed, num_elements);
+    boost::hash_combine(seed, static_cast<int>(optype));
+    boost::hash_combine(seed, static_cast<int>(join_type));
+    return seed;
+  }
+
+  bool referencesTable(const int db_id, const int table_id) const {
+    return std::any_of(
+        chunk_keys.begin(), chunk_keys.end(), [db_id, table_id](const ChunkKey& key) {
+          CHECK_GE(key.size(), size_t(2));
+          return key[CHUNK_KEY_DB_IDX] == db_id && key[CHUNK_KEY_TABLE_IDX] == table_id;
+        });
+  }
 };
 
 class HashTypeCache {
@@ -58,6 +77,8 @@ class HashTypeCache {
 
   static void clear();
 
+  static void invalidateTable(const int db_id, const int table_id);
+
  private:
   static std::map<std::vector<ChunkKey>, HashType> hash_type_cache_;
   static std::mutex hash_type_cache_mutex_;
@@ -78,7 +99,8 @@ class BaselineJoinHashTable : public HashJoin {
       const HashType preferred_hash_type,
       const int device_count,
       ColumnCacheMap& column_cache,
-      Executor* executor);
+      Executor* executor,
+      const std::optional<HashJoinPartition>& partition = std::nullopt);
 
   static size_t getShardCountForCondition(
       const Analyzer::BinOper* condition,
@@ -126,6 +148,14 @@ class BaselineJoinHashTable : public HashJoin {
     };
   }
 
+  static auto getTableCacheInvalidator() -> std::function<void(const int, const int)> {
+    return [](const int db_id, const int table_id) -> void {
+      CHECK(hash_table_cache_);
+      hash_table_cache_->getTableCacheInvalidator()(db_id, table_id);
+      HashTypeCache::invalidateTable(db_id, table_id);
+    };
+  }
+
   static auto* getHashTableCache() {
     CHECK(hash_table_cache_);
     return hash_table_cache_.get();
@@ -141,7 +171,8 @@ class BaselineJoinHashTable : public HashJoin {
                         ColumnCacheMap& column_cache,
                         Executor* executor,
                         const std::vector<InnerOuter>& inner_outer_pairs,
-                        const int device_count);
+                        const int device_count,
+                        const std::optional<HashJoinPartition>& partition);
 
   size_t getComponentBufferSize() const noexcept override;
 
@@ -191,10 +222,15 @@ class BaselineJoinHashTable : public HashJoin {
 
   llvm::Value* hashPtr(const size_t index);
 
+  void codegenProbePrefetch(llvm::Value* hash_ptr,
+                            const size_t entry_size,
+                            const CompilationOptions& co);
+
   std::shared_ptr<HashTable> initHashTableOnCpuFromCache(const HashTableCacheKey&);
 
   void putHashTableOnCpuToCache(const HashTableCacheKey&,
-                                std::shared_ptr<HashTable>& hash_table);
+                                std::shared_ptr<HashTable>& hash_table,
+                                const double build_cost_ms);
 
   std::pair<std::optional<size_t>, size_t> getApproximateTupleCountFromCache(
       const HashTableCacheKey&) const;
@@ -212,6 +248,7 @@ class BaselineJoinHashTable : public HashJoin {
   std::vector<InnerOuter> inner_outer_pairs_;
   const Catalog_Namespace::Catalog* catalog_;
   const int device_count_;
+  const std::optional<HashJoinPartition> partition_;
 
   std::optional<HashType>
       layout_override_;  // allows us to use a 1:many hash table for many:many
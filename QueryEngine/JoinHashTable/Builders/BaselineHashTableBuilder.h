@@ -101,6 +101,45 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
   }
 }
 
+template <typename SIZE, class KEY_HANDLER>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const size_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const KEY_HANDLER* key_handler,
+                                             const int32_t cpu_thread_count,
+                                             const size_t partition_count) {
+  if constexpr (std::is_same<KEY_HANDLER, GenericKeyHandler>::value) {
+    if constexpr (sizeof(SIZE) == 4) {
+      return fill_baseline_hash_join_buff_partitioned_32(hash_buff,
+                                                         entry_count,
+                                                         invalid_slot_val,
+                                                         for_semi_join,
+                                                         key_component_count,
+                                                         with_val_slot,
+                                                         key_handler,
+                                                         cpu_thread_count,
+                                                         partition_count);
+    } else {
+      static_assert(sizeof(SIZE) == 8);
+      return fill_baseline_hash_join_buff_partitioned_64(hash_buff,
+                                                         entry_count,
+                                                         invalid_slot_val,
+                                                         for_semi_join,
+                                                         key_component_count,
+                                                         with_val_slot,
+                                                         key_handler,
+                                                         cpu_thread_count,
+                                                         partition_count);
+    }
+  } else {
+    UNREACHABLE() << "Only the keys of equi joins are filled in partitions";
+    return -1;
+  }
+}
+
 template <typename SIZE,
           class KEY_HANDLER,
           typename std::enable_if<sizeof(SIZE) == 4, SIZE>::type* = nullptr>
@@ -305,58 +344,101 @@ class BaselineJoinHashTableBuilder {
     for (auto& child : init_cpu_buff_threads) {
       child.get();
     }
-    std::vector<std::future<int>> fill_cpu_buff_threads;
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      fill_cpu_buff_threads.emplace_back(std::async(
-          std::launch::async,
-          [key_handler,
-           keyspace_entry_count,
-           &join_columns,
-           key_component_count,
-           key_component_width,
-           layout,
-           thread_idx,
-           cpu_hash_table_ptr,
-           thread_count,
-           for_semi_join] {
-            switch (key_component_width) {
-              case 4: {
-                return fill_baseline_hash_join_buff<int32_t>(cpu_hash_table_ptr,
-                                                             keyspace_entry_count,
-                                                             -1,
-                                                             for_semi_join,
-                                                             key_component_count,
-                                                             layout == HashType::OneToOne,
-                                                             key_handler,
-                                                             join_columns[0].num_elems,
-                                                             thread_idx,
-                                                             thread_count);
-                break;
-              }
-              case 8: {
-                return fill_baseline_hash_join_buff<int64_t>(cpu_hash_table_ptr,
-                                                             keyspace_entry_count,
-                                                             -1,
-                                                             for_semi_join,
-                                                             key_component_count,
-                                                             layout == HashType::OneToOne,
-                                                             key_handler,
-                                                             join_columns[0].num_elems,
-                                                             thread_idx,
-                                                             thread_count);
-                break;
-              }
-              default:
-                CHECK(false);
-            }
-            return -1;
-          }));
-    }
+    // overlaps keys are bucketized bounds and always filled in a single pass, the rows
+    // of the others are scattered to the partitions as their index and key
+    const size_t build_partition_count =
+        std::is_same<KEY_HANDLER, GenericKeyHandler>::value
+            ? get_hash_join_build_partition_count(
+                  entry_size * keyspace_entry_count,
+                  keys_for_all_rows * (key_component_count + 1) * key_component_width)
+            : 1;
     int err = 0;
-    for (auto& child : fill_cpu_buff_threads) {
-      int partial_err = child.get();
-      if (partial_err) {
-        err = partial_err;
+    if (build_partition_count > 1) {
+      VLOG(1) << "Filling CPU Join Hash Table in " << build_partition_count
+              << " partitions";
+      switch (key_component_width) {
+        case 4:
+          err = fill_baseline_hash_join_buff_partitioned<int32_t>(
+              cpu_hash_table_ptr,
+              keyspace_entry_count,
+              -1,
+              for_semi_join,
+              key_component_count,
+              layout == HashType::OneToOne,
+              key_handler,
+              thread_count,
+              build_partition_count);
+          break;
+        case 8:
+          err = fill_baseline_hash_join_buff_partitioned<int64_t>(
+              cpu_hash_table_ptr,
+              keyspace_entry_count,
+              -1,
+              for_semi_join,
+              key_component_count,
+              layout == HashType::OneToOne,
+              key_handler,
+              thread_count,
+              build_partition_count);
+          break;
+        default:
+          CHECK(false);
+      }
+    } else {
+      std::vector<std::future<int>> fill_cpu_buff_threads;
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        fill_cpu_buff_threads.emplace_back(std::async(
+            std::launch::async,
+            [key_handler,
+             keyspace_entry_count,
+             &join_columns,
+             key_component_count,
+             key_component_width,
+             layout,
+             thread_idx,
+             cpu_hash_table_ptr,
+             thread_count,
+             for_semi_join] {
+              switch (key_component_width) {
+                case 4: {
+                  return fill_baseline_hash_join_buff<int32_t>(
+                      cpu_hash_table_ptr,
+                      keyspace_entry_count,
+                      -1,
+                      for_semi_join,
+                      key_component_count,
+                      layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                  break;
+                }
+                case 8: {
+                  return fill_baseline_hash_join_buff<int64_t>(
+                      cpu_hash_table_ptr,
+                      keyspace_entry_count,
+                      -1,
+                      for_semi_join,
+                      key_component_count,
+                      layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                  break;
+                }
+                default:
+                  CHECK(false);
+              }
+              return -1;
+            }));
+      }
+      for (auto& child : fill_cpu_buff_threads) {
+        int partial_err = child.get();
+        if (partial_err) {
+          err = partial_err;
+        }
       }
     }
     if (err) {
@@ -380,6 +462,7 @@ class BaselineJoinHashTableBuilder {
               join_bucket_info,
               composite_key_info.sd_inner_proxy_per_key,
               composite_key_info.sd_outer_proxy_per_key,
+              composite_key_info.sd_translation_map_per_key,
               thread_count);
           break;
         }
@@ -396,6 +479,7 @@ class BaselineJoinHashTableBuilder {
               join_bucket_info,
               composite_key_info.sd_inner_proxy_per_key,
               composite_key_info.sd_outer_proxy_per_key,
+              composite_key_info.sd_translation_map_per_key,
               thread_count);
           break;
         }
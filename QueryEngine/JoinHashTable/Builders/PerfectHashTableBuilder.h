@@ -197,6 +197,7 @@ class PerfectJoinHashTableBuilder {
     auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
     const StringDictionaryProxy* sd_inner_proxy{nullptr};
     const StringDictionaryProxy* sd_outer_proxy{nullptr};
+    const std::vector<int32_t>* sd_translation_map{nullptr};
     const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
     const bool for_semi_join = for_semi_anti_join(join_type);
     if (ti.is_string() &&
@@ -209,6 +210,8 @@ class PerfectJoinHashTableBuilder {
       sd_outer_proxy =
           executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
       CHECK(sd_outer_proxy);
+      sd_translation_map =
+          sd_inner_proxy->getTranslationMap(sd_outer_proxy, join_column.num_elems);
     }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
@@ -229,44 +232,67 @@ class PerfectJoinHashTableBuilder {
       t.join();
     }
     init_cpu_buff_threads.clear();
+    const JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                       col_range.getIntMin(),
+                                       col_range.getIntMax(),
+                                       inline_fixed_encoding_null_val(ti),
+                                       is_bitwise_eq,
+                                       col_range.getIntMax() + 1,
+                                       get_join_column_type_kind(ti)};
+    // the rows are scattered to the partitions as their slot and index
+    const auto build_partition_count = get_hash_join_build_partition_count(
+        hash_entry_info.getNormalizedHashEntryCount() * sizeof(int32_t),
+        join_column.num_elems * 2 * sizeof(int32_t));
     std::atomic<int> err{0};
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      init_cpu_buff_threads.emplace_back([hash_join_invalid_val,
-                                          &join_column,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
-                                          thread_idx,
-                                          thread_count,
-                                          &ti,
-                                          &err,
-                                          &col_range,
-                                          &is_bitwise_eq,
-                                          &for_semi_join,
-                                          cpu_hash_table_buff,
-                                          hash_entry_info] {
-        int partial_err =
-            fill_hash_join_buff_bucketized(cpu_hash_table_buff,
-                                           hash_join_invalid_val,
-                                           for_semi_join,
-                                           join_column,
-                                           {static_cast<size_t>(ti.get_size()),
-                                            col_range.getIntMin(),
-                                            col_range.getIntMax(),
-                                            inline_fixed_encoding_null_val(ti),
-                                            is_bitwise_eq,
-                                            col_range.getIntMax() + 1,
-                                            get_join_column_type_kind(ti)},
-                                           sd_inner_proxy,
-                                           sd_outer_proxy,
-                                           thread_idx,
-                                           thread_count,
-                                           hash_entry_info.bucket_normalization);
-        int zero{0};
-        err.compare_exchange_strong(zero, partial_err);
-      });
-    }
-    for (auto& t : init_cpu_buff_threads) {
-      t.join();
+    if (build_partition_count > 1) {
+      VLOG(1) << "Filling CPU Join Hash Table in " << build_partition_count
+              << " partitions";
+      err = fill_hash_join_buff_bucketized_partitioned(
+          cpu_hash_table_buff,
+          hash_entry_info.getNormalizedHashEntryCount(),
+          hash_join_invalid_val,
+          for_semi_join,
+          join_column,
+          type_info,
+          sd_inner_proxy,
+          sd_outer_proxy,
+          sd_translation_map,
+          hash_entry_info.bucket_normalization,
+          thread_count,
+          build_partition_count);
+    } else {
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        init_cpu_buff_threads.emplace_back([hash_join_invalid_val,
+                                            &join_column,
+                                            sd_inner_proxy,
+                                            sd_outer_proxy,
+                                            sd_translation_map,
+                                            thread_idx,
+                                            thread_count,
+                                            &type_info,
+                                            &err,
+                                            &for_semi_join,
+                                            cpu_hash_table_buff,
+                                            hash_entry_info] {
+          int partial_err =
+              fill_hash_join_buff_bucketized(cpu_hash_table_buff,
+                                             hash_join_invalid_val,
+                                             for_semi_join,
+                                             join_column,
+                                             type_info,
+                                             sd_inner_proxy,
+                                             sd_outer_proxy,
+                                             sd_translation_map,
+                                             thread_idx,
+                                             thread_count,
+                                             hash_entry_info.bucket_normalization);
+          int zero{0};
+          err.compare_exchange_strong(zero, partial_err);
+        });
+      }
+      for (auto& t : init_cpu_buff_threads) {
+        t.join();
+      }
     }
     if (err) {
       // Too many hash entries, need to retry with a 1:many table
@@ -299,6 +325,7 @@ class PerfectJoinHashTableBuilder {
     auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
     const StringDictionaryProxy* sd_inner_proxy{nullptr};
     const StringDictionaryProxy* sd_outer_proxy{nullptr};
+    const std::vector<int32_t>* sd_translation_map{nullptr};
     if (ti.is_string()) {
       CHECK_EQ(kENCODING_DICT, ti.get_compression());
       sd_inner_proxy =
@@ -309,6 +336,8 @@ class PerfectJoinHashTableBuilder {
       sd_outer_proxy =
           executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
       CHECK(sd_outer_proxy);
+      sd_translation_map =
+          sd_inner_proxy->getTranslationMap(sd_outer_proxy, join_column.num_elems);
     }
     int thread_count = cpu_threads();
     std::vector<std::future<void>> init_threads;
@@ -342,6 +371,7 @@ class PerfectJoinHashTableBuilder {
                                               get_join_column_type_kind(ti)},
                                              sd_inner_proxy,
                                              sd_outer_proxy,
+                                             sd_translation_map,
                                              thread_count);
     } else {
       fill_one_to_many_hash_table(cpu_hash_table_buff,
@@ -357,6 +387,7 @@ class PerfectJoinHashTableBuilder {
                                    get_join_column_type_kind(ti)},
                                   sd_inner_proxy,
                                   sd_outer_proxy,
+                                  sd_translation_map,
                                   thread_count);
     }
   }
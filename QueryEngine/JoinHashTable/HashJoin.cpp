@@ -25,8 +25,11 @@
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/ScalarExprVisitor.h"
+#include "QueryEngine/WindowContext.h"
 
 extern bool g_enable_overlaps_hashjoin;
+extern bool g_enable_hash_join_probe_prefetch;
+extern size_t g_hash_join_probe_prefetch_min_bytes;
 
 void ColumnsForDevice::setBucketInfo(
     const std::vector<double>& inverse_bucket_sizes_for_dimension,
@@ -234,6 +237,53 @@ llvm::Value* HashJoin::codegenHashTableLoad(const size_t table_idx, Executor* ex
   return hash_ptr;
 }
 
+void HashJoin::codegenProbePrefetch(const std::string& fname,
+                                    const Analyzer::Expr* key_col,
+                                    const size_t hash_table_bytes,
+                                    const std::vector<llvm::Value*>& slot_args,
+                                    const CompilationOptions& co,
+                                    Executor* executor) {
+  AUTOMATIC_IR_METADATA(executor->cgen_state_.get());
+  // tables which fit in the cache don't stall the probe
+  if (co.device_type != ExecutorDeviceType::CPU || !g_enable_hash_join_probe_prefetch ||
+      hash_table_bytes < g_hash_join_probe_prefetch_min_bytes) {
+    return;
+  }
+  // the keys are read ahead from the fragment of the outer table, as stored
+  const auto key_col_var = dynamic_cast<const Analyzer::ColumnVar*>(key_col);
+  if (!key_col_var || dynamic_cast<const Analyzer::Var*>(key_col) ||
+      key_col_var->get_rte_idx() != 0) {
+    return;
+  }
+  const auto& key_ti = key_col_var->get_type_info();
+  if (!((key_ti.is_integer() || key_ti.is_decimal()) &&
+        key_ti.get_compression() == kENCODING_NONE) &&
+      !key_ti.is_dict_encoded_string()) {
+    return;
+  }
+  const auto cd = get_column_descriptor_maybe(
+      key_col_var->get_column_id(), key_col_var->get_table_id(), *executor->getCatalog());
+  if ((cd && cd->isVirtualCol) || executor->plan_state_->isLazyFetchColumn(key_col_var) ||
+      WindowProjectNodeContext::getActiveWindowFunctionContext(executor)) {
+    return;
+  }
+  auto cgen_state = executor->cgen_state_.get();
+  const auto key_byte_stream = get_arg_by_name(
+      cgen_state->row_func_,
+      "col_buf" +
+          std::to_string(executor->plan_state_->getLocalColumnId(key_col_var, true)));
+  const auto row_count = cgen_state->ir_builder_.CreateLoad(
+      get_arg_by_name(cgen_state->row_func_, "num_rows_per_scan"));
+  std::vector<llvm::Value*> prefetch_args{
+      key_byte_stream,
+      cgen_state->llInt(static_cast<int32_t>(key_ti.get_size())),
+      cgen_state->llBool(key_ti.is_string() && key_ti.get_size() < 4),
+      get_arg_by_name(cgen_state->row_func_, "pos"),
+      row_count};
+  prefetch_args.insert(prefetch_args.end(), slot_args.begin(), slot_args.end());
+  cgen_state->emitCall(fname, prefetch_args);
+}
+
 //! Make hash table from an in-flight SQL query's parse tree etc.
 std::shared_ptr<HashJoin> HashJoin::getInstance(
     const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
@@ -262,6 +312,32 @@ std::shared_ptr<HashJoin> HashJoin::getInstance(
                                                          column_cache,
                                                          executor,
                                                          query_hint);
+  } else if (const auto partition = getPartitionForQual(qual_bin_oper, executor)) {
+    // only the keyed layout can hold the keys of one partition
+    CHECK_EQ(memory_level, Data_Namespace::MemoryLevel::CPU_LEVEL);
+    CHECK(join_type == JoinType::INNER);
+    const auto join_quals = coalesce_singleton_equi_join(qual_bin_oper);
+    CHECK_EQ(join_quals.size(), size_t(1));
+    const auto join_qual =
+        std::dynamic_pointer_cast<Analyzer::BinOper>(join_quals.front());
+    VLOG(1) << "Trying to build keyed hash table for partition "
+            << partition->partition_idx << " of " << partition->partition_count << ":";
+    try {
+      join_hash_table = BaselineJoinHashTable::getInstance(join_qual,
+                                                           query_infos,
+                                                           memory_level,
+                                                           join_type,
+                                                           preferred_hash_type,
+                                                           device_count,
+                                                           column_cache,
+                                                           executor,
+                                                           partition);
+    } catch (const HashJoinFail& e) {
+      // a loop join would produce the matches of all partitions in every pass
+      throw std::runtime_error(
+          std::string("Failed to build the hash table of a partitioned join | ") +
+          e.what());
+    }
   } else if (dynamic_cast<const Analyzer::ExpressionTuple*>(
                  qual_bin_oper->get_left_operand())) {
     VLOG(1) << "Trying to build keyed hash table:";
@@ -321,6 +397,22 @@ std::shared_ptr<HashJoin> HashJoin::getInstance(
   return join_hash_table;
 }
 
+std::optional<HashJoinPartition> HashJoin::getPartitionForQual(
+    const std::shared_ptr<Analyzer::BinOper>& qual_bin_oper,
+    const Executor* executor) {
+  const auto& partition = executor->hash_join_partition_;
+  if (!partition) {
+    return std::nullopt;
+  }
+  const auto inner_outer_pairs = normalize_column_pairs(
+      qual_bin_oper.get(), *executor->getCatalog(), executor->getTemporaryTables());
+  CHECK(!inner_outer_pairs.empty());
+  if (inner_outer_pairs.front().first->get_rte_idx() != partition->inner_rte_idx) {
+    return std::nullopt;
+  }
+  return partition;
+}
+
 CompositeKeyInfo HashJoin::getCompositeKeyInfo(
     const std::vector<InnerOuter>& inner_outer_pairs,
     const Executor* executor) {
@@ -355,7 +447,10 @@ CompositeKeyInfo HashJoin::getCompositeKeyInfo(
     }
     cache_key_chunks.push_back(cache_key_chunks_for_column);
   }
-  return {sd_inner_proxy_per_key, sd_outer_proxy_per_key, cache_key_chunks};
+  return {sd_inner_proxy_per_key,
+          sd_outer_proxy_per_key,
+          cache_key_chunks,
+          std::vector<const std::vector<int32_t>*>(inner_outer_pairs.size())};
 }
 
 std::shared_ptr<Analyzer::ColumnVar> getSyntheticColumnVar(std::string_view table,
@@ -18,6 +18,7 @@
 
 #include <llvm/IR/Value.h>
 #include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -86,6 +87,14 @@ struct ColumnsForDevice {
                      const std::vector<InnerOuter> inner_outer_pairs);
 };
 
+// One partition of the build side of an inner join which is executed in partitions,
+// see PartitionedHashJoin.h. The join is identified by its inner table's rte index.
+struct HashJoinPartition {
+  int inner_rte_idx;
+  size_t partition_count;
+  size_t partition_idx;
+};
+
 struct HashJoinMatchingSet {
   llvm::Value* elements;
   llvm::Value* count;
@@ -96,6 +105,8 @@ struct CompositeKeyInfo {
   std::vector<const void*> sd_inner_proxy_per_key;
   std::vector<const void*> sd_outer_proxy_per_key;
   std::vector<ChunkKey> cache_key_chunks;  // used for the cache key
+  // fetched by the CPU builds, null for the keys translated one string at a time
+  std::vector<const std::vector<int32_t>*> sd_translation_map_per_key;
 };
 
 class DeviceAllocator;
@@ -146,6 +157,15 @@ class HashJoin {
 
   static llvm::Value* codegenHashTableLoad(const size_t table_idx, Executor* executor);
 
+  //! Emits a call to `fname`, one of the prefetch_*hash_join_slots runtime functions,
+  //! with `slot_args` if the outer key of the probe can be read ahead of the current row.
+  static void codegenProbePrefetch(const std::string& fname,
+                                   const Analyzer::Expr* key_col,
+                                   const size_t hash_table_bytes,
+                                   const std::vector<llvm::Value*>& slot_args,
+                                   const CompilationOptions& co,
+                                   Executor* executor);
+
   virtual Data_Namespace::MemoryLevel getMemoryLevel() const noexcept = 0;
 
   virtual int getDeviceCount() const noexcept = 0;
@@ -264,6 +284,11 @@ class HashJoin {
       const std::vector<InnerOuter>& inner_outer_pairs,
       const Executor* executor);
 
+  // The partition of the executor's partitioned hash join if the qualifier is its join.
+  static std::optional<HashJoinPartition> getPartitionForQual(
+      const std::shared_ptr<Analyzer::BinOper>& qual_bin_oper,
+      const Executor* executor);
+
  protected:
   virtual size_t getComponentBufferSize() const noexcept = 0;
 
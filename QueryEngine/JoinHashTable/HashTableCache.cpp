@@ -0,0 +1,102 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/HashTableCache.h"
+
+#include <algorithm>
+
+extern size_t g_join_hash_table_cache_max_size;
+
+HashTableCacheBudget::EntryId HashTableCacheBudget::nextEntryId() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return next_entry_id_++;
+}
+
+HashTableCacheBudget::Victims HashTableCacheBudget::track(HashTableCacheBase* cache,
+                                                          const EntryId id,
+                                                          const size_t size_bytes,
+                                                          const double build_cost_ms) {
+  CHECK(cache);
+  CHECK_GT(size_bytes, size_t(0));
+  // read on every call since the caches are created before the flags are parsed
+  const size_t max_size_bytes = g_join_hash_table_cache_max_size;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.max_size_bytes = max_size_bytes;
+  if (size_bytes > max_size_bytes) {
+    stats_.evictions++;
+    return {{cache, id}};
+  }
+  // builds faster than the timer resolution still cost something
+  const double credit = std::max(build_cost_ms, 1.0) / size_bytes;
+  auto& entry = tracked_[id];
+  entry = TrackedEntry{cache, size_bytes, credit, 0};
+  setPriority(id, entry);
+  stats_.num_entries++;
+  stats_.total_size_bytes += size_bytes;
+
+  Victims victims;
+  while (stats_.total_size_bytes > max_size_bytes) {
+    CHECK(!queue_.empty());
+    const auto [priority, victim_id] = *queue_.begin();
+    auto victim_it = tracked_.find(victim_id);
+    CHECK(victim_it != tracked_.end());
+    inflation_ = priority;
+    victims.emplace_back(victim_it->second.cache, victim_id);
+    stats_.num_entries--;
+    stats_.total_size_bytes -= victim_it->second.size_bytes;
+    stats_.evictions++;
+    queue_.erase(queue_.begin());
+    tracked_.erase(victim_it);
+  }
+  return victims;
+}
+
+void HashTableCacheBudget::touch(const EntryId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tracked_.find(id);
+  if (it == tracked_.end()) {
+    return;
+  }
+  queue_.erase({it->second.priority, id});
+  setPriority(id, it->second);
+}
+
+void HashTableCacheBudget::untrack(const EntryId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tracked_.find(id);
+  if (it == tracked_.end()) {
+    return;
+  }
+  queue_.erase({it->second.priority, id});
+  stats_.num_entries--;
+  stats_.total_size_bytes -= it->second.size_bytes;
+  tracked_.erase(it);
+}
+
+HashTableCacheBudget::Stats HashTableCacheBudget::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+HashTableCacheBudget& HashTableCacheBudget::getInstance() {
+  static HashTableCacheBudget instance;
+  return instance;
+}
+
+void HashTableCacheBudget::setPriority(const EntryId id, TrackedEntry& entry) {
+  entry.priority = inflation_ + entry.credit;
+  queue_.emplace(entry.priority, id);
+}
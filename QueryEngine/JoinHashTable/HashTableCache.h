@@ -16,29 +16,130 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <list>
 #include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Logger/Logger.h"
 
+class HashTableCacheBase {
+ public:
+  using EntryId = uint64_t;
+
+  virtual ~HashTableCacheBase() {}
+
+  // Drops the given entry if it is still cached, called by the budget on eviction.
+  virtual void evict(const EntryId id) = 0;
+};
+
+/**
+ * Byte budget shared by all join hash table caches, bounded by
+ * g_join_hash_table_cache_max_size.
+ *
+ * Eviction follows GreedyDual-Size: an entry is worth L + build cost / size, where L is
+ * the worth of the last evicted entry. Cheap to rebuild, large hash tables go first and
+ * entries which are not hit age out as L grows. Hits refresh the worth of an entry.
+ *
+ * The budget never calls into a cache while holding its own lock. Instead, track()
+ * returns the entries to evict and the caller evicts them once it released its lock.
+ */
+class HashTableCacheBudget {
+ public:
+  using EntryId = HashTableCacheBase::EntryId;
+  using Victims = std::vector<std::pair<HashTableCacheBase*, EntryId>>;
+
+  struct Stats {
+    size_t num_entries{0};
+    size_t total_size_bytes{0};
+    size_t max_size_bytes{0};
+    size_t evictions{0};
+  };
+
+  EntryId nextEntryId();
+
+  // Starts accounting for a cached hash table. Returns the entries which have to be
+  // evicted to stay within the budget, possibly including the new entry itself.
+  Victims track(HashTableCacheBase* cache,
+                const EntryId id,
+                const size_t size_bytes,
+                const double build_cost_ms);
+
+  void touch(const EntryId id);
+
+  void untrack(const EntryId id);
+
+  Stats getStats() const;
+
+  static HashTableCacheBudget& getInstance();
+
+ private:
+  struct TrackedEntry {
+    HashTableCacheBase* cache;
+    size_t size_bytes;
+    double credit;
+    double priority;
+  };
+
+  void setPriority(const EntryId id, TrackedEntry& entry);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<EntryId, TrackedEntry> tracked_;
+  std::set<std::pair<double, EntryId>> queue_;  // lowest priority first
+  double inflation_{0};
+  EntryId next_entry_id_{0};
+  Stats stats_;
+};
+
+/**
+ * Cache of join hash tables (or auxiliary data for building them). Keys provide hash()
+ * and referencesTable(db_id, table_id); equal keys must hash to the same value.
+ *
+ * Entries inserted with a non-zero size are accounted for in the shared
+ * HashTableCacheBudget and may be evicted at any time.
+ */
 template <class K, class V>
-class HashTableCache {
+class HashTableCache : public HashTableCacheBase {
  public:
-  HashTableCache() {}
+  HashTableCache() : budget_(HashTableCacheBudget::getInstance()) {}
+
+  ~HashTableCache() override { clear(); }
 
   std::function<void()> getCacheInvalidator() {
     return [this]() -> void {
       std::lock_guard<std::mutex> guard(mutex_);
       VLOG(1) << "Invalidating " << contents_.size() << " cached hash tables.";
-      contents_.clear();
+      clearImpl();
+    };
+  }
+
+  std::function<void(const int, const int)> getTableCacheInvalidator() {
+    return [this](const int db_id, const int table_id) -> void {
+      std::lock_guard<std::mutex> guard(mutex_);
+      size_t num_invalidated{0};
+      for (auto it = contents_.begin(); it != contents_.end();) {
+        if (it->key.referencesTable(db_id, table_id)) {
+          it = erase(it);
+          num_invalidated++;
+        } else {
+          ++it;
+        }
+      }
+      VLOG(1) << "Invalidating " << num_invalidated << " cached hash tables of table "
+              << table_id << ".";
     };
   }
 
   V getCachedHashTable(const size_t idx) {
     std::lock_guard<std::mutex> guard(mutex_);
     CHECK_LT(idx, contents_.size());
-    return contents_.at(idx).second;
+    return std::next(contents_.begin(), idx)->value;
   }
 
   size_t getNumberOfCachedHashTables() {
@@ -48,33 +149,102 @@ class HashTableCache {
 
   void clear() {
     std::lock_guard<std::mutex> guard(mutex_);
-    contents_.clear();
+    clearImpl();
   }
 
-  void insert(const K& key, V& hash_table) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    for (auto& kv : contents_) {
-      if (kv.first == key) {
-        auto& cached_hash_table = kv.second;
-        cached_hash_table = hash_table;
-        return;
+  // Replaces the entry for an equal key, if any. The size and build cost of the hash
+  // table drive its eviction, a size of zero exempts the entry from the budget.
+  void insert(const K& key,
+              V& hash_table,
+              const size_t size_bytes = 0,
+              const double build_cost_ms = 0) {
+    HashTableCacheBudget::Victims victims;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto it = find(key);
+      if (it != contents_.end()) {
+        erase(it);
+      }
+      const auto id = budget_.nextEntryId();
+      contents_.push_back(Entry{key, hash_table, id});
+      const auto entry_it = std::prev(contents_.end());
+      index_.emplace(key.hash(), entry_it);
+      ids_.emplace(id, entry_it);
+      if (size_bytes) {
+        victims = budget_.track(this, id, size_bytes, build_cost_ms);
       }
     }
-    contents_.emplace_back(key, hash_table);
+    for (const auto& [cache, id] : victims) {
+      cache->evict(id);
+    }
   }
 
   // makes a copy
   std::optional<V> get(const K& key) {
     std::lock_guard<std::mutex> guard(mutex_);
-    for (const auto& kv : contents_) {
-      if (kv.first == key) {
-        return kv.second;
-      }
+    auto it = find(key);
+    if (it == contents_.end()) {
+      return std::nullopt;
+    }
+    budget_.touch(it->id);
+    return it->value;
+  }
+
+  void evict(const EntryId id) override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = ids_.find(id);
+    if (it != ids_.end()) {
+      VLOG(1) << "Evicting cached hash table to stay within the cache budget.";
+      erase(it->second);
     }
-    return std::nullopt;
   }
 
  protected:
-  std::vector<std::pair<K, V>> contents_;
+  struct Entry {
+    K key;
+    V value;
+    EntryId id;
+  };
+  using EntryList = std::list<Entry>;
+
+  // the caller must hold mutex_
+  typename EntryList::iterator find(const K& key) {
+    const auto range = index_.equal_range(key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->key == key) {
+        return it->second;
+      }
+    }
+    return contents_.end();
+  }
+
+  // the caller must hold mutex_
+  typename EntryList::iterator erase(typename EntryList::iterator entry_it) {
+    const auto range = index_.equal_range(entry_it->key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == entry_it) {
+        index_.erase(it);
+        break;
+      }
+    }
+    ids_.erase(entry_it->id);
+    budget_.untrack(entry_it->id);
+    return contents_.erase(entry_it);
+  }
+
+  // the caller must hold mutex_
+  void clearImpl() {
+    for (const auto& entry : contents_) {
+      budget_.untrack(entry.id);
+    }
+    contents_.clear();
+    index_.clear();
+    ids_.clear();
+  }
+
+  EntryList contents_;  // in insertion order
+  std::unordered_multimap<size_t, typename EntryList::iterator> index_;
+  std::unordered_map<EntryId, typename EntryList::iterator> ids_;
   std::mutex mutex_;
+  HashTableCacheBudget& budget_;
 };
@@ -1240,6 +1240,7 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
                          &join_columns[0],
                          join_bucket_info[0].inverse_bucket_sizes_for_dimension.data());
   const auto catalog = executor_->getCatalog();
+  const auto build_clock = timer_start();
   BaselineJoinHashTableBuilder builder(catalog);
   const auto err = builder.initHashTableOnCpu(&key_handler,
                                               composite_key_info,
@@ -1258,11 +1259,12 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
         std::to_string(err) + std::string(")"));
   }
   std::shared_ptr<BaselineHashTable> hash_table = builder.getHashTable();
+  const auto build_cost_ms = timer_stop(build_clock);
   if (HashJoin::getInnerTableId(inner_outer_pairs_) > 0) {
     if (skip_hashtable_caching) {
       VLOG(1) << "Skip to cache overlaps join hashtable";
     } else {
-      putHashTableOnCpuToCache(cache_key, hash_table);
+      putHashTableOnCpuToCache(cache_key, hash_table, build_cost_ms);
     }
   }
   return hash_table;
@@ -1750,7 +1752,8 @@ OverlapsJoinHashTable::getApproximateTupleCountFromCache(
 
 void OverlapsJoinHashTable::putHashTableOnCpuToCache(
     const OverlapsHashTableCacheKey& key,
-    std::shared_ptr<HashTable> hash_table) {
+    std::shared_ptr<HashTable> hash_table,
+    const double build_cost_ms) {
   for (auto chunk_key : key.chunk_keys) {
     CHECK_GE(chunk_key.size(), size_t(2));
     if (chunk_key[1] < 0) {
@@ -1758,5 +1761,9 @@ void OverlapsJoinHashTable::putHashTableOnCpuToCache(
     }
   }
   CHECK(hash_table_cache_);
-  hash_table_cache_->insert(key, hash_table);
+  CHECK(hash_table);
+  hash_table_cache_->insert(key,
+                            hash_table,
+                            hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU),
+                            build_cost_ms);
 }
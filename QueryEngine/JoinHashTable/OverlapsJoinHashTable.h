@@ -44,6 +44,24 @@ struct OverlapsHashTableCacheKey {
            bucket_threshold == that.bucket_threshold;
   }
 
+  // bucket sizes are compared approximately and therefore not hashed
+  size_t hash() const {
+    size_t seed = boost::hash_value(chunk_keys);
+    boost::hash_combine(seed, num_elements);
+    boost::hash_combine(seed, static_cast<int>(optype));
+    boost::hash_combine(seed, max_hashtable_size);
+    boost::hash_combine(seed, bucket_threshold);
+    return seed;
+  }
+
+  bool referencesTable(const int db_id, const int table_id) const {
+    return std::any_of(
+        chunk_keys.begin(), chunk_keys.end(), [db_id, table_id](const ChunkKey& key) {
+          CHECK_GE(key.size(), size_t(2));
+          return key[CHUNK_KEY_DB_IDX] == db_id && key[CHUNK_KEY_TABLE_IDX] == table_id;
+        });
+  }
+
   OverlapsHashTableCacheKey(const size_t num_elements,
                             const std::vector<ChunkKey>& chunk_keys,
                             const SQLOps& optype,
@@ -75,12 +93,12 @@ class OverlapsHashTableCache : public HashTableCache<K, V> {
  public:
   std::optional<std::pair<K, V>> getWithKey(const K& key) {
     std::lock_guard<std::mutex> guard(this->mutex_);
-    for (const auto& kv : this->contents_) {
-      if (kv.first == key) {
-        return kv;
-      }
+    auto it = this->find(key);
+    if (it == this->contents_.end()) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    this->budget_.touch(it->id);
+    return std::make_pair(it->key, it->value);
   }
 };
 
@@ -132,6 +150,16 @@ class OverlapsJoinHashTable : public HashJoin {
     };
   }
 
+  static auto getTableCacheInvalidator() -> std::function<void(const int, const int)> {
+    return [](const int db_id, const int table_id) -> void {
+      CHECK(auto_tuner_cache_);
+      auto_tuner_cache_->getTableCacheInvalidator()(db_id, table_id);
+
+      CHECK(hash_table_cache_);
+      hash_table_cache_->getTableCacheInvalidator()(db_id, table_id);
+    };
+  }
+
   static size_t getCombinedHashTableCacheSize() {
     // for unit tests
     CHECK(hash_table_cache_ && auto_tuner_cache_);
@@ -338,7 +366,8 @@ class OverlapsJoinHashTable : public HashJoin {
       const OverlapsHashTableCacheKey&);
 
   void putHashTableOnCpuToCache(const OverlapsHashTableCacheKey& key,
-                                std::shared_ptr<HashTable> hash_table);
+                                std::shared_ptr<HashTable> hash_table,
+                                const double build_cost_ms);
 
   llvm::Value* codegenKey(const CompilationOptions&);
   std::vector<llvm::Value*> codegenManyKey(const CompilationOptions&);
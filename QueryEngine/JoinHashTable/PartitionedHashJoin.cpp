@@ -0,0 +1,117 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/PartitionedHashJoin.h"
+
+#include "QueryEngine/Execute.h"
+
+#include <algorithm>
+
+bool g_enable_partitioned_hash_join{true};
+// build side rows per partition, the most a keyed hash table takes at its 50% fill rate
+size_t g_hash_join_partition_size{(1UL << 30) - 1};
+
+namespace {
+
+// every partition is a pass over the probe side
+constexpr size_t kMaxPartitionCount{1024};
+
+bool is_column(const Analyzer::Expr* expr, const Analyzer::Expr* join_col) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  const auto join_col_var = dynamic_cast<const Analyzer::ColumnVar*>(join_col);
+  return col_var && join_col_var &&
+         col_var->get_table_id() == join_col_var->get_table_id() &&
+         col_var->get_column_id() == join_col_var->get_column_id() &&
+         col_var->get_rte_idx() == join_col_var->get_rte_idx();
+}
+
+// Whether the results of the partitions can be concatenated.
+bool has_disjoint_partition_results(const RelAlgExecutionUnit& ra_exe_unit,
+                                    const bool is_agg,
+                                    const InnerOuter& join_key) {
+  if (ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front()) {
+    // aggregates of the partitions would have to be reduced
+    return !is_agg;
+  }
+  return std::any_of(ra_exe_unit.groupby_exprs.begin(),
+                     ra_exe_unit.groupby_exprs.end(),
+                     [&join_key](const std::shared_ptr<Analyzer::Expr>& groupby_expr) {
+                       return is_column(groupby_expr.get(), join_key.first) ||
+                              is_column(groupby_expr.get(), join_key.second);
+                     });
+}
+
+}  // namespace
+
+std::optional<HashJoinPartition> get_hash_join_partition(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const bool is_agg,
+    const Executor* executor) {
+  CHECK_GT(g_hash_join_partition_size, size_t(0));
+  // partial results of a top n don't add up to the result of the query
+  if (!g_enable_partitioned_hash_join || ra_exe_unit.estimator ||
+      ra_exe_unit.union_all ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::Default) {
+    return std::nullopt;
+  }
+  std::optional<HashJoinPartition> partition;
+  size_t max_inner_row_count{g_hash_join_partition_size};
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (join_condition.type != JoinType::INNER) {
+      continue;
+    }
+    // the hash table of a level is built for its first equijoin qualifier
+    std::shared_ptr<Analyzer::BinOper> qual_bin_oper;
+    for (const auto& join_qual : join_condition.quals) {
+      qual_bin_oper = std::dynamic_pointer_cast<Analyzer::BinOper>(join_qual);
+      if (qual_bin_oper && IS_EQUIVALENCE(qual_bin_oper->get_optype())) {
+        break;
+      }
+      qual_bin_oper.reset();
+    }
+    if (!qual_bin_oper || qual_bin_oper->is_overlaps_oper()) {
+      continue;
+    }
+    std::vector<InnerOuter> inner_outer_pairs;
+    try {
+      inner_outer_pairs = normalize_column_pairs(qual_bin_oper.get(),
+                                                 *executor->getCatalog(),
+                                                 executor->getTemporaryTables());
+    } catch (const std::exception&) {
+      // not a hash join
+      continue;
+    }
+    CHECK(!inner_outer_pairs.empty());
+    const auto inner_rte_idx = inner_outer_pairs.front().first->get_rte_idx();
+    CHECK_LT(static_cast<size_t>(inner_rte_idx), query_infos.size());
+    const auto inner_row_count =
+        query_infos[inner_rte_idx].info.getNumTuplesUpperBound();
+    if (inner_row_count <= max_inner_row_count ||
+        !has_disjoint_partition_results(ra_exe_unit, is_agg, inner_outer_pairs.front())) {
+      continue;
+    }
+    // the largest build side is partitioned, the others are built whole in every pass
+    max_inner_row_count = inner_row_count;
+    size_t partition_count{2};
+    while (partition_count < kMaxPartitionCount &&
+           partition_count * g_hash_join_partition_size < inner_row_count) {
+      partition_count *= 2;
+    }
+    partition = HashJoinPartition{inner_rte_idx, partition_count, 0};
+  }
+  return partition;
+}
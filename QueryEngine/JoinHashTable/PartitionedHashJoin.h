@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PartitionedHashJoin.h
+ * @brief   Partitioned execution of inner joins with more build side rows than fit in a
+ *          hash table.
+ *
+ * The build side is split in partitions on a hash of the first join key component, and
+ * the query runs once per partition with a hash table of only the build rows of that
+ * partition. Every match is found in exactly one pass, so the results of the passes are
+ * concatenated: for projections as is, for group bys when the join key is a group by
+ * key, which makes the groups of different passes disjoint.
+ */
+
+#pragma once
+
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+
+#include <optional>
+
+extern bool g_enable_partitioned_hash_join;
+extern size_t g_hash_join_partition_size;
+
+// The first partition of the inner join to execute in partitions, std::nullopt if no
+// build side is larger than a partition or the query can't run in partitions.
+std::optional<HashJoinPartition> get_hash_join_partition(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const bool is_agg,
+    const Executor* executor);
@@ -509,9 +509,12 @@ int PerfectJoinHashTable::initHashTableForDevice(
     CHECK(!chunk_key.empty());
 
     auto hash_table = initHashTableOnCpuFromCache(chunk_key, join_column.num_elems, cols);
+    const bool is_cached = hash_table != nullptr;
+    int64_t build_cost_ms{0};
     {
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
       if (!hash_table) {
+        const auto build_clock = timer_start();
         PerfectJoinHashTableBuilder builder(executor_->catalog_);
         if (layout == HashType::OneToOne) {
           builder.initOneToOneHashTableOnCpu(join_column,
@@ -534,6 +537,7 @@ int PerfectJoinHashTable::initHashTableForDevice(
                                               executor_);
           hash_table = builder.getHashTable();
         }
+        build_cost_ms = timer_stop(build_clock);
       } else {
         if (layout == HashType::OneToOne &&
             hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) >
@@ -544,8 +548,9 @@ int PerfectJoinHashTable::initHashTableForDevice(
         }
       }
     }
-    if (inner_col->get_table_id() > 0) {
-      putHashTableOnCpuToCache(chunk_key, join_column.num_elems, hash_table, cols);
+    if (!is_cached && inner_col->get_table_id() > 0) {
+      putHashTableOnCpuToCache(
+          chunk_key, join_column.num_elems, hash_table, cols, build_cost_ms);
     }
     // Transfer the hash table on the GPU if we've only built it on CPU
     // but the query runs on GPU (join on dictionary encoded columns).
@@ -668,7 +673,8 @@ std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::initHashTableOnCpuFromCa
 void PerfectJoinHashTable::putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                                     const size_t num_elements,
                                                     HashTableCacheValue hash_table,
-                                                    const InnerOuter& cols) {
+                                                    const InnerOuter& cols,
+                                                    const double build_cost_ms) {
   CHECK_GE(chunk_key.size(), size_t(2));
   if (chunk_key[1] < 0) {
     // Do not cache hash tables over intermediate results
@@ -684,7 +690,10 @@ void PerfectJoinHashTable::putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                   join_type_};
   CHECK(hash_table_cache_);
   CHECK(hash_table && !hash_table->getGpuBuffer());
-  hash_table_cache_->insert(cache_key, hash_table);
+  hash_table_cache_->insert(cache_key,
+                            hash_table,
+                            hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU),
+                            build_cost_ms);
 }
 
 llvm::Value* PerfectJoinHashTable::codegenHashTableLoad(const size_t table_idx) {
@@ -717,6 +726,15 @@ std::vector<llvm::Value*> PerfectJoinHashTable::getHashJoinArgs(
       executor_->cgen_state_->castToTypeIn(key_lvs.front(), 64),
       executor_->cgen_state_->llInt(col_range_.getIntMin()),
       executor_->cgen_state_->llInt(col_range_.getIntMax())};
+  if (!shard_count && key_col_ti.get_type() != kDATE) {
+    HashJoin::codegenProbePrefetch(
+        "prefetch_hash_join_slots",
+        key_col,
+        hash_entry_info.getNormalizedHashEntryCount() * sizeof(int32_t),
+        {hash_ptr, hash_join_idx_args[2], hash_join_idx_args[3]},
+        co,
+        executor_);
+  }
   if (shard_count) {
     const auto expected_hash_entry_count =
         get_hash_entry_count(col_range_, isBitwiseEq());
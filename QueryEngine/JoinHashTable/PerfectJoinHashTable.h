@@ -35,6 +35,7 @@
 #include "QueryEngine/JoinHashTable/HashTableCache.h"
 #include "QueryEngine/JoinHashTable/PerfectHashTable.h"
 
+#include <boost/functional/hash.hpp>
 #include <llvm/IR/Value.h>
 
 #ifdef HAVE_CUDA
@@ -105,6 +106,11 @@ class PerfectJoinHashTable : public HashJoin {
     return hash_table_cache_->getCacheInvalidator();
   }
 
+  static auto getTableCacheInvalidator() -> std::function<void(const int, const int)> {
+    CHECK(hash_table_cache_);
+    return hash_table_cache_->getTableCacheInvalidator();
+  }
+
   virtual ~PerfectJoinHashTable() {}
 
  private:
@@ -170,7 +176,8 @@ class PerfectJoinHashTable : public HashJoin {
   void putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                 const size_t num_elements,
                                 HashTableCacheValue hash_table,
-                                const InnerOuter& cols);
+                                const InnerOuter& cols,
+                                const double build_cost_ms);
 
   const InputTableInfo& getInnerQueryInfo(const Analyzer::ColumnVar* inner_col) const;
 
@@ -217,6 +224,25 @@ class PerfectJoinHashTable : public HashJoin {
              chunk_key == that.chunk_key && optype == that.optype &&
              join_type == that.join_type;
     }
+
+    size_t hash() const {
+      size_t seed = boost::hash_value(chunk_key);
+      boost::hash_combine(seed, outer_col.get_table_id());
+      boost::hash_combine(seed, outer_col.get_column_id());
+      boost::hash_combine(seed, num_elements);
+      boost::hash_combine(seed, static_cast<int>(optype));
+      boost::hash_combine(seed, static_cast<int>(join_type));
+      return seed;
+    }
+
+    // the outer table matters as well when the inner keys were translated to the
+    // dictionary of the outer column
+    bool referencesTable(const int db_id, const int table_id) const {
+      CHECK_GE(chunk_key.size(), size_t(2));
+      return chunk_key[CHUNK_KEY_DB_IDX] == db_id &&
+             (chunk_key[CHUNK_KEY_TABLE_IDX] == table_id ||
+              outer_col.get_table_id() == table_id);
+    }
   };
 
   static std::unique_ptr<HashTableCache<JoinHashTableCacheKey, HashTableCacheValue>>
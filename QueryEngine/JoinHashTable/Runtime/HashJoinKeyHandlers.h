@@ -42,7 +42,8 @@ struct GenericKeyHandler {
 #ifndef __CUDACC__
                     ,
                     const void* const* sd_inner_proxy_per_key,
-                    const void* const* sd_outer_proxy_per_key
+                    const void* const* sd_outer_proxy_per_key,
+                    const std::vector<int32_t>* const* sd_translation_map_per_key
 #endif
                     )
       : key_component_count_(key_component_count)
@@ -54,11 +55,13 @@ struct GenericKeyHandler {
       CHECK(sd_outer_proxy_per_key);
       sd_inner_proxy_per_key_ = sd_inner_proxy_per_key;
       sd_outer_proxy_per_key_ = sd_outer_proxy_per_key;
+      sd_translation_map_per_key_ = sd_translation_map_per_key;
     } else
 #endif
     {
       sd_inner_proxy_per_key_ = nullptr;
       sd_outer_proxy_per_key_ = nullptr;
+      sd_translation_map_per_key_ = nullptr;
     }
   }
 
@@ -83,14 +86,17 @@ struct GenericKeyHandler {
       const auto sd_outer_proxy = sd_outer_proxy_per_key_
                                       ? sd_outer_proxy_per_key_[key_component_index]
                                       : nullptr;
+      const auto sd_translation_map =
+          sd_translation_map_per_key_ ? sd_translation_map_per_key_[key_component_index]
+                                      : nullptr;
       if (sd_inner_proxy && elem != join_column_iterator.type_info->null_val) {
         CHECK(sd_outer_proxy);
         const auto sd_inner_dict_proxy =
             static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
         const auto sd_outer_dict_proxy =
             static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-        const auto elem_str = sd_inner_dict_proxy->getString(elem);
-        const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+        const auto outer_id = sd_inner_dict_proxy->translateStringId(
+            elem, sd_outer_dict_proxy, sd_translation_map);
         if (outer_id == StringDictionary::INVALID_STR_ID) {
           skip_entry = true;
           break;
@@ -98,6 +104,16 @@ struct GenericKeyHandler {
         elem = outer_id;
       }
 #endif
+      // the first key component decides the partition of the entry, after translation
+      // to the dictionary of the outer column it's probed with
+      if (key_component_index == 0 &&
+          join_column_iterator.type_info->partition_count > 1 &&
+          get_hash_join_key_partition(elem,
+                                      join_column_iterator.type_info->partition_count) !=
+              join_column_iterator.type_info->partition_idx) {
+        skip_entry = true;
+        break;
+      }
       key_scratch_buff[key_component_index] = elem;
     }
 
@@ -124,6 +140,8 @@ struct GenericKeyHandler {
   const JoinColumnTypeInfo* type_info_per_key_;
   const void* const* sd_inner_proxy_per_key_;
   const void* const* sd_outer_proxy_per_key_;
+  // fetched before the build, null for the keys translated one string at a time
+  const std::vector<int32_t>* const* sd_translation_map_per_key_;
 };
 
 struct OverlapsKeyHandler {
@@ -34,6 +34,7 @@
 #include "StringDictionary/StringDictionary.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <atomic>
 #include <future>
 #endif
 
@@ -68,18 +69,20 @@ namespace {
  * ignore any element ID that is not in the dictionary corresponding to t1_s.x or is
  * outside the range of column t1_s.
  */
-inline int64_t translate_str_id_to_outer_dict(const int64_t elem,
-                                              const int64_t min_elem,
-                                              const int64_t max_elem,
-                                              const void* sd_inner_proxy,
-                                              const void* sd_outer_proxy) {
+inline int64_t translate_str_id_to_outer_dict(
+    const int64_t elem,
+    const int64_t min_elem,
+    const int64_t max_elem,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map) {
   CHECK(sd_outer_proxy);
   const auto sd_inner_dict_proxy =
       static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
   const auto sd_outer_dict_proxy =
       static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-  const auto elem_str = sd_inner_dict_proxy->getString(elem);
-  const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+  const auto outer_id = sd_inner_dict_proxy->translateStringId(
+      elem, sd_outer_dict_proxy, sd_translation_map);
   if (outer_id > max_elem || outer_id < min_elem) {
     return StringDictionary::INVALID_STR_ID;
   }
@@ -124,6 +127,7 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
                                      const JoinColumnTypeInfo type_info,
                                      const void* sd_inner_proxy,
                                      const void* sd_outer_proxy,
+                                     const std::vector<int32_t>* sd_translation_map,
                                      const int32_t cpu_thread_idx,
                                      const int32_t cpu_thread_count,
                                      HASHTABLE_FILLING_FUNC filling_func) {
@@ -148,8 +152,12 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -165,16 +173,18 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
   return 0;
 };
 
-DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(int32_t* buff,
-                                                  const int32_t invalid_slot_val,
-                                                  const bool for_semi_join,
-                                                  const JoinColumn join_column,
-                                                  const JoinColumnTypeInfo type_info,
-                                                  const void* sd_inner_proxy,
-                                                  const void* sd_outer_proxy,
-                                                  const int32_t cpu_thread_idx,
-                                                  const int32_t cpu_thread_count,
-                                                  const int64_t bucket_normalization) {
+DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(
+    int32_t* buff,
+    const int32_t invalid_slot_val,
+    const bool for_semi_join,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count,
+    const int64_t bucket_normalization) {
   auto filling_func = for_semi_join ? SUFFIX(fill_hashtable_for_semi_join)
                                     : SUFFIX(fill_one_to_one_hashtable);
   auto hashtable_filling_func = [&](auto elem, size_t index) {
@@ -189,6 +199,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(int32_t* buff,
                                   type_info,
                                   sd_inner_proxy,
                                   sd_outer_proxy,
+                                  sd_translation_map,
                                   cpu_thread_idx,
                                   cpu_thread_count,
                                   hashtable_filling_func);
@@ -201,6 +212,7 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                        const JoinColumnTypeInfo type_info,
                                        const void* sd_inner_proxy,
                                        const void* sd_outer_proxy,
+                                       const std::vector<int32_t>* sd_translation_map,
                                        const int32_t cpu_thread_idx,
                                        const int32_t cpu_thread_count) {
   auto filling_func = for_semi_join ? SUFFIX(fill_hashtable_for_semi_join)
@@ -216,22 +228,25 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                   type_info,
                                   sd_inner_proxy,
                                   sd_outer_proxy,
+                                  sd_translation_map,
                                   cpu_thread_idx,
                                   cpu_thread_count,
                                   hashtable_filling_func);
 }
 
 template <typename HASHTABLE_FILLING_FUNC>
-DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
-                                            const int32_t invalid_slot_val,
-                                            const JoinColumn join_column,
-                                            const JoinColumnTypeInfo type_info,
-                                            const ShardInfo shard_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
-                                            const int32_t cpu_thread_idx,
-                                            const int32_t cpu_thread_count,
-                                            HASHTABLE_FILLING_FUNC filling_func) {
+DEVICE int fill_hash_join_buff_sharded_impl(
+    int32_t* buff,
+    const int32_t invalid_slot_val,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const ShardInfo shard_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count,
+    HASHTABLE_FILLING_FUNC filling_func) {
 #ifdef __CUDACC__
   int32_t start = threadIdx.x + blockDim.x * blockIdx.x;
   int32_t step = blockDim.x * gridDim.x;
@@ -257,8 +272,12 @@ DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -283,6 +302,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded_bucketized)(
     const ShardInfo shard_info,
     const void* sd_inner_proxy,
     const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
     const int32_t cpu_thread_idx,
     const int32_t cpu_thread_count,
     const int64_t bucket_normalization) {
@@ -308,21 +328,24 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded_bucketized)(
                                           shard_info,
                                           sd_inner_proxy,
                                           sd_outer_proxy,
+                                          sd_translation_map,
                                           cpu_thread_idx,
                                           cpu_thread_count,
                                           hashtable_filling_func);
 }
 
-DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
-                                               const int32_t invalid_slot_val,
-                                               const bool for_semi_join,
-                                               const JoinColumn join_column,
-                                               const JoinColumnTypeInfo type_info,
-                                               const ShardInfo shard_info,
-                                               const void* sd_inner_proxy,
-                                               const void* sd_outer_proxy,
-                                               const int32_t cpu_thread_idx,
-                                               const int32_t cpu_thread_count) {
+DEVICE int SUFFIX(fill_hash_join_buff_sharded)(
+    int32_t* buff,
+    const int32_t invalid_slot_val,
+    const bool for_semi_join,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const ShardInfo shard_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count) {
   auto filling_func = for_semi_join ? SUFFIX(fill_hashtable_for_semi_join)
                                     : SUFFIX(fill_one_to_one_hashtable);
   auto hashtable_filling_func = [&](auto elem, auto shard, size_t index) {
@@ -343,6 +366,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
                                           shard_info,
                                           sd_inner_proxy,
                                           sd_outer_proxy,
+                                          sd_translation_map,
                                           cpu_thread_idx,
                                           cpu_thread_count,
                                           hashtable_filling_func);
@@ -631,6 +655,7 @@ DEVICE void count_matches_impl(int32_t* count_buff,
                                ,
                                const void* sd_inner_proxy,
                                const void* sd_outer_proxy,
+                               const std::vector<int32_t>* sd_translation_map,
                                const int32_t cpu_thread_idx,
                                const int32_t cpu_thread_count
 #endif
@@ -656,8 +681,12 @@ DEVICE void count_matches_impl(int32_t* count_buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -679,6 +708,7 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                                   ,
                                   const void* sd_inner_proxy,
                                   const void* sd_outer_proxy,
+                                  const std::vector<int32_t>* sd_translation_map,
                                   const int32_t cpu_thread_idx,
                                   const int32_t cpu_thread_count
 #endif
@@ -694,6 +724,7 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                      ,
                      sd_inner_proxy,
                      sd_outer_proxy,
+                     sd_translation_map,
                      cpu_thread_idx,
                      cpu_thread_count
 #endif
@@ -701,19 +732,21 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                      slot_sel);
 }
 
-GLOBAL void SUFFIX(count_matches_bucketized)(int32_t* count_buff,
-                                             const int32_t invalid_slot_val,
-                                             const JoinColumn join_column,
-                                             const JoinColumnTypeInfo type_info
+GLOBAL void SUFFIX(count_matches_bucketized)(
+    int32_t* count_buff,
+    const int32_t invalid_slot_val,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
-                                             ,
-                                             const void* sd_inner_proxy,
-                                             const void* sd_outer_proxy,
-                                             const int32_t cpu_thread_idx,
-                                             const int32_t cpu_thread_count
+    ,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count
 #endif
-                                             ,
-                                             const int64_t bucket_normalization) {
+    ,
+    const int64_t bucket_normalization) {
   auto slot_sel = [bucket_normalization, &type_info](auto count_buff, auto elem) {
     return SUFFIX(get_bucketized_hash_slot)(
         count_buff, elem, type_info.min_val, bucket_normalization);
@@ -726,6 +759,7 @@ GLOBAL void SUFFIX(count_matches_bucketized)(int32_t* count_buff,
                      ,
                      sd_inner_proxy,
                      sd_outer_proxy,
+                     sd_translation_map,
                      cpu_thread_idx,
                      cpu_thread_count
 #endif
@@ -742,6 +776,7 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
                                           ,
                                           const void* sd_inner_proxy,
                                           const void* sd_outer_proxy,
+                                          const std::vector<int32_t>* sd_translation_map,
                                           const int32_t cpu_thread_idx,
                                           const int32_t cpu_thread_count
 #endif
@@ -766,8 +801,12 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -872,6 +911,7 @@ DEVICE void fill_row_ids_impl(int32_t* buff,
                               ,
                               const void* sd_inner_proxy,
                               const void* sd_outer_proxy,
+                              const std::vector<int32_t>* sd_translation_map,
                               const int32_t cpu_thread_idx,
                               const int32_t cpu_thread_count
 #endif
@@ -902,8 +942,12 @@ DEVICE void fill_row_ids_impl(int32_t* buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -931,6 +975,7 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                                  ,
                                  const void* sd_inner_proxy,
                                  const void* sd_outer_proxy,
+                                 const std::vector<int32_t>* sd_translation_map,
                                  const int32_t cpu_thread_idx,
                                  const int32_t cpu_thread_count
 #endif
@@ -948,6 +993,7 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                     ,
                     sd_inner_proxy,
                     sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -955,20 +1001,22 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                     slot_sel);
 }
 
-GLOBAL void SUFFIX(fill_row_ids_bucketized)(int32_t* buff,
-                                            const int64_t hash_entry_count,
-                                            const int32_t invalid_slot_val,
-                                            const JoinColumn join_column,
-                                            const JoinColumnTypeInfo type_info
+GLOBAL void SUFFIX(fill_row_ids_bucketized)(
+    int32_t* buff,
+    const int64_t hash_entry_count,
+    const int32_t invalid_slot_val,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
-                                            ,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
-                                            const int32_t cpu_thread_idx,
-                                            const int32_t cpu_thread_count
+    ,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count
 #endif
-                                            ,
-                                            const int64_t bucket_normalization) {
+    ,
+    const int64_t bucket_normalization) {
   auto slot_sel = [&type_info, bucket_normalization](auto pos_buff, auto elem) {
     return SUFFIX(get_bucketized_hash_slot)(
         pos_buff, elem, type_info.min_val, bucket_normalization);
@@ -982,6 +1030,7 @@ GLOBAL void SUFFIX(fill_row_ids_bucketized)(int32_t* buff,
                     ,
                     sd_inner_proxy,
                     sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -1000,6 +1049,7 @@ DEVICE void fill_row_ids_sharded_impl(int32_t* buff,
                                       ,
                                       const void* sd_inner_proxy,
                                       const void* sd_outer_proxy,
+                                      const std::vector<int32_t>* sd_translation_map,
                                       const int32_t cpu_thread_idx,
                                       const int32_t cpu_thread_count
 #endif
@@ -1031,8 +1081,12 @@ DEVICE void fill_row_ids_sharded_impl(int32_t* buff,
 #ifndef __CUDACC__
     if (sd_inner_proxy &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id = translate_str_id_to_outer_dict(elem,
+                                                           type_info.min_val,
+                                                           type_info.max_val,
+                                                           sd_inner_proxy,
+                                                           sd_outer_proxy,
+                                                           sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -1061,6 +1115,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                                          ,
                                          const void* sd_inner_proxy,
                                          const void* sd_outer_proxy,
+                                         const std::vector<int32_t>* sd_translation_map,
                                          const int32_t cpu_thread_idx,
                                          const int32_t cpu_thread_count
 #endif
@@ -1083,6 +1138,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                     ,
                     sd_inner_proxy,
                     sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -1090,21 +1146,23 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                     slot_sel);
 }
 
-GLOBAL void SUFFIX(fill_row_ids_sharded_bucketized)(int32_t* buff,
-                                                    const int64_t hash_entry_count,
-                                                    const int32_t invalid_slot_val,
-                                                    const JoinColumn join_column,
-                                                    const JoinColumnTypeInfo type_info,
-                                                    const ShardInfo shard_info
+GLOBAL void SUFFIX(fill_row_ids_sharded_bucketized)(
+    int32_t* buff,
+    const int64_t hash_entry_count,
+    const int32_t invalid_slot_val,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const ShardInfo shard_info
 #ifndef __CUDACC__
-                                                    ,
-                                                    const void* sd_inner_proxy,
-                                                    const void* sd_outer_proxy,
-                                                    const int32_t cpu_thread_idx,
-                                                    const int32_t cpu_thread_count
+    ,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int32_t cpu_thread_idx,
+    const int32_t cpu_thread_count
 #endif
-                                                    ,
-                                                    const int64_t bucket_normalization) {
+    ,
+    const int64_t bucket_normalization) {
   auto slot_sel = [&shard_info, &type_info, bucket_normalization](auto pos_buff,
                                                                   auto elem) {
     return SUFFIX(get_bucketized_hash_slot_sharded)(pos_buff,
@@ -1125,6 +1183,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded_bucketized)(int32_t* buff,
                     ,
                     sd_inner_proxy,
                     sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -1390,6 +1449,7 @@ void fill_one_to_many_hash_table_impl(int32_t* buff,
                                       const JoinColumnTypeInfo& type_info,
                                       const void* sd_inner_proxy,
                                       const void* sd_outer_proxy,
+                                      const std::vector<int32_t>* sd_translation_map,
                                       const unsigned cpu_thread_count,
                                       COUNT_MATCHES_LAUNCH_FUNCTOR count_matches_func,
                                       FILL_ROW_IDS_LAUNCH_FUNCTOR fill_row_ids_func) {
@@ -1451,14 +1511,16 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const JoinColumnTypeInfo& type_info,
                                  const void* sd_inner_proxy,
                                  const void* sd_outer_proxy,
+                                 const std::vector<int32_t>* sd_translation_map,
                                  const unsigned cpu_thread_count) {
   auto launch_count_matches = [count_buff = buff + hash_entry_info.hash_entry_count,
                                invalid_slot_val,
                                &join_column,
                                &type_info,
                                sd_inner_proxy,
-                               sd_outer_proxy](auto cpu_thread_idx,
-                                               auto cpu_thread_count) {
+                               sd_outer_proxy,
+                               sd_translation_map](auto cpu_thread_idx,
+                                                   auto cpu_thread_count) {
     SUFFIX(count_matches)
     (count_buff,
      invalid_slot_val,
@@ -1466,6 +1528,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
      type_info,
      sd_inner_proxy,
      sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count);
   };
@@ -1475,8 +1538,9 @@ void fill_one_to_many_hash_table(int32_t* buff,
                               &join_column,
                               &type_info,
                               sd_inner_proxy,
-                              sd_outer_proxy](auto cpu_thread_idx,
-                                              auto cpu_thread_count) {
+                              sd_outer_proxy,
+                              sd_translation_map](auto cpu_thread_idx,
+                                                  auto cpu_thread_count) {
     SUFFIX(fill_row_ids)
     (buff,
      hash_entry_count,
@@ -1485,6 +1549,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
      type_info,
      sd_inner_proxy,
      sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count);
   };
@@ -1496,19 +1561,22 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                    type_info,
                                    sd_inner_proxy,
                                    sd_outer_proxy,
+                                   sd_translation_map,
                                    cpu_thread_count,
                                    launch_count_matches,
                                    launch_fill_row_ids);
 }
 
-void fill_one_to_many_hash_table_bucketized(int32_t* buff,
-                                            const HashEntryInfo hash_entry_info,
-                                            const int32_t invalid_slot_val,
-                                            const JoinColumn& join_column,
-                                            const JoinColumnTypeInfo& type_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
-                                            const unsigned cpu_thread_count) {
+void fill_one_to_many_hash_table_bucketized(
+    int32_t* buff,
+    const HashEntryInfo hash_entry_info,
+    const int32_t invalid_slot_val,
+    const JoinColumn& join_column,
+    const JoinColumnTypeInfo& type_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const unsigned cpu_thread_count) {
   auto bucket_normalization = hash_entry_info.bucket_normalization;
   auto hash_entry_count = hash_entry_info.getNormalizedHashEntryCount();
   auto launch_count_matches = [bucket_normalization,
@@ -1517,8 +1585,9 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                &join_column,
                                &type_info,
                                sd_inner_proxy,
-                               sd_outer_proxy](auto cpu_thread_idx,
-                                               auto cpu_thread_count) {
+                               sd_outer_proxy,
+                               sd_translation_map](auto cpu_thread_idx,
+                                                   auto cpu_thread_count) {
     SUFFIX(count_matches_bucketized)
     (count_buff,
      invalid_slot_val,
@@ -1526,6 +1595,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
      type_info,
      sd_inner_proxy,
      sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count,
      bucket_normalization);
@@ -1537,8 +1607,9 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                               &join_column,
                               &type_info,
                               sd_inner_proxy,
-                              sd_outer_proxy](auto cpu_thread_idx,
-                                              auto cpu_thread_count) {
+                              sd_outer_proxy,
+                              sd_translation_map](auto cpu_thread_idx,
+                                                  auto cpu_thread_count) {
     SUFFIX(fill_row_ids_bucketized)
     (buff,
      hash_entry_count,
@@ -1547,6 +1618,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
      type_info,
      sd_inner_proxy,
      sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count,
      bucket_normalization);
@@ -1559,6 +1631,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                    type_info,
                                    sd_inner_proxy,
                                    sd_outer_proxy,
+                                   sd_translation_map,
                                    cpu_thread_count,
                                    launch_count_matches,
                                    launch_fill_row_ids);
@@ -1574,6 +1647,7 @@ void fill_one_to_many_hash_table_sharded_impl(
     const ShardInfo& shard_info,
     const void* sd_inner_proxy,
     const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
     const unsigned cpu_thread_count,
     COUNT_MATCHES_LAUNCH_FUNCTOR count_matches_launcher,
     FILL_ROW_IDS_LAUNCH_FUNCTOR fill_row_ids_launcher) {
@@ -1632,6 +1706,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          const ShardInfo& shard_info,
                                          const void* sd_inner_proxy,
                                          const void* sd_outer_proxy,
+                                         const std::vector<int32_t>* sd_translation_map,
                                          const unsigned cpu_thread_count) {
   auto launch_count_matches = [count_buff = buff + hash_entry_count,
                                invalid_slot_val,
@@ -1641,7 +1716,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
 #ifndef __CUDACC__
                                ,
                                sd_inner_proxy,
-                               sd_outer_proxy
+                               sd_outer_proxy,
+                               sd_translation_map
 #endif
   ](auto cpu_thread_idx, auto cpu_thread_count) {
     return SUFFIX(count_matches_sharded)(count_buff,
@@ -1653,6 +1729,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          ,
                                          sd_inner_proxy,
                                          sd_outer_proxy,
+                                         sd_translation_map,
                                          cpu_thread_idx,
                                          cpu_thread_count
 #endif
@@ -1668,7 +1745,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
 #ifndef __CUDACC__
                               ,
                               sd_inner_proxy,
-                              sd_outer_proxy
+                              sd_outer_proxy,
+                              sd_translation_map
 #endif
   ](auto cpu_thread_idx, auto cpu_thread_count) {
     return SUFFIX(fill_row_ids_sharded)(buff,
@@ -1681,6 +1759,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                         ,
                                         sd_inner_proxy,
                                         sd_outer_proxy,
+                                        sd_translation_map,
                                         cpu_thread_idx,
                                         cpu_thread_count);
 #endif
@@ -1696,6 +1775,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                            ,
                                            sd_inner_proxy,
                                            sd_outer_proxy,
+                                           sd_translation_map,
                                            cpu_thread_count
 #endif
                                            ,
@@ -1821,6 +1901,263 @@ int overlaps_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                                cpu_thread_count);
 }
 
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern size_t g_hash_join_build_partition_bytes;
+
+size_t get_hash_join_build_partition_count(const size_t hash_table_bytes,
+                                           const size_t scratch_bytes) {
+  // bounds the number of partition buffers of each thread
+  constexpr size_t kMaxPartitionCount{4096};
+  // the rows scattered to the partitions are held on top of the table
+  constexpr size_t kMaxScratchToTableRatio{2};
+  if (!g_enable_radix_partitioned_hash_join_build || !g_hash_join_build_partition_bytes ||
+      hash_table_bytes <= g_hash_join_build_partition_bytes ||
+      scratch_bytes > kMaxScratchToTableRatio * hash_table_bytes) {
+    return 1;
+  }
+  size_t partition_count{2};
+  while (partition_count < kMaxPartitionCount &&
+         partition_count * g_hash_join_build_partition_bytes < hash_table_bytes) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
+namespace {
+
+/**
+ * Fills a hash table in two passes which keep the random writes to it within the cache.
+ * The first pass scatters the rows of each thread to the partition of the table their
+ * slot lies in, a contiguous range of slots of about the partition size in bytes. The
+ * second pass inserts whole partitions per thread. Collisions can still probe into the
+ * next partition, so the slots are written with CAS as in the single pass fill.
+ */
+template <typename ENTRY, typename SCATTER_FUNC, typename INSERT_FUNC>
+int fill_hash_join_buff_partitioned(const size_t partition_count,
+                                    const int32_t cpu_thread_count,
+                                    SCATTER_FUNC scatter,
+                                    INSERT_FUNC insert) {
+  auto run_threads = [cpu_thread_count](auto thread_func) {
+    std::vector<std::future<int>> threads;
+    for (int32_t thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+      threads.emplace_back(std::async(std::launch::async, thread_func, thread_idx));
+    }
+    int err{0};
+    for (auto& thread : threads) {
+      const auto partial_err = thread.get();
+      if (partial_err) {
+        err = partial_err;
+      }
+    }
+    return err;
+  };
+
+  std::vector<std::vector<std::vector<ENTRY>>> partition_buffs(
+      cpu_thread_count, std::vector<std::vector<ENTRY>>(partition_count));
+  const auto err = run_threads([&partition_buffs, &scatter](const int32_t thread_idx) {
+    return scatter(partition_buffs[thread_idx], thread_idx);
+  });
+  if (err) {
+    return err;
+  }
+  std::atomic<size_t> next_partition{0};
+  return run_threads([&partition_buffs, &insert, &next_partition, partition_count](
+                         const int32_t) {
+    for (size_t partition = next_partition++; partition < partition_count;
+         partition = next_partition++) {
+      for (auto& thread_partition_buffs : partition_buffs) {
+        const auto err = insert(thread_partition_buffs[partition]);
+        if (err) {
+          return err;
+        }
+        // the scattered rows take up to twice the memory of the table, free them as we go
+        std::vector<ENTRY>().swap(thread_partition_buffs[partition]);
+      }
+    }
+    return 0;
+  });
+}
+
+// perfect hash tables on CPU have at most INT32_MAX entries
+struct PerfectHashBuildEntry {
+  int32_t slot;
+  int32_t index;
+};
+
+template <typename T>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const int64_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const GenericKeyHandler* f,
+                                             const int32_t cpu_thread_count,
+                                             const size_t partition_count) {
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+  const size_t hash_entry_size =
+      (key_component_count + (with_val_slot ? 1 : 0)) * sizeof(T);
+  const int64_t partition_entry_count =
+      (entry_count + partition_count - 1) / partition_count;
+  // the rows are scattered as their index followed by the key components
+  const size_t row_size = key_component_count + 1;
+  auto scatter = [entry_count,
+                  key_size_in_bytes,
+                  partition_entry_count,
+                  cpu_thread_count,
+                  f](std::vector<std::vector<T>>& partition_buffs,
+                     const int32_t thread_idx) {
+    auto key_buff_handler = [entry_count,
+                             key_size_in_bytes,
+                             partition_entry_count,
+                             &partition_buffs](const int64_t entry_idx,
+                                               const T* key_scratch_buffer,
+                                               const size_t key_component_count) {
+      const uint32_t h =
+          MurmurHash1Impl(key_scratch_buffer, key_size_in_bytes, 0) % entry_count;
+      auto& partition_buff = partition_buffs[h / partition_entry_count];
+      partition_buff.push_back(entry_idx);
+      partition_buff.insert(partition_buff.end(),
+                            key_scratch_buffer,
+                            key_scratch_buffer + key_component_count);
+      return 0;
+    };
+    T key_scratch_buff[g_maximum_conditions_to_coalesce];
+    JoinColumnTuple cols(f->get_number_of_columns(),
+                         f->get_join_columns(),
+                         f->get_join_column_type_infos());
+    for (auto& it : cols.slice(thread_idx, cpu_thread_count)) {
+      const auto err = (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+      if (err) {
+        return err;
+      }
+    }
+    return 0;
+  };
+  auto insert = [hash_buff,
+                 entry_count,
+                 invalid_slot_val,
+                 for_semi_join,
+                 key_component_count,
+                 with_val_slot,
+                 key_size_in_bytes,
+                 hash_entry_size,
+                 row_size](const std::vector<T>& partition_buff) {
+    const auto write_slot = for_semi_join ? write_baseline_hash_slot_for_semi_join<T>
+                                          : write_baseline_hash_slot<T>;
+    for (size_t i = 0; i < partition_buff.size(); i += row_size) {
+      const auto err = write_slot(partition_buff[i],
+                                  hash_buff,
+                                  entry_count,
+                                  &partition_buff[i + 1],
+                                  key_component_count,
+                                  with_val_slot,
+                                  invalid_slot_val,
+                                  key_size_in_bytes,
+                                  hash_entry_size);
+      if (err) {
+        return err;
+      }
+    }
+    return 0;
+  };
+  return fill_hash_join_buff_partitioned<T>(
+      partition_count, cpu_thread_count, scatter, insert);
+}
+
+}  // namespace
+
+int fill_hash_join_buff_bucketized_partitioned(
+    int32_t* buff,
+    const int64_t entry_count,
+    const int32_t invalid_slot_val,
+    const bool for_semi_join,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const int64_t bucket_normalization,
+    const int32_t cpu_thread_count,
+    const size_t partition_count) {
+  const int64_t partition_entry_count =
+      (entry_count + partition_count - 1) / partition_count;
+  auto scatter = [&](std::vector<std::vector<PerfectHashBuildEntry>>& partition_buffs,
+                     const int32_t thread_idx) {
+    auto hashtable_scatter_func = [&](auto elem, size_t index) {
+      const int64_t slot =
+          get_bucketized_hash_slot(buff, elem, type_info.min_val, bucket_normalization) -
+          buff;
+      partition_buffs[slot / partition_entry_count].push_back(
+          {static_cast<int32_t>(slot), static_cast<int32_t>(index)});
+      return 0;
+    };
+    return fill_hash_join_buff_impl(buff,
+                                    invalid_slot_val,
+                                    join_column,
+                                    type_info,
+                                    sd_inner_proxy,
+                                    sd_outer_proxy,
+                                    sd_translation_map,
+                                    thread_idx,
+                                    cpu_thread_count,
+                                    hashtable_scatter_func);
+  };
+  auto filling_func =
+      for_semi_join ? fill_hashtable_for_semi_join : fill_one_to_one_hashtable;
+  auto insert = [buff, invalid_slot_val, filling_func](
+                    const std::vector<PerfectHashBuildEntry>& partition_buff) {
+    for (const auto& entry : partition_buff) {
+      if (filling_func(entry.index, buff + entry.slot, invalid_slot_val)) {
+        return -1;
+      }
+    }
+    return 0;
+  };
+  return fill_hash_join_buff_partitioned<PerfectHashBuildEntry>(
+      partition_count, cpu_thread_count, scatter, insert);
+}
+
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int32_t cpu_thread_count,
+                                                const size_t partition_count) {
+  return fill_baseline_hash_join_buff_partitioned<int32_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           cpu_thread_count,
+                                                           partition_count);
+}
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int32_t cpu_thread_count,
+                                                const size_t partition_count) {
+  return fill_baseline_hash_join_buff_partitioned<int64_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           cpu_thread_count,
+                                                           partition_count);
+}
+
 template <typename T>
 void fill_one_to_many_baseline_hash_table(
     int32_t* buff,
@@ -1833,6 +2170,7 @@ void fill_one_to_many_baseline_hash_table(
     const std::vector<JoinBucketInfo>& join_buckets_per_key,
     const std::vector<const void*>& sd_inner_proxy_per_key,
     const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const std::vector<int32_t>*>& sd_translation_map_per_key,
     const size_t cpu_thread_count) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
@@ -1872,14 +2210,17 @@ void fill_one_to_many_baseline_hash_table(
            &type_info_per_key,
            &sd_inner_proxy_per_key,
            &sd_outer_proxy_per_key,
+           &sd_translation_map_per_key,
            cpu_thread_idx,
            cpu_thread_count] {
-            const auto key_handler = GenericKeyHandler(key_component_count,
-                                                       true,
-                                                       &join_column_per_key[0],
-                                                       &type_info_per_key[0],
-                                                       &sd_inner_proxy_per_key[0],
-                                                       &sd_outer_proxy_per_key[0]);
+            const auto key_handler =
+                GenericKeyHandler(key_component_count,
+                                  true,
+                                  &join_column_per_key[0],
+                                  &type_info_per_key[0],
+                                  &sd_inner_proxy_per_key[0],
+                                  &sd_outer_proxy_per_key[0],
+                                  &sd_translation_map_per_key[0]);
             count_matches_baseline(count_buff,
                                    composite_key_dict,
                                    hash_entry_count,
@@ -1956,6 +2297,7 @@ void fill_one_to_many_baseline_hash_table(
                                           &type_info_per_key,
                                           &sd_inner_proxy_per_key,
                                           &sd_outer_proxy_per_key,
+                                          &sd_translation_map_per_key,
                                           cpu_thread_idx,
                                           cpu_thread_count] {
                                            const auto key_handler = GenericKeyHandler(
@@ -1964,7 +2306,8 @@ void fill_one_to_many_baseline_hash_table(
                                                &join_column_per_key[0],
                                                &type_info_per_key[0],
                                                &sd_inner_proxy_per_key[0],
-                                               &sd_outer_proxy_per_key[0]);
+                                               &sd_outer_proxy_per_key[0],
+                                               &sd_translation_map_per_key[0]);
                                            SUFFIX(fill_row_ids_baseline)
                                            (buff,
                                             composite_key_dict,
@@ -1994,6 +2337,7 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinBucketInfo>& join_bucket_info,
     const std::vector<const void*>& sd_inner_proxy_per_key,
     const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const std::vector<int32_t>*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count) {
   fill_one_to_many_baseline_hash_table<int32_t>(buff,
                                                 composite_key_dict,
@@ -2005,6 +2349,7 @@ void fill_one_to_many_baseline_hash_table_32(
                                                 join_bucket_info,
                                                 sd_inner_proxy_per_key,
                                                 sd_outer_proxy_per_key,
+                                                sd_translation_map_per_key,
                                                 cpu_thread_count);
 }
 
@@ -2019,6 +2364,7 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinBucketInfo>& join_bucket_info,
     const std::vector<const void*>& sd_inner_proxy_per_key,
     const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const std::vector<int32_t>*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count) {
   fill_one_to_many_baseline_hash_table<int64_t>(buff,
                                                 composite_key_dict,
@@ -2030,6 +2376,7 @@ void fill_one_to_many_baseline_hash_table_64(
                                                 join_bucket_info,
                                                 sd_inner_proxy_per_key,
                                                 sd_outer_proxy_per_key,
+                                                sd_translation_map_per_key,
                                                 cpu_thread_count);
 }
 
@@ -2060,6 +2407,7 @@ void approximate_distinct_tuples(uint8_t* hll_buffer_all_cpus,
                                                      &join_column_per_key[0],
                                                      &type_info_per_key[0],
                                                      nullptr,
+                                                     nullptr,
                                                      nullptr);
           approximate_distinct_tuples_impl(hll_buffer,
                                            nullptr,
@@ -97,7 +97,7 @@ void init_baseline_hash_join_buff_on_device_64(int8_t* hash_join_buff,
                                                const bool with_val_slot,
                                                const int32_t invalid_slot_val);
 
-enum ColumnType { SmallDate = 0, Signed = 1, Unsigned = 2, Double = 3 };
+enum ColumnType { SmallDate = 0, Signed = 1, Unsigned = 2, Double = 3, EncodedInt = 4 };
 
 struct JoinChunk {
   const int8_t*
@@ -122,11 +122,23 @@ struct JoinColumnTypeInfo {
   const bool uses_bw_eq;
   const int64_t translated_null_val;
   const ColumnType column_type;
+  // only the keys of one partition are inserted in the hash table of a partitioned join
+  const size_t partition_count{1};
+  const size_t partition_idx{0};
 };
 
+// Partition of a hash join key, uniformly spread over a power of two partition count.
+DEVICE inline size_t get_hash_join_key_partition(const int64_t key,
+                                                 const size_t partition_count) {
+  const auto h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+  return (h >> 32) & (partition_count - 1);
+}
+
 inline ColumnType get_join_column_type_kind(const SQLTypeInfo& ti) {
   if (ti.is_date_in_days()) {
     return SmallDate;
+  } else if (ti.is_rl_or_diff_encoded()) {
+    return EncodedInt;
   } else {
     return is_unsigned_type(ti) ? Unsigned : Signed;
   }
@@ -144,6 +156,7 @@ int fill_hash_join_buff_bucketized(int32_t* buff,
                                    const JoinColumnTypeInfo type_info,
                                    const void* sd_inner,
                                    const void* sd_outer,
+                                   const std::vector<int32_t>* sd_translation_map,
                                    const int32_t cpu_thread_idx,
                                    const int32_t cpu_thread_count,
                                    const int64_t bucket_normalization);
@@ -155,9 +168,30 @@ int fill_hash_join_buff(int32_t* buff,
                         const JoinColumnTypeInfo type_info,
                         const void* sd_inner,
                         const void* sd_outer,
+                        const std::vector<int32_t>* sd_translation_map,
                         const int32_t cpu_thread_idx,
                         const int32_t cpu_thread_count);
 
+//! Number of cache sized partitions to fill a CPU hash table of the given size in, one
+//! if the table is filled in a single pass. The rows scattered to the partitions take
+//! scratch_bytes, too many of them compared to the table are filled in a single pass.
+size_t get_hash_join_build_partition_count(const size_t hash_table_bytes,
+                                           const size_t scratch_bytes);
+
+int fill_hash_join_buff_bucketized_partitioned(
+    int32_t* buff,
+    const int64_t entry_count,
+    const int32_t invalid_slot_val,
+    const bool for_semi_join,
+    const JoinColumn join_column,
+    const JoinColumnTypeInfo type_info,
+    const void* sd_inner,
+    const void* sd_outer,
+    const std::vector<int32_t>* sd_translation_map,
+    const int64_t bucket_normalization,
+    const int32_t cpu_thread_count,
+    const size_t partition_count);
+
 void fill_hash_join_buff_on_device(int32_t* buff,
                                    const int32_t invalid_slot_val,
                                    const bool for_semi_join,
@@ -204,26 +238,31 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const JoinColumnTypeInfo& type_info,
                                  const void* sd_inner_proxy,
                                  const void* sd_outer_proxy,
+                                 const std::vector<int32_t>* sd_translation_map,
                                  const unsigned cpu_thread_count);
 
-void fill_one_to_many_hash_table_bucketized(int32_t* buff,
-                                            const HashEntryInfo hash_entry_info,
-                                            const int32_t invalid_slot_val,
-                                            const JoinColumn& join_column,
-                                            const JoinColumnTypeInfo& type_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
-                                            const unsigned cpu_thread_count);
-
-void fill_one_to_many_hash_table_sharded_bucketized(int32_t* buff,
-                                                    const HashEntryInfo hash_entry_info,
-                                                    const int32_t invalid_slot_val,
-                                                    const JoinColumn& join_column,
-                                                    const JoinColumnTypeInfo& type_info,
-                                                    const ShardInfo& shard_info,
-                                                    const void* sd_inner_proxy,
-                                                    const void* sd_outer_proxy,
-                                                    const unsigned cpu_thread_count);
+void fill_one_to_many_hash_table_bucketized(
+    int32_t* buff,
+    const HashEntryInfo hash_entry_info,
+    const int32_t invalid_slot_val,
+    const JoinColumn& join_column,
+    const JoinColumnTypeInfo& type_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const unsigned cpu_thread_count);
+
+void fill_one_to_many_hash_table_sharded_bucketized(
+    int32_t* buff,
+    const HashEntryInfo hash_entry_info,
+    const int32_t invalid_slot_val,
+    const JoinColumn& join_column,
+    const JoinColumnTypeInfo& type_info,
+    const ShardInfo& shard_info,
+    const void* sd_inner_proxy,
+    const void* sd_outer_proxy,
+    const std::vector<int32_t>* sd_translation_map,
+    const unsigned cpu_thread_count);
 
 void fill_one_to_many_hash_table_on_device(int32_t* buff,
                                            const HashEntryInfo hash_entry_info,
@@ -287,6 +326,26 @@ int overlaps_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                              const int32_t cpu_thread_idx,
                                              const int32_t cpu_thread_count);
 
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int32_t cpu_thread_count,
+                                                const size_t partition_count);
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int32_t cpu_thread_count,
+                                                const size_t partition_count);
+
 void fill_baseline_hash_join_buff_on_device_32(int8_t* hash_buff,
                                                const int64_t entry_count,
                                                const int32_t invalid_slot_val,
@@ -328,6 +387,7 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinBucketInfo>& join_bucket_info,
     const std::vector<const void*>& sd_inner_proxy_per_key,
     const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const std::vector<int32_t>*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count);
 
 void fill_one_to_many_baseline_hash_table_64(
@@ -341,6 +401,7 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinBucketInfo>& join_bucket_info,
     const std::vector<const void*>& sd_inner_proxy_per_key,
     const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const std::vector<int32_t>*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count);
 
 void fill_one_to_many_baseline_hash_table_on_device_32(
@@ -35,8 +35,16 @@ __global__ void fill_hash_join_buff_wrapper(int32_t* buff,
                                             const JoinColumn join_column,
                                             const JoinColumnTypeInfo type_info,
                                             int* err) {
-  int partial_err = SUFFIX(fill_hash_join_buff)(
-      buff, invalid_slot_val, for_semi_join, join_column, type_info, NULL, NULL, -1, -1);
+  int partial_err = SUFFIX(fill_hash_join_buff)(buff,
+                                                invalid_slot_val,
+                                                for_semi_join,
+                                                join_column,
+                                                type_info,
+                                                NULL,
+                                                NULL,
+                                                NULL,
+                                                -1,
+                                                -1);
   atomicCAS(err, 0, partial_err);
 }
 
@@ -55,6 +63,7 @@ __global__ void fill_hash_join_buff_bucketized_wrapper(
                                                            type_info,
                                                            NULL,
                                                            NULL,
+                                                           NULL,
                                                            -1,
                                                            -1,
                                                            bucket_normalization);
@@ -110,6 +119,7 @@ __global__ void fill_hash_join_buff_wrapper_sharded_bucketized(
                                                                    shard_info,
                                                                    NULL,
                                                                    NULL,
+                                                                   NULL,
                                                                    -1,
                                                                    -1,
                                                                    bucket_normalization);
@@ -131,6 +141,7 @@ __global__ void fill_hash_join_buff_wrapper_sharded(int32_t* buff,
                                                         shard_info,
                                                         NULL,
                                                         NULL,
+                                                        NULL,
                                                         -1,
                                                         -1);
   atomicCAS(err, 0, partial_err);
@@ -51,6 +51,9 @@ struct JoinColumnIterator {
             chunk_data, type_info->elem_sz, index_inside_chunk);
       case Double:
         return SUFFIX(fixed_width_double_decode_noinline)(chunk_data, index_inside_chunk);
+      case EncodedInt:
+        return SUFFIX(encoded_int_decode_noinline)(
+            chunk_data, type_info->null_val, index_inside_chunk);
       default:
 #ifndef __CUDACC__
         CHECK(false);
@@ -96,6 +96,160 @@ baseline_hash_join_idx_64(const int8_t* hash_buff,
   return baseline_hash_join_idx_impl<int64_t>(hash_buff, key, key_bytes, entry_count);
 }
 
+#ifndef __CUDACC__
+
+namespace {
+
+// Rows of the outer table whose hash table slots are prefetched at a time, one block
+// ahead of the rows being probed.
+constexpr int64_t kProbePrefetchBlockSize{16};
+
+template <typename T>
+FORCE_INLINE void decode_probe_keys(const int8_t* key_byte_stream,
+                                    const int64_t start,
+                                    const int64_t count,
+                                    int64_t* keys) {
+  const auto key_stream = reinterpret_cast<const T*>(key_byte_stream) + start;
+  for (int64_t i = 0; i < count; ++i) {
+    keys[i] = key_stream[i];
+  }
+}
+
+/**
+ * Calls `prefetch_slot` with the keys of the block of rows after the one `pos` starts,
+ * once per block. The keys are decoded with one typed loop per width, which the
+ * compiler vectorizes, and the prefetches of a block overlap instead of each probe
+ * waiting on its own cache miss.
+ */
+template <typename PREFETCH_SLOT_FUNC>
+FORCE_INLINE void prefetch_next_probe_block(const int8_t* key_byte_stream,
+                                            const int32_t key_byte_width,
+                                            const bool key_is_unsigned,
+                                            const int64_t pos,
+                                            const int64_t row_count,
+                                            PREFETCH_SLOT_FUNC prefetch_slot) {
+  if (pos % kProbePrefetchBlockSize) {
+    return;
+  }
+  const int64_t start = pos + kProbePrefetchBlockSize;
+  const int64_t count = row_count - start < kProbePrefetchBlockSize
+                            ? row_count - start
+                            : kProbePrefetchBlockSize;
+  int64_t keys[kProbePrefetchBlockSize];
+  switch (key_byte_width) {
+    case 1:
+      key_is_unsigned ? decode_probe_keys<uint8_t>(key_byte_stream, start, count, keys)
+                      : decode_probe_keys<int8_t>(key_byte_stream, start, count, keys);
+      break;
+    case 2:
+      key_is_unsigned ? decode_probe_keys<uint16_t>(key_byte_stream, start, count, keys)
+                      : decode_probe_keys<int16_t>(key_byte_stream, start, count, keys);
+      break;
+    case 4:
+      decode_probe_keys<int32_t>(key_byte_stream, start, count, keys);
+      break;
+    case 8:
+      decode_probe_keys<int64_t>(key_byte_stream, start, count, keys);
+      break;
+    default:
+      return;
+  }
+  for (int64_t i = 0; i < count; ++i) {
+    prefetch_slot(keys[i]);
+  }
+}
+
+template <typename T>
+FORCE_INLINE void prefetch_baseline_hash_join_slots_impl(const int8_t* hash_buff,
+                                                         const int8_t* key_byte_stream,
+                                                         const int32_t key_byte_width,
+                                                         const bool key_is_unsigned,
+                                                         const int64_t pos,
+                                                         const int64_t row_count,
+                                                         const int64_t entry_count,
+                                                         const int64_t entry_size) {
+  if (!entry_count) {
+    return;
+  }
+  prefetch_next_probe_block(
+      key_byte_stream,
+      key_byte_width,
+      key_is_unsigned,
+      pos,
+      row_count,
+      [hash_buff, entry_count, entry_size](const int64_t key) {
+        const T key_component = key;
+        const uint32_t h = MurmurHash1(&key_component, sizeof(T), 0) % entry_count;
+        __builtin_prefetch(hash_buff + h * entry_size);
+      });
+}
+
+}  // namespace
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE void prefetch_hash_join_slots(
+    int64_t hash_buff,
+    const int8_t* key_byte_stream,
+    const int32_t key_byte_width,
+    const bool key_is_unsigned,
+    const int64_t pos,
+    const int64_t row_count,
+    const int64_t min_key,
+    const int64_t max_key) {
+  prefetch_next_probe_block(
+      key_byte_stream,
+      key_byte_width,
+      key_is_unsigned,
+      pos,
+      row_count,
+      [hash_buff, min_key, max_key](const int64_t key) {
+        // null keys are out of range, a null value which isn't only costs a prefetch
+        if (key >= min_key && key <= max_key) {
+          __builtin_prefetch(
+              SUFFIX(get_hash_slot)(reinterpret_cast<int32_t*>(hash_buff), key, min_key));
+        }
+      });
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE void prefetch_baseline_hash_join_slots_32(
+    const int8_t* hash_buff,
+    const int8_t* key_byte_stream,
+    const int32_t key_byte_width,
+    const bool key_is_unsigned,
+    const int64_t pos,
+    const int64_t row_count,
+    const int64_t entry_count,
+    const int64_t entry_size) {
+  prefetch_baseline_hash_join_slots_impl<int32_t>(hash_buff,
+                                                  key_byte_stream,
+                                                  key_byte_width,
+                                                  key_is_unsigned,
+                                                  pos,
+                                                  row_count,
+                                                  entry_count,
+                                                  entry_size);
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE void prefetch_baseline_hash_join_slots_64(
+    const int8_t* hash_buff,
+    const int8_t* key_byte_stream,
+    const int32_t key_byte_width,
+    const bool key_is_unsigned,
+    const int64_t pos,
+    const int64_t row_count,
+    const int64_t entry_count,
+    const int64_t entry_size) {
+  prefetch_baseline_hash_join_slots_impl<int64_t>(hash_buff,
+                                                  key_byte_stream,
+                                                  key_byte_width,
+                                                  key_is_unsigned,
+                                                  pos,
+                                                  row_count,
+                                                  entry_count,
+                                                  entry_size);
+}
+
+#endif  // __CUDACC__
+
 template <typename T>
 FORCE_INLINE DEVICE int64_t get_bucket_key_for_value_impl(const T value,
                                                           const double bucket_size) {
@@ -20,21 +20,31 @@
 #include "GpuSharedMemoryUtils.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
+#include "PersistentCodeCache.h"
 #include "QueryTemplateGenerator.h"
 
 #include "CudaMgr/CudaMgr.h"
 #include "OSDependent/omnisci_path.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "MapDRelease.h"
 #include "StreamingTopN.h"
 
 #if LLVM_VERSION_MAJOR < 9
 static_assert(false, "LLVM Version >= 9 is required.");
 #endif
 
+#include <boost/filesystem.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <set>
+#include <thread>
+
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/GlobalValue.h>
 #include <llvm/IR/InstIterator.h>
@@ -64,11 +74,13 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
-#if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
-#endif
 
 float g_fraction_code_cache_to_evict = 0.2;
+extern bool g_enable_persistent_code_cache;
+extern bool g_enable_tiered_compilation;
+extern size_t g_persistent_code_cache_max_size;
+extern std::string g_base_path;
 
 std::unique_ptr<llvm::Module> udf_gpu_module;
 std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -325,6 +337,17 @@ void optimize_ir(llvm::Function* query_func,
 
   eliminate_dead_self_recursive_funcs(*module, live_funcs);
 }
+
+// Only drops the runtime functions the query does not use, which is what makes code
+// generation without optimization cheap.
+void prune_ir(llvm::Module* module,
+              const std::unordered_set<llvm::Function*>& live_funcs) {
+  llvm::legacy::PassManager pass_manager;
+  pass_manager.add(llvm::createGlobalDCEPass());
+  pass_manager.run(*module);
+
+  eliminate_dead_self_recursive_funcs(*module, live_funcs);
+}
 #endif
 
 }  // namespace
@@ -411,17 +434,254 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
   return "Assembly for the CPU:\n" + std::string(code_str.str()) + "\nEnd of assembly";
 }
 
+// Serves a single compilation from the persistent code cache: hands the cached object to
+// MCJIT if there is one, and otherwise stores the object MCJIT generates.
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  PersistentObjectCache(PersistentCodeCache& code_cache,
+                        const std::string& key,
+                        std::optional<std::string>&& cached_object)
+      : code_cache_(code_cache), key_(key), cached_object_(std::move(cached_object)) {}
+
+  void notifyObjectCompiled(const llvm::Module*, llvm::MemoryBufferRef obj) override {
+    if (!cached_object_) {
+      code_cache_.put(key_, std::string(obj.getBufferStart(), obj.getBufferSize()));
+    }
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module*) override {
+    if (!cached_object_) {
+      return nullptr;
+    }
+    return llvm::MemoryBuffer::getMemBufferCopy(*cached_object_);
+  }
+
+  bool hasCachedObject() const { return cached_object_.has_value(); }
+
+ private:
+  PersistentCodeCache& code_cache_;
+  const std::string key_;
+  const std::optional<std::string> cached_object_;
+};
+
+PersistentCodeCache* get_persistent_code_cache() {
+  static std::once_flag init_flag;
+  static std::unique_ptr<PersistentCodeCache> code_cache;
+  std::call_once(init_flag, [] {
+    if (!g_enable_persistent_code_cache || g_base_path.empty()) {
+      return;
+    }
+    const auto cache_dir = boost::filesystem::path(g_base_path) / "mapd_code_cache";
+    try {
+      code_cache = std::make_unique<PersistentCodeCache>(
+          cache_dir.string(), g_persistent_code_cache_max_size);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to open the persistent code cache at " << cache_dir << ": "
+                 << e.what() << ". Continuing without it.";
+    }
+  });
+  return code_cache.get();
+}
+
+// The object code of a query is only valid for the exact same IR, runtime, LLVM code
+// generator and target CPU, so all of them go into the key.
+std::string get_persistent_code_cache_key(const CodeCacheKey& key,
+                                          const CompilationOptions& co) {
+  std::ostringstream oss;
+  oss << MAPD_RELEASE << '\n'
+      << LLVM_VERSION_STRING << '\n'
+      << llvm::sys::getHostCPUName().str() << '\n';
+  llvm::StringMap<bool> host_features;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    std::vector<std::string> features;
+    for (const auto& feature : host_features) {
+      features.push_back((feature.second ? '+' : '-') + feature.first().str());
+    }
+    std::sort(features.begin(), features.end());
+    for (const auto& feature : features) {
+      oss << feature << ',';
+    }
+  }
+  oss << '\n' << static_cast<int>(co.opt_level) << '\n';
+  for (const auto& ir : key) {
+    oss << ir.size() << '\n' << ir;
+  }
+  return oss.str();
+}
+
+/**
+ * Compiles optimized versions of queries which ran with baseline (unoptimized) code on a
+ * background thread. The global LLVM context cannot be used concurrently with query
+ * compilation, so every job carries the pruned query module as bitcode and is compiled
+ * in a fresh LLVM context owned by the resulting compilation context. The module never
+ * leaves that context: it is owned by the execution engine of the compilation context.
+ *
+ * Finished code is kept in a cache shared by all executors; an executor picks it up the
+ * next time the query hits its own code cache.
+ */
+class BackgroundCompiler {
+ public:
+  struct Job {
+    CodeCacheKey key;
+    std::string bitcode;
+    std::string query_func_name;
+    std::string multifrag_query_func_name;
+    std::vector<std::string> live_func_names;
+    CompilationOptions co;
+    std::string persistent_key;  // empty if the persistent code cache is not used
+  };
+
+  BackgroundCompiler() : optimized_code_(code_cache_size) {}
+
+  ~BackgroundCompiler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      should_exit_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  void submit(Job&& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_.count(job.key) ||
+        optimized_code_.find(job.key) != optimized_code_.cend()) {
+      return;
+    }
+    in_flight_.insert(job.key);
+    jobs_.push_back(std::move(job));
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&BackgroundCompiler::worker, this);
+    }
+    cv_.notify_one();
+  }
+
+  CodeCacheVal getOptimizedCode(const CodeCacheKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = optimized_code_.find(key);
+    if (it == optimized_code_.cend()) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  // Waits for the submitted jobs to finish, returns the number of queries compiled.
+  size_t waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return in_flight_.empty(); });
+    return compiled_count_;
+  }
+
+ private:
+  static constexpr size_t code_cache_size{1000};
+
+  void worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return should_exit_ || !jobs_.empty(); });
+      if (should_exit_) {
+        return;
+      }
+      auto job = std::move(jobs_.front());
+      jobs_.pop_front();
+      lock.unlock();
+      CodeCacheVal optimized_code;
+      try {
+        optimized_code = compile(job);
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Background compilation of an optimized query failed: "
+                     << e.what();
+      }
+      lock.lock();
+      in_flight_.erase(job.key);
+      if (optimized_code) {
+        optimized_code_.put(job.key, optimized_code);
+        ++compiled_count_;
+      }
+      idle_cv_.notify_all();
+    }
+  }
+
+  static CodeCacheVal compile(const Job& job) {
+    auto timer = timer_start();
+    auto llvm_context = std::make_unique<llvm::LLVMContext>();
+    auto buffer = llvm::MemoryBuffer::getMemBuffer(job.bitcode, "", false);
+    auto module_or_err = llvm::parseBitcodeFile(buffer->getMemBufferRef(), *llvm_context);
+    if (!module_or_err) {
+      LOG(WARNING) << "Background compilation failed to parse the query module: "
+                   << llvm::toString(module_or_err.takeError());
+      return nullptr;
+    }
+    auto module = module_or_err->release();
+    auto query_func = module->getFunction(job.query_func_name);
+    auto multifrag_query_func = module->getFunction(job.multifrag_query_func_name);
+    CHECK(query_func);
+    CHECK(multifrag_query_func);
+    std::unordered_set<llvm::Function*> live_funcs;
+    for (const auto& func_name : job.live_func_names) {
+      if (auto func = module->getFunction(func_name)) {
+        live_funcs.insert(func);
+      }
+    }
+    std::unique_ptr<PersistentObjectCache> object_cache;
+    if (!job.persistent_key.empty()) {
+      auto persistent_code_cache = get_persistent_code_cache();
+      CHECK(persistent_code_cache);
+      object_cache = std::make_unique<PersistentObjectCache>(
+          *persistent_code_cache, job.persistent_key, std::nullopt);
+    }
+    auto execution_engine = CodeGenerator::generateNativeCPUCode(
+        query_func, live_funcs, job.co, object_cache.get());
+    auto compilation_context = std::make_shared<CpuCompilationContext>(
+        std::move(execution_engine), std::move(llvm_context));
+    compilation_context->setFunctionPointer(multifrag_query_func);
+    VLOG(1) << "Background compilation of an optimized query took " << timer_stop(timer)
+            << " ms.";
+    return compilation_context;
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable idle_cv_;
+  bool should_exit_{false};
+  std::deque<Job> jobs_;
+  std::set<CodeCacheKey> in_flight_;
+  size_t compiled_count_{0};
+  LruCache<CodeCacheKey, CodeCacheVal, boost::hash<CodeCacheKey>> optimized_code_;
+  std::thread worker_;
+};
+
+BackgroundCompiler& get_background_compiler() {
+  static BackgroundCompiler background_compiler;
+  return background_compiler;
+}
+
+std::string serialize_to_bitcode(const llvm::Module& module) {
+  std::string bitcode;
+  llvm::raw_string_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(module, os);
+  os.flush();
+  return bitcode;
+}
+
 }  // namespace
 
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    llvm::ObjectCache* object_cache,
+    const bool has_cached_object,
+    const bool baseline_code) {
   auto module = func->getParent();
   // run optimizations
 #ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  optimize_ir(func, module, pass_manager, live_funcs, co);
+  if (!has_cached_object && !baseline_code) {
+    llvm::legacy::PassManager pass_manager;
+    optimize_ir(func, module, pass_manager, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -439,7 +699,7 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   llvm::TargetOptions to;
   to.EnableFastISel = true;
   eb.setTargetOptions(to);
-  if (co.opt_level == ExecutorOptLevel::ReductionJIT) {
+  if (co.opt_level == ExecutorOptLevel::ReductionJIT || baseline_code) {
     eb.setOptLevel(llvm::CodeGenOpt::None);
   }
 
@@ -452,9 +712,18 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
 
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
-  LOG(ASM) << assemblyForCPU(execution_engine, module);
+  if (!has_cached_object) {
+    LOG(ASM) << assemblyForCPU(execution_engine, module);
+  }
 
+  if (object_cache) {
+    execution_engine->setObjectCache(object_cache);
+  }
   execution_engine->finalizeObject();
+  if (object_cache) {
+    // the object cache only lives for the duration of the compilation
+    execution_engine->setObjectCache(nullptr);
+  }
   return execution_engine;
 }
 
@@ -474,8 +743,25 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   }
   auto cached_code = getCodeFromCache(key, cpu_code_cache_);
   if (cached_code) {
+    if (g_enable_tiered_compilation) {
+      // replace baseline code with the optimized version once it is ready, the module
+      // of the cache entry stays the one of the executor's LLVM context
+      auto optimized_code = get_background_compiler().getOptimizedCode(key);
+      if (optimized_code && optimized_code != cached_code) {
+        addCodeToCache(key, optimized_code, cgen_state_->module_, cpu_code_cache_);
+        return optimized_code;
+      }
+    }
     return cached_code;
   }
+  if (g_enable_tiered_compilation) {
+    // another executor may have compiled the optimized version already
+    auto optimized_code = get_background_compiler().getOptimizedCode(key);
+    if (optimized_code) {
+      addCodeToCache(key, optimized_code, module, cpu_code_cache_);
+      return optimized_code;
+    }
+  }
 
   if (cgen_state_->needs_geos_) {
 #ifdef ENABLE_GEOS
@@ -502,8 +788,49 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  std::unique_ptr<PersistentObjectCache> object_cache;
+  std::string persistent_key;
+  // UDF modules can change between restarts without changing the key, skip them
+  auto persistent_code_cache =
+      udf_cpu_module || rt_udf_cpu_module ? nullptr : get_persistent_code_cache();
+  if (persistent_code_cache) {
+    persistent_key = get_persistent_code_cache_key(key, co);
+    auto cached_object = persistent_code_cache->get(persistent_key);
+    object_cache = std::make_unique<PersistentObjectCache>(
+        *persistent_code_cache, persistent_key, std::move(cached_object));
+  }
+  const bool has_cached_object = object_cache && object_cache->hasCachedObject();
+
+#ifndef WITH_JIT_DEBUG
+  if (g_enable_tiered_compilation && !has_cached_object) {
+    // Run the query with unoptimized code right away and compile the optimized code in
+    // the background. Only the pruned module is handed over, which keeps the bitcode
+    // small.
+    prune_ir(module, live_funcs);
+    BackgroundCompiler::Job job{key,
+                                serialize_to_bitcode(*module),
+                                query_func->getName().str(),
+                                multifrag_query_func->getName().str(),
+                                {},
+                                co,
+                                persistent_key};
+    for (const auto func : live_funcs) {
+      job.live_func_names.push_back(func->getName().str());
+    }
+    get_background_compiler().submit(std::move(job));
+
+    auto execution_engine = CodeGenerator::generateNativeCPUCode(
+        query_func, live_funcs, co, nullptr, false, /*baseline_code=*/true);
+    auto cpu_compilation_context =
+        std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+    cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+    addCodeToCache(key, cpu_compilation_context, module, cpu_code_cache_);
+    return cpu_compilation_context;
+  }
+#endif  // WITH_JIT_DEBUG
+
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, object_cache.get(), has_cached_object);
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
@@ -511,6 +838,10 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   return cpu_compilation_context;
 }
 
+size_t Executor::waitForTieredCompilation() {
+  return get_background_compiler().waitUntilIdle();
+}
+
 void CodeGenerator::link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
                                     llvm::Module& module,
                                     CgenState* cgen_state,
@@ -1366,6 +1697,7 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
+         func->getName() == "encoded_int_decode" ||
          func->getName() == "record_error_code" || func->getName() == "get_error_code" ||
          func->getName() == "pos_start_impl" || func->getName() == "pos_step_impl" ||
          func->getName() == "group_buff_idx_impl" ||
@@ -2587,7 +2919,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
     for (size_t i = 0; i < num_count_distinct_descs; i++) {
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
-      if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::StdSet ||
+      if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::CompactSet ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
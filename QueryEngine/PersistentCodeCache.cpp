@@ -0,0 +1,248 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'M', 'N', 'I', 'C', 'O', 'D', 'E'};
+constexpr uint32_t kFormatVersion{1};
+const std::string kEntryExtension{".obj"};
+const std::string kTempExtension{".tmp"};
+
+struct EntryHeader {
+  char magic[sizeof(kMagic)];
+  uint32_t format_version;
+  uint32_t checksum;
+  uint64_t key_size;
+  uint64_t object_size;
+};
+
+uint32_t compute_checksum(const std::string& key, const std::string& object_code) {
+  boost::crc_32_type crc;
+  crc.process_bytes(key.data(), key.size());
+  crc.process_bytes(object_code.data(), object_code.size());
+  return crc.checksum();
+}
+
+std::string get_file_name(const std::string& key) {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0')
+      << static_cast<uint64_t>(boost::hash_value(key)) << kEntryExtension;
+  return oss.str();
+}
+
+size_t get_entry_size(const std::string& key, const std::string& object_code) {
+  return sizeof(EntryHeader) + key.size() + object_code.size();
+}
+
+enum class ReadStatus { Ok, KeyMismatch, Invalid };
+
+ReadStatus read_entry(const std::string& path,
+                      const std::string& key,
+                      std::string& object_code) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return ReadStatus::Invalid;
+  }
+  EntryHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) ||
+      header.format_version != kFormatVersion) {
+    return ReadStatus::Invalid;
+  }
+  const auto file_size = boost::filesystem::file_size(path);
+  if (file_size != sizeof(header) + header.key_size + header.object_size) {
+    return ReadStatus::Invalid;
+  }
+  std::string stored_key(header.key_size, '\0');
+  object_code.resize(header.object_size);
+  if (!in.read(stored_key.data(), stored_key.size()) ||
+      !in.read(object_code.data(), object_code.size())) {
+    return ReadStatus::Invalid;
+  }
+  if (compute_checksum(stored_key, object_code) != header.checksum) {
+    return ReadStatus::Invalid;
+  }
+  return stored_key == key ? ReadStatus::Ok : ReadStatus::KeyMismatch;
+}
+
+}  // namespace
+
+PersistentCodeCache::PersistentCodeCache(const std::string& cache_dir,
+                                         const size_t max_size_bytes)
+    : cache_dir_(cache_dir), max_size_bytes_(max_size_bytes) {
+  boost::filesystem::create_directories(cache_dir_);
+  loadIndex();
+}
+
+std::optional<std::string> PersistentCodeCache::get(const std::string& key) {
+  const auto file_name = get_file_name(key);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (!entries_.count(file_name)) {
+    stats_.misses++;
+    return std::nullopt;
+  }
+  std::string object_code;
+  ReadStatus status{ReadStatus::Invalid};
+  try {
+    status = read_entry(getFilePath(file_name), key, object_code);
+  } catch (const boost::filesystem::filesystem_error& e) {
+    LOG(WARNING) << "Failed to read code cache entry " << file_name << ": " << e.what();
+  }
+  if (status != ReadStatus::Ok) {
+    if (status == ReadStatus::Invalid) {
+      LOG(WARNING) << "Discarding invalid code cache entry " << file_name;
+      stats_.invalid_entries++;
+      removeEntry(file_name);
+    }
+    stats_.misses++;
+    return std::nullopt;
+  }
+  touch(file_name);
+  stats_.hits++;
+  return object_code;
+}
+
+void PersistentCodeCache::put(const std::string& key, const std::string& object_code) {
+  const auto entry_size = get_entry_size(key, object_code);
+  if (entry_size > max_size_bytes_) {
+    return;
+  }
+  EntryHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.format_version = kFormatVersion;
+  header.checksum = compute_checksum(key, object_code);
+  header.key_size = key.size();
+  header.object_size = object_code.size();
+
+  const auto file_name = get_file_name(key);
+  std::ostringstream tmp_name;
+  tmp_name << file_name << '.' << std::this_thread::get_id() << kTempExtension;
+  const auto tmp_path = getFilePath(tmp_name.str());
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  try {
+    {
+      std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(key.data(), key.size());
+      out.write(object_code.data(), object_code.size());
+      if (!out.flush()) {
+        throw std::runtime_error("write failed");
+      }
+    }
+    if (entries_.count(file_name)) {
+      removeEntry(file_name);
+    }
+    evictToFit(entry_size);
+    boost::filesystem::rename(tmp_path, getFilePath(file_name));
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to write code cache entry " << file_name << ": " << e.what();
+    boost::system::error_code ec;
+    boost::filesystem::remove(tmp_path, ec);
+    return;
+  }
+  lru_.push_front(file_name);
+  entries_[file_name] = Entry{entry_size, lru_.begin()};
+  stats_.num_entries++;
+  stats_.total_size_bytes += entry_size;
+}
+
+PersistentCodeCache::Stats PersistentCodeCache::getStats() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return stats_;
+}
+
+void PersistentCodeCache::loadIndex() {
+  std::vector<std::pair<std::time_t, boost::filesystem::path>> files;
+  for (const auto& dir_entry : boost::filesystem::directory_iterator(cache_dir_)) {
+    const auto& path = dir_entry.path();
+    if (!boost::filesystem::is_regular_file(path)) {
+      continue;
+    }
+    if (path.extension() == kTempExtension) {
+      // left behind by a process which died while writing an entry
+      boost::system::error_code ec;
+      boost::filesystem::remove(path, ec);
+      continue;
+    }
+    if (path.extension() == kEntryExtension) {
+      files.emplace_back(boost::filesystem::last_write_time(path), path);
+    }
+  }
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+  for (const auto& [mtime, path] : files) {
+    const auto file_name = path.filename().string();
+    const auto size_bytes = boost::filesystem::file_size(path);
+    lru_.push_back(file_name);
+    entries_[file_name] = Entry{size_bytes, std::prev(lru_.end())};
+    stats_.num_entries++;
+    stats_.total_size_bytes += size_bytes;
+  }
+  // the budget may have been lowered since the entries were written
+  evictToFit(0);
+  LOG(INFO) << "Loaded code cache index from " << cache_dir_ << " with "
+            << stats_.num_entries << " entries, " << stats_.total_size_bytes
+            << " bytes.";
+}
+
+void PersistentCodeCache::evictToFit(const size_t incoming_size_bytes) {
+  while (!lru_.empty() &&
+         stats_.total_size_bytes + incoming_size_bytes > max_size_bytes_) {
+    removeEntry(lru_.back());
+    stats_.evictions++;
+  }
+}
+
+void PersistentCodeCache::removeEntry(const std::string& file_name) {
+  auto it = entries_.find(file_name);
+  CHECK(it != entries_.end());
+  boost::system::error_code ec;
+  boost::filesystem::remove(getFilePath(file_name), ec);
+  stats_.num_entries--;
+  stats_.total_size_bytes -= it->second.size_bytes;
+  lru_.erase(it->second.lru_it);
+  entries_.erase(it);
+}
+
+void PersistentCodeCache::touch(const std::string& file_name) {
+  auto it = entries_.find(file_name);
+  CHECK(it != entries_.end());
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(getFilePath(file_name), std::time(nullptr), ec);
+}
+
+std::string PersistentCodeCache::getFilePath(const std::string& file_name) const {
+  return (boost::filesystem::path(cache_dir_) / file_name).string();
+}
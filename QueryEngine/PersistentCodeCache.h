@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/**
+ * On-disk cache of compiled object code, used to skip LLVM optimization and code
+ * generation for queries compiled by a previous server process.
+ *
+ * Every entry is a single file named after the hash of its key. The file stores the full
+ * key next to the object code and a checksum over both, so hash collisions, truncated
+ * writes and corrupted files are all detected on load and treated as a miss. Files are
+ * written to a temporary name and renamed into place, which keeps concurrent readers
+ * from seeing partial entries.
+ *
+ * The total size of the cached objects is bounded; the least recently used entries are
+ * evicted first. Recency survives restarts through the file modification times, which
+ * are refreshed on every hit.
+ */
+class PersistentCodeCache {
+ public:
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t invalid_entries{0};  // entries discarded on load because validation failed
+    size_t evictions{0};
+    size_t num_entries{0};
+    size_t total_size_bytes{0};
+  };
+
+  PersistentCodeCache(const std::string& cache_dir, const size_t max_size_bytes);
+
+  // Returns the object code stored for the given key, if any.
+  std::optional<std::string> get(const std::string& key);
+
+  void put(const std::string& key, const std::string& object_code);
+
+  Stats getStats() const;
+
+  const std::string& getCacheDir() const { return cache_dir_; }
+
+ private:
+  struct Entry {
+    size_t size_bytes;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  void loadIndex();
+  void evictToFit(const size_t incoming_size_bytes);
+  void removeEntry(const std::string& file_name);
+  void touch(const std::string& file_name);
+  std::string getFilePath(const std::string& file_name) const;
+
+  const std::string cache_dir_;
+  const size_t max_size_bytes_;
+
+  mutable std::mutex cache_mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;  // most recently used first
+  Stats stats_;
+};
@@ -16,21 +16,65 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <future>
+#include <map>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 
+#include "Logger/Logger.h"
+
 /**
  * QueryDispatchQueue maintains a list of pending queries and dispatches those queries as
- * Executors become available
+ * Executors become available.
+ *
+ * Pending queries are grouped into flows keyed by (priority class, tenant). Flows are
+ * served by start-time fair queueing: every dispatch advances the flow's virtual time by
+ * the inverse of its priority weight, and the flow with the smallest virtual time runs
+ * next. Tenants within a priority class therefore share executors evenly, and a single
+ * tenant submitting a long batch of work cannot monopolize the queue.
+ *
+ * If a memory budget is set, a query is only dispatched once its estimated memory fits
+ * into the budget alongside all running queries. A query is always admitted when nothing
+ * else is running, so an estimate larger than the budget cannot stall the queue.
  */
 class QueryDispatchQueue {
  public:
   using Task = std::packaged_task<void(size_t)>;
 
-  QueryDispatchQueue(const size_t parallel_executors_max) {
+  enum class Priority { INTERACTIVE = 0, NORMAL, BATCH };
+  static constexpr size_t kNumPriorities{3};
+
+  struct TaskOptions {
+    Priority priority{Priority::NORMAL};
+    std::string tenant;  // usually the user name; flows are fair-shared per tenant
+    size_t estimated_memory_bytes{0};
+  };
+
+  struct PriorityStats {
+    size_t queue_depth{0};
+    size_t dispatched{0};
+    int64_t total_wait_ms{0};
+    int64_t max_wait_ms{0};
+  };
+
+  struct Stats {
+    size_t num_workers{0};
+    size_t running{0};
+    size_t reserved_memory_bytes{0};
+    size_t memory_budget_bytes{0};
+    size_t admission_delays{0};  // dispatches held back by the memory budget
+    std::array<PriorityStats, kNumPriorities> per_priority;
+  };
+
+  QueryDispatchQueue(const size_t parallel_executors_max,
+                     const size_t memory_budget_bytes = 0)
+      : memory_budget_bytes_(memory_budget_bytes) {
     workers_.resize(parallel_executors_max);
     for (size_t i = 0; i < workers_.size(); i++) {
       // worker IDs are 1-indexed, leaving Executor 0 for non-dispatch queue worker tasks
@@ -44,6 +88,12 @@ class QueryDispatchQueue {
    * once the task runs.
    */
   void submit(std::shared_ptr<Task> task, const bool is_update_delete) {
+    submit(task, is_update_delete, TaskOptions{});
+  }
+
+  void submit(std::shared_ptr<Task> task,
+              const bool is_update_delete,
+              const TaskOptions& options) {
     if (workers_.size() == 1 && is_update_delete) {
       std::lock_guard<decltype(update_delete_mutex_)> update_delete_lock(
           update_delete_mutex_);
@@ -58,12 +108,33 @@ class QueryDispatchQueue {
     }
     std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
 
-    LOG(INFO) << "Dispatching query with " << queue_.size() << " queries in the queue.";
-    queue_.push(task);
+    const auto priority_idx = static_cast<size_t>(options.priority);
+    CHECK_LT(priority_idx, kNumPriorities);
+    auto& flow = flows_[std::make_pair(priority_idx, options.tenant)];
+    if (flow.pending.empty()) {
+      // an idle flow must not bank credit from the time it was inactive
+      flow.virtual_time = std::max(flow.virtual_time, virtual_clock_);
+    }
+    flow.pending.push(PendingTask{
+        task, options.estimated_memory_bytes, std::chrono::steady_clock::now()});
+    stats_.per_priority[priority_idx].queue_depth++;
+
+    LOG(INFO) << "Dispatching query with " << queued_count_ << " queries in the queue.";
+    queued_count_++;
     lock.unlock();
     cv_.notify_all();
   }
 
+  Stats getStats() const {
+    std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+    auto stats = stats_;
+    stats.num_workers = workers_.size();
+    stats.running = running_count_;
+    stats.reserved_memory_bytes = reserved_memory_bytes_;
+    stats.memory_budget_bytes = memory_budget_bytes_;
+    return stats;
+  }
+
   ~QueryDispatchQueue() {
     {
       std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
@@ -76,38 +147,119 @@ class QueryDispatchQueue {
   }
 
  private:
+  struct PendingTask {
+    std::shared_ptr<Task> task;
+    size_t estimated_memory_bytes;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  struct Flow {
+    std::queue<PendingTask> pending;
+    double virtual_time{0};
+  };
+
+  using FlowKey = std::pair<size_t, std::string>;
+
+  // Relative executor share of each priority class, indexed by Priority.
+  static constexpr std::array<double, kNumPriorities> kPriorityWeights{{16.0, 4.0, 1.0}};
+
+  // Returns the flow that should run next, or flows_.end() if nothing can be admitted.
+  // Must be called with queue_mutex_ held.
+  std::map<FlowKey, Flow>::iterator nextFlow() {
+    auto next = flows_.end();
+    for (auto it = flows_.begin(); it != flows_.end();) {
+      if (it->second.pending.empty()) {
+        // idle flows are only kept around while they still owe service to other flows
+        it = it->second.virtual_time <= virtual_clock_ ? flows_.erase(it) : std::next(it);
+        continue;
+      }
+      if (next == flows_.end() || it->second.virtual_time < next->second.virtual_time) {
+        next = it;
+      }
+      ++it;
+    }
+    if (next == flows_.end() || memory_budget_bytes_ == 0 || running_count_ == 0) {
+      return next;
+    }
+    // Do not backfill around a query that does not fit yet; running queries will release
+    // their reservations, which guarantees the held query is eventually admitted.
+    const auto estimate = next->second.pending.front().estimated_memory_bytes;
+    if (reserved_memory_bytes_ + estimate > memory_budget_bytes_) {
+      if (!admission_blocked_) {
+        admission_blocked_ = true;
+        stats_.admission_delays++;
+      }
+      return flows_.end();
+    }
+    return next;
+  }
+
   void worker(const size_t worker_idx) {
     std::unique_lock<std::mutex> lock(queue_mutex_);
     while (true) {
-      cv_.wait(lock, [this] { return !queue_.empty() || threads_should_exit_; });
+      auto flow_it = flows_.end();
+      cv_.wait(lock, [this, &flow_it] {
+        if (threads_should_exit_) {
+          return true;
+        }
+        flow_it = nextFlow();
+        return flow_it != flows_.end();
+      });
 
       if (threads_should_exit_) {
         return;
       }
 
-      if (!queue_.empty()) {
-        auto task = queue_.front();
-        queue_.pop();
-
-        LOG(INFO) << "Worker " << worker_idx
-                  << " running query and returning control. There are now "
-                  << queue_.size() << " queries in the queue.";
-        // allow other threads to pick up tasks
-        lock.unlock();
-        CHECK(task);
-        (*task)(worker_idx);
-        // wait for signal
-        lock.lock();
-      }
+      CHECK(flow_it != flows_.end());
+      auto& flow = flow_it->second;
+      auto pending = flow.pending.front();
+      flow.pending.pop();
+      const auto priority_idx = flow_it->first.first;
+      virtual_clock_ = flow.virtual_time;
+      flow.virtual_time += 1.0 / kPriorityWeights[priority_idx];
+      admission_blocked_ = false;
+      queued_count_--;
+      running_count_++;
+      reserved_memory_bytes_ += pending.estimated_memory_bytes;
+
+      const auto wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() - pending.enqueue_time)
+                               .count();
+      auto& priority_stats = stats_.per_priority[priority_idx];
+      priority_stats.queue_depth--;
+      priority_stats.dispatched++;
+      priority_stats.total_wait_ms += wait_ms;
+      priority_stats.max_wait_ms = std::max(priority_stats.max_wait_ms, wait_ms);
+
+      LOG(INFO) << "Worker " << worker_idx
+                << " running query and returning control. There are now "
+                << queued_count_ << " queries in the queue.";
+      // allow other threads to pick up tasks
+      lock.unlock();
+      CHECK(pending.task);
+      (*pending.task)(worker_idx);
+      // wait for signal
+      lock.lock();
+      running_count_--;
+      reserved_memory_bytes_ -= pending.estimated_memory_bytes;
+      // a released reservation may admit a query another worker is holding back
+      cv_.notify_all();
     }
   }
 
-  std::mutex queue_mutex_;
+  mutable std::mutex queue_mutex_;
   std::condition_variable cv_;
 
   std::mutex update_delete_mutex_;
 
   bool threads_should_exit_{false};
-  std::queue<std::shared_ptr<Task>> queue_;
+  std::map<FlowKey, Flow> flows_;
+  double virtual_clock_{0};
+  size_t queued_count_{0};
+  size_t running_count_{0};
+  size_t reserved_memory_bytes_{0};
+  const size_t memory_budget_bytes_;
+  bool admission_blocked_{false};
+  Stats stats_;
   std::vector<std::thread> workers_;
 };
@@ -591,6 +591,7 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     const std::vector<std::vector<uint64_t>>& frag_offsets,
     const int32_t scan_limit,
     int32_t* error_code,
+    const bool is_rowid_lookup,
     const uint32_t num_tables,
     const std::vector<int64_t>& join_hash_tables) {
   auto timer = DEBUG_TIMER(__func__);
@@ -635,7 +636,9 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     flatened_frag_offsets.insert(
         flatened_frag_offsets.end(), offsets.begin(), offsets.end());
   }
-  int64_t rowid_lookup_num_rows{*error_code ? *error_code + 1 : 0};
+  // The initial error code is the first row to scan. For row id lookups it is also the
+  // last one; otherwise the row counts have already been trimmed to the kernel's morsel.
+  int64_t rowid_lookup_num_rows{is_rowid_lookup && *error_code ? *error_code + 1 : 0};
   auto num_rows_ptr =
       rowid_lookup_num_rows ? &rowid_lookup_num_rows : &flatened_num_rows[0];
   int32_t total_matched_init{0};
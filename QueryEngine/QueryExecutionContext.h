@@ -88,6 +88,7 @@ class QueryExecutionContext : boost::noncopyable {
       const std::vector<std::vector<uint64_t>>& frag_row_offsets,
       const int32_t scan_limit,
       int32_t* error_code,
+      const bool is_rowid_lookup,
       const uint32_t num_tables,
       const std::vector<int64_t>& join_hash_tables);
 
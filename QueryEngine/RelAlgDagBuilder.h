@@ -1513,8 +1513,9 @@ class RelModify : public RelAlgNode {
           }
         }
 
-        // Check for valid types
-        if (column_desc->columnType.is_varlen()) {
+        // Check for valid types, RL and DIFF encoded chunks cannot be updated in place
+        if (column_desc->columnType.is_varlen() ||
+            column_desc->columnType.is_rl_or_diff_encoded()) {
           varlen_update_required = true;
         }
         if (column_desc->columnType.is_geometry()) {
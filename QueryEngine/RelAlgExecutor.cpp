@@ -27,12 +27,16 @@
 #include "QueryEngine/ExtensionFunctionsBinding.h"
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/FromTableReordering.h"
+#include "QueryEngine/GroupBySpill.h"
+#include "QueryEngine/JoinHashTable/PartitionedHashJoin.h"
 #include "QueryEngine/QueryPhysicalInputsCollector.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/ResultSetBuilder.h"
+#include "QueryEngine/ResultSetRecycler.h"
 #include "QueryEngine/RexVisitor.h"
+#include "QueryEngine/RunLengthAggregate.h"
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
@@ -53,6 +57,7 @@ bool g_enable_union{false};
 
 extern bool g_enable_bump_allocator;
 extern size_t g_default_max_groups_buffer_entry_guess;
+extern bool g_enable_result_set_recycler;
 
 namespace {
 
@@ -622,6 +627,28 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
 
   const auto exec_desc_count = get_descriptor_count();
 
+  // the last step produces the result of the whole sequence, which can be served from
+  // the recycler without running any of the steps
+  std::optional<std::string> recycler_key;
+  std::set<int> recycler_table_ids;
+  if (g_enable_result_set_recycler && !with_existing_temp_tables && !render_info &&
+      !eo.just_explain && !eo.just_validate && !eo.just_calcite_explain &&
+      !eo.find_push_down_candidates && !g_cluster) {
+    auto exec_desc_ptr = seq.getDescriptor(exec_desc_count - 1);
+    CHECK(exec_desc_ptr);
+    recycler_key =
+        getResultSetRecyclerKey(exec_desc_ptr->getBody(), recycler_table_ids);
+    if (recycler_key) {
+      auto cached_result = ResultSetRecycler::getInstance().get(*recycler_key);
+      if (cached_result) {
+        VLOG(1) << "Recycled the result of " << exec_desc_ptr->getBody()->toString();
+        exec_desc_ptr->getBody()->setOutputMetainfo(cached_result->getTargetsMeta());
+        exec_desc_ptr->setResult(*cached_result);
+        return *cached_result;
+      }
+    }
+  }
+
   for (size_t i = 0; i < exec_desc_count; i++) {
     VLOG(1) << "Executing query step " << i;
     // only render on the last step
@@ -654,7 +681,43 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
     }
   }
 
-  return seq.getDescriptor(exec_desc_count - 1)->getResult();
+  const auto& result = seq.getDescriptor(exec_desc_count - 1)->getResult();
+  if (recycler_key && ResultSetRecycler::isRecyclable(result)) {
+    ResultSetRecycler::getInstance().put(
+        *recycler_key, result, cat_.getDatabaseId(), recycler_table_ids);
+  }
+  return result;
+}
+
+std::optional<std::string> RelAlgExecutor::getResultSetRecyclerKey(
+    const RelAlgNode* node,
+    std::set<int>& table_ids) {
+  const auto plan_key = ResultSetRecycler::buildPlanKey(node);
+  if (!plan_key) {
+    return std::nullopt;
+  }
+  table_ids = plan_key->table_ids;
+  std::ostringstream oss;
+  oss << plan_key->plan << "|db=" << cat_.getDatabaseId();
+  auto& data_mgr = cat_.getDataMgr();
+  for (const int table_id : plan_key->table_ids) {
+    const auto td = cat_.getMetadataForTable(table_id, false);
+    CHECK(td);
+    oss << "|t" << table_id << ":epochs=";
+    for (const auto physical_td : cat_.getPhysicalTablesDescriptors(td)) {
+      oss << data_mgr.getTableEpoch(cat_.getDatabaseId(), physical_td->tableId) << ',';
+    }
+    const auto table_generations = executor_->computeTableGenerations({table_id});
+    oss << "tuples=" << table_generations.getGeneration(table_id).tuple_count;
+  }
+  const auto dictionary_generations =
+      executor_->computeStringDictionaryGenerations(get_physical_inputs(cat_, node));
+  const std::map<uint32_t, uint64_t> sorted_dictionary_generations(
+      dictionary_generations.asMap().begin(), dictionary_generations.asMap().end());
+  for (const auto& [dict_id, generation] : sorted_dictionary_generations) {
+    oss << "|d" << dict_id << ':' << generation;
+  }
+  return oss.str();
 }
 
 ExecutionResult RelAlgExecutor::executeRelAlgSubSeq(
@@ -1502,8 +1565,6 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
   CHECK(node);
   auto timer = DEBUG_TIMER(__func__);
 
-  UpdateTriggeredCacheInvalidator::invalidateCaches();
-
   auto co = co_in;
   co.hoist_literals = false;  // disable literal hoisting as it interferes with dict
                               // encoded string updates
@@ -1513,6 +1574,8 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
                                                      const bool is_aggregate) {
     auto table_descriptor = node->getModifiedTableDescriptor();
     CHECK(table_descriptor);
+    UpdateTriggeredCacheInvalidator::invalidateCachesByTable(cat_.getDatabaseId(),
+                                                             table_descriptor->tableId);
     if (node->isVarlenUpdateRequired() && !table_descriptor->hasDeletedCol) {
       throw std::runtime_error(
           "UPDATE queries involving variable length columns are only supported on tables "
@@ -1631,13 +1694,13 @@ void RelAlgExecutor::executeDelete(const RelAlgNode* node,
   CHECK(node);
   auto timer = DEBUG_TIMER(__func__);
 
-  DeleteTriggeredCacheInvalidator::invalidateCaches();
-
   auto execute_delete_for_node = [this, &co, &eo_in](const auto node,
                                                      auto& work_unit,
                                                      const bool is_aggregate) {
     auto* table_descriptor = node->getModifiedTableDescriptor();
     CHECK(table_descriptor);
+    DeleteTriggeredCacheInvalidator::invalidateCachesByTable(cat_.getDatabaseId(),
+                                                             table_descriptor->tableId);
     if (!table_descriptor->hasDeletedCol) {
       throw std::runtime_error(
           "DELETE queries are only supported on tables with the vacuum attribute set to "
@@ -1969,6 +2032,10 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
     if (!order_col) {
       throw std::runtime_error("Only order by columns supported for now");
     }
+    if (order_col->get_type_info().is_rl_or_diff_encoded()) {
+      throw std::runtime_error(
+          "Ordering window functions by RL or DIFF encoded columns not supported yet");
+    }
     const int8_t* column;
     size_t join_col_elem_count;
     std::tie(column, join_col_elem_count) =
@@ -2918,6 +2985,33 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   }
   const auto table_infos = get_table_infos(work_unit.exe_unit, executor_);
 
+  // aggregates over RL encoded columns only are evaluated once per run
+  if (is_agg && !render_info && !eo.just_explain && !eo.just_validate &&
+      !is_window_execution_unit(work_unit.exe_unit)) {
+    if (auto rows =
+            execute_run_length_aggregate(work_unit.exe_unit, table_infos, executor_)) {
+      ExecutionResult result{rows, targets_meta};
+      result.setQueueTime(queue_time_ms);
+      return result;
+    }
+  }
+
+  // inner joins with more build side rows than fit in a hash table run in partitions
+  if (!executor_->hash_join_partition_ && !render_info && !eo.just_explain &&
+      !eo.just_validate && !is_window_execution_unit(work_unit.exe_unit)) {
+    if (const auto partition =
+            get_hash_join_partition(work_unit.exe_unit, table_infos, is_agg, executor_)) {
+      return executeJoinInPartitions(work_unit,
+                                     *partition,
+                                     targets_meta,
+                                     is_agg,
+                                     co,
+                                     eo,
+                                     queue_time_ms,
+                                     previous_count);
+    }
+  }
+
   auto ra_exe_unit = decide_approx_count_distinct_implementation(
       work_unit.exe_unit, table_infos, executor_, co.device_type, target_exprs_owned_);
 
@@ -2995,6 +3089,27 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   };
 
+  // group bys with more groups than fit in memory run in partitions of the groups
+  auto execute_with_ndv_estimation =
+      [&](const size_t groups_buffer_entry_guess) -> ExecutionResult {
+    if (g_enable_group_by_spill && !render_info && !eo.just_explain &&
+        !eo.just_validate &&
+        groups_buffer_entry_guess > g_group_by_spill_partition_size) {
+      if (const auto partition_key = get_group_by_partition_key(ra_exe_unit)) {
+        return executeGroupByInPartitions(
+            {ra_exe_unit, work_unit.body, groups_buffer_entry_guess},
+            partition_key,
+            targets_meta,
+            is_agg,
+            co,
+            eo,
+            queue_time_ms);
+      }
+    }
+    return execute_and_handle_errors(
+        groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
+  };
+
   auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
@@ -3013,7 +3128,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
     if (cached_cardinality.first && card >= 0) {
-      result = execute_and_handle_errors(card, true, /*has_ndv_estimation=*/true);
+      result = execute_with_ndv_estimation(card);
     } else {
       const auto ndv_groups_estimation =
           getNDVEstimation(work_unit, e.range(), is_agg, co, eo);
@@ -3021,8 +3136,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
           ndv_groups_estimation > 0 ? 2 * ndv_groups_estimation
                                     : 2 * groups_approx_upper_bound(table_infos);
       CHECK_GT(estimated_groups_buffer_entry_guess, size_t(0));
-      result = execute_and_handle_errors(
-          estimated_groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
+      result = execute_with_ndv_estimation(estimated_groups_buffer_entry_guess);
       if (!(eo.just_validate || eo.just_explain)) {
         executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
       }
@@ -3214,6 +3328,28 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   VLOG(1) << "Resetting max groups buffer entry guess.";
   max_groups_buffer_entry_guess = 0;
 
+  // the groups don't fit in memory, try once more one partition of the groups at a time
+  auto execute_in_partitions =
+      [&](const RelAlgExecutionUnit& ra_exe_unit,
+          const size_t groups_buffer_entry_guess) -> std::optional<ExecutionResult> {
+    const auto partition_key = g_enable_group_by_spill && !render_info
+                                   ? get_group_by_partition_key(ra_exe_unit)
+                                   : nullptr;
+    if (!partition_key) {
+      return std::nullopt;
+    }
+    LOG(WARNING) << "Group by query ran out of memory, retrying in partitions of the "
+                    "groups.";
+    return executeGroupByInPartitions(
+        {ra_exe_unit, work_unit.body, groups_buffer_entry_guess},
+        partition_key,
+        targets_meta,
+        is_agg,
+        co_cpu,
+        eo_no_multifrag,
+        queue_time_ms);
+  };
+
   int iteration_ctr = -1;
   while (true) {
     iteration_ctr++;
@@ -3242,6 +3378,10 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
         // Only allow two iterations of increasingly large entry guesses up to a maximum
         // of 512MB per column per kernel
         if (g_enable_watchdog || iteration_ctr > 1) {
+          if (auto result_in_partitions =
+                  execute_in_partitions(ra_exe_unit, 2 * max_groups_buffer_entry_guess)) {
+            return *result_in_partitions;
+          }
           throw std::runtime_error("Query ran out of output slots in the result");
         }
         max_groups_buffer_entry_guess *= 2;
@@ -3250,6 +3390,14 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
       } else {
+        if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+          if (auto result_in_partitions = execute_in_partitions(
+                  ra_exe_unit,
+                  std::max(work_unit.max_groups_buffer_entry_guess,
+                           max_groups_buffer_entry_guess))) {
+            return *result_in_partitions;
+          }
+        }
         handlePersistentError(e.getErrorCode());
       }
       continue;
@@ -3260,6 +3408,182 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+namespace {
+
+// Collects the results of the passes of a query executed in partitions, writing out the
+// ones which can be spilled. The results are concatenated once all passes are done, the
+// spilled ones read back one partition at a time.
+class PartitionResults {
+ public:
+  void add(const ResultSetPtr& result) {
+    CHECK(result);
+    if (can_spill_group_by_result(*result)) {
+      spill_file_.spill(*result);
+    } else {
+      in_memory_results_.push_back(result);
+    }
+    // an empty result is kept only in case all the partitions are empty
+    const bool is_empty =
+        !spill_file_.getSpilledPartitionCount() && in_memory_results_.empty();
+    empty_result_ = is_empty ? result : nullptr;
+  }
+
+  ResultSetPtr get(const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+                   const Executor* executor) {
+    ResultSetPtr result;
+    auto append = [&result](const ResultSetPtr& partition_result) {
+      if (result) {
+        result->append(*partition_result);
+      } else {
+        result = partition_result;
+      }
+    };
+    for (size_t i = 0; i < spill_file_.getSpilledPartitionCount(); ++i) {
+      append(spill_file_.load(i,
+                              row_set_mem_owner,
+                              executor->getCatalog(),
+                              executor->blockSize(),
+                              executor->gridSize()));
+    }
+    for (const auto& in_memory_result : in_memory_results_) {
+      append(in_memory_result);
+    }
+    return result ? result : empty_result_;
+  }
+
+ private:
+  GroupBySpillFile spill_file_;
+  std::vector<ResultSetPtr> in_memory_results_;
+  ResultSetPtr empty_result_;
+};
+
+}  // namespace
+
+ExecutionResult RelAlgExecutor::executeGroupByInPartitions(
+    const RelAlgExecutor::WorkUnit& work_unit,
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms) {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& ra_exe_unit = work_unit.exe_unit;
+  const auto table_infos = get_table_infos(ra_exe_unit, executor_);
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  const auto partition_count =
+      std::max(get_group_by_partition_count(work_unit.max_groups_buffer_entry_guess),
+               size_t(2));
+  const auto partition_groups_buffer_entry_guess =
+      std::max(work_unit.max_groups_buffer_entry_guess / partition_count, size_t(1));
+  LOG(INFO) << "Executing group by in " << partition_count << " partitions on "
+            << partition_key->toString();
+
+  const auto row_set_mem_owner = executor_->row_set_mem_owner_;
+  CHECK(row_set_mem_owner);
+  ScopeGuard restore_row_set_mem_owner = [this, row_set_mem_owner] {
+    executor_->row_set_mem_owner_ = row_set_mem_owner;
+  };
+  PartitionResults partition_results;
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    const auto partition_exe_unit = create_group_by_partition_execution_unit(
+        ra_exe_unit, partition_key, partition_idx, partition_count);
+    // the hash tables of the partition are freed along with its owner once it's spilled
+    executor_->row_set_mem_owner_ =
+        row_set_mem_owner->clonePartitionOwner(cpu_threads());
+    auto groups_buffer_entry_guess = partition_groups_buffer_entry_guess;
+    ResultSetPtr result;
+    while (true) {
+      auto max_groups_buffer_entry_guess = groups_buffer_entry_guess;
+      ColumnCacheMap column_cache;
+      try {
+        result = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
+                                            is_agg,
+                                            table_infos,
+                                            partition_exe_unit,
+                                            co_cpu,
+                                            eo,
+                                            cat_,
+                                            nullptr,
+                                            true,
+                                            column_cache);
+        break;
+      } catch (const QueryExecutionError& e) {
+        // Ran out of slots, the keys are skewed towards this partition
+        if (e.getErrorCode() >= 0) {
+          handlePersistentError(e.getErrorCode());
+        }
+        if (g_enable_watchdog ||
+            groups_buffer_entry_guess > 2 * g_group_by_spill_partition_size) {
+          throw std::runtime_error("Query ran out of output slots in the result");
+        }
+        groups_buffer_entry_guess *= 2;
+      }
+    }
+    row_set_mem_owner->addStrDictData(*executor_->row_set_mem_owner_);
+    partition_results.add(result);
+    add_executed_group_by_partition();
+  }
+
+  // the last partition is freed before the spilled ones are read back
+  executor_->row_set_mem_owner_ = row_set_mem_owner;
+  ExecutionResult execution_result{partition_results.get(row_set_mem_owner, executor_),
+                                   targets_meta};
+  execution_result.setQueueTime(queue_time_ms);
+  return execution_result;
+}
+
+ExecutionResult RelAlgExecutor::executeJoinInPartitions(
+    const RelAlgExecutor::WorkUnit& work_unit,
+    const HashJoinPartition& partition,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms,
+    const std::optional<size_t> previous_count) {
+  auto timer = DEBUG_TIMER(__func__);
+  LOG(INFO) << "Executing join in " << partition.partition_count
+            << " partitions of the build side of input " << partition.inner_rte_idx;
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  // filters have been pushed down before, if any
+  auto eo_partition = eo;
+  eo_partition.find_push_down_candidates = false;
+
+  const auto row_set_mem_owner = executor_->row_set_mem_owner_;
+  CHECK(row_set_mem_owner);
+  ScopeGuard reset_partition = [this, row_set_mem_owner] {
+    executor_->hash_join_partition_.reset();
+    executor_->row_set_mem_owner_ = row_set_mem_owner;
+  };
+  PartitionResults partition_results;
+  for (size_t partition_idx = 0; partition_idx < partition.partition_count;
+       ++partition_idx) {
+    executor_->hash_join_partition_ = HashJoinPartition{
+        partition.inner_rte_idx, partition.partition_count, partition_idx};
+    executor_->row_set_mem_owner_ =
+        row_set_mem_owner->clonePartitionOwner(cpu_threads());
+    // each pass is a regular execution of the query with a partial hash table
+    const auto result = executeWorkUnit(work_unit,
+                                        targets_meta,
+                                        is_agg,
+                                        co_cpu,
+                                        eo_partition,
+                                        nullptr,
+                                        queue_time_ms,
+                                        previous_count);
+    row_set_mem_owner->addStrDictData(*executor_->row_set_mem_owner_);
+    partition_results.add(result.getRows());
+  }
+
+  executor_->hash_join_partition_.reset();
+  executor_->row_set_mem_owner_ = row_set_mem_owner;
+  ExecutionResult execution_result{partition_results.get(row_set_mem_owner, executor_),
+                                   targets_meta};
+  execution_result.setQueueTime(queue_time_ms);
+  return execution_result;
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -159,6 +159,11 @@ class RelAlgExecutor : private StorageIOFacility {
                                             const bool just_explain_plan,
                                             RenderInfo* render_info);
 
+  // Returns the key of the given node's result in the result set recycler, or
+  // std::nullopt if the result must not be recycled.
+  std::optional<std::string> getResultSetRecyclerKey(const RelAlgNode* node,
+                                                     std::set<int>& table_ids);
+
   void executeRelAlgStep(const RaExecutionSequence& seq,
                          const size_t step_idx,
                          const CompilationOptions&,
@@ -300,6 +305,28 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Executes a group by one partition of its groups at a time, for queries with more
+  // groups than fit in memory. See GroupBySpill.h.
+  ExecutionResult executeGroupByInPartitions(
+      const RelAlgExecutor::WorkUnit& work_unit,
+      const std::shared_ptr<Analyzer::Expr>& partition_key,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const int64_t queue_time_ms);
+
+  // Executes an inner join one partition of its build side at a time, for build sides
+  // with more rows than fit in a hash table. See PartitionedHashJoin.h.
+  ExecutionResult executeJoinInPartitions(const RelAlgExecutor::WorkUnit& work_unit,
+                                          const HashJoinPartition& partition,
+                                          const std::vector<TargetMetaInfo>& targets_meta,
+                                          const bool is_agg,
+                                          const CompilationOptions& co,
+                                          const ExecutionOptions& eo,
+                                          const int64_t queue_time_ms,
+                                          const std::optional<size_t> previous_count);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -628,6 +628,11 @@ void fill_dictionary_encoded_in_vals(
     const int64_t needle_null_val) {
   CHECK(in_vals.empty());
   bool dicts_are_equal = source_dict == dest_dict;
+  // all the slices translate with the map built for the whole subquery result
+  const auto translation_map =
+      dicts_are_equal ? nullptr
+                      : source_dict->getTranslationMap(dest_dict,
+                                                       values_rowset->entryCount());
   for (auto index = values_rowset_slice.first; index < values_rowset_slice.second;
        ++index) {
     const auto row = values_rowset->getOneColRow(index);
@@ -640,7 +645,7 @@ void fill_dictionary_encoded_in_vals(
       const int string_id =
           row.value == needle_null_val
               ? needle_null_val
-              : dest_dict->getIdOfString(source_dict->getString(row.value));
+              : source_dict->translateStringId(row.value, dest_dict, translation_map);
       if (string_id != StringDictionary::INVALID_STR_ID) {
         in_vals.push_back(string_id);
       }
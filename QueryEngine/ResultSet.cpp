@@ -242,6 +242,9 @@ void ResultSet::append(ResultSet& that) {
     return;
   }
   appended_storage_.push_back(std::move(that.storage_));
+  if (that.row_set_mem_owner_ != row_set_mem_owner_) {
+    appended_row_set_mem_owners_.push_back(that.row_set_mem_owner_);
+  }
   query_mem_desc_.setEntryCount(
       query_mem_desc_.getEntryCount() +
       appended_storage_.back()->query_mem_desc_.getEntryCount());
@@ -691,6 +694,26 @@ ResultSet::ApproxMedianBuffers ResultSet::ResultSetComparator<
   return approx_median_materialized_buffers;
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+std::vector<std::shared_ptr<const std::vector<int32_t>>> ResultSet::ResultSetComparator<
+    BUFFER_ITERATOR_TYPE>::materializeDictionaryStringRanks() const {
+  std::vector<std::shared_ptr<const std::vector<int32_t>>> dictionary_string_ranks;
+  for (const auto& order_entry : order_entries_) {
+    const auto entry_ti = get_compact_type(result_set_->targets_[order_entry.tle_no - 1]);
+    if (entry_ti.is_string() && entry_ti.get_compression() == kENCODING_DICT &&
+        executor_) {
+      const auto string_dict_proxy = executor_->getStringDictionaryProxy(
+          entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
+      // the ids missing from the ranks compare as strings
+      dictionary_string_ranks.emplace_back(
+          string_dict_proxy->getSortedRanks(permutation_.size()));
+    } else {
+      dictionary_string_ranks.emplace_back(nullptr);
+    }
+  }
+  return dictionary_string_ranks;
+}
+
 template <typename BUFFER_ITERATOR_TYPE>
 std::vector<int64_t>
 ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctColumn(
@@ -781,9 +804,11 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   const auto fixedup_rhs = rhs_storage_lookup_result.fixedup_entry_idx;
   size_t materialized_count_distinct_buffer_idx{0};
   size_t materialized_approx_median_buffer_idx{0};
+  size_t order_entry_idx{0};
 
   for (const auto& order_entry : order_entries_) {
     CHECK_GE(order_entry.tle_no, 1);
+    const auto& dictionary_string_ranks = dictionary_string_ranks_[order_entry_idx++];
     const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
     const auto entry_ti = get_compact_type(agg_info);
     bool float_argument_input = takes_float_argument(agg_info);
@@ -863,6 +888,17 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
       if (UNLIKELY(entry_ti.is_string() &&
                    entry_ti.get_compression() == kENCODING_DICT)) {
         CHECK_EQ(4, entry_ti.get_logical_size());
+        // ids of the dictionary compare through their ranks, transient ids as strings
+        if (dictionary_string_ranks && lhs_v.i1 >= 0 && rhs_v.i1 >= 0 &&
+            static_cast<size_t>(lhs_v.i1) < dictionary_string_ranks->size() &&
+            static_cast<size_t>(rhs_v.i1) < dictionary_string_ranks->size()) {
+          const auto lhs_rank = (*dictionary_string_ranks)[lhs_v.i1];
+          const auto rhs_rank = (*dictionary_string_ranks)[rhs_v.i1];
+          if (lhs_rank == rhs_rank) {
+            continue;
+          }
+          return (lhs_rank < rhs_rank) != order_entry.is_desc;
+        }
         CHECK(executor_);
         const auto string_dict_proxy = executor_->getStringDictionaryProxy(
             entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
@@ -1032,18 +1068,19 @@ std::shared_ptr<const std::vector<std::string>> ResultSet::getStringDictionaryPa
 bool ResultSet::isDirectColumnarConversionPossible() const {
   if (!g_enable_direct_columnarization) {
     return false;
-  } else if (query_mem_desc_.didOutputColumnar()) {
+  }
+  // group by entries are only read from the main storage
+  const bool is_group_by = appended_storage_.empty() &&
+                           (query_mem_desc_.getQueryDescriptionType() ==
+                                QueryDescriptionType::GroupByPerfectHash ||
+                            query_mem_desc_.getQueryDescriptionType() ==
+                                QueryDescriptionType::GroupByBaselineHash);
+  if (query_mem_desc_.didOutputColumnar()) {
     return permutation_.empty() && (query_mem_desc_.getQueryDescriptionType() ==
                                         QueryDescriptionType::Projection ||
-                                    (query_mem_desc_.getQueryDescriptionType() ==
-                                         QueryDescriptionType::GroupByPerfectHash ||
-                                     query_mem_desc_.getQueryDescriptionType() ==
-                                         QueryDescriptionType::GroupByBaselineHash));
+                                    is_group_by);
   } else {
-    return permutation_.empty() && (query_mem_desc_.getQueryDescriptionType() ==
-                                        QueryDescriptionType::GroupByPerfectHash ||
-                                    query_mem_desc_.getQueryDescriptionType() ==
-                                        QueryDescriptionType::GroupByBaselineHash);
+    return permutation_.empty() && is_group_by;
   }
 }
 
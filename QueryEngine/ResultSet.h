@@ -349,6 +349,7 @@ class ResultSet {
   void holdChunks(const std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks) {
     chunks_ = chunks;
   }
+  bool holdsChunks() const { return !chunks_.empty() || !chunk_iters_.empty(); }
   void holdChunkIterators(const std::shared_ptr<std::list<ChunkIter>> chunk_iters) {
     chunk_iters_.push_back(chunk_iters);
   }
@@ -638,12 +639,15 @@ class ResultSet {
         , buffer_itr_(result_set)
         , executor_(executor)
         , single_threaded_(single_threaded)
-        , approx_median_materialized_buffers_(materializeApproxMedianColumns()) {
+        , approx_median_materialized_buffers_(materializeApproxMedianColumns())
+        , dictionary_string_ranks_(materializeDictionaryStringRanks()) {
       materializeCountDistinctColumns();
     }
 
     void materializeCountDistinctColumns();
     ApproxMedianBuffers materializeApproxMedianColumns() const;
+    std::vector<std::shared_ptr<const std::vector<int32_t>>>
+    materializeDictionaryStringRanks() const;
 
     std::vector<int64_t> materializeCountDistinctColumn(
         const Analyzer::OrderEntry& order_entry) const;
@@ -660,6 +664,9 @@ class ResultSet {
     const bool single_threaded_;
     std::vector<std::vector<int64_t>> count_distinct_materialized_buffers_;
     const ApproxMedianBuffers approx_median_materialized_buffers_;
+    // sort ranks of the dictionary ids, per order entry on a dictionary encoded string
+    const std::vector<std::shared_ptr<const std::vector<int32_t>>>
+        dictionary_string_ranks_;
   };
 
   Comparator createComparator(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -737,6 +744,8 @@ class ResultSet {
   size_t drop_first_;
   size_t keep_first_;
   std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner_;
+  // owners of appended storage allocated by another owner, e.g. a partition of the query
+  std::vector<std::shared_ptr<RowSetMemoryOwner>> appended_row_set_mem_owners_;
   Permutation permutation_;
 
   const Catalog_Namespace::Catalog* catalog_;
@@ -0,0 +1,385 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ResultSetRecycler.h"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/RelAlgDagBuilder.h"
+#include "QueryEngine/ResultSet.h"
+
+extern size_t g_result_set_recycler_max_size;
+
+namespace {
+
+// Functions whose value depends on the time or the session of the query.
+const std::unordered_set<std::string> non_deterministic_functions{"NOW",
+                                                                  "DATETIME",
+                                                                  "CURRENT_DATE",
+                                                                  "CURRENT_TIME",
+                                                                  "CURRENT_TIMESTAMP",
+                                                                  "CURRENT_USER",
+                                                                  "LOCALTIME",
+                                                                  "LOCALTIMESTAMP",
+                                                                  "RAND",
+                                                                  "RANDOM"};
+
+class NotRecyclable : public std::runtime_error {
+ public:
+  NotRecyclable(const std::string& reason) : std::runtime_error(reason) {}
+};
+
+/**
+ * Serializes a RelAlg DAG into a string which only depends on the content of the nodes.
+ * Every node is serialized once and labeled by the order in which it was first reached,
+ * so shared inputs and inputs referenced from expressions do not blow up the key.
+ */
+class PlanKeyBuilder {
+ public:
+  ResultSetRecycler::PlanKey build(const RelAlgNode* node) {
+    visitNode(node);
+    return {definitions_.str(), table_ids_};
+  }
+
+ private:
+  size_t visitNode(const RelAlgNode* node) {
+    CHECK(node);
+    const auto it = labels_.find(node);
+    if (it != labels_.end()) {
+      return it->second;
+    }
+    std::vector<size_t> input_labels;
+    for (size_t i = 0; i < node->inputCount(); ++i) {
+      input_labels.push_back(visitNode(node->getInput(i)));
+    }
+    // expressions may reference nodes which are not inputs (e.g. subqueries), those are
+    // labeled while the definition of this node is built
+    const auto definition = defineNode(node, input_labels);
+    const auto label = labels_.size();
+    labels_.emplace(node, label);
+    definitions_ << 'n' << label << '=' << definition << ';';
+    return label;
+  }
+
+  std::string defineNode(const RelAlgNode* node, const std::vector<size_t>& inputs) {
+    std::ostringstream oss;
+    if (const auto scan = dynamic_cast<const RelScan*>(node)) {
+      const auto td = scan->getTableDescriptor();
+      CHECK(td);
+      if (td->isTemporaryTable() || td->isForeignTable()) {
+        throw NotRecyclable("reads table " + td->tableName);
+      }
+      table_ids_.insert(td->tableId);
+      oss << "scan(" << td->tableId << ')';
+    } else if (const auto project = dynamic_cast<const RelProject*>(node)) {
+      checkNotModify(project);
+      oss << "project(";
+      for (size_t i = 0; i < project->size(); ++i) {
+        oss << rex(project->getProjectAt(i)) << ',';
+      }
+      oss << names(project->getFields());
+    } else if (const auto compound = dynamic_cast<const RelCompound*>(node)) {
+      checkNotModify(compound);
+      oss << "compound(" << compound->getGroupByCount() << ',' << compound->isAggregate()
+          << ",filter=" << rex(compound->getFilterExpr()) << ",sources=";
+      for (size_t i = 0; i < compound->getScalarSourcesSize(); ++i) {
+        oss << rex(compound->getScalarSource(i)) << ',';
+      }
+      oss << "targets=";
+      for (size_t i = 0; i < compound->size(); ++i) {
+        const auto target = compound->getTargetExpr(i);
+        if (const auto agg = dynamic_cast<const RexAgg*>(target)) {
+          oss << rexAgg(agg) << ',';
+        } else {
+          oss << rex(dynamic_cast<const RexScalar*>(target)) << ',';
+        }
+      }
+      oss << names(compound->getFields());
+    } else if (const auto aggregate = dynamic_cast<const RelAggregate*>(node)) {
+      oss << "aggregate(" << aggregate->getGroupByCount() << ',';
+      for (const auto& agg : aggregate->getAggExprs()) {
+        oss << rexAgg(agg.get()) << ',';
+      }
+      oss << names(aggregate->getFields());
+    } else if (const auto filter = dynamic_cast<const RelFilter*>(node)) {
+      oss << "filter(" << rex(filter->getCondition());
+    } else if (const auto join = dynamic_cast<const RelJoin*>(node)) {
+      oss << "join(" << static_cast<int>(join->getJoinType()) << ','
+          << rex(join->getCondition());
+    } else if (const auto join = dynamic_cast<const RelLeftDeepInnerJoin*>(node)) {
+      oss << "left_deep_join(" << rex(join->getInnerCondition());
+      for (size_t level = 1; level < join->inputCount(); ++level) {
+        oss << ',' << rex(join->getOuterCondition(level));
+      }
+    } else if (const auto sort = dynamic_cast<const RelSort*>(node)) {
+      oss << "sort(" << sort->getLimit() << ',' << sort->getOffset() << ','
+          << sort->isEmptyResult();
+      for (size_t i = 0; i < sort->collationCount(); ++i) {
+        oss << ',' << sort->getCollation(i).toString();
+      }
+    } else if (const auto logical_values = dynamic_cast<const RelLogicalValues*>(node)) {
+      oss << "values(";
+      for (const auto& target_meta : logical_values->getTupleType()) {
+        oss << target_meta.get_resname() << ' '
+            << target_meta.get_type_info().to_string() << ',';
+      }
+      for (size_t row = 0; row < logical_values->getNumRows(); ++row) {
+        oss << '[';
+        for (size_t col = 0; col < logical_values->getRowsSize(); ++col) {
+          oss << rex(logical_values->getValueAt(row, col)) << ',';
+        }
+        oss << ']';
+      }
+    } else if (const auto logical_union = dynamic_cast<const RelLogicalUnion*>(node)) {
+      oss << "union(" << logical_union->isAll();
+    } else {
+      // table functions, table modifications and anything added later
+      throw NotRecyclable("unsupported node " + node->toString());
+    }
+    oss << ",inputs=";
+    for (const auto input : inputs) {
+      oss << 'n' << input << ',';
+    }
+    oss << ')';
+    return oss.str();
+  }
+
+  static void checkNotModify(const ModifyManipulationTarget* node) {
+    if (node->isUpdateViaSelect() || node->isDeleteViaSelect()) {
+      throw NotRecyclable("modifies a table");
+    }
+  }
+
+  static std::string names(const std::vector<std::string>& fields) {
+    std::string result{"fields="};
+    for (const auto& field : fields) {
+      result += field + ',';
+    }
+    return result;
+  }
+
+  std::string rexAgg(const RexAgg* agg) {
+    std::ostringstream oss;
+    oss << "agg(" << agg->getKind() << ',' << agg->isDistinct() << ','
+        << agg->getType().to_string();
+    for (size_t i = 0; i < agg->size(); ++i) {
+      oss << ',' << agg->getOperand(i);
+    }
+    oss << ')';
+    return oss.str();
+  }
+
+  std::string rex(const RexScalar* rex_scalar) {
+    if (!rex_scalar) {
+      return "null";
+    }
+    std::ostringstream oss;
+    if (const auto input = dynamic_cast<const RexInput*>(rex_scalar)) {
+      oss << "$n" << visitNode(input->getSourceNode()) << '.' << input->getIndex();
+    } else if (const auto literal = dynamic_cast<const RexLiteral*>(rex_scalar)) {
+      oss << literal->toString() << '(' << literal->getScale() << ','
+          << literal->getPrecision() << ',' << literal->getTypeScale() << ','
+          << literal->getTypePrecision() << ')';
+    } else if (const auto ref = dynamic_cast<const RexRef*>(rex_scalar)) {
+      oss << "ref(" << ref->getIndex() << ')';
+    } else if (const auto subquery = dynamic_cast<const RexSubQuery*>(rex_scalar)) {
+      oss << "subquery(n" << visitNode(subquery->getRelAlg()) << ')';
+    } else if (const auto rex_case = dynamic_cast<const RexCase*>(rex_scalar)) {
+      oss << "case(";
+      for (size_t i = 0; i < rex_case->branchCount(); ++i) {
+        oss << rex(rex_case->getWhen(i)) << "->" << rex(rex_case->getThen(i)) << ',';
+      }
+      oss << rex(rex_case->getElse()) << ')';
+    } else if (const auto window = dynamic_cast<const RexWindowFunctionOperator*>(
+                   rex_scalar)) {
+      oss << "window(" << static_cast<int>(window->getKind()) << ','
+          << window->getType().to_string() << ',' << operands(window) << ",partition=";
+      for (const auto& key : window->getPartitionKeys()) {
+        oss << rex(key.get()) << ',';
+      }
+      oss << "order=";
+      for (const auto& key : window->getOrderKeys()) {
+        oss << rex(key.get()) << ',';
+      }
+      for (const auto& collation : window->getCollation()) {
+        oss << collation.toString() << ',';
+      }
+      oss << windowBound(window->getLowerBound()) << ','
+          << windowBound(window->getUpperBound()) << ',' << window->isRows() << ')';
+    } else if (const auto function = dynamic_cast<const RexFunctionOperator*>(
+                   rex_scalar)) {
+      if (non_deterministic_functions.count(function->getName())) {
+        throw NotRecyclable("calls " + function->getName());
+      }
+      oss << function->getName() << '(' << function->getType().to_string() << ','
+          << operands(function) << ')';
+    } else if (const auto oper = dynamic_cast<const RexOperator*>(rex_scalar)) {
+      oss << "op(" << oper->getOperator() << ',' << oper->getType().to_string() << ','
+          << operands(oper) << ')';
+    } else {
+      throw NotRecyclable("unsupported expression " + rex_scalar->toString());
+    }
+    return oss.str();
+  }
+
+  std::string operands(const RexOperator* oper) {
+    std::string result;
+    for (size_t i = 0; i < oper->size(); ++i) {
+      result += rex(oper->getOperand(i)) + ',';
+    }
+    return result;
+  }
+
+  std::string windowBound(const RexWindowFunctionOperator::RexWindowBound& bound) {
+    std::ostringstream oss;
+    oss << "bound(" << bound.unbounded << bound.preceding << bound.following
+        << bound.is_current_row << ',' << rex(bound.offset.get()) << ','
+        << bound.order_key << ')';
+    return oss.str();
+  }
+
+  std::unordered_map<const RelAlgNode*, size_t> labels_;
+  std::ostringstream definitions_;
+  std::set<int> table_ids_;
+};
+
+size_t get_result_size_bytes(const ResultSet& rows) {
+  size_t size_bytes = sizeof(ResultSet);
+  if (rows.getStorage()) {
+    size_bytes += rows.getBufferSizeBytes(ExecutorDeviceType::CPU);
+  }
+  return size_bytes;
+}
+
+}  // namespace
+
+ResultSetRecycler::ResultSetRecycler(const size_t max_size_bytes)
+    : max_size_bytes_(max_size_bytes) {
+  stats_.max_size_bytes = max_size_bytes_;
+}
+
+std::optional<ExecutionResult> ResultSetRecycler::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = entries_.find(key);
+  // a result set in use by a running query cannot be shared, its cursor is not
+  if (it == entries_.end() || it->second.result.getRows().use_count() > 1) {
+    stats_.misses++;
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  stats_.hits++;
+  const auto& rows = it->second.result.getRows();
+  rows->moveToBegin();
+  return it->second.result;
+}
+
+void ResultSetRecycler::put(const std::string& key,
+                            const ExecutionResult& result,
+                            const int db_id,
+                            const std::set<int>& table_ids) {
+  CHECK(isRecyclable(result));
+  const auto size_bytes = get_result_size_bytes(*result.getRows());
+  if (size_bytes > max_size_bytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeEntry(it);
+  }
+  evictToFit(size_bytes);
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{result, db_id, table_ids, size_bytes, lru_.begin()});
+  stats_.num_entries++;
+  stats_.total_size_bytes += size_bytes;
+}
+
+void ResultSetRecycler::clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  VLOG(1) << "Invalidating " << entries_.size() << " recycled result sets.";
+  entries_.clear();
+  lru_.clear();
+  stats_.num_entries = 0;
+  stats_.total_size_bytes = 0;
+}
+
+void ResultSetRecycler::invalidateTable(const int db_id, const int table_id) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    const auto& entry = it->second;
+    if (entry.db_id == db_id && entry.table_ids.count(table_id)) {
+      removeEntry(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+ResultSetRecycler::Stats ResultSetRecycler::getStats() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return stats_;
+}
+
+std::optional<ResultSetRecycler::PlanKey> ResultSetRecycler::buildPlanKey(
+    const RelAlgNode* node) {
+  try {
+    return PlanKeyBuilder().build(node);
+  } catch (const NotRecyclable& e) {
+    VLOG(1) << "Query result is not recyclable: " << e.what();
+    return std::nullopt;
+  }
+}
+
+bool ResultSetRecycler::isRecyclable(const ExecutionResult& result) {
+  if (result.isFilterPushDownEnabled()) {
+    return false;
+  }
+  const auto& rows = result.getRows();
+  if (!rows || rows->isExplain() || rows->getDeviceType() != ExecutorDeviceType::CPU ||
+      rows->holdsChunks()) {
+    return false;
+  }
+  const auto& lazy_fetch_info = rows->getLazyFetchInfo();
+  return std::none_of(lazy_fetch_info.begin(),
+                      lazy_fetch_info.end(),
+                      [](const ColumnLazyFetchInfo& col_lazy_fetch) {
+                        return col_lazy_fetch.is_lazily_fetched;
+                      });
+}
+
+ResultSetRecycler& ResultSetRecycler::getInstance() {
+  static ResultSetRecycler instance(g_result_set_recycler_max_size);
+  return instance;
+}
+
+void ResultSetRecycler::evictToFit(const size_t incoming_size_bytes) {
+  while (!lru_.empty() &&
+         stats_.total_size_bytes + incoming_size_bytes > max_size_bytes_) {
+    removeEntry(entries_.find(lru_.back()));
+    stats_.evictions++;
+  }
+}
+
+void ResultSetRecycler::removeEntry(std::unordered_map<std::string, Entry>::iterator it) {
+  CHECK(it != entries_.end());
+  stats_.num_entries--;
+  stats_.total_size_bytes -= it->second.size_bytes;
+  lru_.erase(it->second.lru_it);
+  entries_.erase(it);
+}
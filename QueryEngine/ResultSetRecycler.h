@@ -0,0 +1,118 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
+
+class RelAlgNode;
+
+/**
+ * Size bounded cache of query and subquery results, which lets repeated (sub)queries
+ * over unchanged tables skip execution entirely.
+ *
+ * Entries are keyed on a canonical, content based serialization of the RelAlg DAG below
+ * the node which produced the result (see buildPlanKey()), extended by the caller with
+ * the epochs, table generations and dictionary generations of the tables it reads.
+ * Updates, deletes and DDL statements additionally drop the results which read the
+ * modified table through the update / delete triggered cache invalidators.
+ *
+ * A cached result set is handed out only when no other query holds it, since iterating
+ * a result set moves its shared cursor. The least recently used entries are evicted
+ * first once the estimated size of the cached result sets exceeds the budget.
+ */
+class ResultSetRecycler {
+ public:
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+    size_t num_entries{0};
+    size_t total_size_bytes{0};
+    size_t max_size_bytes{0};
+  };
+
+  // Canonical description of a plan subtree and the tables it reads.
+  struct PlanKey {
+    std::string plan;
+    std::set<int> table_ids;
+  };
+
+  ResultSetRecycler(const size_t max_size_bytes);
+
+  // Returns the result cached under the given key, if any is present and not in use.
+  std::optional<ExecutionResult> get(const std::string& key);
+
+  void put(const std::string& key,
+           const ExecutionResult& result,
+           const int db_id,
+           const std::set<int>& table_ids);
+
+  void clear();
+
+  // Drops the results which read the given table.
+  void invalidateTable(const int db_id, const int table_id);
+
+  Stats getStats() const;
+
+  // Returns std::nullopt if the result of the given node must not be recycled, i.e. the
+  // plan reads temporary or foreign tables, modifies a table or calls non-deterministic
+  // functions.
+  static std::optional<PlanKey> buildPlanKey(const RelAlgNode* node);
+
+  // Returns false for result sets which reference memory owned by someone else (lazily
+  // fetched columns, pinned chunks, device buffers) or which are not plain query results.
+  static bool isRecyclable(const ExecutionResult& result);
+
+  static ResultSetRecycler& getInstance();
+
+  static auto getCacheInvalidator() -> std::function<void()> {
+    return []() -> void { getInstance().clear(); };
+  }
+
+  static auto getTableCacheInvalidator() -> std::function<void(const int, const int)> {
+    return [](const int db_id, const int table_id) -> void {
+      getInstance().invalidateTable(db_id, table_id);
+    };
+  }
+
+ private:
+  struct Entry {
+    ExecutionResult result;
+    int db_id;
+    std::set<int> table_ids;
+    size_t size_bytes;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  void evictToFit(const size_t incoming_size_bytes);
+  void removeEntry(std::unordered_map<std::string, Entry>::iterator it);
+
+  const size_t max_size_bytes_;
+
+  mutable std::mutex cache_mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;  // most recently used first
+  Stats stats_;
+};
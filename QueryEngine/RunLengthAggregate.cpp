@@ -0,0 +1,389 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/RunLengthAggregate.h"
+
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/GroupByAndAggregate.h"
+#include "QueryEngine/ResultSetStorage.h"
+#include "Shared/EncodedIntStream.h"
+
+bool g_enable_run_length_aggregate{true};
+
+namespace {
+
+class RunLengthAggregate {
+ public:
+  RunLengthAggregate(const Catalog_Namespace::Catalog& catalog, const int table_id)
+      : catalog_(catalog), table_id_(table_id) {}
+
+  // Filters of the form `col <op> constant`, `col IS NULL` and `col IS NOT NULL`.
+  bool addQual(const Analyzer::Expr* qual) {
+    if (const auto u_oper = dynamic_cast<const Analyzer::UOper*>(qual)) {
+      bool negated{false};
+      auto operand = u_oper;
+      if (u_oper->get_optype() == kNOT) {
+        negated = true;
+        operand = dynamic_cast<const Analyzer::UOper*>(u_oper->get_operand());
+      }
+      if (!operand || operand->get_optype() != kISNULL) {
+        return false;
+      }
+      const auto col_idx = addColumn(operand->get_operand());
+      if (!col_idx) {
+        return false;
+      }
+      quals_.push_back({negated ? kISNOTNULL : kISNULL, *col_idx, 0});
+      return true;
+    }
+    const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+    if (!bin_oper || bin_oper->get_qualifier() != kONE) {
+      return false;
+    }
+    switch (bin_oper->get_optype()) {
+      case kEQ:
+      case kNE:
+      case kLT:
+      case kLE:
+      case kGT:
+      case kGE:
+        break;
+      default:
+        return false;
+    }
+    const auto col_idx = addColumn(bin_oper->get_left_operand());
+    const auto constant =
+        dynamic_cast<const Analyzer::Constant*>(bin_oper->get_right_operand());
+    if (!col_idx || !constant || constant->get_is_null()) {
+      return false;
+    }
+    const auto& col_ti = bin_oper->get_left_operand()->get_type_info();
+    const auto& constant_ti = constant->get_type_info();
+    // time values only compare as integers in the same unit
+    if (!(col_ti.is_integer() && constant_ti.is_integer()) &&
+        (col_ti.get_type() != constant_ti.get_type() ||
+         col_ti.get_dimension() != constant_ti.get_dimension())) {
+      return false;
+    }
+    quals_.push_back({bin_oper->get_optype(),
+                      *col_idx,
+                      extract_from_datum(constant->get_constval(), constant_ti)});
+    return true;
+  }
+
+  // COUNT, SUM, AVG, MIN and MAX of a column, and COUNT(*).
+  bool addTarget(const Analyzer::Expr* target_expr) {
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (!agg_expr || agg_expr->get_is_distinct()) {
+      return false;
+    }
+    const auto agg_kind = agg_expr->get_aggtype();
+    std::optional<size_t> col_idx;
+    if (agg_expr->get_arg()) {
+      col_idx = addColumn(agg_expr->get_arg());
+      if (!col_idx) {
+        return false;
+      }
+    }
+    switch (agg_kind) {
+      case kCOUNT:
+        break;
+      case kSUM:
+      case kAVG:
+        if (!col_idx || !agg_expr->get_arg()->get_type_info().is_integer()) {
+          return false;
+        }
+        break;
+      case kMIN:
+      case kMAX:
+        if (!col_idx) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    targets_.push_back({agg_kind, col_idx, agg_expr->get_type_info()});
+    return true;
+  }
+
+  bool hasColumns() const { return !columns_.empty(); }
+
+  // Sweeps the runs of the fragment, false if a sum overflows.
+  bool aggregate(const Fragmenter_Namespace::FragmentInfo& fragment) {
+    const int64_t num_rows = fragment.getNumTuples();
+    if (!num_rows) {
+      return true;
+    }
+    std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks;
+    for (auto& column : columns_) {
+      const auto chunk_meta_it =
+          fragment.getChunkMetadataMap().find(column.cd->columnId);
+      CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+      ChunkKey chunk_key{catalog_.getCurrentDB().dbId,
+                         fragment.physicalTableId,
+                         column.cd->columnId,
+                         fragment.fragmentId};
+      chunks.push_back(Chunk_NS::Chunk::getChunk(column.cd,
+                                                 &catalog_.getDataMgr(),
+                                                 chunk_key,
+                                                 Data_Namespace::CPU_LEVEL,
+                                                 0,
+                                                 chunk_meta_it->second->numBytes,
+                                                 chunk_meta_it->second->numElements));
+      const auto stream = chunks.back()->getBuffer()->getMemoryPtr();
+      const auto header = reinterpret_cast<const EncodedIntStreamHeader*>(stream);
+      CHECK_EQ(header->byte_width, 0);
+      column.runs = encoded_int_runs(stream);
+      column.num_runs = header->num_runs;
+      column.run_idx = 0;
+    }
+    for (int64_t row = 0; row < num_rows;) {
+      int64_t end = num_rows;
+      for (const auto& column : columns_) {
+        CHECK_LT(column.run_idx, column.num_runs);
+        end = std::min(end, column.runs[column.run_idx].end);
+      }
+      if (std::all_of(quals_.begin(), quals_.end(), [this](const Qual& qual) {
+            return passes(qual);
+          })) {
+        if (!aggregateRows(end - row)) {
+          return false;
+        }
+      }
+      for (auto& column : columns_) {
+        if (column.runs[column.run_idx].end == end) {
+          ++column.run_idx;
+        }
+      }
+      row = end;
+    }
+    return true;
+  }
+
+  ResultSetPtr getResult(Executor* executor) const {
+    QueryMemoryDescriptor query_mem_desc(executor,
+                                         /*entry_count=*/1,
+                                         QueryDescriptionType::Projection,
+                                         /*is_table_function=*/false);
+    std::vector<TargetInfo> target_infos;
+    for (const auto& target : targets_) {
+      query_mem_desc.addColSlotInfo({std::make_tuple(target.ti.get_size(), 8)});
+      target_infos.emplace_back(
+          TargetInfo{false, kCOUNT, target.ti, SQLTypeInfo(kNULLT, false), false, false});
+    }
+    auto result = std::make_shared<ResultSet>(target_infos,
+                                              ExecutorDeviceType::CPU,
+                                              query_mem_desc,
+                                              executor->getRowSetMemoryOwner(),
+                                              executor->getCatalog(),
+                                              executor->blockSize(),
+                                              executor->gridSize());
+    auto slot = result->allocateStorage()->getUnderlyingBuffer();
+    for (const auto& target : targets_) {
+      const auto value = target.getValue();
+      std::memcpy(slot, &value, sizeof(value));
+      slot += 8;
+    }
+    return result;
+  }
+
+ private:
+  // An RL column of the table, along with its current run while sweeping a fragment.
+  struct Column {
+    const ColumnDescriptor* cd;
+    int64_t null_val;
+    const EncodedIntRun* runs{nullptr};
+    int32_t num_runs{0};
+    int32_t run_idx{0};
+
+    int64_t value() const { return runs[run_idx].value; }
+  };
+
+  struct Qual {
+    SQLOps optype;
+    size_t col_idx;
+    int64_t constant;
+  };
+
+  struct Target {
+    SQLAgg agg_kind;
+    std::optional<size_t> col_idx;  // none for COUNT(*)
+    SQLTypeInfo ti;
+    int64_t count{0};  // of the non-null rows
+    int64_t value{0};  // sum, minimum or maximum of the non-null rows
+
+    // The value of the target in the slot layout of its type.
+    int64_t getValue() const {
+      switch (agg_kind) {
+        case kCOUNT:
+          return count;
+        case kAVG: {
+          const double avg = count ? static_cast<double>(value) / count
+                                   : inline_fp_null_val(SQLTypeInfo(kDOUBLE, false));
+          int64_t bits;
+          std::memcpy(&bits, &avg, sizeof(avg));
+          return bits;
+        }
+        default:
+          return count ? value : inline_int_null_val(ti);
+      }
+    }
+  };
+
+  std::optional<size_t> addColumn(const Analyzer::Expr* expr) {
+    // integer columns widened for a comparison or an aggregate keep their values
+    const auto u_oper = dynamic_cast<const Analyzer::UOper*>(expr);
+    if (u_oper && u_oper->get_optype() == kCAST && u_oper->get_type_info().is_integer() &&
+        u_oper->get_operand()->get_type_info().is_integer() &&
+        u_oper->get_type_info().get_size() >=
+            u_oper->get_operand()->get_type_info().get_size()) {
+      expr = u_oper->get_operand();
+    }
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+    if (!col_var || col_var->get_table_id() != table_id_ || col_var->get_rte_idx()) {
+      return std::nullopt;
+    }
+    const auto& ti = col_var->get_type_info();
+    if (ti.get_compression() != kENCODING_RL || !(ti.is_integer() || ti.is_time())) {
+      return std::nullopt;
+    }
+    for (size_t col_idx = 0; col_idx < columns_.size(); ++col_idx) {
+      if (columns_[col_idx].cd->columnId == col_var->get_column_id()) {
+        return col_idx;
+      }
+    }
+    const auto cd = get_column_descriptor(col_var->get_column_id(), table_id_, catalog_);
+    columns_.push_back({cd, inline_int_null_val(ti)});
+    return columns_.size() - 1;
+  }
+
+  bool passes(const Qual& qual) const {
+    const auto& column = columns_[qual.col_idx];
+    const auto value = column.value();
+    const bool is_null = value == column.null_val;
+    switch (qual.optype) {
+      case kISNULL:
+        return is_null;
+      case kISNOTNULL:
+        return !is_null;
+      case kEQ:
+        return !is_null && value == qual.constant;
+      case kNE:
+        return !is_null && value != qual.constant;
+      case kLT:
+        return !is_null && value < qual.constant;
+      case kLE:
+        return !is_null && value <= qual.constant;
+      case kGT:
+        return !is_null && value > qual.constant;
+      case kGE:
+        return !is_null && value >= qual.constant;
+      default:
+        UNREACHABLE();
+    }
+    return false;
+  }
+
+  bool aggregateRows(const int64_t num_rows) {
+    for (auto& target : targets_) {
+      if (!target.col_idx) {
+        target.count += num_rows;
+        continue;
+      }
+      const auto& column = columns_[*target.col_idx];
+      const auto value = column.value();
+      if (value == column.null_val) {
+        continue;
+      }
+      const bool first = !target.count;
+      target.count += num_rows;
+      switch (target.agg_kind) {
+        case kSUM:
+        case kAVG: {
+          int64_t run_sum;
+          if (__builtin_mul_overflow(value, num_rows, &run_sum) ||
+              __builtin_add_overflow(target.value, run_sum, &target.value)) {
+            return false;
+          }
+          break;
+        }
+        case kMIN:
+          target.value = first ? value : std::min(target.value, value);
+          break;
+        case kMAX:
+          target.value = first ? value : std::max(target.value, value);
+          break;
+        default:
+          break;
+      }
+    }
+    return true;
+  }
+
+  const Catalog_Namespace::Catalog& catalog_;
+  const int table_id_;
+  std::vector<Column> columns_;
+  std::vector<Qual> quals_;
+  std::vector<Target> targets_;
+};
+
+}  // namespace
+
+ResultSetPtr execute_run_length_aggregate(const RelAlgExecutionUnit& ra_exe_unit,
+                                          const std::vector<InputTableInfo>& table_infos,
+                                          Executor* executor) {
+  if (!g_enable_run_length_aggregate || ra_exe_unit.input_descs.size() != 1 ||
+      table_infos.size() != 1 ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.estimator ||
+      ra_exe_unit.union_all || !ra_exe_unit.sort_info.order_entries.empty() ||
+      ra_exe_unit.groupby_exprs.size() != 1 || ra_exe_unit.groupby_exprs.front() ||
+      ra_exe_unit.target_exprs.empty()) {
+    return nullptr;
+  }
+  const auto table_id = ra_exe_unit.input_descs.front().getTableId();
+  const auto catalog = executor->getCatalog();
+  CHECK(catalog);
+  const auto td = table_id > 0 ? catalog->getMetadataForTable(table_id) : nullptr;
+  if (!td || td->isForeignTable() || catalog->getDeletedColumnIfRowsDeleted(td)) {
+    return nullptr;
+  }
+  RunLengthAggregate aggregate(*catalog, table_id);
+  for (const auto quals : {&ra_exe_unit.simple_quals, &ra_exe_unit.quals}) {
+    for (const auto& qual : *quals) {
+      if (!aggregate.addQual(qual.get())) {
+        return nullptr;
+      }
+    }
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (!aggregate.addTarget(target_expr)) {
+      return nullptr;
+    }
+  }
+  if (!aggregate.hasColumns()) {
+    return nullptr;
+  }
+  for (const auto& fragment : table_infos.front().info.fragments) {
+    if (!aggregate.aggregate(fragment)) {
+      // the kernel raises the overflow error
+      return nullptr;
+    }
+  }
+  VLOG(1) << "Aggregated the runs of table " << td->tableName;
+  return aggregate.getResult(executor);
+}
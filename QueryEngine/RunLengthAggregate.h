@@ -0,0 +1,41 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RunLengthAggregate.h
+ * @brief   Evaluation of non-grouped aggregates on the runs of RL encoded columns.
+ *
+ * Filters and aggregates on a single table which only reference RL encoded integer and
+ * time columns are evaluated once per stretch of rows over which none of the referenced
+ * columns changes value, rather than once per row by a generated kernel. All rows of
+ * such a stretch pass or fail the filters together and are aggregated in one step.
+ */
+
+#pragma once
+
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "QueryEngine/ResultSet.h"
+
+extern bool g_enable_run_length_aggregate;
+
+class Executor;
+
+// The single row result of the aggregates of the execution unit evaluated on the runs of
+// its columns, nullptr if the execution unit doesn't qualify.
+ResultSetPtr execute_run_length_aggregate(const RelAlgExecutionUnit& ra_exe_unit,
+                                          const std::vector<InputTableInfo>& table_infos,
+                                          Executor* executor);
@@ -358,6 +358,58 @@ extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
              : 0;
 }
 
+// Fibonacci hashing, the top bits of the product are the best mixed ones.
+FORCE_INLINE uint64_t hash_set_slot(const int64_t val, const int64_t hash_set_bits) {
+  return (static_cast<uint64_t>(val) * 0x9E3779B97F4A7C15ULL) >> (64 - hash_set_bits);
+}
+
+/**
+ * Sets of values whose range is too wide for a bitmap are open addressing hash sets of
+ * 2^hash_set_bits slots, with linear probing and empty slots holding the null value.
+ * Returns whether `val` wasn't in the set yet.
+ */
+extern "C" bool hash_set_insert(int64_t* hash_set,
+                                const int64_t val,
+                                const int64_t hash_set_bits,
+                                const int64_t null_val) {
+  const uint64_t slot_mask = (uint64_t(1) << hash_set_bits) - 1;
+  for (auto slot = hash_set_slot(val, hash_set_bits);; slot = (slot + 1) & slot_mask) {
+    if (hash_set[slot] == val) {
+      return false;
+    }
+    if (hash_set[slot] == null_val) {
+      hash_set[slot] = val;
+      return true;
+    }
+  }
+}
+
+extern "C" ALWAYS_INLINE int8_t hash_set_contains(const int64_t hash_set,
+                                                  const int64_t val,
+                                                  const int64_t min_val,
+                                                  const int64_t max_val,
+                                                  const int64_t hash_set_bits,
+                                                  const int64_t null_val,
+                                                  const int8_t null_bool_val) {
+  if (val == null_val) {
+    return null_bool_val;
+  }
+  if (val < min_val || val > max_val) {
+    return 0;
+  }
+  const auto slots = reinterpret_cast<const int64_t*>(hash_set);
+  const uint64_t slot_mask = (uint64_t(1) << hash_set_bits) - 1;
+  // the set is at most half full, a missing value ends at an empty slot soon
+  for (auto slot = hash_set_slot(val, hash_set_bits);; slot = (slot + 1) & slot_mask) {
+    if (slots[slot] == val) {
+      return 1;
+    }
+    if (slots[slot] == null_val) {
+      return 0;
+    }
+  }
+}
+
 extern "C" ALWAYS_INLINE int64_t agg_sum(int64_t* agg, const int64_t val) {
   const auto old = *agg;
   *agg += val;
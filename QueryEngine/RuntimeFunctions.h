@@ -113,6 +113,11 @@ extern "C" void agg_count_distinct_bitmap(int64_t* agg,
                                           const int64_t val,
                                           const int64_t min_val);
 
+extern "C" bool hash_set_insert(int64_t* hash_set,
+                                const int64_t val,
+                                const int64_t hash_set_bits,
+                                const int64_t null_val);
+
 #define EMPTY_KEY_64 std::numeric_limits<int64_t>::max()
 #define EMPTY_KEY_32 std::numeric_limits<int32_t>::max()
 #define EMPTY_KEY_16 std::numeric_limits<int16_t>::max()
@@ -264,6 +269,10 @@ extern "C" int64_t fixed_width_small_date_decode_noinline(const int8_t* byte_str
                                                           const int64_t ret_null_val,
                                                           const int64_t pos);
 
+extern "C" int64_t encoded_int_decode_noinline(const int8_t* byte_stream,
+                                               const int64_t null_val,
+                                               const int64_t pos);
+
 extern "C" int8_t* extract_str_ptr_noinline(const uint64_t str_and_len);
 
 extern "C" int32_t extract_str_len_noinline(const uint64_t str_and_len);
@@ -108,6 +108,10 @@ ResultSetPtr TableFunctionExecutionContext::execute(
       CHECK_EQ(col_index, -1);
     }
     if (auto col_var = dynamic_cast<Analyzer::ColumnVar*>(input_expr)) {
+      if (col_var->get_type_info().is_rl_or_diff_encoded()) {
+        throw std::runtime_error(
+            "Table function inputs from RL or DIFF encoded columns not supported yet");
+      }
       auto table_id = col_var->get_table_id();
       auto table_info_it = std::find_if(
           table_infos.begin(), table_infos.end(), [&table_id](const auto& table_info) {
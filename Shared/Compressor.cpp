@@ -208,6 +208,55 @@ void BloscCompressor::getBloscBufferSizes(const uint8_t* data_ptr,
   blosc_cbuffer_sizes(data_ptr, num_bytes_uncompressed, num_bytes_compressed, block_size);
 }
 
+static_assert(BloscCompressor::kMaxOverhead == BLOSC_MAX_OVERHEAD,
+              "Unexpected blosc header size");
+
+size_t BloscCompressor::compressWithContext(const int8_t* buffer,
+                                            const size_t buffer_size,
+                                            int8_t* compressed_buffer,
+                                            const size_t compressed_buffer_size,
+                                            const char* compressor,
+                                            const size_t type_size) {
+  CHECK_GE(compressed_buffer_size, buffer_size + kMaxOverhead);
+  const auto compressed_len = blosc_compress_ctx(5,
+                                                 type_size > 1,
+                                                 type_size,
+                                                 buffer_size,
+                                                 buffer,
+                                                 compressed_buffer,
+                                                 compressed_buffer_size,
+                                                 compressor,
+                                                 0,
+                                                 1);
+  if (compressed_len <= 0) {
+    throw CompressionFailedError(std::string("failed to compress page of length ") +
+                                 std::to_string(buffer_size) + " with " + compressor);
+  }
+  return compressed_len;
+}
+
+size_t BloscCompressor::decompressWithContext(const int8_t* compressed_buffer,
+                                              int8_t* decompressed_buffer,
+                                              const size_t decompressed_buffer_size) {
+  const auto decompressed_len = blosc_decompress_ctx(
+      compressed_buffer, decompressed_buffer, decompressed_buffer_size, 1);
+  if (decompressed_len < 0) {
+    throw CompressionFailedError(
+        std::string("failed to decompress page into buffer of size ") +
+        std::to_string(decompressed_buffer_size));
+  }
+  return decompressed_len;
+}
+
+size_t BloscCompressor::getCompressedSize(const int8_t* compressed_buffer_header) {
+  size_t num_bytes_uncompressed, num_bytes_compressed, block_size;
+  blosc_cbuffer_sizes(compressed_buffer_header,
+                      &num_bytes_uncompressed,
+                      &num_bytes_compressed,
+                      &block_size);
+  return num_bytes_compressed;
+}
+
 BloscCompressor* BloscCompressor::instance = NULL;
 
 BloscCompressor* BloscCompressor::getCompressor() {
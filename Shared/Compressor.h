@@ -77,6 +77,25 @@ class BloscCompressor {
                            size_t* num_bytes_uncompressed,
                            size_t* block_size);
 
+  // Bytes a compressed buffer may exceed its input by, i.e. BLOSC_MAX_OVERHEAD.
+  static constexpr size_t kMaxOverhead = 16;
+
+  // Thread safe, single threaded variants used for FileMgr pages. They run on a private
+  // blosc context and neither take compressor_lock nor depend on the global compressor.
+  // compressor is a blosc compressor name and type_size the width used for shuffling.
+  static size_t compressWithContext(const int8_t* buffer,
+                                    const size_t buffer_size,
+                                    int8_t* compressed_buffer,
+                                    const size_t compressed_buffer_size,
+                                    const char* compressor,
+                                    const size_t type_size);
+  // Returns the number of decompressed bytes, at most decompressed_buffer_size.
+  static size_t decompressWithContext(const int8_t* compressed_buffer,
+                                      int8_t* decompressed_buffer,
+                                      const size_t decompressed_buffer_size);
+  // Size of the compressed buffer starting with the kMaxOverhead bytes of header.
+  static size_t getCompressedSize(const int8_t* compressed_buffer_header);
+
   int setThreads(size_t num_threads);
 
   int setCompressor(std::string& compressor);
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    EncodedIntStream.h
+ * @brief   Layout of the chunks of RL (run length) and DIFF encoded columns.
+ *
+ * Both layouts start with the header below and decode to logical values, with the
+ * logical null of the column for nulls:
+ *  - DIFF: one `byte_width` wide offset from `base` per row. The smallest value of the
+ *    offset type marks a null. The width is the declared size of the column and only
+ *    grows for chunks whose value range doesn't fit it.
+ *  - RL: `num_runs` runs of equal values, ordered by their (exclusive) end row.
+ *
+ * Multi-fragment columns linearized by the executor are DIFF streams with eight byte
+ * offsets from zero, which keeps a single decoder for all of them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "funcannotations.h"
+
+struct EncodedIntStreamHeader {
+  int64_t base;
+  int32_t byte_width;  // zero for run length streams
+  int32_t num_runs;
+};
+
+struct EncodedIntRun {
+  int64_t end;
+  int64_t value;
+};
+
+DEVICE inline int64_t encoded_int_diff_null_sentinel(const int32_t byte_width) {
+  return byte_width >= 8 ? -9223372036854775807LL - 1
+                         : -(int64_t(1) << (8 * byte_width - 1));
+}
+
+DEVICE inline const EncodedIntRun* encoded_int_runs(const int8_t* byte_stream) {
+  return reinterpret_cast<const EncodedIntRun*>(byte_stream +
+                                                sizeof(EncodedIntStreamHeader));
+}
+
+#ifndef __CUDACC__
+
+inline size_t linearized_encoded_int_stream_size(const size_t num_elems) {
+  return sizeof(EncodedIntStreamHeader) + num_elems * sizeof(int64_t);
+}
+
+//! Decodes the first `num_elems` rows of a stream into `out`, nulls as `null_val`.
+inline void decode_encoded_int_stream(const int8_t* byte_stream,
+                                      const size_t num_elems,
+                                      const int64_t null_val,
+                                      int64_t* out) {
+  if (!num_elems) {
+    return;
+  }
+  const auto header = reinterpret_cast<const EncodedIntStreamHeader*>(byte_stream);
+  if (header->byte_width) {
+    const auto payload = byte_stream + sizeof(EncodedIntStreamHeader);
+    const auto null_sentinel = encoded_int_diff_null_sentinel(header->byte_width);
+    for (size_t i = 0; i < num_elems; ++i) {
+      int64_t offset{0};
+      switch (header->byte_width) {
+        case 1:
+          offset = reinterpret_cast<const int8_t*>(payload)[i];
+          break;
+        case 2:
+          offset = reinterpret_cast<const int16_t*>(payload)[i];
+          break;
+        case 4:
+          offset = reinterpret_cast<const int32_t*>(payload)[i];
+          break;
+        default:
+          offset = reinterpret_cast<const int64_t*>(payload)[i];
+          break;
+      }
+      out[i] = offset == null_sentinel ? null_val : header->base + offset;
+    }
+    return;
+  }
+  const auto runs = encoded_int_runs(byte_stream);
+  size_t row = 0;
+  for (int32_t run_idx = 0; run_idx < header->num_runs && row < num_elems; ++run_idx) {
+    for (; row < static_cast<size_t>(runs[run_idx].end) && row < num_elems; ++row) {
+      out[row] = runs[run_idx].value;
+    }
+  }
+}
+
+#endif  // __CUDACC__
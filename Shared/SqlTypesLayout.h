@@ -134,6 +134,25 @@ inline int64_t inline_fixed_encoding_null_val(const SQLTypeInfo& ti) {
         CHECK(false) << "Unknown size for dictionary encoded type: " << ti.get_size();
 #else
         CHECK(false);
+#endif
+    }
+  }
+  if (ti.get_compression() == kENCODING_RL || ti.get_compression() == kENCODING_DIFF) {
+    // run length and diff encoded chunks decode to the logical values
+    switch (ti.get_logical_size()) {
+      case 1:
+        return inline_int_null_value<int8_t>();
+      case 2:
+        return inline_int_null_value<int16_t>();
+      case 4:
+        return inline_int_null_value<int32_t>();
+      case 8:
+        return inline_int_null_value<int64_t>();
+      default:
+#ifndef __CUDACC__
+        CHECK(false) << "Unknown size for encoded type: " << ti.get_logical_size();
+#else
+        CHECK(false);
 #endif
     }
   }
@@ -72,6 +72,10 @@ struct SystemParameters {
       5000;  // calcite send/receive timeout (connect timeout hard coded to 2s)
   size_t calcite_keepalive = false;  // calcite keepalive connection
   int num_executors = 1;
+  size_t dispatch_queue_memory_budget = 0;  // admission limit on estimated query memory
+                                            // [bytes], 0 disables admission control
+  std::string dispatch_queue_interactive_users;  // comma separated, highest priority
+  std::string dispatch_queue_batch_users;        // comma separated, lowest priority
   int num_sessions = -1;  // maximum number of user sessions
 
   SystemParameters() : cuda_block_size(0), cuda_grid_size(0), calcite_max_mem(1024) {}
@@ -323,7 +323,8 @@ class SQLTypeInfo {
   HOST DEVICE inline int get_comp_param() const { return comp_param; }
   HOST DEVICE inline int get_size() const { return size; }
   inline int get_logical_size() const {
-    if (compression == kENCODING_FIXED || compression == kENCODING_DATE_IN_DAYS) {
+    if (compression == kENCODING_FIXED || compression == kENCODING_DATE_IN_DAYS ||
+        is_rl_or_diff_encoded()) {
       SQLTypeInfo ti(type, dimension, scale, notnull, kENCODING_NONE, 0, subtype);
       return ti.get_size();
     }
@@ -730,6 +731,12 @@ class SQLTypeInfo {
 
   inline bool is_date() const { return type == kDATE; }
 
+  // Chunks of RL and DIFF encoded columns can't be written in place by row and carry
+  // their own header, see Shared/EncodedIntStream.h.
+  inline bool is_rl_or_diff_encoded() const {
+    return compression == kENCODING_RL || compression == kENCODING_DIFF;
+  }
+
   inline bool is_high_precision_timestamp() const {
     if (type == kTIMESTAMP) {
       const auto dimension = get_dimension();
@@ -765,13 +772,12 @@ class SQLTypeInfo {
       case kSMALLINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
             return sizeof(int16_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
-            return comp_param / 8;
-          case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return comp_param / 8;
           default:
             assert(false);
         }
@@ -779,14 +785,13 @@ class SQLTypeInfo {
       case kINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
             return sizeof(int32_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
           case kENCODING_GEOINT:
-            return comp_param / 8;
-          case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return comp_param / 8;
           default:
             assert(false);
         }
@@ -796,13 +801,12 @@ class SQLTypeInfo {
       case kDECIMAL:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
             return sizeof(int64_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
-            return comp_param / 8;
-          case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return comp_param / 8;
           default:
             assert(false);
         }
@@ -849,7 +853,9 @@ class SQLTypeInfo {
             }
             return comp_param / 8;
           case kENCODING_RL:
+            return sizeof(int64_t);
           case kENCODING_DIFF:
+            return comp_param / 8;
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -912,7 +918,8 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
   if (encoding == kENCODING_DATE_IN_DAYS ||
-      (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
+      ((encoding == kENCODING_FIXED || type_info.is_rl_or_diff_encoded()) &&
+       type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
   return SQLTypeInfo(type_info.get_type(),
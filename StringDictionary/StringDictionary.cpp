@@ -20,6 +20,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <algorithm>
 #include <future>
 #include <iostream>
 #include <string_view>
@@ -37,6 +38,7 @@
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
 #include "StringDictionaryClient.h"
+#include "StringDictionaryProxy.h"
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
 
@@ -88,7 +90,9 @@ string_dict_hash_t hash_string(const std::string_view& str) {
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_trigram_index{false};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
+std::atomic<uint64_t> StringDictionary::next_instance_id_{0};
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
 
@@ -124,6 +128,13 @@ StringDictionary::StringDictionary(const std::string& folder,
         (storage_path / boost::filesystem::path("DictPayload")).string();
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
+    trigram_index_path_ =
+        (storage_path / boost::filesystem::path("DictTrigrams")).string();
+    if (!recover) {
+      // an index left by a previous dictionary in this folder does not apply
+      boost::system::error_code ec;
+      boost::filesystem::remove(trigram_index_path_, ec);
+    }
     payload_file_size_ = omnisci::file_size(payload_fd_);
     offset_file_size_ = omnisci::file_size(offset_fd_);
   }
@@ -201,6 +212,7 @@ StringDictionary::StringDictionary(const std::string& folder,
       if (dictionary_futures.size() != 0) {
         processDictionaryFutures(dictionary_futures);
       }
+      indexNewStringsUnlocked();
       VLOG(1) << "Opened string dictionary " << folder << " # Strings: " << str_count_
               << " Hash table size: " << string_id_string_dict_hash_table_.size()
               << " Fill rate: "
@@ -355,6 +367,62 @@ void StringDictionary::hashStrings(const std::vector<String>& string_vec,
                     });
 }
 
+/**
+ * Fills in the ids of the input strings already in the dictionary, and nulls for the
+ * empty ones, under the read lock only. Bulk adds then take the write lock for the
+ * strings whose indexes are returned, so ingesting mostly strings seen before doesn't
+ * stall the queries reading the dictionary meanwhile.
+ */
+template <class T, class String>
+std::vector<size_t> StringDictionary::getIdsOfExistingStrings(
+    const std::vector<String>& input_strings,
+    const std::vector<string_dict_hash_t>& input_strings_hashes,
+    T* output_string_ids,
+    const bool parallel) const {
+  std::vector<uint8_t> is_new_string(input_strings.size(), 0);
+  auto get_ids = [&](const size_t begin, const size_t end) {
+    for (size_t input_string_idx = begin; input_string_idx < end; ++input_string_idx) {
+      const auto& input_string = input_strings[input_string_idx];
+      // Currently we make empty strings null
+      if (input_string.empty()) {
+        output_string_ids[input_string_idx] = inline_int_null_value<T>();
+        continue;
+      }
+      // TODO: Recover gracefully if an input string is too long
+      CHECK(input_string.size() <= MAX_STRLEN);
+      const auto string_id =
+          string_id_string_dict_hash_table_[computeBucket(
+              input_strings_hashes[input_string_idx],
+              input_string,
+              string_id_string_dict_hash_table_)];
+      if (string_id == INVALID_STR_ID) {
+        is_new_string[input_string_idx] = 1;
+      } else {
+        output_string_ids[input_string_idx] = string_id;
+      }
+    }
+  };
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (parallel) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, input_strings.size()),
+                        [&get_ids](const tbb::blocked_range<size_t>& r) {
+                          get_ids(r.begin(), r.end());
+                        });
+    } else {
+      get_ids(0, input_strings.size());
+    }
+  }
+  std::vector<size_t> new_string_idxs;
+  for (size_t input_string_idx = 0; input_string_idx < input_strings.size();
+       ++input_string_idx) {
+    if (is_new_string[input_string_idx]) {
+      new_string_idxs.push_back(input_string_idx);
+    }
+  }
+  return new_string_idxs;
+}
+
 template <class T, class String>
 void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
                                     T* output_string_ids) {
@@ -367,22 +435,28 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
     getOrAddBulkRemote(input_strings, output_string_ids);
     return;
   }
+  std::vector<string_dict_hash_t> input_strings_hashes(input_strings.size());
+  for (size_t idx = 0; idx < input_strings.size(); ++idx) {
+    if (!input_strings[idx].empty()) {
+      input_strings_hashes[idx] = hash_string(input_strings[idx]);
+    }
+  }
+  const auto new_string_idxs = getIdsOfExistingStrings(
+      input_strings, input_strings_hashes, output_string_ids, /*parallel=*/false);
+  if (new_string_idxs.empty()) {
+    return;
+  }
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
 
   const size_t initial_str_count = str_count_;
-  size_t idx = 0;
-  for (const auto& input_string : input_strings) {
-    if (input_string.empty()) {
-      output_string_ids[idx++] = inline_int_null_value<T>();
-      continue;
-    }
-    CHECK(input_string.size() <= MAX_STRLEN);
-
-    const string_dict_hash_t input_string_hash = hash_string(input_string);
+  for (const auto idx : new_string_idxs) {
+    const auto& input_string = input_strings[idx];
+    const string_dict_hash_t input_string_hash = input_strings_hashes[idx];
+    // another writer may have added the string since it was looked up
     uint32_t hash_bucket =
         computeBucket(input_string_hash, input_string, string_id_string_dict_hash_table_);
     if (string_id_string_dict_hash_table_[hash_bucket] != INVALID_STR_ID) {
-      output_string_ids[idx++] = string_id_string_dict_hash_table_[hash_bucket];
+      output_string_ids[idx] = string_id_string_dict_hash_table_[hash_bucket];
       continue;
     }
     // need to add record to dictionary
@@ -408,12 +482,13 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
     }
     const int32_t string_id = static_cast<int32_t>(str_count_);
     string_id_string_dict_hash_table_[hash_bucket] = string_id;
-    output_string_ids[idx++] = string_id;
+    output_string_ids[idx] = string_id;
     ++str_count_;
   }
   const size_t num_strings_added = str_count_ - initial_str_count;
   if (num_strings_added > 0) {
     invalidateInvertedIndex();
+    indexNewStringsUnlocked();
   }
 }
 
@@ -428,6 +503,11 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   // as the string hashing does not need to be behind the subsequent write_lock
   std::vector<string_dict_hash_t> input_strings_hashes(input_strings.size());
   hashStrings(input_strings, input_strings_hashes);
+  const auto new_string_idxs = getIdsOfExistingStrings(
+      input_strings, input_strings_hashes, output_string_ids, /*parallel=*/true);
+  if (new_string_idxs.empty()) {
+    return;
+  }
 
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   size_t shadow_str_count =
@@ -435,17 +515,9 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   const size_t storage_high_water_mark = shadow_str_count;
   std::vector<size_t> string_memory_ids;
   size_t sum_new_string_lengths = 0;
-  string_memory_ids.reserve(input_strings.size());
-  size_t input_string_idx{0};
-  for (const auto& input_string : input_strings) {
-    // Currently we make empty strings null
-    if (input_string.empty()) {
-      output_string_ids[input_string_idx++] = inline_int_null_value<T>();
-      continue;
-    }
-    // TODO: Recover gracefully if an input string is too long
-    CHECK(input_string.size() <= MAX_STRLEN);
-
+  string_memory_ids.reserve(new_string_idxs.size());
+  for (const auto input_string_idx : new_string_idxs) {
+    const auto& input_string = input_strings[input_string_idx];
     if (fillRateIsHigh(shadow_str_count)) {
       // resize when more than 50% is full
       increaseHashTableCapacityFromStorageAndMemory(shadow_str_count,
@@ -469,7 +541,7 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
     // (computeBucketFromStorageAndMemory) already checked to ensure the input string and
     // bucket string are equal)
     if (string_id_string_dict_hash_table_[hash_bucket] != INVALID_STR_ID) {
-      output_string_ids[input_string_idx++] =
+      output_string_ids[input_string_idx] =
           string_id_string_dict_hash_table_[hash_bucket];
       continue;
     }
@@ -491,13 +563,14 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
     if (materialize_hashes_) {
       hash_cache_[shadow_str_count] = input_string_hash;
     }
-    output_string_ids[input_string_idx++] = shadow_str_count++;
+    output_string_ids[input_string_idx] = shadow_str_count++;
   }
   appendToStorageBulk(input_strings, string_memory_ids, sum_new_string_lengths);
   const size_t num_strings_added = shadow_str_count - str_count_;
   str_count_ = shadow_str_count;
   if (num_strings_added > 0) {
     invalidateInvertedIndex();
+    indexNewStringsUnlocked();
   }
 }
 template void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
@@ -651,18 +724,32 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  // only the strings holding all the trigrams of the pattern literals can match it
+  std::vector<int32_t> candidate_ids;
+  const auto trigram_index = getTrigramIndexUnlocked();
+  const bool use_candidates =
+      trigram_index &&
+      trigram_index->getCandidates(
+          TrigramIndex::getLikeLiterals(pattern, is_simple, escape),
+          generation,
+          candidate_ids);
+  const size_t candidate_count = use_candidates ? candidate_ids.size() : generation;
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
-                          generation,
+                          &candidate_ids,
+                          use_candidates,
+                          candidate_count,
                           icase,
                           is_simple,
                           escape,
                           worker_idx,
                           worker_count,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
+      for (size_t candidate_idx = worker_idx; candidate_idx < candidate_count;
+           candidate_idx += worker_count) {
+        const int32_t string_id =
+            use_candidates ? candidate_ids[candidate_idx] : candidate_idx;
         const auto str = getStringUnlocked(string_id);
         if (is_like(str, pattern, icase, is_simple, escape)) {
           worker_results[worker_idx].push_back(string_id);
@@ -923,16 +1010,27 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  std::vector<int32_t> candidate_ids;
+  const auto trigram_index = getTrigramIndexUnlocked();
+  const bool use_candidates =
+      trigram_index &&
+      trigram_index->getCandidates(
+          TrigramIndex::getRegexpLiterals(pattern), generation, candidate_ids);
+  const size_t candidate_count = use_candidates ? candidate_ids.size() : generation;
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
-                          generation,
+                          &candidate_ids,
+                          use_candidates,
+                          candidate_count,
                           escape,
                           worker_idx,
                           worker_count,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
+      for (size_t candidate_idx = worker_idx; candidate_idx < candidate_count;
+           candidate_idx += worker_count) {
+        const int32_t string_id =
+            use_candidates ? candidate_ids[candidate_idx] : candidate_idx;
         const auto str = getStringUnlocked(string_id);
         if (is_regexp_like(str, pattern, escape)) {
           worker_results[worker_idx].push_back(string_id);
@@ -1099,6 +1197,7 @@ int32_t StringDictionary::getOrAddImpl(const std::string_view& str) noexcept {
     }
     ++str_count_;
     invalidateInvertedIndex();
+    indexNewStringsUnlocked();
   }
   return string_id_string_dict_hash_table_[bucket];
 }
@@ -1383,6 +1482,41 @@ void StringDictionary::invalidateInvertedIndex() noexcept {
   compare_cache_.invalidateInvertedIndex();
 }
 
+/**
+ * Indexes the strings added since the last call in the trigram index, which is created
+ * on first use from the copy saved at the last checkpoint if any. Called by the paths
+ * adding strings so that queries find the index up to date. Must be called with the
+ * write lock held.
+ */
+void StringDictionary::indexNewStringsUnlocked() const {
+  if (!g_enable_stringdict_trigram_index) {
+    return;
+  }
+  if (!trigram_index_) {
+    trigram_index_ = std::make_unique<TrigramIndex>();
+    if (!trigram_index_path_.empty() && trigram_index_->load(trigram_index_path_)) {
+      if (trigram_index_->indexedCount() > str_count_) {
+        // the strings past the last checkpoint were not recovered
+        trigram_index_ = std::make_unique<TrigramIndex>();
+      }
+    }
+    trigram_index_saved_count_ = trigram_index_->indexedCount();
+  }
+  for (size_t string_id = trigram_index_->indexedCount(); string_id < str_count_;
+       ++string_id) {
+    trigram_index_->addString(string_id, getStringFromStorageFast(string_id));
+  }
+}
+
+/**
+ * Returns the trigram index, only built here for dictionaries populated before it was
+ * enabled. Must be called with the write lock held.
+ */
+const TrigramIndex* StringDictionary::getTrigramIndexUnlocked() const {
+  indexNewStringsUnlocked();
+  return trigram_index_.get();
+}
+
 // TODO 5 Mar 2021 Nothing will undo the writes to dictionary currently on a failed
 // load.  The next write to the dictionary that does checkpoint will make the
 // uncheckpointed data be written to disk. Only option is a table truncate, and thats
@@ -1403,9 +1537,125 @@ bool StringDictionary::checkpoint() noexcept {
         (omnisci::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
   ret = ret && (omnisci::fsync(offset_fd_) == 0);
   ret = ret && (omnisci::fsync(payload_fd_) == 0);
+  if (ret && g_enable_stringdict_trigram_index) {
+    // rewriting the whole index is only worth it once it grew by a tenth, it's written
+    // from a copy so that adds and queries don't wait for the disk
+    std::unique_ptr<TrigramIndex> trigram_index_snapshot;
+    {
+      mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+      if (trigram_index_) {
+        const auto indexed_count = trigram_index_->indexedCount();
+        if (indexed_count - trigram_index_saved_count_ >
+            std::max(indexed_count / 10, size_t(1))) {
+          trigram_index_snapshot = std::make_unique<TrigramIndex>(*trigram_index_);
+        }
+      }
+    }
+    if (trigram_index_snapshot && trigram_index_snapshot->save(trigram_index_path_)) {
+      mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+      trigram_index_saved_count_ =
+          std::max(trigram_index_saved_count_, trigram_index_snapshot->indexedCount());
+    }
+  }
   return ret;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getTranslationMap(
+    const std::shared_ptr<const StringDictionary>& dest_dict_ptr,
+    const size_t source_generation,
+    const size_t dest_generation) const {
+  // the maps of the least recently used destinations are dropped past this many
+  constexpr size_t kMaxTranslationMapCount{8};
+  CHECK(dest_dict_ptr);
+  const auto dest_dict = dest_dict_ptr.get();
+  if (client_ || dest_dict->client_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> translation_maps_lock(translation_maps_mutex_);
+  for (auto it = translation_maps_.begin(); it != translation_maps_.end();) {
+    it = it->second.dest_dict.expired() ? translation_maps_.erase(it) : std::next(it);
+  }
+  auto& translation_map = translation_maps_[dest_dict->instance_id_];
+  translation_map.last_use = ++translation_map_uses_;
+  if (translation_map.ids && translation_map.source_generation == source_generation &&
+      translation_map.dest_generation == dest_generation) {
+    return translation_map.ids;
+  }
+  if (translation_maps_.size() > kMaxTranslationMapCount) {
+    const auto lru_it = std::min_element(
+        translation_maps_.begin(),
+        translation_maps_.end(),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.second.last_use < rhs.second.last_use;
+        });
+    translation_maps_.erase(lru_it);
+  }
+  auto ids = std::make_shared<std::vector<int32_t>>(source_generation, INVALID_STR_ID);
+  if (dest_dict == this) {
+    for (size_t string_id = 0; string_id < std::min(source_generation, dest_generation);
+         ++string_id) {
+      (*ids)[string_id] = string_id;
+    }
+  } else {
+    // always lock the dictionaries in the same order, translations may go both ways
+    const auto first_dict = instance_id_ < dest_dict->instance_id_ ? this : dest_dict;
+    const auto second_dict = first_dict == this ? dest_dict : this;
+    mapd_shared_lock<mapd_shared_mutex> first_read_lock(first_dict->rw_mutex_);
+    mapd_shared_lock<mapd_shared_mutex> second_read_lock(second_dict->rw_mutex_);
+    CHECK_LE(source_generation, str_count_);
+    CHECK_LE(dest_generation, dest_dict->str_count_);
+    const auto& dest_hash_table = dest_dict->string_id_string_dict_hash_table_;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, source_generation),
+        [this, dest_dict, dest_generation, &dest_hash_table, &ids](
+            const tbb::blocked_range<size_t>& r) {
+          for (size_t string_id = r.begin(); string_id != r.end(); ++string_id) {
+            const auto str = getStringFromStorageFast(string_id);
+            const auto dest_string_id = dest_hash_table[dest_dict->computeBucket(
+                hash_string(str), str, dest_hash_table)];
+            (*ids)[string_id] = truncate_to_generation(dest_string_id, dest_generation);
+          }
+        });
+  }
+  translation_map = {
+      dest_dict_ptr, source_generation, dest_generation, ids, translation_map.last_use};
+  return ids;
+}
+
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getSortedRanks(
+    const size_t sorted_count,
+    const size_t generation) {
+  // ranking sorts every string of the dictionary, sorting fewer ids than a fraction of
+  // them is cheaper comparing their strings
+  constexpr size_t kMinSortedFraction{8};
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (client_) {
+      return nullptr;
+    }
+    const auto string_count = std::min(generation, str_count_);
+    const size_t ranked_count = sorted_ranks_ ? sorted_ranks_->size() : 0;
+    if (ranked_count >= string_count ||
+        sorted_count < string_count / kMinSortedFraction) {
+      return sorted_ranks_;
+    }
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  if (sorted_ranks_ && sorted_ranks_->size() == str_count_) {
+    return sorted_ranks_;
+  }
+  if (sorted_cache.size() < str_count_) {
+    buildSortedCache();
+  }
+  CHECK_EQ(sorted_cache.size(), str_count_);
+  auto sorted_ranks = std::make_shared<std::vector<int32_t>>(str_count_);
+  for (size_t rank = 0; rank < sorted_cache.size(); ++rank) {
+    (*sorted_ranks)[sorted_cache[rank]] = rank;
+  }
+  sorted_ranks_ = sorted_ranks;
+  return sorted_ranks_;
+}
+
 void StringDictionary::buildSortedCache() {
   // This method is not thread-safe.
   const auto cur_cache_size = sorted_cache.size();
@@ -1459,16 +1709,16 @@ void StringDictionary::populate_string_ids(
     StringDictionary* dest_dict,
     const std::vector<int32_t>& source_ids,
     const StringDictionary* source_dict,
-    const std::map<int32_t, std::string> transient_mapping) {
+    const std::vector<std::string_view>& transient_strings) {
   std::vector<std::string> strings;
 
   for (const int32_t source_id : source_ids) {
     if (source_id == std::numeric_limits<int32_t>::min()) {
       strings.emplace_back("");
     } else if (source_id < 0) {
-      if (auto string_itr = transient_mapping.find(source_id);
-          string_itr != transient_mapping.end()) {
-        strings.emplace_back(string_itr->second);
+      if (const auto transient_idx = StringDictionaryProxy::transientIdToIndex(source_id);
+          transient_idx < transient_strings.size()) {
+        strings.emplace_back(transient_strings[transient_idx]);
       } else {
         throw std::runtime_error("Unexpected negative source ID");
       }
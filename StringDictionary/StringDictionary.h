@@ -21,14 +21,19 @@
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
 #include "LeafHostInfo.h"
+#include "TrigramIndex.h"
 
+#include <atomic>
 #include <future>
 #include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_trigram_index;
 
 class StringDictionaryClient;
 
@@ -74,6 +79,18 @@ class StringDictionary {
                                   const std::string& comp_operator,
                                   const size_t generation);
 
+  /**
+   * Returns the rank of every string in the sort order of the dictionary, indexed by
+   * string id, so that ids can be ordered as integers. The ranks are rebuilt from the
+   * incrementally merged sorted cache when strings were added since the last call, and
+   * the ranks of earlier generations remain ordered the same way. They are only rebuilt
+   * to sort many ids relative to the strings below `generation`, for `sorted_count` ids
+   * the ranks last built are returned as is, which can miss the latest strings or be
+   * nullptr. Returns nullptr for remote dictionaries.
+   */
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks(const size_t sorted_count,
+                                                             const size_t generation);
+
   std::vector<int32_t> getRegexpLike(const std::string& pattern,
                                      const char escape,
                                      const size_t generation) const;
@@ -82,6 +99,17 @@ class StringDictionary {
 
   bool checkpoint() noexcept;
 
+  /**
+   * Returns the ids in `dest_dict` of the strings of this dictionary below
+   * `source_generation`, or INVALID_STR_ID for the ones missing from `dest_dict` below
+   * `dest_generation`. Built once in parallel and cached for the pair of generations,
+   * for a few destinations at most. Returns nullptr for remote dictionaries.
+   */
+  std::shared_ptr<const std::vector<int32_t>> getTranslationMap(
+      const std::shared_ptr<const StringDictionary>& dest_dict,
+      const size_t source_generation,
+      const size_t dest_generation) const;
+
   /**
    * @brief Populates provided \p dest_ids vector with string ids corresponding to given
    * source strings
@@ -90,21 +118,21 @@ class StringDictionary {
    * populates a vector of destination string ids by either returning the string id of
    * matching strings in the destination dictionary or creating new entries in the
    * dictionary. Source string ids can also be transient if they were created by a
-   * function (e.g LOWER/UPPER functions). A map of transient string ids to string values
-   * is provided in order to handle this use case.
+   * function (e.g LOWER/UPPER functions). The transient strings of the source proxy are
+   * provided in order to handle this use case.
    *
    * @param dest_ids - vector of destination string ids to be populated
    * @param dest_dict - destination dictionary
    * @param source_ids - vector of source string ids for which destination ids are needed
    * @param source_dict - source dictionary
-   * @param transient_mapping - map of transient source string ids to string values
+   * @param transient_strings - transient source strings, in the order of their ids
    */
   static void populate_string_ids(
       std::vector<int32_t>& dest_ids,
       StringDictionary* dest_dict,
       const std::vector<int32_t>& source_ids,
       const StringDictionary* source_dict,
-      const std::map<int32_t, std::string> transient_mapping = {});
+      const std::vector<std::string_view>& transient_strings = {});
 
   static void populate_string_array_ids(
       std::vector<std::vector<int32_t>>& dest_array_ids,
@@ -131,6 +159,14 @@ class StringDictionary {
     int32_t diff;
   };
 
+  struct TranslationMap {
+    std::weak_ptr<const StringDictionary> dest_dict;
+    size_t source_generation;
+    size_t dest_generation;
+    std::shared_ptr<const std::vector<int32_t>> ids;
+    uint64_t last_use;
+  };
+
   struct PayloadString {
     char* c_str_ptr;
     size_t size;
@@ -155,6 +191,12 @@ class StringDictionary {
   void hashStrings(const std::vector<String>& string_vec,
                    std::vector<string_dict_hash_t>& hashes) const noexcept;
   template <class T, class String>
+  std::vector<size_t> getIdsOfExistingStrings(
+      const std::vector<String>& input_strings,
+      const std::vector<string_dict_hash_t>& input_strings_hashes,
+      T* output_string_ids,
+      const bool parallel) const;
+  template <class T, class String>
   void getOrAddBulkRemote(const std::vector<String>& string_vec, T* encoded_vec);
   int32_t getUnlocked(const std::string& str) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
@@ -194,6 +236,8 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  void indexNewStringsUnlocked() const;
+  const TrigramIndex* getTrigramIndexUnlocked() const;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -209,6 +253,7 @@ class StringDictionary {
   std::vector<int32_t> string_id_string_dict_hash_table_;
   std::vector<string_dict_hash_t> hash_cache_;
   std::vector<int32_t> sorted_cache;
+  std::shared_ptr<const std::vector<int32_t>> sorted_ranks_;
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
@@ -226,8 +271,18 @@ class StringDictionary {
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  std::string trigram_index_path_;
+  mutable std::unique_ptr<TrigramIndex> trigram_index_;
+  mutable size_t trigram_index_saved_count_{0};
   std::unique_ptr<StringDictionaryClient> client_;
   std::unique_ptr<StringDictionaryClient> client_no_timeout_;
+  // identifies the destination of translation maps, unlike addresses it's never reused
+  const uint64_t instance_id_{next_instance_id_++};
+  static std::atomic<uint64_t> next_instance_id_;
+  // latest translation map to each destination dictionary, by instance id
+  mutable std::map<uint64_t, TranslationMap> translation_maps_;
+  mutable uint64_t translation_map_uses_{0};
+  mutable std::mutex translation_maps_mutex_;
 
   char* CANARY_BUFFER{nullptr};
   size_t canary_buffer_size = 0;
@@ -16,6 +16,9 @@
 
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <thread>
 
 #include "Logger/Logger.h"
@@ -25,9 +28,19 @@
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
 
+namespace {
+
+constexpr size_t kTransientBlockSize{64 * 1024};
+constexpr size_t kInitialTransientHashTableSize{256};
+
+}  // namespace
+
 StringDictionaryProxy::StringDictionaryProxy(std::shared_ptr<StringDictionary> sd,
                                              const int64_t generation)
-    : string_dict_(sd), generation_(generation) {}
+    : string_dict_(sd)
+    , transient_string_hash_table_(kInitialTransientHashTableSize,
+                                   StringDictionary::INVALID_STR_ID)
+    , generation_(generation) {}
 
 int32_t truncate_to_generation(const int32_t id, const size_t generation) {
   if (id == StringDictionary::INVALID_STR_ID) {
@@ -39,50 +52,115 @@ int32_t truncate_to_generation(const int32_t id, const size_t generation) {
 
 int32_t StringDictionaryProxy::getOrAddTransient(const std::string& str) {
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  return getOrAddTransientUnlocked(str);
+}
+
+std::vector<int32_t> StringDictionaryProxy::getOrAddTransientBulk(
+    const std::vector<std::string>& strings) {
+  std::vector<int32_t> string_ids;
+  string_ids.reserve(strings.size());
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  for (const auto& str : strings) {
+    string_ids.push_back(getOrAddTransientUnlocked(str));
+  }
+  return string_ids;
+}
+
+int32_t StringDictionaryProxy::getOrAddTransientUnlocked(const std::string& str) {
   CHECK_GE(generation_, 0);
   auto transient_id =
       truncate_to_generation(string_dict_->getIdOfString(str), generation_);
   if (transient_id != StringDictionary::INVALID_STR_ID) {
     return transient_id;
   }
-  const auto it = transient_str_to_int_.find(str);
-  if (it != transient_str_to_int_.end()) {
-    return it->second;
+  auto bucket = computeTransientBucket(str);
+  if (transient_string_hash_table_[bucket] != StringDictionary::INVALID_STR_ID) {
+    return transient_string_hash_table_[bucket];
   }
-  transient_id =
-      -(transient_str_to_int_.size() + 2);  // make sure it's not INVALID_STR_ID
-  {
-    auto it_ok = transient_str_to_int_.insert(std::make_pair(str, transient_id));
-    CHECK(it_ok.second);
-  }
-  {
-    auto it_ok = transient_int_to_str_.insert(std::make_pair(transient_id, str));
-    CHECK(it_ok.second);
+  if (2 * (transient_strings_.size() + 1) > transient_string_hash_table_.size()) {
+    // resize when more than 50% is full
+    increaseTransientHashTableCapacity();
+    bucket = computeTransientBucket(str);
   }
+  transient_id = transientIndexToId(transient_strings_.size());
+  transient_strings_.push_back(copyToTransientArena(str));
+  transient_string_hash_table_[bucket] = transient_id;
   return transient_id;
 }
 
+uint32_t StringDictionaryProxy::computeTransientBucket(const std::string_view str) const
+    noexcept {
+  const size_t hash_table_size = transient_string_hash_table_.size();
+  uint32_t bucket = std::hash<std::string_view>{}(str) & (hash_table_size - 1);
+  while (true) {
+    const auto candidate_id = transient_string_hash_table_[bucket];
+    if (candidate_id == StringDictionary::INVALID_STR_ID ||
+        transient_strings_[transientIdToIndex(candidate_id)] == str) {
+      break;
+    }
+    // wrap around
+    if (++bucket == hash_table_size) {
+      bucket = 0;
+    }
+  }
+  return bucket;
+}
+
+void StringDictionaryProxy::increaseTransientHashTableCapacity() noexcept {
+  std::vector<int32_t> hash_table(transient_string_hash_table_.size() * 2,
+                                  StringDictionary::INVALID_STR_ID);
+  transient_string_hash_table_.swap(hash_table);
+  for (size_t index = 0; index < transient_strings_.size(); ++index) {
+    transient_string_hash_table_[computeTransientBucket(transient_strings_[index])] =
+        transientIndexToId(index);
+  }
+}
+
+std::string_view StringDictionaryProxy::copyToTransientArena(
+    const std::string_view str) {
+  if (!transient_block_ptr_ || str.size() > transient_block_free_) {
+    const auto block_size = std::max(kTransientBlockSize, str.size());
+    transient_string_blocks_.emplace_back(std::make_unique<char[]>(block_size));
+    transient_block_ptr_ = transient_string_blocks_.back().get();
+    transient_block_free_ = block_size;
+  }
+  memcpy(transient_block_ptr_, str.data(), str.size());
+  const std::string_view arena_str(transient_block_ptr_, str.size());
+  transient_block_ptr_ += str.size();
+  transient_block_free_ -= str.size();
+  return arena_str;
+}
+
+std::string_view StringDictionaryProxy::getTransientString(
+    const int32_t string_id) const {
+  CHECK_NE(StringDictionary::INVALID_STR_ID, string_id);
+  const auto index = transientIdToIndex(string_id);
+  CHECK_LT(index, transient_strings_.size());
+  return transient_strings_[index];
+}
+
+std::vector<std::string_view> StringDictionaryProxy::getTransientStrings() const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  return transient_strings_;
+}
+
 int32_t StringDictionaryProxy::getIdOfString(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   CHECK_GE(generation_, 0);
   auto str_id = truncate_to_generation(string_dict_->getIdOfString(str), generation_);
-  if (str_id != StringDictionary::INVALID_STR_ID || transient_str_to_int_.empty()) {
+  if (str_id != StringDictionary::INVALID_STR_ID || transient_strings_.empty()) {
     return str_id;
   }
-  auto it = transient_str_to_int_.find(str);
-  return it != transient_str_to_int_.end() ? it->second
-                                           : StringDictionary::INVALID_STR_ID;
+  return transient_string_hash_table_[computeTransientBucket(str)];
 }
 
 int32_t StringDictionaryProxy::getIdOfStringNoGeneration(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   auto str_id = string_dict_->getIdOfString(str);
-  if (str_id != StringDictionary::INVALID_STR_ID || transient_str_to_int_.empty()) {
+  if (str_id != StringDictionary::INVALID_STR_ID || transient_strings_.empty()) {
     return str_id;
   }
-  auto it = transient_str_to_int_.find(str);
-  return it != transient_str_to_int_.end() ? it->second
-                                           : StringDictionary::INVALID_STR_ID;
+  return transient_string_hash_table_[computeTransientBucket(str)];
 }
 
 std::string StringDictionaryProxy::getString(int32_t string_id) const {
@@ -93,30 +171,80 @@ std::string StringDictionaryProxy::getString(int32_t string_id) const {
   if (string_id >= 0) {
     return string_dict_->getString(string_id);
   }
-  CHECK_NE(StringDictionary::INVALID_STR_ID, string_id);
-  auto it = transient_int_to_str_.find(string_id);
-  CHECK(it != transient_int_to_str_.end());
-  return it->second;
+  return std::string(getTransientString(string_id));
+}
+
+int32_t StringDictionaryProxy::translateStringId(
+    const int32_t string_id,
+    const StringDictionaryProxy* dest_proxy,
+    const std::vector<int32_t>* translation_map) const {
+  CHECK(dest_proxy);
+  if (translation_map && string_id >= 0 &&
+      static_cast<size_t>(string_id) < translation_map->size()) {
+    return (*translation_map)[string_id];
+  }
+  return dest_proxy->getIdOfString(getString(string_id));
+}
+
+bool StringDictionaryProxy::hasTransientStrings() const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  return !transient_strings_.empty();
+}
+
+const std::vector<int32_t>* StringDictionaryProxy::getTranslationMap(
+    const StringDictionaryProxy* dest_proxy,
+    const size_t id_count) const {
+  // the map probes the destination with every string of this dictionary, translating
+  // fewer ids than a fraction of them is cheaper one string at a time
+  constexpr size_t kMinTranslatedFraction{8};
+  CHECK(dest_proxy);
+  // the strings missing from a map could be transient strings of the destination
+  if (generation_ < 0 || dest_proxy->generation_ < 0 ||
+      dest_proxy->hasTransientStrings()) {
+    return nullptr;
+  }
+  const auto key =
+      std::make_pair(dest_proxy->string_dict_.get(), dest_proxy->generation_);
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    const auto it = translation_maps_.find(key);
+    if (it != translation_maps_.end()) {
+      return it->second.ids.get();
+    }
+  }
+  if (id_count < static_cast<size_t>(generation_) / kMinTranslatedFraction) {
+    return nullptr;
+  }
+  // built outside of our lock, the dictionary serializes and caches the builds
+  auto ids = string_dict_->getTranslationMap(
+      dest_proxy->string_dict_, generation_, dest_proxy->generation_);
+  if (!ids) {
+    return nullptr;
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  const auto it =
+      translation_maps_.emplace(key, TranslationMap{dest_proxy->string_dict_, ids}).first;
+  return it->second.ids.get();
 }
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const std::string_view str,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
   return icase
              ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_ilike(str.data(),
                                          str.size(),
                                          pattern.c_str(),
                                          pattern.size(),
                                          escape))
              : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_like(str.data(),
                                         str.size(),
                                         pattern.c_str(),
                                         pattern.size(),
@@ -131,10 +259,11 @@ std::vector<int32_t> StringDictionaryProxy::getLike(const std::string& pattern,
                                                     const char escape) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getLike(pattern, icase, is_simple, escape, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (size_t index = 0; index < transient_strings_.size(); ++index) {
+    const auto str = transient_strings_[index];
     if (is_like(str, pattern, icase, is_simple, escape)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
@@ -142,7 +271,7 @@ std::vector<int32_t> StringDictionaryProxy::getLike(const std::string& pattern,
 
 namespace {
 
-bool do_compare(const std::string& str,
+bool do_compare(const std::string_view str,
                 const std::string& pattern,
                 const std::string& comp_operator) {
   int res = str.compare(pattern);
@@ -169,10 +298,11 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
     const std::string& comp_operator) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getCompare(pattern, comp_operator, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (size_t index = 0; index < transient_strings_.size(); ++index) {
+    const auto str = transient_strings_[index];
     if (do_compare(str, pattern, comp_operator)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
@@ -180,10 +310,10 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
 
 namespace {
 
-bool is_regexp_like(const std::string& str,
+bool is_regexp_like(const std::string_view str,
                     const std::string& pattern,
                     const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
+  return regexp_like(str.data(), str.size(), pattern.c_str(), pattern.size(), escape);
 }
 
 }  // namespace
@@ -192,15 +322,24 @@ std::vector<int32_t> StringDictionaryProxy::getRegexpLike(const std::string& pat
                                                           const char escape) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getRegexpLike(pattern, escape, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (size_t index = 0; index < transient_strings_.size(); ++index) {
+    const auto str = transient_strings_[index];
     if (is_regexp_like(str, pattern, escape)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionaryProxy::getSortedRanks(
+    const size_t sorted_count) const {
+  return string_dict_->getSortedRanks(
+      sorted_count,
+      generation_ < 0 ? std::numeric_limits<size_t>::max()
+                      : static_cast<size_t>(generation_));
+}
+
 int32_t StringDictionaryProxy::getOrAdd(const std::string& str) noexcept {
   return string_dict_->getOrAdd(str);
 }
@@ -210,10 +349,9 @@ std::pair<const char*, size_t> StringDictionaryProxy::getStringBytes(
   if (string_id >= 0) {
     return string_dict_.get()->getStringBytes(string_id);
   }
-  CHECK_NE(StringDictionary::INVALID_STR_ID, string_id);
-  auto it = transient_int_to_str_.find(string_id);
-  CHECK(it != transient_int_to_str_.end());
-  return std::make_pair(it->second.c_str(), it->second.size());
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto str = getTransientString(string_id);
+  return std::make_pair(str.data(), str.size());
 }
 
 size_t StringDictionaryProxy::storageEntryCount() const {
@@ -21,7 +21,9 @@
 #include "StringDictionary.h"
 
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -34,10 +36,21 @@ class StringDictionaryProxy {
   StringDictionary* getDictionary() noexcept;
   int64_t getGeneration() const noexcept;
   int32_t getOrAddTransient(const std::string& str);
+  std::vector<int32_t> getOrAddTransientBulk(const std::vector<std::string>& strings);
   int32_t getIdOfString(const std::string& str) const;
   int32_t getIdOfStringNoGeneration(
       const std::string& str) const;  // disregard generation, only used by QueryRenderer
   std::string getString(int32_t string_id) const;
+  // Id in `dest_proxy` of the string `string_id` refers to, looked up in
+  // `translation_map` from getTranslationMap if any rather than by a string round trip.
+  int32_t translateStringId(const int32_t string_id,
+                            const StringDictionaryProxy* dest_proxy,
+                            const std::vector<int32_t>* translation_map = nullptr) const;
+  // Map of the ids of this proxy to the ones of `dest_proxy`, fetched once before
+  // translating `id_count` ids. Null if that few are cheaper to translate one string at
+  // a time, or no map applies. The map lives as long as this proxy.
+  const std::vector<int32_t>* getTranslationMap(const StringDictionaryProxy* dest_proxy,
+                                                const size_t id_count) const;
   std::pair<const char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
   void updateGeneration(const int64_t generation) noexcept;
@@ -52,15 +65,49 @@ class StringDictionaryProxy {
 
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape) const;
 
-  const std::map<int32_t, std::string> getTransientMapping() const {
-    return transient_int_to_str_;
+  // Sort ranks of the dictionary strings by id for sorting `sorted_count` ids, see
+  // StringDictionary::getSortedRanks. Transient ids and the ids past the ranks aren't
+  // ranked and have to be compared as strings.
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks(
+      const size_t sorted_count) const;
+
+  /**
+   * Transient strings in the order they were added, the one at index i has the id
+   * transientIndexToId(i). The views stay valid for the lifetime of the proxy.
+   */
+  std::vector<std::string_view> getTransientStrings() const;
+
+  // Transient ids are allocated downwards from -2, so that none is INVALID_STR_ID.
+  static int32_t transientIndexToId(const size_t index) {
+    return -static_cast<int32_t>(index) - 2;
   }
 
+  static size_t transientIdToIndex(const int32_t id) { return -id - 2; }
+
  private:
+  int32_t getOrAddTransientUnlocked(const std::string& str);
+  uint32_t computeTransientBucket(const std::string_view str) const noexcept;
+  void increaseTransientHashTableCapacity() noexcept;
+  std::string_view copyToTransientArena(const std::string_view str);
+  std::string_view getTransientString(const int32_t string_id) const;
+  bool hasTransientStrings() const;
+
   std::shared_ptr<StringDictionary> string_dict_;
-  std::map<int32_t, std::string> transient_int_to_str_;
-  std::map<std::string, int32_t> transient_str_to_int_;
+  // Transient strings are copied into blocks which are never moved, and indexed by an
+  // open addressing table of their ids, like the strings of the dictionary
+  std::vector<std::unique_ptr<char[]>> transient_string_blocks_;
+  char* transient_block_ptr_{nullptr};
+  size_t transient_block_free_{0};
+  std::vector<std::string_view> transient_strings_;
+  std::vector<int32_t> transient_string_hash_table_;
   int64_t generation_;
+  // translation maps to other dictionaries, keyed by the destination and its generation
+  struct TranslationMap {
+    std::shared_ptr<StringDictionary> dest_dict;  // pins the address used as key
+    std::shared_ptr<const std::vector<int32_t>> ids;
+  };
+  mutable std::map<std::pair<const StringDictionary*, int64_t>, TranslationMap>
+      translation_maps_;
   mutable mapd_shared_mutex rw_mutex_;
 };
 #endif  // STRINGDICTIONARY_STRINGDICTIONARYPROXY_H
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/TrigramIndex.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+
+#include <fcntl.h>
+
+#include "Logger/Logger.h"
+#include "OSDependent/omnisci_fs.h"
+
+namespace {
+
+constexpr uint64_t kTrigramIndexMagic{0x314D415247495254};  // "TRIGRAM1"
+
+uint8_t lowercase(const char c) {
+  return 'A' <= c && c <= 'Z' ? 'a' + (c - 'A') : static_cast<uint8_t>(c);
+}
+
+void append_trigrams(const std::string_view str, std::vector<uint32_t>& trigrams) {
+  for (size_t i = 2; i < str.size(); ++i) {
+    trigrams.push_back(lowercase(str[i - 2]) << 16 | lowercase(str[i - 1]) << 8 |
+                       lowercase(str[i]));
+  }
+}
+
+void sort_unique(std::vector<uint32_t>& trigrams) {
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+template <typename T>
+void write_value(std::ofstream& out, const T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T read_value(std::ifstream& in) {
+  T value{0};
+  in.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+void TrigramIndex::addString(const int32_t string_id, const std::string_view str) {
+  CHECK_EQ(static_cast<size_t>(string_id), indexed_count_);
+  std::vector<uint32_t> trigrams;
+  append_trigrams(str, trigrams);
+  sort_unique(trigrams);
+  for (const auto trigram : trigrams) {
+    posting_lists_[trigram].push_back(string_id);
+  }
+  ++indexed_count_;
+}
+
+bool TrigramIndex::getCandidates(const std::vector<std::string>& literals,
+                                 const size_t generation,
+                                 std::vector<int32_t>& candidate_ids) const {
+  std::vector<uint32_t> trigrams;
+  for (const auto& literal : literals) {
+    append_trigrams(literal, trigrams);
+  }
+  if (trigrams.empty()) {
+    return false;
+  }
+  sort_unique(trigrams);
+  candidate_ids.clear();
+  std::vector<const std::vector<int32_t>*> posting_lists;
+  for (const auto trigram : trigrams) {
+    const auto it = posting_lists_.find(trigram);
+    if (it == posting_lists_.end()) {
+      return true;
+    }
+    posting_lists.push_back(&it->second);
+  }
+  // intersect the shortest lists first, the candidates only ever get fewer
+  std::sort(posting_lists.begin(),
+            posting_lists.end(),
+            [](const std::vector<int32_t>* lhs, const std::vector<int32_t>* rhs) {
+              return lhs->size() < rhs->size();
+            });
+  const auto& shortest_list = *posting_lists.front();
+  candidate_ids.assign(shortest_list.begin(),
+                       std::lower_bound(shortest_list.begin(),
+                                        shortest_list.end(),
+                                        static_cast<int32_t>(std::min(
+                                            generation, size_t(INT32_MAX)))));
+  std::vector<int32_t> intersection;
+  for (size_t i = 1; i < posting_lists.size() && !candidate_ids.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidate_ids.begin(),
+                          candidate_ids.end(),
+                          posting_lists[i]->begin(),
+                          posting_lists[i]->end(),
+                          std::back_inserter(intersection));
+    candidate_ids.swap(intersection);
+  }
+  return true;
+}
+
+bool TrigramIndex::save(const std::string& path) const {
+  // a crash while writing leaves the previous index in place
+  const auto temp_path = path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    write_value<uint64_t>(out, kTrigramIndexMagic);
+    write_value<uint64_t>(out, indexed_count_);
+    write_value<uint64_t>(out, posting_lists_.size());
+    for (const auto& [trigram, string_ids] : posting_lists_) {
+      write_value<uint32_t>(out, trigram);
+      write_value<uint64_t>(out, string_ids.size());
+      out.write(reinterpret_cast<const char*>(string_ids.data()),
+                string_ids.size() * sizeof(int32_t));
+    }
+    out.flush();
+    if (!out) {
+      LOG(WARNING) << "Failed to write string dictionary trigram index " << temp_path;
+      std::remove(temp_path.c_str());
+      return false;
+    }
+  }
+  // the contents must be on disk before the rename makes them the index
+  const auto fd = omnisci::open(temp_path.c_str(), O_RDWR, 0644);
+  const bool synced = fd >= 0 && omnisci::fsync(fd) == 0;
+  if (fd >= 0) {
+    omnisci::close(fd);
+  }
+  if (!synced) {
+    LOG(WARNING) << "Failed to sync string dictionary trigram index " << temp_path;
+    std::remove(temp_path.c_str());
+    return false;
+  }
+  return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+bool TrigramIndex::load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in || read_value<uint64_t>(in) != kTrigramIndexMagic) {
+    return false;
+  }
+  const auto indexed_count = read_value<uint64_t>(in);
+  const auto posting_list_count = read_value<uint64_t>(in);
+  decltype(posting_lists_) posting_lists;
+  for (uint64_t i = 0; i < posting_list_count && in; ++i) {
+    const auto trigram = read_value<uint32_t>(in);
+    const auto string_id_count = read_value<uint64_t>(in);
+    if (string_id_count > indexed_count) {
+      return false;
+    }
+    auto& string_ids = posting_lists[trigram];
+    string_ids.resize(string_id_count);
+    in.read(reinterpret_cast<char*>(string_ids.data()),
+            string_id_count * sizeof(int32_t));
+  }
+  if (!in) {
+    LOG(WARNING) << "String dictionary trigram index " << path
+                 << " is truncated, it will be rebuilt";
+    return false;
+  }
+  posting_lists_.swap(posting_lists);
+  indexed_count_ = indexed_count;
+  return true;
+}
+
+std::vector<std::string> TrigramIndex::getLikeLiterals(const std::string& pattern,
+                                                       const bool is_simple,
+                                                       const char escape) {
+  // the wildcards have already been stripped from simple patterns
+  if (is_simple) {
+    return {pattern};
+  }
+  std::vector<std::string> literals(1);
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] == escape && i + 1 < pattern.size()) {
+      literals.back().push_back(pattern[++i]);
+    } else if (pattern[i] == '%' || pattern[i] == '_') {
+      literals.emplace_back();
+    } else {
+      literals.back().push_back(pattern[i]);
+    }
+  }
+  return literals;
+}
+
+std::vector<std::string> TrigramIndex::getRegexpLiterals(const std::string& pattern) {
+  // only literals outside of groups and bracket expressions are surely matched, and
+  // none at all with alternatives
+  if (pattern.find('|') != std::string::npos) {
+    return {};
+  }
+  std::vector<std::string> literals(1);
+  int group_depth{0};
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const auto c = pattern[i];
+    if (c == '(') {
+      ++group_depth;
+    } else if (c == ')') {
+      group_depth = std::max(group_depth - 1, 0);
+    } else if (c == '[') {
+      // a closing bracket right after the opening one (or its negation) is literal
+      i += i + 1 < pattern.size() && pattern[i + 1] == '^' ? 2 : 1;
+      if (i < pattern.size() && pattern[i] == ']') {
+        ++i;
+      }
+      while (i < pattern.size() && pattern[i] != ']') {
+        ++i;
+      }
+    } else if (c == '*' || c == '?' || c == '{') {
+      // the previous character may not be there at all
+      if (!literals.back().empty()) {
+        literals.back().pop_back();
+      }
+      if (c == '{') {
+        while (i < pattern.size() && pattern[i] != '}') {
+          ++i;
+        }
+      }
+    } else if (c == '\\') {
+      ++i;
+    } else if (!group_depth && c != '.' && c != '+' && c != '^' && c != '$') {
+      literals.back().push_back(c);
+      continue;
+    }
+    literals.emplace_back();
+  }
+  return literals;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    TrigramIndex.h
+ * @brief   Inverted index from the trigrams of the strings of a dictionary to their ids,
+ * used to narrow down the strings matched against LIKE and REGEXP patterns.
+ */
+
+#ifndef STRINGDICTIONARY_TRIGRAMINDEX_H
+#define STRINGDICTIONARY_TRIGRAMINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class TrigramIndex {
+ public:
+  /**
+   * Indexes the ASCII lowercased trigrams of `str`. Strings must be added in the order
+   * of their ids, which keeps the posting lists sorted.
+   */
+  void addString(const int32_t string_id, const std::string_view str);
+
+  //! Number of strings indexed, i.e. the id of the next string to add.
+  size_t indexedCount() const { return indexed_count_; }
+
+  /**
+   * Fills `candidate_ids` with the sorted ids below `generation` of the strings holding
+   * all the trigrams of `literals`. Returns false if the literals are too short to
+   * narrow down the strings, in which case all of them are candidates.
+   */
+  bool getCandidates(const std::vector<std::string>& literals,
+                     const size_t generation,
+                     std::vector<int32_t>& candidate_ids) const;
+
+  //! Writes the index to `path` through a temporary file, returns false on failure.
+  bool save(const std::string& path) const;
+
+  //! Reads an index written by `save`, returns false if it's missing or corrupt.
+  bool load(const std::string& path);
+
+  //! Substrings every string matching a LIKE pattern contains.
+  static std::vector<std::string> getLikeLiterals(const std::string& pattern,
+                                                  const bool is_simple,
+                                                  const char escape);
+
+  //! Substrings every string matching a POSIX extended regular expression contains.
+  static std::vector<std::string> getRegexpLiterals(const std::string& pattern);
+
+ private:
+  std::unordered_map<uint32_t, std::vector<int32_t>> posting_lists_;
+  size_t indexed_count_{0};
+};
+
+#endif  // STRINGDICTIONARY_TRIGRAMINDEX_H
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file BufferMgrTest.cpp
+ * @brief Unit tests for the allocation and replacement policy of BufferMgr.
+ */
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+
+extern bool g_enable_segmented_lru_buffer_pool;
+extern bool g_enable_slab_prefaulting;
+extern bool g_enable_transparent_huge_pages;
+
+namespace bn = Buffer_Namespace;
+
+class BufferMgrTest : public testing::Test {
+ protected:
+  static constexpr size_t page_size_ = 512;
+  static constexpr size_t num_pages_ = 10;
+  static constexpr int32_t db_ = 1, hot_tb_ = 1, scan_tb_ = 2;
+
+  void SetUp() override {
+    buffer_mgr_ = std::make_unique<bn::CpuBufferMgr>(0,
+                                                     num_pages_ * page_size_,
+                                                     nullptr,
+                                                     num_pages_ * page_size_,
+                                                     num_pages_ * page_size_,
+                                                     page_size_);
+  }
+
+  void TearDown() override {
+    g_enable_segmented_lru_buffer_pool = true;
+    g_enable_slab_prefaulting = false;
+    g_enable_transparent_huge_pages = false;
+  }
+
+  void createChunk(const ChunkKey& key, const size_t num_pages = 1) {
+    buffer_mgr_->createBuffer(key, page_size_, num_pages * page_size_)->unPin();
+  }
+
+  void getChunk(const ChunkKey& key) { buffer_mgr_->getBuffer(key)->unPin(); }
+
+  int getStartPage(const ChunkKey& key) {
+    for (const auto& segment : buffer_mgr_->getSlabSegments()[0]) {
+      if (segment.mem_status == bn::USED && segment.chunk_key == key) {
+        return segment.start_page;
+      }
+    }
+    return -1;
+  }
+
+  std::unique_ptr<bn::CpuBufferMgr> buffer_mgr_;
+};
+
+TEST_F(BufferMgrTest, ScanDoesNotEvictReusedChunks) {
+  const ChunkKey hot_key1{db_, hot_tb_, 1, 0}, hot_key2{db_, hot_tb_, 1, 1};
+  createChunk(hot_key1);
+  createChunk(hot_key2);
+  getChunk(hot_key1);
+  getChunk(hot_key2);
+  for (int frag_id = 0; frag_id < 20; ++frag_id) {
+    createChunk({db_, scan_tb_, 1, frag_id});
+  }
+  EXPECT_TRUE(buffer_mgr_->isBufferOnDevice(hot_key1));
+  EXPECT_TRUE(buffer_mgr_->isBufferOnDevice(hot_key2));
+
+  const auto table_stats = buffer_mgr_->getTableStats();
+  const auto& hot_stats = table_stats.at({db_, hot_tb_});
+  EXPECT_EQ(hot_stats.num_hits, size_t(2));
+  EXPECT_EQ(hot_stats.num_evictions, size_t(0));
+  const auto& scan_stats = table_stats.at({db_, scan_tb_});
+  EXPECT_EQ(scan_stats.num_hits, size_t(0));
+  EXPECT_EQ(scan_stats.num_evictions, 20 - (num_pages_ - 2));
+}
+
+TEST_F(BufferMgrTest, ScanEvictsReusedChunksWithLru) {
+  g_enable_segmented_lru_buffer_pool = false;
+  const ChunkKey hot_key{db_, hot_tb_, 1, 0};
+  createChunk(hot_key);
+  getChunk(hot_key);
+  for (int frag_id = 0; frag_id < 20; ++frag_id) {
+    createChunk({db_, scan_tb_, 1, frag_id});
+  }
+  EXPECT_FALSE(buffer_mgr_->isBufferOnDevice(hot_key));
+  EXPECT_EQ(buffer_mgr_->getTableStats().at({db_, hot_tb_}).num_evictions, size_t(1));
+}
+
+TEST_F(BufferMgrTest, DemotesLeastRecentlyUsedProtectedChunks) {
+  // Only 80% of the pool may be protected, so the two chunks reused first are demoted
+  for (int frag_id = 0; frag_id < static_cast<int>(num_pages_); ++frag_id) {
+    createChunk({db_, hot_tb_, 1, frag_id});
+    getChunk({db_, hot_tb_, 1, frag_id});
+  }
+  createChunk({db_, scan_tb_, 1, 0}, 2);
+  EXPECT_FALSE(buffer_mgr_->isBufferOnDevice({db_, hot_tb_, 1, 0}));
+  EXPECT_FALSE(buffer_mgr_->isBufferOnDevice({db_, hot_tb_, 1, 1}));
+  for (int frag_id = 2; frag_id < static_cast<int>(num_pages_); ++frag_id) {
+    EXPECT_TRUE(buffer_mgr_->isBufferOnDevice({db_, hot_tb_, 1, frag_id}));
+  }
+}
+
+TEST_F(BufferMgrTest, AllocatesSmallestFreeSegment) {
+  // Chunks of 1, 3, 1, 2 and 2 pages, which leaves a free page at the end of the slab
+  const std::vector<size_t> chunk_num_pages{1, 3, 1, 2, 2};
+  for (size_t frag_id = 0; frag_id < chunk_num_pages.size(); ++frag_id) {
+    createChunk({db_, hot_tb_, 1, static_cast<int>(frag_id)}, chunk_num_pages[frag_id]);
+  }
+  buffer_mgr_->deleteBuffer({db_, hot_tb_, 1, 1});
+  buffer_mgr_->deleteBuffer({db_, hot_tb_, 1, 3});
+
+  // Free segments of 3 pages at page 1, 2 pages at page 5 and 1 page at page 9
+  const ChunkKey key{db_, scan_tb_, 1, 0};
+  createChunk(key, 2);
+  EXPECT_EQ(getStartPage(key), 5);
+  const ChunkKey small_key{db_, scan_tb_, 1, 1};
+  createChunk(small_key);
+  EXPECT_EQ(getStartPage(small_key), 9);
+  EXPECT_EQ(buffer_mgr_->getTableStats().count({db_, hot_tb_}), size_t(0));
+
+  // A chunk freed next to free segments is merged with them
+  buffer_mgr_->deleteBuffer({db_, hot_tb_, 1, 2});
+  const ChunkKey large_key{db_, scan_tb_, 1, 2};
+  createChunk(large_key, 4);
+  EXPECT_EQ(getStartPage(large_key), 1);
+}
+
+namespace {
+
+// Places the chunks of even and odd fragments on two NUMA nodes
+class TwoNodeCpuBufferMgr : public bn::CpuBufferMgr {
+ public:
+  using bn::CpuBufferMgr::CpuBufferMgr;
+
+ protected:
+  int getNumaNodeForChunk(const ChunkKey& chunk_key) override {
+    return chunk_key[CHUNK_KEY_FRAGMENT_IDX] % 2;
+  }
+
+ private:
+  bool bindSlabToNumaNode(const size_t, const size_t, const int) override { return true; }
+};
+
+}  // namespace
+
+TEST_F(BufferMgrTest, PlacesChunksOnTheirNumaNode) {
+  // Two slabs of half the pool
+  buffer_mgr_ = std::make_unique<TwoNodeCpuBufferMgr>(0,
+                                                      num_pages_ * page_size_,
+                                                      nullptr,
+                                                      num_pages_ / 2 * page_size_,
+                                                      num_pages_ / 2 * page_size_,
+                                                      page_size_);
+  auto get_slab_num = [this](const ChunkKey& key) {
+    const auto& slab_segments = buffer_mgr_->getSlabSegments();
+    for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
+      for (const auto& segment : slab_segments[slab_num]) {
+        if (segment.mem_status == bn::USED && segment.chunk_key == key) {
+          return static_cast<int>(slab_num);
+        }
+      }
+    }
+    return -1;
+  };
+  for (int frag_id = 0; frag_id < 6; ++frag_id) {
+    createChunk({db_, scan_tb_, 1, frag_id});
+  }
+  for (int frag_id = 0; frag_id < 6; ++frag_id) {
+    EXPECT_EQ(get_slab_num({db_, scan_tb_, 1, frag_id}), frag_id % 2);
+  }
+
+  // The slab of the first node is full, remote memory is used rather than evicting
+  createChunk({db_, scan_tb_, 1, 6}, 2);
+  createChunk({db_, scan_tb_, 1, 8});
+  EXPECT_EQ(get_slab_num({db_, scan_tb_, 1, 6}), 0);
+  EXPECT_EQ(get_slab_num({db_, scan_tb_, 1, 8}), 1);
+  EXPECT_EQ(buffer_mgr_->getTableStats().count({db_, scan_tb_}), size_t(0));
+}
+
+namespace {
+
+// Whether the mapping holding the address is advised for transparent huge pages, the
+// "hg" flag of /proc/self/smaps.
+bool is_advised_for_huge_pages(const void* addr) {
+  const auto address = reinterpret_cast<uintptr_t>(addr);
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  bool in_mapping{false};
+  while (std::getline(smaps, line)) {
+    uintptr_t begin, end;
+    if (std::sscanf(line.c_str(), "%lx-%lx", &begin, &end) == 2) {
+      in_mapping = begin <= address && address < end;
+    } else if (in_mapping && line.rfind("VmFlags:", 0) == 0) {
+      return line.find(" hg") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST_F(BufferMgrTest, WritesToPrefaultedHugePageSlab) {
+  if (!boost::filesystem::exists("/sys/kernel/mm/transparent_hugepage")) {
+    GTEST_SKIP() << "transparent huge pages not supported";
+  }
+  g_enable_transparent_huge_pages = true;
+  g_enable_slab_prefaulting = true;
+  // slabs of at least a huge page are mapped on huge pages
+  constexpr size_t slab_size{8 * 1024 * 1024};
+  buffer_mgr_ = std::make_unique<bn::CpuBufferMgr>(
+      0, 2 * slab_size, nullptr, slab_size, slab_size, page_size_);
+  std::vector<int8_t> data(slab_size / 2);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 127;
+  }
+  // written while the slab may still be prefaulted
+  for (int frag_id = 0; frag_id < 2; ++frag_id) {
+    auto buffer = buffer_mgr_->createBuffer({db_, scan_tb_, 1, frag_id}, page_size_);
+    buffer->append(data.data(), data.size());
+    EXPECT_TRUE(is_advised_for_huge_pages(buffer->getMemoryPtr()));
+    buffer->unPin();
+  }
+  for (int frag_id = 0; frag_id < 2; ++frag_id) {
+    auto buffer = buffer_mgr_->getBuffer({db_, scan_tb_, 1, frag_id});
+    std::vector<int8_t> read_data(data.size());
+    buffer->read(read_data.data(), read_data.size());
+    buffer->unPin();
+    EXPECT_EQ(read_data, data);
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <set>
+
+#include "../QueryEngine/CountDistinctSet.h"
+
+/**
+ * COUNT(DISTINCT x) GROUP BY y workloads with values too spread out for a bitmap, on the
+ * std::set the count distinct sets used to be and on CountDistinctSet. The first
+ * argument is the number of distinct values per group, the second whether the values
+ * are dense (1) or random 64 bit values (0). The bytes_per_value counter is the memory
+ * held by the sets, per value.
+ */
+
+namespace {
+
+constexpr size_t kNumValues{1 << 20};
+
+size_t num_allocated_bytes{0};
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {}
+
+  T* allocate(const size_t count) {
+    num_allocated_bytes += count * sizeof(T);
+    return std::allocator<T>().allocate(count);
+  }
+
+  void deallocate(T* ptr, const size_t count) {
+    num_allocated_bytes -= count * sizeof(T);
+    std::allocator<T>().deallocate(ptr, count);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>&) const {
+    return false;
+  }
+};
+
+using StdSet = std::set<int64_t, std::less<int64_t>, CountingAllocator<int64_t>>;
+
+std::vector<int64_t> generate_values(const benchmark::State& state) {
+  const size_t values_per_group = state.range(0);
+  const bool dense = state.range(1);
+  std::mt19937_64 gen(values_per_group);
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values.push_back(dense ? (int64_t(1) << 40) | (i % values_per_group)
+                           : static_cast<int64_t>(gen()));
+  }
+  return values;
+}
+
+size_t memory_usage(const std::vector<StdSet>& sets) {
+  return num_allocated_bytes + sets.size() * sizeof(StdSet);
+}
+
+size_t memory_usage(const std::vector<CountDistinctSet>& sets) {
+  size_t memory_usage = sets.size() * sizeof(CountDistinctSet);
+  for (const auto& set : sets) {
+    memory_usage += set.memoryUsage();
+  }
+  return memory_usage;
+}
+
+template <typename SET>
+void insert_and_reduce(benchmark::State& state) {
+  const auto values = generate_values(state);
+  const size_t values_per_group = state.range(0);
+  const size_t num_groups = kNumValues / values_per_group;
+  double bytes_per_value{0};
+  for (auto _ : state) {
+    // two kernels, each inserting every value into its own sets, then reduced
+    std::vector<SET> sets(num_groups), other_sets(num_groups);
+    for (size_t i = 0; i < values.size(); ++i) {
+      sets[i / values_per_group].insert(values[i]);
+    }
+    bytes_per_value = static_cast<double>(memory_usage(sets)) / kNumValues;
+    for (size_t i = 0; i < values.size(); ++i) {
+      other_sets[i / values_per_group].insert(values[i]);
+    }
+    for (size_t group = 0; group < num_groups; ++group) {
+      if constexpr (std::is_same_v<SET, StdSet>) {
+        sets[group].insert(other_sets[group].begin(), other_sets[group].end());
+      } else {
+        sets[group].merge(other_sets[group]);
+      }
+    }
+    benchmark::DoNotOptimize(sets.data());
+  }
+  state.counters["bytes_per_value"] = bytes_per_value;
+  state.SetItemsProcessed(2 * state.iterations() * kNumValues);
+}
+
+void workloads(benchmark::internal::Benchmark* benchmark) {
+  for (const int64_t values_per_group : {4, 64, 4096, 1 << 20}) {
+    for (const int64_t dense : {0, 1}) {
+      benchmark->Args({values_per_group, dense});
+    }
+  }
+}
+
+}  // namespace
+
+static void BM_StdSet(benchmark::State& state) {
+  insert_and_reduce<StdSet>(state);
+}
+
+static void BM_CountDistinctSet(benchmark::State& state) {
+  insert_and_reduce<CountDistinctSet>(state);
+}
+
+BENCHMARK(BM_StdSet)->Apply(workloads)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CountDistinctSet)->Apply(workloads)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file CountDistinctSetTest.cpp
+ * @brief Unit tests for the layouts of the exact COUNT(DISTINCT) set.
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <set>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/CountDistinctSet.h"
+
+namespace {
+
+std::vector<int64_t> dense_values(const size_t count, const int64_t start) {
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < count; ++i) {
+    values.push_back(start + 3 * i);
+  }
+  return values;
+}
+
+std::vector<int64_t> sparse_values(const size_t count, const uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < count; ++i) {
+    values.push_back(static_cast<int64_t>(gen()));
+  }
+  return values;
+}
+
+void check_same_values(const CountDistinctSet& set, const std::set<int64_t>& expected) {
+  ASSERT_EQ(set.size(), expected.size());
+  for (const auto val : expected) {
+    ASSERT_TRUE(set.contains(val)) << val;
+    ASSERT_EQ(set.contains(val + 1), expected.count(val + 1) > 0) << val + 1;
+  }
+}
+
+}  // namespace
+
+TEST(CountDistinctSet, InsertsInAllLayouts) {
+  const std::vector<std::vector<int64_t>> inputs{
+      {},
+      {5, -1, 5, std::numeric_limits<int64_t>::min(), 0, -1},
+      dense_values(10, -5),        // sorted array
+      sparse_values(1000, 1),      // hash set
+      dense_values(100000, -100),  // roaring bitmap
+      sparse_values(20000, 2)};    // hash set, too sparse for the bitmap
+  for (const auto& input : inputs) {
+    CountDistinctSet set;
+    std::set<int64_t> expected;
+    for (const auto val : input) {
+      set.insert(val);
+      set.insert(val);  // duplicates do not count
+      expected.insert(val);
+    }
+    check_same_values(set, expected);
+  }
+}
+
+TEST(CountDistinctSet, HoldsTheEmptySlotValue) {
+  CountDistinctSet set;
+  std::set<int64_t> expected;
+  for (const auto val : sparse_values(100, 3)) {
+    set.insert(val);
+    expected.insert(val);
+  }
+  set.insert(std::numeric_limits<int64_t>::min());
+  expected.insert(std::numeric_limits<int64_t>::min());
+  check_same_values(set, expected);
+}
+
+TEST(CountDistinctSet, MergesAllLayouts) {
+  const std::vector<std::vector<int64_t>> inputs{{},
+                                                 dense_values(8, 0),
+                                                 dense_values(12, 6),
+                                                 sparse_values(500, 4),
+                                                 dense_values(50000, 1000),
+                                                 dense_values(80000, 100000)};
+  for (const auto& lhs_input : inputs) {
+    for (const auto& rhs_input : inputs) {
+      CountDistinctSet lhs, rhs;
+      std::set<int64_t> expected;
+      for (const auto val : lhs_input) {
+        lhs.insert(val);
+        expected.insert(val);
+      }
+      for (const auto val : rhs_input) {
+        rhs.insert(val);
+        expected.insert(val);
+      }
+      lhs.merge(rhs);
+      check_same_values(lhs, expected);
+      // the merged set keeps growing like any other
+      lhs.insert(-7);
+      expected.insert(-7);
+      check_same_values(lhs, expected);
+    }
+  }
+}
+
+TEST(CountDistinctSet, IsSmallerThanStdSet) {
+  // std::set takes at least 40 bytes per value, for the tree node and its pointers
+  CountDistinctSet dense_set;
+  const auto dense = dense_values(1000000, 0);
+  for (const auto val : dense) {
+    dense_set.insert(val);
+  }
+  EXPECT_LT(dense_set.memoryUsage(), dense.size());
+
+  CountDistinctSet sparse_set;
+  const auto sparse = sparse_values(100000, 5);
+  for (const auto val : sparse) {
+    sparse_set.insert(val);
+  }
+  EXPECT_LE(sparse_set.memoryUsage(), 32 * sparse.size());
+
+  CountDistinctSet small_set;
+  for (const auto val : dense_values(10, 0)) {
+    small_set.insert(val);
+  }
+  EXPECT_LE(small_set.memoryUsage(), 16 * sizeof(int64_t));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
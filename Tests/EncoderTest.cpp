@@ -26,6 +26,7 @@
 #include "DataMgr/Encoder.h"
 #include "DataMgr/MemoryLevel.h"
 #include "Shared/DatumFetchers.h"
+#include "Shared/EncodedIntStream.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -763,6 +764,260 @@ TYPED_TEST(FixedLengthArrayNoneEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+class EncoderBloomFilterTest : public EncoderUpdateStatsTest {
+ protected:
+  std::shared_ptr<const ChunkBloomFilter> getBloomFilter() {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    buffer_->getEncoder()->getMetadata(chunk_metadata);
+    return chunk_metadata->bloomFilter;
+  }
+};
+
+TEST_F(EncoderBloomFilterTest, NotEnabled) {
+  createEncoder(kBIGINT);
+  updateWithData(std::vector<int64_t>{1, 2, 3});
+  ASSERT_FALSE(getBloomFilter());
+}
+
+TEST_F(EncoderBloomFilterTest, NoneEncoder) {
+  createEncoder(kBIGINT);
+  buffer_->getEncoder()->enableBloomFilter();
+  std::vector<int64_t> data;
+  for (int64_t i = 0; i < 1000; ++i) {
+    data.push_back(i * 1000);
+  }
+  data.push_back(inline_int_null_value<int64_t>());
+  updateWithData(data);
+  const auto bloom_filter = getBloomFilter();
+  ASSERT_TRUE(bloom_filter);
+  ASSERT_FALSE(bloom_filter->isSaturated());
+  size_t false_positives{0};
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(bloom_filter->mayContain(i * 1000));
+    false_positives += bloom_filter->mayContain(i * 1000 + 1);
+  }
+  ASSERT_LT(false_positives, size_t(50));
+}
+
+TEST_F(EncoderBloomFilterTest, FixedLengthEncoder) {
+  createEncoder(FixedLengthEncoderTraits<int32_t, int16_t>::getSqlType());
+  buffer_->getEncoder()->enableBloomFilter();
+  updateWithData(std::vector<int32_t>{-7, 12, inline_int_null_value<int16_t>()});
+  const auto bloom_filter = getBloomFilter();
+  ASSERT_TRUE(bloom_filter);
+  ASSERT_TRUE(bloom_filter->mayContain(-7));
+  ASSERT_TRUE(bloom_filter->mayContain(12));
+  ASSERT_FALSE(bloom_filter->mayContain(13));
+}
+
+TEST_F(EncoderBloomFilterTest, Saturate) {
+  createEncoder(kINT);
+  buffer_->getEncoder()->enableBloomFilter();
+  updateWithData(std::vector<int32_t>{1});
+  ASSERT_FALSE(getBloomFilter()->mayContain(2));
+  buffer_->getEncoder()->saturateBloomFilter();
+  ASSERT_TRUE(getBloomFilter()->mayContain(2));
+}
+
+TEST(ChunkBloomFilter, Intersect) {
+  ChunkBloomFilter lhs;
+  ChunkBloomFilter rhs;
+  for (int64_t i = 0; i < 10; ++i) {
+    lhs.add(i);
+    rhs.add(i + 1000000);
+  }
+  ASSERT_FALSE(lhs.mayIntersect(rhs));
+  rhs.add(5);
+  ASSERT_TRUE(lhs.mayIntersect(rhs));
+
+  ChunkBloomFilter merged;
+  merged.merge(lhs);
+  ASSERT_TRUE(merged.mayContain(7));
+  merged.saturate();
+  ASSERT_TRUE(merged.isSaturated());
+  ChunkBloomFilter empty;
+  ASSERT_TRUE(empty.mayIntersect(merged));
+}
+
+TEST(ChunkBloomFilter, ReadWrite) {
+  ChunkBloomFilter written;
+  for (int64_t i = -500; i < 500; ++i) {
+    written.add(i);
+  }
+  FILE* f = tmpfile();
+  ASSERT_TRUE(f);
+  written.write(f);
+  rewind(f);
+  ChunkBloomFilter read;
+  read.read(f);
+  fclose(f);
+  for (int64_t i = -500; i < 500; ++i) {
+    ASSERT_TRUE(read.mayContain(i));
+  }
+  ASSERT_FALSE(read.mayIntersect(ChunkBloomFilter{}));
+}
+
+class MemoryTestBuffer : public TestBuffer {
+ public:
+  MemoryTestBuffer(const SQLTypeInfo sql_type) : TestBuffer(sql_type) {}
+
+  void read(int8_t* const dst,
+            const size_t num_bytes,
+            const size_t offset,
+            const MemoryLevel dst_buffer_type,
+            const int dst_device_id) override {
+    CHECK_LE(offset + num_bytes, size_);
+    memcpy(dst, data_.data() + offset, num_bytes);
+  }
+
+  void write(int8_t* src,
+             const size_t num_bytes,
+             const size_t offset,
+             const MemoryLevel src_buffer_type,
+             const int src_device_id) override {
+    if (offset + num_bytes > data_.size()) {
+      data_.resize(offset + num_bytes);
+    }
+    memcpy(data_.data() + offset, src, num_bytes);
+    size_ = std::max(size_, offset + num_bytes);
+  }
+
+  void append(int8_t* src,
+              const size_t num_bytes,
+              const MemoryLevel src_buffer_type,
+              const int device_id) override {
+    write(src, num_bytes, size_, src_buffer_type, device_id);
+  }
+
+  int8_t* getMemoryPtr() override { return data_.data(); }
+
+ private:
+  std::vector<int8_t> data_;
+};
+
+class EncodedIntEncoderTest : public EncoderUpdateStatsTest {
+ protected:
+  void createEncoder(const SQLTypes type,
+                     const EncodingType compression,
+                     const int comp_param = 0) {
+    auto sql_type_info = SQLTypeInfo(type, false, compression);
+    sql_type_info.set_comp_param(comp_param);
+    buffer_.reset(new MemoryTestBuffer(sql_type_info));
+  }
+
+  template <typename T>
+  void appendData(std::vector<T> data, const int64_t offset = -1) {
+    auto src_data = reinterpret_cast<int8_t*>(data.data());
+    buffer_->getEncoder()->appendData(
+        src_data, data.size(), buffer_->getSqlType(), false, offset);
+  }
+
+  template <typename T>
+  void appendReplicated(const T value, const size_t num_elems) {
+    auto src_data = reinterpret_cast<int8_t*>(const_cast<T*>(&value));
+    buffer_->getEncoder()->appendData(
+        src_data, num_elems, buffer_->getSqlType(), true);
+  }
+
+  EncodedIntStreamHeader getHeader() {
+    return *reinterpret_cast<const EncodedIntStreamHeader*>(buffer_->getMemoryPtr());
+  }
+
+  template <typename T>
+  void assertDecodesTo(const std::vector<T>& expected) {
+    ASSERT_EQ(buffer_->getEncoder()->getNumElems(), expected.size());
+    std::vector<int64_t> decoded(expected.size());
+    decode_encoded_int_stream(buffer_->getMemoryPtr(),
+                              expected.size(),
+                              inline_int_null_value<T>(),
+                              decoded.data());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(decoded[i], static_cast<int64_t>(expected[i])) << "row " << i;
+    }
+  }
+};
+
+TEST_F(EncodedIntEncoderTest, RunLengthAppend) {
+  createEncoder(kINT, kENCODING_RL);
+  const auto null_val = inline_int_null_value<int32_t>();
+  appendData(std::vector<int32_t>{5, 5, 5, 7, null_val, null_val});
+  ASSERT_EQ(getHeader().num_runs, 3);
+  // the first rows of the append extend the last run
+  appendData(std::vector<int32_t>{null_val, 9, 9});
+  ASSERT_EQ(getHeader().num_runs, 4);
+  appendReplicated<int32_t>(9, 3);
+  ASSERT_EQ(getHeader().num_runs, 4);
+  ASSERT_EQ(getHeader().byte_width, 0);
+  assertDecodesTo(std::vector<int32_t>{
+      5, 5, 5, 7, null_val, null_val, null_val, 9, 9, 9, 9, 9});
+  assertExpectedStats<int32_t>(5, 9, true);
+}
+
+TEST_F(EncodedIntEncoderTest, RunLengthRewrite) {
+  createEncoder(kBIGINT, kENCODING_RL);
+  appendData(std::vector<int64_t>{1, 1, 2, 2});
+  appendData(std::vector<int64_t>{3, 3, 3}, 0);
+  ASSERT_EQ(getHeader().num_runs, 1);
+  assertDecodesTo(std::vector<int64_t>{3, 3, 3});
+  assertExpectedStats<int64_t>(3, 3, false);
+}
+
+TEST_F(EncodedIntEncoderTest, DiffAppend) {
+  createEncoder(kBIGINT, kENCODING_DIFF, 16);
+  const auto null_val = inline_int_null_value<int64_t>();
+  const int64_t base = 1600000000;
+  appendData(std::vector<int64_t>{null_val, base, base + 100, base - 32767});
+  appendData(std::vector<int64_t>{base + 32767, null_val});
+  ASSERT_EQ(getHeader().base, base);
+  ASSERT_EQ(getHeader().byte_width, 2);
+  assertDecodesTo(std::vector<int64_t>{
+      null_val, base, base + 100, base - 32767, base + 32767, null_val});
+  assertExpectedStats<int64_t>(base - 32767, base + 32767, true);
+}
+
+TEST_F(EncodedIntEncoderTest, DiffReframe) {
+  createEncoder(kINT, kENCODING_DIFF, 8);
+  const auto null_val = inline_int_null_value<int32_t>();
+  appendData(std::vector<int32_t>{0, null_val});
+  ASSERT_EQ(getHeader().base, 0);
+  // out of the frame but within the range of one byte offsets, only re-based
+  appendData(std::vector<int32_t>{200});
+  ASSERT_EQ(getHeader().byte_width, 1);
+  ASSERT_EQ(getHeader().base, 100);
+  // the range of 255 doesn't fit one byte offsets anymore, grows to the next width
+  appendData(std::vector<int32_t>{-55});
+  ASSERT_EQ(getHeader().byte_width, 2);
+  ASSERT_EQ(getHeader().base, 72);
+  appendReplicated<int32_t>(1 << 30, 2);
+  ASSERT_EQ(getHeader().byte_width, 4);
+  ASSERT_EQ(buffer_->size(), sizeof(EncodedIntStreamHeader) + 6 * 4);
+  assertDecodesTo(std::vector<int32_t>{0, null_val, 200, -55, 1 << 30, 1 << 30});
+  assertExpectedStats<int32_t>(-55, 1 << 30, true);
+}
+
+TEST_F(EncodedIntEncoderTest, DiffRewriteNarrows) {
+  createEncoder(kBIGINT, kENCODING_DIFF, 8);
+  const int64_t big = int64_t(1) << 40;
+  appendData(std::vector<int64_t>{-big, big});
+  ASSERT_EQ(getHeader().byte_width, 8);
+  ASSERT_EQ(getHeader().base, 0);
+  appendData(std::vector<int64_t>{big, big + 1}, 0);
+  ASSERT_EQ(getHeader().byte_width, 1);
+  ASSERT_EQ(getHeader().base, big);
+  ASSERT_EQ(buffer_->size(), sizeof(EncodedIntStreamHeader) + 2);
+  assertDecodesTo(std::vector<int64_t>{big, big + 1});
+}
+
+TEST_F(EncodedIntEncoderTest, DiffAllNulls) {
+  createEncoder(kSMALLINT, kENCODING_DIFF, 8);
+  const auto null_val = inline_int_null_value<int16_t>();
+  appendData(std::vector<int16_t>{null_val, null_val});
+  appendData(std::vector<int16_t>{3});
+  ASSERT_EQ(getHeader().base, 0);
+  assertDecodesTo(std::vector<int16_t>{null_val, null_val, 3});
+  assertExpectedStats<int16_t>(3, 3, true);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
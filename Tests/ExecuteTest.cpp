@@ -21,6 +21,7 @@
 #include "../QueryEngine/ArrowResultSet.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
+#include "../QueryEngine/GroupBySpill.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
@@ -59,6 +60,19 @@ extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_overlaps_hashjoin;
 extern double g_gpu_mem_limit_percent;
 extern size_t g_parallel_top_min;
+extern bool g_enable_cpu_morsels;
+extern size_t g_cpu_morsel_min_rows;
+extern bool g_enable_tiered_compilation;
+extern bool g_enable_group_by_spill;
+extern size_t g_group_by_spill_partition_size;
+extern bool g_enable_run_length_aggregate;
+extern bool g_enable_partitioned_hash_join;
+extern size_t g_hash_join_partition_size;
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern size_t g_hash_join_build_partition_bytes;
+extern bool g_enable_hash_join_probe_prefetch;
+extern size_t g_hash_join_probe_prefetch_min_bytes;
+extern size_t g_in_values_max_bitmap_to_hash_set_ratio;
 
 extern bool g_enable_window_functions;
 extern bool g_enable_calcite_view_optimize;
@@ -7882,6 +7896,236 @@ TEST(Select, SpeculativeTopNSort) {
   }
 }
 
+TEST(Select, CpuMorsels) {
+  ScopeGuard reset = [orig_enable = g_enable_cpu_morsels,
+                      orig_min_rows = g_cpu_morsel_min_rows] {
+    g_enable_cpu_morsels = orig_enable;
+    g_cpu_morsel_min_rows = orig_min_rows;
+  };
+  // single row morsels split every fragment of the test tables
+  g_enable_cpu_morsels = true;
+  g_cpu_morsel_min_rows = 1;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*) FROM test;", dt);
+  c("SELECT SUM(x + y), MIN(z), MAX(t), AVG(ff) FROM test;", dt);
+  c("SELECT COUNT(*) FROM test WHERE x > 6 AND x < 8;", dt);
+  c("SELECT x, COUNT(*), SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+  c("SELECT str, COUNT(*) FROM test GROUP BY str ORDER BY str;", dt);
+  c("SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x, y;", dt);
+  c("SELECT x, COUNT(*) AS val FROM gpu_sort_test GROUP BY x ORDER BY val DESC, x;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.x = test_inner.x;", dt);
+  c("SELECT x, COUNT(DISTINCT y) FROM test GROUP BY x ORDER BY x;", dt);
+  c("SELECT x, y FROM test ORDER BY x, y LIMIT 5;", dt);
+}
+
+TEST(Select, TieredCompilation) {
+  ScopeGuard reset = [orig_enable = g_enable_tiered_compilation] {
+    g_enable_tiered_compilation = orig_enable;
+  };
+  g_enable_tiered_compilation = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  const auto compiled_count = Executor::waitForTieredCompilation();
+  // the first round runs baseline code, the second one the optimized code
+  for (size_t i = 0; i < 2; ++i) {
+    c("SELECT SUM(x * 3 + y), MIN(z - 1), MAX(t + 2) FROM test WHERE x <> 9;", dt);
+    c("SELECT x, COUNT(*), SUM(y * 2) FROM test WHERE y > 40 GROUP BY x ORDER BY x;",
+      dt);
+    c("SELECT str, MAX(ff) FROM test GROUP BY str ORDER BY str;", dt);
+    c("SELECT x, y FROM test WHERE z > -100 ORDER BY x, y LIMIT 7;", dt);
+    if (i == 0) {
+      ASSERT_GT(Executor::waitForTieredCompilation(), compiled_count);
+    }
+  }
+}
+
+TEST(Select, GroupBySpill) {
+  ScopeGuard reset = [orig_enable = g_enable_group_by_spill,
+                      orig_partition_size = g_group_by_spill_partition_size,
+                      orig_big_group_threshold = g_big_group_threshold] {
+    g_enable_group_by_spill = orig_enable;
+    g_group_by_spill_partition_size = orig_partition_size;
+    g_big_group_threshold = orig_big_group_threshold;
+  };
+  const std::string drop_spill_test{"DROP TABLE IF EXISTS spill_test;"};
+  run_ddl_statement(drop_spill_test);
+  g_sqlite_comparator.query(drop_spill_test);
+  run_ddl_statement(
+      "CREATE TABLE spill_test (k BIGINT, x INT, y INT, str TEXT ENCODING DICT(32)) WITH "
+      "(fragment_size=100);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE spill_test (k BIGINT, x INT, y INT, str TEXT);");
+  // keys strided by 2^32 don't fit the perfect hash layout and all share their low bits
+  for (int i = 0; i < 256; ++i) {
+    const auto k = i % 128 == 5
+                       ? std::string("NULL")
+                       : std::to_string((i % 64 - 32) * 4294967296LL);
+    const std::string insert_query{"INSERT INTO spill_test VALUES(" + k + ", " +
+                                   std::to_string(i % 7) + ", " + std::to_string(i) +
+                                   ", 'str" + std::to_string(i % 3) + "');"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // every group by estimated by the NDV estimator runs in partitions of a few groups
+  g_enable_group_by_spill = true;
+  g_group_by_spill_partition_size = 2;
+  g_big_group_threshold = 1;
+  const auto dt = ExecutorDeviceType::CPU;
+  for (const std::string query :
+       {"SELECT k, COUNT(*), SUM(y), MIN(x), MAX(y) FROM spill_test GROUP BY k ORDER BY "
+        "k NULLS FIRST;",
+        "SELECT k, x, COUNT(*), AVG(y) FROM spill_test GROUP BY k, x ORDER BY k NULLS "
+        "FIRST, x;",
+        "SELECT k, str, COUNT(*) FROM spill_test GROUP BY k, str ORDER BY k NULLS FIRST, "
+        "str;",
+        "SELECT k, COUNT(DISTINCT x) FROM spill_test GROUP BY k ORDER BY k NULLS FIRST;",
+        "SELECT k, COUNT(*) AS n FROM spill_test WHERE x > 2 GROUP BY k ORDER BY n DESC, "
+        "k NULLS FIRST;"}) {
+    const auto executed_partitions = get_executed_group_by_partition_count();
+    c(query, dt);
+    EXPECT_GT(get_executed_group_by_partition_count(), executed_partitions) << query;
+  }
+  run_ddl_statement(drop_spill_test);
+  g_sqlite_comparator.query(drop_spill_test);
+}
+
+TEST(Select, RunLengthAggregate) {
+  ScopeGuard reset = [orig_enable = g_enable_run_length_aggregate] {
+    g_enable_run_length_aggregate = orig_enable;
+  };
+  const std::string drop_rl_test{"DROP TABLE IF EXISTS rl_test;"};
+  run_ddl_statement(drop_rl_test);
+  g_sqlite_comparator.query(drop_rl_test);
+  run_ddl_statement(
+      "CREATE TABLE rl_test (sensor SMALLINT ENCODING RL, reading INT ENCODING RL, ts "
+      "TIMESTAMP(0) ENCODING RL, x INT) WITH (fragment_size=5);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE rl_test (sensor SMALLINT, reading INT, ts TIMESTAMP(0), x INT);");
+  // runs of the columns end at different rows, some of them across fragments
+  for (int i = 0; i < 23; ++i) {
+    const auto reading = i % 7 == 3 ? "NULL" : std::to_string(i / 4 * 10 - 20);
+    const std::string insert_query{"INSERT INTO rl_test VALUES(" + std::to_string(i / 6) +
+                                   ", " + reading + ", '2021-01-0" +
+                                   std::to_string(1 + i / 5) + " 00:00:00', " +
+                                   std::to_string(i) + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // aggregates evaluated on the runs return their row as a projection
+  auto aggregated_runs = [](const std::string& query) {
+    return run_multiple_agg(query, ExecutorDeviceType::CPU)->getQueryDescriptionType() ==
+           QueryDescriptionType::Projection;
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  for (const bool enable : {true, false}) {
+    g_enable_run_length_aggregate = enable;
+    for (const std::string query :
+         {"SELECT COUNT(*), COUNT(reading), SUM(reading), MIN(reading), MAX(reading), "
+          "AVG(reading) FROM rl_test;",
+          "SELECT COUNT(*), SUM(reading), MIN(sensor) FROM rl_test WHERE sensor = 2;",
+          "SELECT COUNT(*), SUM(reading), MAX(sensor) FROM rl_test WHERE sensor >= 1 AND "
+          "reading < 20;",
+          "SELECT COUNT(*), MIN(sensor), MAX(sensor) FROM rl_test WHERE reading IS NULL;",
+          "SELECT COUNT(*), AVG(reading) FROM rl_test WHERE reading IS NOT NULL AND "
+          "sensor <> 3;",
+          "SELECT COUNT(*), SUM(reading), MIN(reading), AVG(sensor) FROM rl_test WHERE "
+          "sensor > 10;"}) {
+      c(query, dt);
+      ASSERT_EQ(aggregated_runs(query), enable) << query;
+    }
+    ASSERT_EQ(v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM rl_test WHERE ts >= '2021-01-03 00:00:00';", dt)),
+              13);
+    // columns which aren't RL encoded are aggregated by the kernel
+    c("SELECT SUM(x) FROM rl_test WHERE sensor = 1;", dt);
+    ASSERT_FALSE(aggregated_runs("SELECT SUM(x) FROM rl_test WHERE sensor = 1;"));
+  }
+  run_ddl_statement(drop_rl_test);
+  g_sqlite_comparator.query(drop_rl_test);
+}
+
+TEST(Select, PartitionedHashJoin) {
+  ScopeGuard reset = [orig_enable = g_enable_partitioned_hash_join,
+                      orig_partition_size = g_hash_join_partition_size] {
+    g_enable_partitioned_hash_join = orig_enable;
+    g_hash_join_partition_size = orig_partition_size;
+  };
+  // every inner join with more than one build side row runs in partitions
+  g_enable_partitioned_hash_join = true;
+  g_hash_join_partition_size = 1;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x ORDER BY a.y, z;", dt);
+  c("SELECT a.x, b.str FROM test a JOIN test_inner b ON a.x = b.x AND a.y = b.y ORDER "
+    "BY a.x, b.str;",
+    dt);
+  c("SELECT a.x, b.x FROM test a JOIN join_test b ON a.str = b.dup_str ORDER BY a.x, "
+    "b.x;",
+    dt);
+  c("SELECT a.x, COUNT(*), SUM(a.y) FROM test a JOIN join_test b ON a.x = b.x GROUP BY "
+    "a.x ORDER BY a.x;",
+    dt);
+  c("SELECT b.dup_str, COUNT(*) FROM test a JOIN join_test b ON a.str = b.dup_str GROUP "
+    "BY b.dup_str ORDER BY b.dup_str;",
+    dt);
+  // aggregates which aren't grouped by the join key run in a single pass
+  c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.str = b.dup_str;", dt);
+  c("SELECT a.y, COUNT(*) FROM test a JOIN join_test b ON a.x = b.x GROUP BY a.y ORDER "
+    "BY a.y;",
+    dt);
+}
+
+TEST(Select, RadixPartitionedHashJoinBuild) {
+  ScopeGuard reset = [orig_enable = g_enable_radix_partitioned_hash_join_build,
+                      orig_partition_bytes = g_hash_join_build_partition_bytes] {
+    g_enable_radix_partitioned_hash_join_build = orig_enable;
+    g_hash_join_build_partition_bytes = orig_partition_bytes;
+  };
+  // every CPU hash table with no more build rows than slots is filled in partitions,
+  // rather than taken from the cache
+  g_enable_radix_partitioned_hash_join_build = true;
+  g_hash_join_build_partition_bytes = 8;
+  QR::get()->clearCpuMemory();
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x ORDER BY a.y, z;", dt);
+  c("SELECT a.x, b.str FROM test a JOIN test_inner b ON a.x = b.x AND a.y = b.y ORDER "
+    "BY a.x, b.str;",
+    dt);
+  c("SELECT a.x, b.x FROM test a JOIN join_test b ON a.str = b.str ORDER BY a.x, b.x;",
+    dt);
+  c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test_inner);", dt);
+  c("SELECT COUNT(*) FROM test a WHERE NOT EXISTS (SELECT * FROM test_inner b WHERE "
+    "a.x = b.x AND a.y = b.y);",
+    dt);
+  // duplicate keys fail the one to one fill, it is retried one to many in a single pass
+  c("SELECT a.x, b.x FROM test a JOIN join_test b ON a.str = b.dup_str ORDER BY a.x, "
+    "b.x;",
+    dt);
+}
+
+TEST(Select, HashJoinProbePrefetch) {
+  ScopeGuard reset = [orig_enable = g_enable_hash_join_probe_prefetch,
+                      orig_min_bytes = g_hash_join_probe_prefetch_min_bytes] {
+    g_enable_hash_join_probe_prefetch = orig_enable;
+    g_hash_join_probe_prefetch_min_bytes = orig_min_bytes;
+  };
+  // the probe of every CPU hash table prefetches the slots of the next block of rows
+  g_enable_hash_join_probe_prefetch = true;
+  g_hash_join_probe_prefetch_min_bytes = 0;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x ORDER BY a.y, z;", dt);
+  c("SELECT a.x, b.x FROM test a JOIN join_test b ON a.str = b.str ORDER BY a.x, b.x;",
+    dt);
+  c("SELECT a.x, b.x FROM test a JOIN join_test b ON a.str = b.dup_str ORDER BY a.x, "
+    "b.x;",
+    dt);
+  c("SELECT COUNT(*) FROM test a LEFT JOIN test_inner b ON a.x = b.x WHERE b.y IS "
+    "NULL;",
+    dt);
+  // decimals of a range too wide for a perfect hash table are joined on a baseline one
+  c("SELECT COUNT(*) FROM big_decimal_range_test a JOIN big_decimal_range_test b ON "
+    "a.d = b.d;",
+    dt);
+}
+
 TEST(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = g_bigint_count;
   ScopeGuard reset = [default_bigint_flag] { g_bigint_count = default_bigint_flag; };
@@ -8490,6 +8734,29 @@ TEST(Select, Subqueries) {
   }
 }
 
+TEST(Select, InValuesHashSet) {
+  ScopeGuard reset = [orig_ratio = g_in_values_max_bitmap_to_hash_set_ratio] {
+    g_in_values_max_bitmap_to_hash_set_ratio = orig_ratio;
+  };
+  // every set of values is probed in a hash set instead of a bitmap
+  g_in_values_max_bitmap_to_hash_set_ratio = 0;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test WHERE x IN (7, 8, 9, 10);", dt);
+    c("SELECT COUNT(*) FROM test WHERE t NOT IN (1001, 1003, 1005, 1007, 1009);", dt);
+    c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test_inner);", dt);
+    c("SELECT COUNT(*) FROM test WHERE x NOT IN (SELECT x FROM test_inner);", dt);
+    c("SELECT COUNT(*) FROM test WHERE ofd NOT IN (SELECT ofd FROM test GROUP BY ofd);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE str IN (SELECT str FROM test_in_bitmap GROUP BY "
+      "str);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE str NOT IN (SELECT str FROM test_in_bitmap GROUP "
+      "BY str);",
+      dt);
+  }
+}
+
 TEST(Select, Export_Via_Query_Having_Scalar_Subquery) {
   // EXPORT stmt needs "validation_query" to gather some info from the query
   // before doing the actual data export
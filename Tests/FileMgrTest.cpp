@@ -1133,6 +1133,8 @@ TEST_F(MaxRollbackEpochTest, WriteEmptyBufferAndMultipleEpochVersions) {
   ASSERT_EQ(static_cast<uint64_t>(2), used_page_count);
 }
 
+extern bool g_enable_direct_io_reads;
+
 constexpr char file_mgr_path[] = "./FileMgrTest";
 namespace bf = boost::filesystem;
 
@@ -1207,6 +1209,98 @@ TEST_F(FileMgrUnitTest, InitializeWithUncheckpointedAppendPages) {
   ASSERT_EQ(buffer->pageCount(), 1U);
 }
 
+TEST_F(FileMgrUnitTest, CompressedPagesWriteReadAndReopen) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  std::vector<int8_t> expected(200);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = i / 7;
+  }
+  {
+    File_Namespace::GlobalFileMgr temp_gfm(0, fsi, file_mgr_path, 0, page_size_);
+    File_Namespace::FileMgrParams file_mgr_params;
+    file_mgr_params.page_compression = "LZ4";
+    temp_gfm.setFileMgrParams(1, 1, file_mgr_params);
+    auto fm = dynamic_cast<File_Namespace::FileMgr*>(temp_gfm.getFileMgr(1, 1));
+    auto buffer =
+        dynamic_cast<File_Namespace::FileBuffer*>(fm->createBuffer({1, 1, 1, 1}));
+    ASSERT_TRUE(buffer->hasCompressedPages());
+    buffer->append(expected.data(), 100);
+    temp_gfm.checkpoint(1, 1);
+    // partial page append and update over checkpointed pages
+    buffer->append(expected.data() + 100, 100);
+    std::vector<int8_t> update(10, 42);
+    buffer->write(update.data(), update.size(), 35);
+    std::copy(update.begin(), update.end(), expected.begin() + 35);
+    temp_gfm.checkpoint(1, 1);
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = dynamic_cast<File_Namespace::FileBuffer*>(gfm.getBuffer({1, 1, 1, 1}));
+  ASSERT_TRUE(buffer->hasCompressedPages());
+  ASSERT_EQ(buffer->size(), expected.size());
+  std::vector<int8_t> read_buffer(expected.size());
+  buffer->read(read_buffer.data(), read_buffer.size());
+  ASSERT_EQ(read_buffer, expected);
+  buffer->read(read_buffer.data(), 50, 30);
+  ASSERT_EQ(std::memcmp(read_buffer.data(), expected.data() + 30, 50), 0);
+}
+
+class FileMgrReadTest : public FileMgrUnitTest,
+                        public testing::WithParamInterface<bool> {
+ protected:
+  void SetUp() override {
+    FileMgrUnitTest::SetUp();
+    g_enable_direct_io_reads = GetParam();
+  }
+  void TearDown() override {
+    g_enable_direct_io_reads = false;
+    FileMgrUnitTest::TearDown();
+  }
+};
+
+TEST_P(FileMgrReadTest, ReadsAcrossPageRuns) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  // block aligned pages, so that direct reads apply
+  constexpr size_t page_size = 4096;
+  std::vector<int8_t> expected(page_size * 10 + 11);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = i % 127;
+  }
+  {
+    File_Namespace::GlobalFileMgr temp_gfm(0, fsi, file_mgr_path, 2, page_size);
+    auto fm = dynamic_cast<File_Namespace::FileMgr*>(temp_gfm.getFileMgr(1, 1));
+    // interleaved appends split the pages of each buffer into runs in the file
+    auto buffer_1 = fm->createBuffer({1, 1, 1, 1});
+    auto buffer_2 = fm->createBuffer({1, 1, 2, 1});
+    for (size_t offset = 0; offset < expected.size(); offset += 3 * page_size) {
+      const auto num_bytes = std::min(3 * page_size, expected.size() - offset);
+      buffer_1->append(expected.data() + offset, num_bytes);
+      buffer_2->append(expected.data() + offset, num_bytes);
+    }
+    std::vector<int8_t> read_buffer(expected.size());
+    buffer_1->read(read_buffer.data(), read_buffer.size());
+    ASSERT_EQ(read_buffer, expected);
+    temp_gfm.checkpoint(1, 1);
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 2, page_size);
+  for (const int column_id : {1, 2}) {
+    auto buffer = gfm.getBuffer({1, 1, column_id, 1});
+    for (const size_t offset : {size_t(0), size_t(5), page_size + 3}) {
+      const auto num_bytes = expected.size() - offset;
+      std::vector<int8_t> read_buffer(num_bytes);
+      buffer->read(read_buffer.data(), num_bytes, offset);
+      ASSERT_EQ(std::memcmp(read_buffer.data(), expected.data() + offset, num_bytes), 0);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(BufferedAndDirectReads,
+                         FileMgrReadTest,
+                         testing::Values(false, true));
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <numeric>
+#include <random>
+
+#include "../QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
+#include "../Shared/thread_count.h"
+
+extern bool g_enable_radix_partitioned_hash_join_build;
+
+/**
+ * Fills of one to one CPU join hash tables from a build side of unique keys in random
+ * order, in a single pass of every thread over the whole table and in cache sized
+ * partitions. The argument is the number of build side rows, the perfect hash tables
+ * take 4 bytes per row and the baseline ones 32.
+ */
+
+namespace {
+
+struct BuildSide {
+  std::vector<int64_t> keys;
+  JoinChunk chunk;
+  JoinColumn column;
+  JoinColumnTypeInfo type_info;
+
+  explicit BuildSide(const size_t num_rows)
+      : keys(num_rows)
+      , chunk{nullptr, num_rows}
+      , column{nullptr, sizeof(JoinChunk), 1, num_rows, sizeof(int64_t)}
+      , type_info{sizeof(int64_t),
+                  0,
+                  static_cast<int64_t>(num_rows) - 1,
+                  inline_int_null_value<int64_t>(),
+                  false,
+                  static_cast<int64_t>(num_rows),
+                  Signed} {
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(num_rows));
+    chunk.col_buff = reinterpret_cast<const int8_t*>(keys.data());
+    column.col_chunks_buff = reinterpret_cast<const int8_t*>(&chunk);
+  }
+};
+
+// the largest build side takes 8GB, keep a single one around
+std::unique_ptr<BuildSide> build_side;
+
+const BuildSide& get_build_side(const benchmark::State& state) {
+  const size_t num_rows = state.range(0);
+  if (!build_side || build_side->keys.size() != num_rows) {
+    build_side.reset();
+    build_side = std::make_unique<BuildSide>(num_rows);
+  }
+  return *build_side;
+}
+
+template <typename FILL_FUNC>
+int fill_on_threads(const int thread_count, FILL_FUNC fill) {
+  std::vector<std::future<int>> threads;
+  for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    threads.emplace_back(std::async(std::launch::async, fill, thread_idx));
+  }
+  int err{0};
+  for (auto& thread : threads) {
+    err |= thread.get();
+  }
+  return err;
+}
+
+void fill_perfect_hash_table(benchmark::State& state, const bool partitioned) {
+  g_enable_radix_partitioned_hash_join_build = partitioned;
+  const auto& build = get_build_side(state);
+  const size_t entry_count = build.keys.size();
+  std::vector<int32_t> hash_table(entry_count);
+  const int thread_count = cpu_threads();
+  const auto partition_count = get_hash_join_build_partition_count(
+      entry_count * sizeof(int32_t), entry_count * 2 * sizeof(int32_t));
+  for (auto _ : state) {
+    std::fill(hash_table.begin(), hash_table.end(), -1);
+    int err{0};
+    if (partition_count > 1) {
+      err = fill_hash_join_buff_bucketized_partitioned(hash_table.data(),
+                                                       entry_count,
+                                                       -1,
+                                                       false,
+                                                       build.column,
+                                                       build.type_info,
+                                                       nullptr,
+                                                       nullptr,
+                                                       nullptr,
+                                                       1,
+                                                       thread_count,
+                                                       partition_count);
+    } else {
+      err = fill_on_threads(thread_count, [&](const int thread_idx) {
+        return fill_hash_join_buff_bucketized(hash_table.data(),
+                                              -1,
+                                              false,
+                                              build.column,
+                                              build.type_info,
+                                              nullptr,
+                                              nullptr,
+                                              nullptr,
+                                              thread_idx,
+                                              thread_count,
+                                              1);
+      });
+    }
+    CHECK_EQ(err, 0);
+    benchmark::DoNotOptimize(hash_table.data());
+  }
+  state.counters["partitions"] = partition_count;
+  state.SetItemsProcessed(state.iterations() * entry_count);
+}
+
+void fill_baseline_hash_table(benchmark::State& state, const bool partitioned) {
+  g_enable_radix_partitioned_hash_join_build = partitioned;
+  const auto& build = get_build_side(state);
+  // twice as many entries as keys, as the baseline join hash tables are sized
+  const size_t entry_count = 2 * build.keys.size();
+  const size_t entry_size = 2 * sizeof(int64_t);
+  std::vector<int8_t> hash_table(entry_count * entry_size);
+  const GenericKeyHandler key_handler(
+      1, true, &build.column, &build.type_info, nullptr, nullptr, nullptr);
+  const int thread_count = cpu_threads();
+  const auto partition_count = get_hash_join_build_partition_count(
+      hash_table.size(), build.keys.size() * 2 * sizeof(int64_t));
+  for (auto _ : state) {
+    init_baseline_hash_join_buff_64(hash_table.data(), entry_count, 1, true, -1, 0, 1);
+    int err{0};
+    if (partition_count > 1) {
+      err = fill_baseline_hash_join_buff_partitioned_64(hash_table.data(),
+                                                        entry_count,
+                                                        -1,
+                                                        false,
+                                                        1,
+                                                        true,
+                                                        &key_handler,
+                                                        thread_count,
+                                                        partition_count);
+    } else {
+      err = fill_on_threads(thread_count, [&](const int thread_idx) {
+        return fill_baseline_hash_join_buff_64(hash_table.data(),
+                                               entry_count,
+                                               -1,
+                                               false,
+                                               1,
+                                               true,
+                                               &key_handler,
+                                               build.keys.size(),
+                                               thread_idx,
+                                               thread_count);
+      });
+    }
+    CHECK_EQ(err, 0);
+    benchmark::DoNotOptimize(hash_table.data());
+  }
+  state.counters["partitions"] = partition_count;
+  state.SetItemsProcessed(state.iterations() * build.keys.size());
+}
+
+void build_sizes(benchmark::internal::Benchmark* benchmark) {
+  for (int64_t num_rows = 1 << 20; num_rows <= 1 << 30; num_rows *= 4) {
+    benchmark->Arg(num_rows);
+  }
+}
+
+}  // namespace
+
+static void BM_PerfectHashFill(benchmark::State& state) {
+  fill_perfect_hash_table(state, false);
+}
+
+static void BM_PerfectHashFillPartitioned(benchmark::State& state) {
+  fill_perfect_hash_table(state, true);
+}
+
+static void BM_BaselineHashFill(benchmark::State& state) {
+  fill_baseline_hash_table(state, false);
+}
+
+static void BM_BaselineHashFillPartitioned(benchmark::State& state) {
+  fill_baseline_hash_table(state, true);
+}
+
+BENCHMARK(BM_PerfectHashFill)
+    ->Apply(build_sizes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_PerfectHashFillPartitioned)
+    ->Apply(build_sizes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_BaselineHashFill)
+    ->Apply(build_sizes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_BaselineHashFillPartitioned)
+    ->Apply(build_sizes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
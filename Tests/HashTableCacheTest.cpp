@@ -0,0 +1,162 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../QueryEngine/JoinHashTable/HashTableCache.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+extern size_t g_join_hash_table_cache_max_size;
+
+namespace {
+
+struct TestKey {
+  int db_id;
+  int table_id;
+  int column_id;
+
+  bool operator==(const TestKey& that) const {
+    return db_id == that.db_id && table_id == that.table_id &&
+           column_id == that.column_id;
+  }
+
+  // deliberately collides for all columns of a table to exercise the hash buckets
+  size_t hash() const { return static_cast<size_t>(table_id); }
+
+  bool referencesTable(const int db_id, const int table_id) const {
+    return this->db_id == db_id && this->table_id == table_id;
+  }
+};
+
+using TestCache = HashTableCache<TestKey, int>;
+
+class HashTableCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    max_size_ = g_join_hash_table_cache_max_size;
+    g_join_hash_table_cache_max_size = 1000;
+  }
+
+  void TearDown() override { g_join_hash_table_cache_max_size = max_size_; }
+
+  static void put(TestCache& cache,
+                  const TestKey& key,
+                  int value,
+                  const size_t size_bytes = 0,
+                  const double build_cost_ms = 0) {
+    cache.insert(key, value, size_bytes, build_cost_ms);
+  }
+
+ private:
+  size_t max_size_;
+};
+
+}  // namespace
+
+TEST_F(HashTableCacheTest, GetAndReplace) {
+  TestCache cache;
+  put(cache, {1, 1, 1}, 11);
+  put(cache, {1, 1, 2}, 12);
+  put(cache, {1, 2, 1}, 21);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(3));
+  ASSERT_EQ(cache.get({1, 1, 2}), 12);
+  ASSERT_FALSE(cache.get({1, 1, 3}));
+
+  put(cache, {1, 1, 2}, 120);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(3));
+  ASSERT_EQ(cache.get({1, 1, 2}), 120);
+  ASSERT_EQ(cache.getCachedHashTable(0), 11);
+}
+
+TEST_F(HashTableCacheTest, TableInvalidation) {
+  TestCache cache;
+  put(cache, {1, 1, 1}, 11, 100, 10);
+  put(cache, {1, 1, 2}, 12, 100, 10);
+  put(cache, {1, 2, 1}, 21, 100, 10);
+  put(cache, {2, 1, 1}, 211, 100, 10);
+  const auto size_before = HashTableCacheBudget::getInstance().getStats();
+
+  cache.getTableCacheInvalidator()(1, 1);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(2));
+  ASSERT_FALSE(cache.get({1, 1, 1}));
+  ASSERT_EQ(cache.get({1, 2, 1}), 21);
+  ASSERT_EQ(cache.get({2, 1, 1}), 211);
+  const auto size_after = HashTableCacheBudget::getInstance().getStats();
+  ASSERT_EQ(size_before.total_size_bytes - size_after.total_size_bytes, size_t(200));
+
+  cache.getCacheInvalidator()();
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(0));
+  ASSERT_EQ(HashTableCacheBudget::getInstance().getStats().num_entries, size_t(0));
+}
+
+TEST_F(HashTableCacheTest, EvictsCheapestPerByte) {
+  TestCache cache;
+  put(cache, {1, 1, 1}, 11, 400, 400);
+  put(cache, {1, 1, 2}, 12, 400, 4);
+  // over budget, the entry which is cheapest to rebuild per byte goes first
+  put(cache, {1, 1, 3}, 13, 400, 40);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(2));
+  ASSERT_FALSE(cache.get({1, 1, 2}));
+  ASSERT_EQ(cache.get({1, 1, 1}), 11);
+  ASSERT_EQ(cache.get({1, 1, 3}), 13);
+  ASSERT_LE(HashTableCacheBudget::getInstance().getStats().total_size_bytes,
+            size_t(1000));
+}
+
+TEST_F(HashTableCacheTest, BudgetSharedAcrossCaches) {
+  TestCache perfect_cache;
+  TestCache baseline_cache;
+  put(perfect_cache, {1, 1, 1}, 11, 600, 1);
+  put(baseline_cache, {1, 2, 1}, 21, 600, 100);
+  ASSERT_EQ(perfect_cache.getNumberOfCachedHashTables(), size_t(0));
+  ASSERT_EQ(baseline_cache.getNumberOfCachedHashTables(), size_t(1));
+}
+
+TEST_F(HashTableCacheTest, OversizedEntryIsNotCached) {
+  TestCache cache;
+  put(cache, {1, 1, 1}, 11, 2000, 1000);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(0));
+  // entries without a size are not accounted for
+  put(cache, {1, 1, 2}, 12);
+  ASSERT_EQ(cache.getNumberOfCachedHashTables(), size_t(1));
+}
+
+TEST_F(HashTableCacheTest, RecentlyUsedEntriesSurvive) {
+  TestCache cache;
+  put(cache, {1, 1, 1}, 11, 400, 10);
+  put(cache, {1, 1, 2}, 12, 400, 10);
+  // evicts the first entry and raises the inflation value
+  put(cache, {1, 1, 3}, 13, 400, 10);
+  ASSERT_FALSE(cache.get({1, 1, 1}));
+  // a hit refreshes the second entry above the third one
+  ASSERT_EQ(cache.get({1, 1, 2}), 12);
+  put(cache, {1, 1, 4}, 14, 400, 10);
+  ASSERT_EQ(cache.get({1, 1, 2}), 12);
+  ASSERT_FALSE(cache.get({1, 1, 3}));
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+
+#include "../ImportExport/Importer.h"
+#include "../Logger/Logger.h"
+#include "../QueryEngine/Execute.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_cpu_morsels;
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+constexpr int64_t kNumRows{6000000};
+constexpr int64_t kFragmentSize{2500000};
+
+std::once_flag setup_flag;
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU);
+}
+
+}  // namespace
+
+/**
+ * Synthetic table with three fragments of uneven cost: rows are loaded sorted on x, so a
+ * filter on x passes (almost) only rows of the last fragment and the expensive aggregate
+ * expression is evaluated on a single fragment.
+ */
+class SkewedScanFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    std::call_once(setup_flag, global_setup);
+
+    QR::get()->runDDLStatement("DROP TABLE IF EXISTS morsel_bench;");
+    QR::get()->runDDLStatement(
+        "CREATE TABLE morsel_bench (x BIGINT, y DOUBLE) WITH (FRAGMENT_SIZE=" +
+        std::to_string(kFragmentSize) + ");");
+
+    auto cat = QR::get()->getCatalog();
+    const auto td = cat->getMetadataForTable("morsel_bench");
+    CHECK(td);
+    auto loader = QR::get()->getLoader(td);
+    CHECK(loader);
+
+    auto col_descs = loader->get_column_descs();
+    std::vector<std::unique_ptr<import_export::TypedImportBuffer>> import_buffers;
+    for (auto cd : col_descs) {
+      import_buffers.push_back(std::make_unique<import_export::TypedImportBuffer>(
+          cd, loader->getStringDict(cd)));
+    }
+    for (int64_t i = 0; i < kNumRows; i++) {
+      import_buffers[0]->addBigint(i);
+      import_buffers[1]->addDouble(0.001 * (i % 1000));
+    }
+    loader->load(import_buffers, kNumRows, nullptr);
+
+    // warm up the buffer pool and the code cache
+    run_query(query());
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    QR::get()->runDDLStatement("DROP TABLE IF EXISTS morsel_bench;");
+  }
+
+  static std::string query() {
+    return "SELECT COUNT(*), SUM(SQRT(y) * LN(y + 1.0) + EXP(y)) FROM morsel_bench "
+           "WHERE x >= " +
+           std::to_string(2 * kFragmentSize) + ";";
+  }
+};
+
+//! Skewed filtered aggregate with fragment granularity kernels (range 0) and with morsel
+//! kernels (range 1). The tail_idle_ms counter is the time CPU kernel workers spent idle
+//! waiting for the slowest kernel, per query.
+BENCHMARK_DEFINE_F(SkewedScanFixture, SkewedFilteredAggregate)(benchmark::State& state) {
+  const bool orig_enable_cpu_morsels = g_enable_cpu_morsels;
+  g_enable_cpu_morsels = state.range(0);
+  // the query runner dispatch queue has a single worker, which runs on executor 1
+  auto executor = Executor::getExecutor(/*executor_id=*/1);
+  CHECK(executor);
+  const auto idle_time_begin = executor->getKernelTailIdleTimeMs();
+  for (auto _ : state) {
+    run_query(query());
+  }
+  state.counters["tail_idle_ms"] =
+      benchmark::Counter(executor->getKernelTailIdleTimeMs() - idle_time_begin,
+                         benchmark::Counter::kAvgIterations);
+  g_enable_cpu_morsels = orig_enable_cpu_morsels;
+}
+
+BENCHMARK_REGISTER_F(SkewedScanFixture, SkewedFilteredAggregate)
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
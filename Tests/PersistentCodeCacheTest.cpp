@@ -0,0 +1,171 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../QueryEngine/PersistentCodeCache.h"
+#include "TestHelpers.h"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+namespace {
+
+class PersistentCodeCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cache_dir_ = (boost::filesystem::path(BASE_PATH) / "persistent_code_cache_test");
+    boost::filesystem::remove_all(cache_dir_);
+  }
+
+  void TearDown() override { boost::filesystem::remove_all(cache_dir_); }
+
+  std::vector<boost::filesystem::path> entryFiles() const {
+    std::vector<boost::filesystem::path> files;
+    for (const auto& entry : boost::filesystem::directory_iterator(cache_dir_)) {
+      files.push_back(entry.path());
+    }
+    return files;
+  }
+
+  boost::filesystem::path cache_dir_;
+};
+
+}  // namespace
+
+TEST_F(PersistentCodeCacheTest, PutGet) {
+  PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+  ASSERT_FALSE(cache.get("key1"));
+  cache.put("key1", "object1");
+  cache.put("key2", std::string("object\0two", 10));
+  ASSERT_EQ(*cache.get("key1"), "object1");
+  ASSERT_EQ(*cache.get("key2"), std::string("object\0two", 10));
+  const auto stats = cache.getStats();
+  ASSERT_EQ(stats.hits, size_t(2));
+  ASSERT_EQ(stats.misses, size_t(1));
+  ASSERT_EQ(stats.num_entries, size_t(2));
+}
+
+TEST_F(PersistentCodeCacheTest, SurvivesRestart) {
+  {
+    PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+    cache.put("key", "object");
+  }
+  PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+  ASSERT_EQ(cache.getStats().num_entries, size_t(1));
+  ASSERT_EQ(*cache.get("key"), "object");
+}
+
+TEST_F(PersistentCodeCacheTest, Overwrite) {
+  PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+  cache.put("key", "old");
+  cache.put("key", "new");
+  ASSERT_EQ(*cache.get("key"), "new");
+  ASSERT_EQ(cache.getStats().num_entries, size_t(1));
+  ASSERT_EQ(entryFiles().size(), size_t(1));
+}
+
+TEST_F(PersistentCodeCacheTest, CorruptedEntryIsDiscarded) {
+  {
+    PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+    cache.put("key", "object code");
+  }
+  const auto files = entryFiles();
+  ASSERT_EQ(files.size(), size_t(1));
+  {
+    // flip the last byte of the object code
+    std::fstream file(files.front().string(),
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('X');
+  }
+  PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+  ASSERT_FALSE(cache.get("key"));
+  const auto stats = cache.getStats();
+  ASSERT_EQ(stats.invalid_entries, size_t(1));
+  ASSERT_EQ(stats.num_entries, size_t(0));
+  ASSERT_TRUE(entryFiles().empty());
+}
+
+TEST_F(PersistentCodeCacheTest, TruncatedEntryIsDiscarded) {
+  {
+    PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+    cache.put("key", "object code");
+  }
+  const auto files = entryFiles();
+  ASSERT_EQ(files.size(), size_t(1));
+  boost::filesystem::resize_file(files.front(),
+                                 boost::filesystem::file_size(files[0]) - 4);
+  PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+  ASSERT_FALSE(cache.get("key"));
+  ASSERT_EQ(cache.getStats().invalid_entries, size_t(1));
+}
+
+TEST_F(PersistentCodeCacheTest, LruEviction) {
+  const std::string object(1000, 'o');
+  // room for two entries, including the key and header
+  PersistentCodeCache cache(cache_dir_.string(), 2500);
+  cache.put("key1", object);
+  cache.put("key2", object);
+  ASSERT_TRUE(cache.get("key1"));
+  cache.put("key3", object);
+  ASSERT_TRUE(cache.get("key1"));
+  ASSERT_FALSE(cache.get("key2"));
+  ASSERT_TRUE(cache.get("key3"));
+  const auto stats = cache.getStats();
+  ASSERT_EQ(stats.evictions, size_t(1));
+  ASSERT_EQ(stats.num_entries, size_t(2));
+  ASSERT_LE(stats.total_size_bytes, size_t(2500));
+  ASSERT_EQ(entryFiles().size(), size_t(2));
+}
+
+TEST_F(PersistentCodeCacheTest, ShrunkBudgetEvictsOnLoad) {
+  const std::string object(1000, 'o');
+  {
+    PersistentCodeCache cache(cache_dir_.string(), 1 << 20);
+    cache.put("key1", object);
+    cache.put("key2", object);
+    cache.put("key3", object);
+  }
+  PersistentCodeCache cache(cache_dir_.string(), 1500);
+  const auto stats = cache.getStats();
+  ASSERT_EQ(stats.num_entries, size_t(1));
+  ASSERT_LE(stats.total_size_bytes, size_t(1500));
+}
+
+TEST_F(PersistentCodeCacheTest, OversizedEntryIsNotStored) {
+  PersistentCodeCache cache(cache_dir_.string(), 100);
+  cache.put("key", std::string(1000, 'o'));
+  ASSERT_FALSE(cache.get("key"));
+  ASSERT_TRUE(entryFiles().empty());
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
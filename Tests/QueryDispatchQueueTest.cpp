@@ -0,0 +1,211 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../QueryEngine/QueryDispatchQueue.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+namespace {
+
+using Priority = QueryDispatchQueue::Priority;
+
+// Records the order in which submitted tasks start executing.
+class DispatchRecorder {
+ public:
+  DispatchRecorder(QueryDispatchQueue& queue) : queue_(queue) {}
+
+  void submit(const std::string& label,
+              const QueryDispatchQueue::TaskOptions& options,
+              const size_t sleep_ms = 10) {
+    auto task = std::make_shared<QueryDispatchQueue::Task>(
+        [this, label, sleep_ms](const size_t) {
+          record(label);
+          std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+        });
+    futures_.push_back(task->get_future());
+    queue_.submit(task, /*is_update_delete=*/false, options);
+  }
+
+  // Submits a task which occupies its worker until `release` is set, and waits for it
+  // to start so the tasks submitted next pile up in the queue.
+  void submitBlocker(const std::string& label,
+                     const QueryDispatchQueue::TaskOptions& options,
+                     std::shared_future<void> release) {
+    auto started = std::make_shared<std::promise<void>>();
+    auto task = std::make_shared<QueryDispatchQueue::Task>(
+        [this, label, started, release](const size_t) {
+          record(label);
+          started->set_value();
+          release.wait();
+        });
+    futures_.push_back(task->get_future());
+    queue_.submit(task, /*is_update_delete=*/false, options);
+    started->get_future().wait();
+  }
+
+  void record(const std::string& label) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    order_.push_back(label);
+  }
+
+  std::vector<std::string> wait() {
+    for (auto& future : futures_) {
+      future.get();
+    }
+    return order_;
+  }
+
+ private:
+  QueryDispatchQueue& queue_;
+  std::mutex order_mutex_;
+  std::vector<std::string> order_;
+  std::vector<std::future<void>> futures_;
+};
+
+// The worker releases the reservation of a task only after the task has set its future.
+QueryDispatchQueue::Stats wait_for_idle(const QueryDispatchQueue& queue) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  auto stats = queue.getStats();
+  while (stats.running > 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+    stats = queue.getStats();
+  }
+  return stats;
+}
+
+QueryDispatchQueue::TaskOptions make_options(const Priority priority,
+                                             const std::string& tenant,
+                                             const size_t estimated_memory_bytes = 0) {
+  QueryDispatchQueue::TaskOptions options;
+  options.priority = priority;
+  options.tenant = tenant;
+  options.estimated_memory_bytes = estimated_memory_bytes;
+  return options;
+}
+
+}  // namespace
+
+TEST(QueryDispatchQueue, FifoWithinFlow) {
+  QueryDispatchQueue queue(1);
+  DispatchRecorder recorder(queue);
+  for (size_t i = 0; i < 5; ++i) {
+    recorder.submit(std::to_string(i), make_options(Priority::NORMAL, "alice"), 1);
+  }
+  const auto order = recorder.wait();
+  ASSERT_EQ(order, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+}
+
+TEST(QueryDispatchQueue, InteractiveOvertakesBatch) {
+  QueryDispatchQueue queue(1);
+  DispatchRecorder recorder(queue);
+  // occupy the single worker so the remaining tasks pile up in the queue
+  std::promise<void> release_blocker;
+  recorder.submitBlocker("blocker",
+                         make_options(Priority::BATCH, "etl"),
+                         release_blocker.get_future().share());
+  for (size_t i = 0; i < 4; ++i) {
+    recorder.submit("batch", make_options(Priority::BATCH, "etl"));
+  }
+  recorder.submit("interactive", make_options(Priority::INTERACTIVE, "dashboard"));
+  release_blocker.set_value();
+  const auto order = recorder.wait();
+  ASSERT_EQ(order.size(), size_t(6));
+  // the batch flow has accumulated virtual time from the blocker, so the interactive
+  // query runs before any of the queued batch queries
+  ASSERT_EQ(order[1], "interactive");
+}
+
+TEST(QueryDispatchQueue, FairShareAcrossTenants) {
+  QueryDispatchQueue queue(1);
+  DispatchRecorder recorder(queue);
+  std::promise<void> release_blocker;
+  recorder.submitBlocker("blocker",
+                         make_options(Priority::NORMAL, "blocker"),
+                         release_blocker.get_future().share());
+  for (size_t i = 0; i < 4; ++i) {
+    recorder.submit("alice", make_options(Priority::NORMAL, "alice"));
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    recorder.submit("bob", make_options(Priority::NORMAL, "bob"));
+  }
+  release_blocker.set_value();
+  const auto order = recorder.wait();
+  ASSERT_EQ(order.size(), size_t(9));
+  for (size_t i = 1; i + 1 < order.size(); i += 2) {
+    ASSERT_NE(order[i], order[i + 1]);
+  }
+}
+
+TEST(QueryDispatchQueue, MemoryAdmission) {
+  constexpr size_t budget{100};
+  QueryDispatchQueue queue(4, budget);
+  std::atomic<size_t> running{0};
+  std::atomic<size_t> max_running{0};
+  std::vector<std::shared_ptr<QueryDispatchQueue::Task>> tasks;
+  for (size_t i = 0; i < 8; ++i) {
+    auto task =
+        std::make_shared<QueryDispatchQueue::Task>([&running, &max_running](size_t) {
+          const auto now_running = ++running;
+          size_t prev_max = max_running;
+          while (prev_max < now_running &&
+                 !max_running.compare_exchange_weak(prev_max, now_running)) {
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          --running;
+        });
+    tasks.push_back(task);
+    queue.submit(task, false, make_options(Priority::NORMAL, "alice", 60));
+  }
+  for (auto& task : tasks) {
+    task->get_future().get();
+  }
+  // two 60 byte queries never fit into the 100 byte budget together
+  ASSERT_EQ(max_running, size_t(1));
+  const auto stats = wait_for_idle(queue);
+  ASSERT_EQ(stats.running, size_t(0));
+  ASSERT_EQ(stats.reserved_memory_bytes, size_t(0));
+  ASSERT_GT(stats.admission_delays, size_t(0));
+  ASSERT_EQ(stats.per_priority[static_cast<size_t>(Priority::NORMAL)].dispatched,
+            size_t(8));
+}
+
+TEST(QueryDispatchQueue, OversizedQueryIsAdmittedWhenIdle) {
+  QueryDispatchQueue queue(2, 10);
+  auto task = std::make_shared<QueryDispatchQueue::Task>([](size_t) {});
+  queue.submit(task, false, make_options(Priority::BATCH, "etl", 1000));
+  task->get_future().get();
+  const auto stats = wait_for_idle(queue);
+  ASSERT_EQ(stats.per_priority[static_cast<size_t>(Priority::BATCH)].dispatched,
+            size_t(1));
+  ASSERT_EQ(stats.per_priority[static_cast<size_t>(Priority::BATCH)].queue_depth,
+            size_t(0));
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../QueryEngine/Descriptors/RowSetMemoryOwner.h"
+
+namespace {
+
+constexpr size_t kArenaBlockSize{1 << 20};
+// bounds the memory held by the arenas, which is only freed with the owner
+constexpr size_t kAllocationsPerThread{1 << 16};
+
+std::unique_ptr<RowSetMemoryOwner> row_set_mem_owner;
+
+void setup(const benchmark::State& state) {
+  if (state.thread_index == 0) {
+    row_set_mem_owner =
+        std::make_unique<RowSetMemoryOwner>(kArenaBlockSize, state.threads);
+  }
+}
+
+void teardown(benchmark::State& state) {
+  if (state.thread_index == 0) {
+    row_set_mem_owner.reset();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+//! Group by buffer sized allocations, each kernel thread on its own thread index.
+static void BM_AllocatePerThread(benchmark::State& state) {
+  setup(state);
+  const size_t num_bytes = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(row_set_mem_owner->allocate(num_bytes, state.thread_index));
+  }
+  teardown(state);
+}
+
+//! All threads allocating with the default thread index, which locks the state mutex.
+static void BM_AllocateSharedIndex(benchmark::State& state) {
+  setup(state);
+  const size_t num_bytes = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(row_set_mem_owner->allocate(num_bytes));
+  }
+  teardown(state);
+}
+
+//! COUNT(DISTINCT) bitmaps, which are zeroed and registered with the owner.
+static void BM_AllocateCountDistinctBuffer(benchmark::State& state) {
+  setup(state);
+  const size_t num_bytes = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        row_set_mem_owner->allocateCountDistinctBuffer(num_bytes, state.thread_index));
+  }
+  teardown(state);
+}
+
+BENCHMARK(BM_AllocatePerThread)
+    ->Arg(64)
+    ->Iterations(kAllocationsPerThread)
+    ->ThreadRange(1, 128)
+    ->UseRealTime();
+BENCHMARK(BM_AllocateSharedIndex)
+    ->Arg(64)
+    ->Iterations(kAllocationsPerThread)
+    ->ThreadRange(1, 128)
+    ->UseRealTime();
+BENCHMARK(BM_AllocateCountDistinctBuffer)
+    ->Arg(64)
+    ->Iterations(kAllocationsPerThread)
+    ->ThreadRange(1, 128)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
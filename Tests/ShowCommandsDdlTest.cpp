@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 #include "DBHandlerTestHelpers.h"
+#include "QueryEngine/ResultSetRecycler.h"
 #include "Shared/File.h"
 #include "TestHelpers.h"
 #include "boost/filesystem.hpp"
@@ -30,6 +31,7 @@
 #endif
 
 extern bool g_enable_fsi;
+extern bool g_enable_result_set_recycler;
 
 class ShowUserSessionsTest : public DBHandlerTestFixture {
  public:
@@ -1272,6 +1274,90 @@ TEST_F(ShowDiskCacheUsageForNormalTableTest, NormalTableMinimum) {
                        {table1, i(chunk_size * 2 + getWrapperSizeForTable(table1))}});
 }
 
+class ShowResultCacheUsageTest : public ShowTest {
+ protected:
+  void SetUp() override {
+    if (isDistributedMode()) {
+      GTEST_SKIP() << "Test not supported in distributed mode.";
+    }
+    DBHandlerTestFixture::SetUp();
+    switchToAdmin();
+    g_enable_result_set_recycler = true;
+    ResultSetRecycler::getInstance().clear();
+    sql("DROP TABLE IF EXISTS test_table;");
+    sql("CREATE TABLE test_table (i INTEGER, t TEXT);");
+    sql("INSERT INTO test_table VALUES (1, 'a');");
+    sql("INSERT INTO test_table VALUES (2, 'b');");
+    sql("INSERT INTO test_table VALUES (3, 'b');");
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS test_table;");
+    g_enable_result_set_recycler = false;
+    DBHandlerTestFixture::TearDown();
+  }
+
+  static ResultSetRecycler::Stats getStats() {
+    return ResultSetRecycler::getInstance().getStats();
+  }
+
+  static constexpr char const* group_by_query{
+      "SELECT t, SUM(i) FROM test_table GROUP BY t ORDER BY t;"};
+};
+
+TEST_F(ShowResultCacheUsageTest, RepeatedQuery) {
+  const auto stats_before = getStats();
+  sqlAndCompareResult(group_by_query, {{"a", i(1)}, {"b", i(5)}});
+  sqlAndCompareResult(group_by_query, {{"a", i(1)}, {"b", i(5)}});
+  const auto stats = getStats();
+  ASSERT_EQ(stats.hits - stats_before.hits, size_t(1));
+  ASSERT_EQ(stats.num_entries, size_t(1));
+  ASSERT_GT(stats.total_size_bytes, size_t(0));
+
+  const auto lookups = stats.hits + stats.misses;
+  sqlAndCompareResult("SHOW RESULT CACHE USAGE;",
+                      {{i(stats.num_entries),
+                        i(stats.total_size_bytes),
+                        i(stats.max_size_bytes),
+                        i(stats.hits),
+                        i(stats.misses),
+                        static_cast<double>(stats.hits) / lookups,
+                        i(stats.evictions)}});
+}
+
+TEST_F(ShowResultCacheUsageTest, InsertChangesKey) {
+  const auto stats_before = getStats();
+  sqlAndCompareResult(group_by_query, {{"a", i(1)}, {"b", i(5)}});
+  sql("INSERT INTO test_table VALUES (4, 'a');");
+  sqlAndCompareResult(group_by_query, {{"a", i(5)}, {"b", i(5)}});
+  ASSERT_EQ(getStats().hits, stats_before.hits);
+}
+
+TEST_F(ShowResultCacheUsageTest, DeleteInvalidates) {
+  sqlAndCompareResult(group_by_query, {{"a", i(1)}, {"b", i(5)}});
+  ASSERT_EQ(getStats().num_entries, size_t(1));
+  sql("DELETE FROM test_table WHERE i = 2;");
+  ASSERT_EQ(getStats().num_entries, size_t(0));
+  sqlAndCompareResult(group_by_query, {{"a", i(1)}, {"b", i(3)}});
+}
+
+TEST_F(ShowResultCacheUsageTest, SubqueryResult) {
+  const std::string query{
+      "SELECT COUNT(*) FROM test_table WHERE i > (SELECT MIN(i) FROM test_table);"};
+  sqlAndCompareResult(query, {{i(2)}});
+  // the outer query and the subquery
+  ASSERT_EQ(getStats().num_entries, size_t(2));
+  const auto stats_before = getStats();
+  sqlAndCompareResult(query, {{i(2)}});
+  // the subquery still runs ahead of the outer query, both are recycled
+  ASSERT_EQ(getStats().hits - stats_before.hits, size_t(2));
+}
+
+TEST_F(ShowResultCacheUsageTest, NonDeterministicQuery) {
+  sql("SELECT COUNT(*) FROM test_table WHERE NOW() > TIMESTAMP '2000-01-01 00:00:00';");
+  ASSERT_EQ(getStats().num_entries, size_t(0));
+}
+
 class ShowTableDetailsTest : public ShowTest,
                              public testing::WithParamInterface<int32_t> {
  protected:
@@ -16,16 +16,24 @@
 
 #include "TestHelpers.h"
 
+#include "../Shared/scope.h"
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
 
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
+#include <thread>
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
 #endif
 
 extern bool g_cache_string_hash;
+extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_trigram_index;
 
 TEST(StringDictionary, AddAndGet) {
   StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
@@ -101,6 +109,258 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, GetOrAddBulkExistingAndNewStrings) {
+  ScopeGuard reset_flag = [] { g_enable_stringdict_parallel = false; };
+  for (const bool parallel : {false, true}) {
+    g_enable_stringdict_parallel = parallel;
+    StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+    ASSERT_EQ(0, string_dict.getOrAdd("a"));
+    ASSERT_EQ(1, string_dict.getOrAdd("b"));
+    const std::vector<std::string> strings{"b", "c", "", "a", "c", "d"};
+    std::vector<int32_t> ids(strings.size());
+    string_dict.getOrAddBulk(strings, ids.data());
+    const std::vector<int32_t> expected_ids{
+        1, 2, inline_int_null_value<int32_t>(), 0, 2, 3};
+    EXPECT_EQ(expected_ids, ids);
+    // only existing strings, which don't take the write lock
+    string_dict.getOrAddBulk(strings, ids.data());
+    EXPECT_EQ(expected_ids, ids);
+    EXPECT_EQ(size_t(4), string_dict.storageEntryCount());
+  }
+}
+
+TEST(StringDictionary, GetOrAddBulkWithConcurrentReads) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  ASSERT_EQ(0, string_dict.getOrAdd("first"));
+  std::vector<std::string> strings;
+  for (int i = 0; i < 10000; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  std::thread writer([&string_dict, &strings] {
+    std::vector<int32_t> ids(strings.size());
+    for (int batch = 0; batch < 10; ++batch) {
+      string_dict.getOrAddBulk(strings, ids.data());
+      for (size_t i = 0; i < ids.size(); ++i) {
+        CHECK_EQ(static_cast<int32_t>(i + 1), ids[i]);
+      }
+    }
+  });
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ("first", string_dict.getString(0));
+    ASSERT_EQ(0, string_dict.getIdOfString("first"));
+  }
+  writer.join();
+  EXPECT_EQ(size_t(10001), string_dict.storageEntryCount());
+}
+
+TEST(StringDictionary, GetSortedRanks) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  std::vector<std::string> strings;
+  const auto check_ranks = [&] {
+    const auto ranks = string_dict.getSortedRanks(strings.size(), strings.size());
+    ASSERT_EQ(strings.size(), ranks->size());
+    for (size_t i = 1; i < strings.size(); ++i) {
+      ASSERT_EQ(strings[i - 1] < strings[i], (*ranks)[i - 1] < (*ranks)[i]);
+    }
+  };
+  // strings arrive out of order across generations, ranks are rebuilt for each
+  std::shared_ptr<const std::vector<int32_t>> last_ranks;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      strings.push_back(std::to_string((i * 7919 + round) % 5003) + "_" +
+                        std::to_string(round));
+      ASSERT_EQ(static_cast<int32_t>(strings.size() - 1),
+                string_dict.getOrAdd(strings.back()));
+    }
+    // sorting a few ids gets the ranks last built, current for the previous generation
+    EXPECT_EQ(last_ranks, string_dict.getSortedRanks(10, strings.size()));
+    EXPECT_EQ(last_ranks, string_dict.getSortedRanks(1000, strings.size() - 1000));
+    check_ranks();
+    last_ranks = string_dict.getSortedRanks(strings.size(), strings.size());
+    EXPECT_EQ(last_ranks, string_dict.getSortedRanks(1, strings.size()));
+  }
+}
+
+TEST(StringDictionaryProxy, GetOrAddTransient) {
+  auto string_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  ASSERT_EQ(0, string_dict->getOrAdd("foo"));
+  StringDictionaryProxy proxy(string_dict, string_dict->storageEntryCount());
+  ASSERT_EQ(1, string_dict->getOrAdd("past generation"));
+  EXPECT_EQ(0, proxy.getOrAddTransient("foo"));
+  EXPECT_EQ(-2, proxy.getOrAddTransient("bar"));
+  EXPECT_EQ(-3, proxy.getOrAddTransient("past generation"));
+  EXPECT_EQ(-2, proxy.getOrAddTransient("bar"));
+  // enough strings to grow the hash table and the string blocks a few times
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100000; ++i) {
+    strings.push_back("transient " + std::to_string(i));
+  }
+  strings.emplace_back(100000, 'x');
+  const auto ids = proxy.getOrAddTransientBulk(strings);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(StringDictionaryProxy::transientIndexToId(i + 2), ids[i]);
+    ASSERT_EQ(ids[i], proxy.getIdOfString(strings[i]));
+    ASSERT_EQ(strings[i], proxy.getString(ids[i]));
+  }
+  EXPECT_EQ(ids, proxy.getOrAddTransientBulk(strings));
+  EXPECT_EQ(StringDictionary::INVALID_STR_ID, proxy.getIdOfString("missing"));
+  const auto bytes = proxy.getStringBytes(-3);
+  EXPECT_EQ("past generation", std::string(bytes.first, bytes.second));
+
+  const auto transient_strings = proxy.getTransientStrings();
+  ASSERT_EQ(strings.size() + 2, transient_strings.size());
+  EXPECT_EQ("bar", transient_strings[0]);
+  EXPECT_EQ(std::vector<int32_t>{-2}, proxy.getLike("bar", false, true, '\\'));
+  EXPECT_EQ(std::vector<int32_t>{ids[12345]},
+            proxy.getRegexpLike("transient 12345", '\\'));
+}
+
+TEST(StringDictionaryProxy, TranslateStringId) {
+  auto source_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  auto dest_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  for (int i = 0; i < 10000; ++i) {
+    source_dict->getOrAdd("str" + std::to_string(i));
+    if (i % 3 == 0) {
+      dest_dict->getOrAdd("str" + std::to_string(9999 - i));
+    }
+  }
+  StringDictionaryProxy source_proxy(source_dict, source_dict->storageEntryCount());
+  // the strings of the last third of the destination are past its generation
+  StringDictionaryProxy dest_proxy(dest_dict, 2 * dest_dict->storageEntryCount() / 3);
+  dest_dict->getOrAdd("str2");
+  EXPECT_EQ(nullptr, source_proxy.getTranslationMap(&dest_proxy, 100));
+  const auto translation_map = source_proxy.getTranslationMap(&dest_proxy, 10000);
+  ASSERT_NE(nullptr, translation_map);
+  for (int32_t string_id = 0; string_id < 10000; ++string_id) {
+    const auto expected_id = dest_proxy.getIdOfString(source_proxy.getString(string_id));
+    ASSERT_EQ(expected_id, source_proxy.translateStringId(string_id, &dest_proxy));
+    ASSERT_EQ(expected_id,
+              source_proxy.translateStringId(string_id, &dest_proxy, translation_map));
+  }
+  EXPECT_EQ(StringDictionary::INVALID_STR_ID,
+            source_proxy.translateStringId(
+                source_dict->getIdOfString("str2"), &dest_proxy, translation_map));
+  // kept by the proxy once built, whatever the number of ids
+  EXPECT_EQ(translation_map, source_proxy.getTranslationMap(&dest_proxy, 1));
+  const auto transient_id = source_proxy.getOrAddTransient("str9999");
+  EXPECT_EQ(0,
+            source_proxy.translateStringId(transient_id, &dest_proxy, translation_map));
+  // the strings missing from a map could be transient strings of the destination
+  dest_proxy.getOrAddTransient("str1");
+  EXPECT_EQ(nullptr, source_proxy.getTranslationMap(&dest_proxy, 10000));
+  EXPECT_EQ(dest_proxy.getIdOfString("str1"),
+            source_proxy.translateStringId(source_dict->getIdOfString("str1"),
+                                           &dest_proxy));
+  // the identity within a dictionary
+  const auto identity_map = source_proxy.getTranslationMap(&source_proxy, 10000);
+  ASSERT_NE(nullptr, identity_map);
+  EXPECT_EQ(123, source_proxy.translateStringId(123, &source_proxy, identity_map));
+}
+
+TEST(StringDictionary, TranslationMapCache) {
+  auto source_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  for (int i = 0; i < 100; ++i) {
+    source_dict->getOrAdd("str" + std::to_string(i));
+  }
+  std::vector<std::shared_ptr<StringDictionary>> dest_dicts;
+  for (int i = 0; i < 9; ++i) {
+    dest_dicts.push_back(
+        std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash));
+    dest_dicts.back()->getOrAdd("str" + std::to_string(i));
+  }
+  const auto first_map = source_dict->getTranslationMap(dest_dicts[0], 100, 1);
+  EXPECT_EQ(first_map, source_dict->getTranslationMap(dest_dicts[0], 100, 1));
+  EXPECT_EQ(0, (*first_map)[0]);
+  for (size_t i = 1; i < dest_dicts.size(); ++i) {
+    source_dict->getTranslationMap(dest_dicts[i], 100, 1);
+  }
+  // the map of the least recently used destination was dropped for the ninth one
+  EXPECT_NE(first_map, source_dict->getTranslationMap(dest_dicts[0], 100, 1));
+  // as are the maps of destroyed destinations
+  const auto last_map = source_dict->getTranslationMap(dest_dicts.back(), 100, 1);
+  dest_dicts.back().reset();
+  source_dict->getTranslationMap(dest_dicts[1], 100, 1);
+  EXPECT_EQ(1, last_map.use_count());
+}
+
+namespace {
+
+std::vector<int32_t> sorted(std::vector<int32_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+void add_trigram_test_strings(StringDictionary& string_dict, const int begin) {
+  for (int i = begin; i < begin + 1000; ++i) {
+    string_dict.getOrAdd("Item_" + std::to_string(i) + (i % 3 ? "_red" : "_Blue"));
+  }
+}
+
+}  // namespace
+
+TEST(StringDictionary, TrigramIndexMatchesScan) {
+  ScopeGuard reset_flag = [] { g_enable_stringdict_trigram_index = false; };
+  StringDictionary scanned_dict(BASE_PATH, true, false, g_cache_string_hash);
+  StringDictionary indexed_dict(BASE_PATH, true, false, g_cache_string_hash);
+  add_trigram_test_strings(scanned_dict, 0);
+  add_trigram_test_strings(indexed_dict, 0);
+  const size_t generation = 900;
+  g_enable_stringdict_trigram_index = true;
+  const std::vector<std::tuple<std::string, bool, bool>> like_patterns{
+      {"12", false, true},
+      {"_blue", false, true},
+      {"_blue", true, true},
+      {"item\\_1%red", true, false},
+      {"%5_\\_bl%", true, false},
+      {"%_red", false, false},
+      {"xyz", false, true}};
+  for (const auto& [pattern, icase, is_simple] : like_patterns) {
+    g_enable_stringdict_trigram_index = false;
+    const auto expected =
+        sorted(scanned_dict.getLike(pattern, icase, is_simple, '\\', generation));
+    g_enable_stringdict_trigram_index = true;
+    EXPECT_EQ(expected,
+              sorted(indexed_dict.getLike(pattern, icase, is_simple, '\\', generation)))
+        << pattern;
+  }
+  for (const auto& pattern : {"Item_1[0-9]+_red",
+                              "Item_(12|34)[0-9]*_red",
+                              "Item_7{2}.*_Blue",
+                              "I?tem_99[^0-9]red",
+                              ".*_B.ue"}) {
+    g_enable_stringdict_trigram_index = false;
+    const auto expected = sorted(scanned_dict.getRegexpLike(pattern, '\\', generation));
+    g_enable_stringdict_trigram_index = true;
+    EXPECT_EQ(expected, sorted(indexed_dict.getRegexpLike(pattern, '\\', generation)))
+        << pattern;
+  }
+}
+
+TEST(StringDictionary, TrigramIndexRecover) {
+  ScopeGuard reset_flag = [] { g_enable_stringdict_trigram_index = false; };
+  g_enable_stringdict_trigram_index = true;
+  std::vector<int32_t> expected;
+  {
+    StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+    add_trigram_test_strings(string_dict, 0);
+    EXPECT_EQ(size_t(334), string_dict.getLike("blue", true, true, '\\', 1000).size());
+    ASSERT_TRUE(string_dict.checkpoint());
+    EXPECT_TRUE(boost::filesystem::exists(std::string(BASE_PATH) + "/DictTrigrams"));
+    // indexed as they are added, the index saved at the checkpoint covers them
+    add_trigram_test_strings(string_dict, 1000);
+    ASSERT_TRUE(string_dict.checkpoint());
+    expected = sorted(string_dict.getLike("%7_blue", true, false, '\\', 2000));
+  }
+  StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+  ASSERT_EQ(size_t(2000), string_dict.storageEntryCount());
+  EXPECT_EQ(expected, sorted(string_dict.getLike("%7_blue", true, false, '\\', 2000)));
+  EXPECT_EQ(size_t(66), expected.size());
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
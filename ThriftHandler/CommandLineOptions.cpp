@@ -48,6 +48,30 @@ extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern bool g_enable_cpu_morsels;
+extern size_t g_cpu_morsel_min_rows;
+extern bool g_enable_persistent_code_cache;
+extern size_t g_persistent_code_cache_max_size;
+extern bool g_enable_tiered_compilation;
+extern bool g_enable_result_set_recycler;
+extern size_t g_result_set_recycler_max_size;
+extern size_t g_join_hash_table_cache_max_size;
+extern bool g_enable_direct_io_reads;
+extern bool g_enable_segmented_lru_buffer_pool;
+extern bool g_enable_numa_affinity;
+extern bool g_enable_transparent_huge_pages;
+extern bool g_use_explicit_huge_pages;
+extern bool g_enable_slab_prefaulting;
+extern bool g_enable_group_by_spill;
+extern size_t g_group_by_spill_partition_size;
+extern bool g_enable_run_length_aggregate;
+extern bool g_enable_partitioned_hash_join;
+extern size_t g_hash_join_partition_size;
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern size_t g_hash_join_build_partition_bytes;
+extern bool g_enable_hash_join_probe_prefetch;
+extern size_t g_hash_join_probe_prefetch_min_bytes;
+extern size_t g_in_values_max_bitmap_to_hash_set_ratio;
 
 namespace Catalog_Namespace {
 extern bool g_log_user_id;
@@ -364,6 +388,36 @@ void CommandLineOptions::fillOptions() {
   help_desc.add_options()("disk-cache-size",
                           po::value<std::uint64_t>(&(disk_cache_config.size_limit)),
                           "Specify a maximum size for the disk cache in bytes.");
+  help_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Keep the object code of compiled CPU queries in the data directory, so queries "
+      "compiled before a restart do not need to be compiled again.");
+  help_desc.add_options()(
+      "persistent-code-cache-size",
+      po::value<size_t>(&g_persistent_code_cache_max_size)
+          ->default_value(g_persistent_code_cache_max_size),
+      "Maximum size of the persistent code cache in bytes.");
+  help_desc.add_options()(
+      "enable-result-set-recycler",
+      po::value<bool>(&g_enable_result_set_recycler)
+          ->default_value(g_enable_result_set_recycler)
+          ->implicit_value(true),
+      "Keep the results of queries and subqueries in memory and reuse them when the "
+      "same query runs again over unchanged tables.");
+  help_desc.add_options()(
+      "result-set-recycler-size",
+      po::value<size_t>(&g_result_set_recycler_max_size)
+          ->default_value(g_result_set_recycler_max_size),
+      "Maximum size of the result sets held by the result set recycler in bytes.");
+  help_desc.add_options()(
+      "join-hash-table-cache-size",
+      po::value<size_t>(&g_join_hash_table_cache_max_size)
+          ->default_value(g_join_hash_table_cache_max_size),
+      "Maximum size of the cached join hash tables in bytes. Hash tables which are cheap "
+      "to rebuild relative to their size are evicted first.");
 
 #ifdef HAVE_AWS_S3
   help_desc.add_options()(
@@ -405,6 +459,13 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "enable-stringdict-trigram-index",
+      po::value<bool>(&g_enable_stringdict_trigram_index)
+          ->default_value(g_enable_stringdict_trigram_index)
+          ->implicit_value(true),
+      "Narrow down the strings matched against LIKE and REGEXP patterns with a trigram "
+      "index of the dictionary");
   help_desc.add_options()(
       "log-user-id",
       po::value<bool>(&Catalog_Namespace::g_log_user_id)
@@ -476,10 +537,158 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_group_by)
           ->implicit_value(true),
       "Enable using GPU shared memory for some GROUP BY queries.");
+  developer_desc.add_options()(
+      "enable-cpu-morsels",
+      po::value<bool>(&g_enable_cpu_morsels)
+          ->default_value(g_enable_cpu_morsels)
+          ->implicit_value(true),
+      "Split CPU aggregate kernels over large fragments into row range morsels which are "
+      "scheduled dynamically across CPU threads.");
+  developer_desc.add_options()(
+      "cpu-morsel-min-rows",
+      po::value<size_t>(&g_cpu_morsel_min_rows)->default_value(g_cpu_morsel_min_rows),
+      "Minimum number of rows in a CPU kernel morsel.");
+  developer_desc.add_options()(
+      "enable-tiered-compilation",
+      po::value<bool>(&g_enable_tiered_compilation)
+          ->default_value(g_enable_tiered_compilation)
+          ->implicit_value(true),
+      "Run new CPU queries with unoptimized code while the optimized code is compiled "
+      "in the background.");
+  developer_desc.add_options()(
+      "enable-direct-io-reads",
+      po::value<bool>(&g_enable_direct_io_reads)
+          ->default_value(g_enable_direct_io_reads)
+          ->implicit_value(true),
+      "Read table data files with O_DIRECT, bypassing the OS page cache, where pages "
+      "are block aligned.");
+  developer_desc.add_options()(
+      "enable-segmented-lru-buffer-pool",
+      po::value<bool>(&g_enable_segmented_lru_buffer_pool)
+          ->default_value(g_enable_segmented_lru_buffer_pool)
+          ->implicit_value(true),
+      "Protect chunks referenced more than once from eviction by chunks fetched only "
+      "once, e.g. by a large scan. Otherwise the least recently used chunks are "
+      "evicted first.");
+  developer_desc.add_options()(
+      "enable-numa-affinity",
+      po::value<bool>(&g_enable_numa_affinity)
+          ->default_value(g_enable_numa_affinity)
+          ->implicit_value(true),
+      "Spread the fragments of tables over the NUMA nodes in the CPU buffer pool and run "
+      "CPU kernels on the node holding their fragment.");
+  developer_desc.add_options()(
+      "enable-transparent-huge-pages",
+      po::value<bool>(&g_enable_transparent_huge_pages)
+          ->default_value(g_enable_transparent_huge_pages)
+          ->implicit_value(true),
+      "Advise the CPU buffer pool slabs and query output arenas for transparent huge "
+      "pages. Off by default, since the kernel may compact memory to back them and the "
+      "unused tail of an arena is rounded up to a whole huge page.");
+  developer_desc.add_options()(
+      "use-explicit-huge-pages",
+      po::value<bool>(&g_use_explicit_huge_pages)
+          ->default_value(g_use_explicit_huge_pages)
+          ->implicit_value(true),
+      "Allocate the CPU buffer pool slabs and query output arenas from the huge page "
+      "pool reserved in /proc/sys/vm/nr_hugepages, falling back to regular pages when "
+      "the pool is exhausted.");
+  developer_desc.add_options()(
+      "enable-slab-prefaulting",
+      po::value<bool>(&g_enable_slab_prefaulting)
+          ->default_value(g_enable_slab_prefaulting)
+          ->implicit_value(true),
+      "Fault in the pages of new CPU buffer pool slabs in the background, rather than "
+      "on first touch in query kernels.");
+  developer_desc.add_options()(
+      "enable-group-by-spill",
+      po::value<bool>(&g_enable_group_by_spill)
+          ->default_value(g_enable_group_by_spill)
+          ->implicit_value(true),
+      "Execute group by queries with more groups than fit in memory in partitions of the "
+      "groups, spilling the results of finished partitions to a temporary file. Every "
+      "partition is a scan of the input.");
+  developer_desc.add_options()(
+      "group-by-spill-partition-size",
+      po::value<size_t>(&g_group_by_spill_partition_size)
+          ->default_value(g_group_by_spill_partition_size),
+      "Group by queries estimated to need more groups buffer entries than this are "
+      "executed in partitions of about this many entries.");
+  developer_desc.add_options()(
+      "enable-run-length-aggregate",
+      po::value<bool>(&g_enable_run_length_aggregate)
+          ->default_value(g_enable_run_length_aggregate)
+          ->implicit_value(true),
+      "Evaluate filters and non-grouped aggregates which only reference RL encoded "
+      "columns once per run of equal values rather than once per row.");
+  developer_desc.add_options()(
+      "enable-partitioned-hash-join",
+      po::value<bool>(&g_enable_partitioned_hash_join)
+          ->default_value(g_enable_partitioned_hash_join)
+          ->implicit_value(true),
+      "Execute inner joins with more build side rows than fit in a hash table in "
+      "partitions of the build side, one pass over the probe side per partition.");
+  developer_desc.add_options()(
+      "hash-join-partition-size",
+      po::value<size_t>(&g_hash_join_partition_size)
+          ->default_value(g_hash_join_partition_size),
+      "Inner joins with more build side rows than this are executed in partitions of "
+      "about this many build side rows.");
+  developer_desc.add_options()(
+      "enable-radix-partitioned-hash-join-build",
+      po::value<bool>(&g_enable_radix_partitioned_hash_join_build)
+          ->default_value(g_enable_radix_partitioned_hash_join_build)
+          ->implicit_value(true),
+      "Fill CPU hash join tables larger than the build partition size by first "
+      "partitioning the build side rows by their hash table slot, then inserting one "
+      "partition at a time.");
+  developer_desc.add_options()(
+      "hash-join-build-partition-bytes",
+      po::value<size_t>(&g_hash_join_build_partition_bytes)
+          ->default_value(g_hash_join_build_partition_bytes),
+      "Size in bytes of the hash table partitions filled at a time when building CPU "
+      "hash join tables in partitions, about the size of the L2 cache.");
+  developer_desc.add_options()(
+      "enable-hash-join-probe-prefetch",
+      po::value<bool>(&g_enable_hash_join_probe_prefetch)
+          ->default_value(g_enable_hash_join_probe_prefetch)
+          ->implicit_value(true),
+      "Prefetch the CPU hash join table slots of the next block of outer rows while "
+      "probing the current one.");
+  developer_desc.add_options()(
+      "hash-join-probe-prefetch-min-bytes",
+      po::value<size_t>(&g_hash_join_probe_prefetch_min_bytes)
+          ->default_value(g_hash_join_probe_prefetch_min_bytes),
+      "Minimum size in bytes of a CPU hash join table for its probe to be prefetched.");
+  developer_desc.add_options()(
+      "in-values-max-bitmap-to-hash-set-ratio",
+      po::value<size_t>(&g_in_values_max_bitmap_to_hash_set_ratio)
+          ->default_value(g_in_values_max_bitmap_to_hash_set_ratio),
+      "The values of IN lists and IN subqueries are probed in a hash set rather than a "
+      "bitmap spanning their range if the bitmap would be this many times larger.");
   developer_desc.add_options()("num-executors",
                                po::value<int>(&system_parameters.num_executors)
                                    ->default_value(system_parameters.num_executors),
                                "Number of executors to run in parallel.");
+  developer_desc.add_options()(
+      "dispatch-queue-memory-budget",
+      po::value<size_t>(&system_parameters.dispatch_queue_memory_budget)
+          ->default_value(system_parameters.dispatch_queue_memory_budget),
+      "Upper bound (in bytes) on the estimated input size of concurrently running "
+      "queries. Queries exceeding the budget wait in the dispatch queue. 0 (default) "
+      "disables admission control.");
+  developer_desc.add_options()(
+      "dispatch-queue-interactive-users",
+      po::value<std::string>(&system_parameters.dispatch_queue_interactive_users)
+          ->default_value(system_parameters.dispatch_queue_interactive_users),
+      "Comma separated list of users whose queries are dispatched at interactive "
+      "(highest) priority.");
+  developer_desc.add_options()(
+      "dispatch-queue-batch-users",
+      po::value<std::string>(&system_parameters.dispatch_queue_batch_users)
+          ->default_value(system_parameters.dispatch_queue_batch_users),
+      "Comma separated list of users whose queries are dispatched at batch (lowest) "
+      "priority. Updates and deletes always run at batch priority.");
   developer_desc.add_options()(
       "gpu-shared-mem-threshold",
       po::value<size_t>(&g_gpu_smem_threshold)->default_value(g_gpu_smem_threshold),
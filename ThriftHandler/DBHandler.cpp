@@ -140,6 +140,20 @@ struct ForceDisconnect : public std::runtime_error {
   ForceDisconnect(const std::string& cause) : std::runtime_error(cause) {}
 };
 
+std::unordered_set<std::string> parse_dispatch_user_list(const std::string& user_list) {
+  std::unordered_set<std::string> users;
+  if (user_list.empty()) {
+    return users;
+  }
+  for (const auto& user : split(user_list, ",")) {
+    const auto user_name = strip(user);
+    if (!user_name.empty()) {
+      users.insert(user_name);
+    }
+  }
+  return users;
+}
+
 }  // namespace
 
 template <>
@@ -263,8 +277,9 @@ DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
     , authMetadata_(authMetadata)
     , system_parameters_(system_parameters)
     , legacy_syntax_(legacy_syntax)
-    , dispatch_queue_(
-          std::make_unique<QueryDispatchQueue>(system_parameters.num_executors))
+    , dispatch_queue_(std::make_unique<QueryDispatchQueue>(
+          system_parameters.num_executors,
+          system_parameters.dispatch_queue_memory_budget))
     , super_user_rights_(false)
     , idle_session_duration_(idle_session_duration * 60)
     , max_session_duration_(max_session_duration * 60)
@@ -289,6 +304,10 @@ DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
 
 {
   LOG(INFO) << "OmniSci Server " << MAPD_RELEASE;
+  dispatch_interactive_users_ =
+      parse_dispatch_user_list(system_parameters.dispatch_queue_interactive_users);
+  dispatch_batch_users_ =
+      parse_dispatch_user_list(system_parameters.dispatch_queue_batch_users);
   initialize(is_new_db);
 }
 
@@ -2637,6 +2656,68 @@ void DBHandler::clear_gpu_memory(const TSessionId& session) {
   }
 }
 
+void DBHandler::get_dispatch_queue_status(TDispatchQueueStatus& _return,
+                                          const TSessionId& session) {
+  auto stdlog = STDLOG(get_session_ptr(session));
+  stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
+  CHECK(dispatch_queue_);
+  const auto stats = dispatch_queue_->getStats();
+  _return.num_workers = stats.num_workers;
+  _return.running = stats.running;
+  _return.reserved_memory_bytes = stats.reserved_memory_bytes;
+  _return.memory_budget_bytes = stats.memory_budget_bytes;
+  _return.admission_delays = stats.admission_delays;
+  const std::array<std::string, QueryDispatchQueue::kNumPriorities> priority_names{
+      {"interactive", "normal", "batch"}};
+  for (size_t i = 0; i < stats.per_priority.size(); ++i) {
+    const auto& priority_stats = stats.per_priority[i];
+    TDispatchQueuePriorityStats tstats;
+    tstats.priority = priority_names[i];
+    tstats.queue_depth = priority_stats.queue_depth;
+    tstats.dispatched = priority_stats.dispatched;
+    tstats.total_wait_ms = priority_stats.total_wait_ms;
+    tstats.max_wait_ms = priority_stats.max_wait_ms;
+    _return.priority_stats.push_back(tstats);
+  }
+}
+
+QueryDispatchQueue::TaskOptions DBHandler::getDispatchOptions(
+    const Catalog_Namespace::SessionInfo& session_info,
+    const lockmgr::LockedTableDescriptors& locks,
+    const bool is_update_delete) const {
+  QueryDispatchQueue::TaskOptions options;
+  const auto& user_name = session_info.get_currentUser().userName;
+  options.tenant = user_name;
+  if (is_update_delete || dispatch_batch_users_.count(user_name)) {
+    options.priority = QueryDispatchQueue::Priority::BATCH;
+  } else if (dispatch_interactive_users_.count(user_name)) {
+    options.priority = QueryDispatchQueue::Priority::INTERACTIVE;
+  }
+  if (system_parameters_.dispatch_queue_memory_budget == 0) {
+    return options;
+  }
+  // Estimate the query footprint by the uncompressed size of the fixed width columns of
+  // every table the query reads. This overestimates for selective projections, which is
+  // the conservative direction for admission control.
+  const auto& cat = session_info.getCatalog();
+  for (const auto& lock : locks) {
+    const auto td = (*lock)();
+    if (!td || td->isView || !td->fragmenter) {
+      continue;
+    }
+    size_t row_width{0};
+    for (const auto cd :
+         cat.getAllColumnMetadataForTable(td->tableId, false, false, false)) {
+      const auto col_size = cd->columnType.get_size();
+      if (col_size > 0) {
+        row_width += col_size;
+      }
+    }
+    options.estimated_memory_bytes += row_width * td->fragmenter->getNumRows();
+  }
+  return options;
+}
+
 void DBHandler::clear_cpu_memory(const TSessionId& session) {
   auto stdlog = STDLOG(get_session_ptr(session));
   stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
@@ -6038,9 +6119,11 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
                                    Executor::UNITARY_EXECUTOR_ID,
                                    QuerySessionStatus::QueryStatus::PENDING_QUEUE);
     }
+    const bool is_update_delete = pw.getDMLType() == ParserWrapper::DMLType::Update ||
+                                  pw.getDMLType() == ParserWrapper::DMLType::Delete;
     dispatch_queue_->submit(execute_rel_alg_task,
-                            pw.getDMLType() == ParserWrapper::DMLType::Update ||
-                                pw.getDMLType() == ParserWrapper::DMLType::Delete);
+                            is_update_delete,
+                            getDispatchOptions(*session_ptr, locks, is_update_delete));
     auto result_future = execute_rel_alg_task->get_future();
     result_future.get();
     return;
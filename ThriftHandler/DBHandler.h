@@ -255,6 +255,8 @@ class DBHandler : public OmniSciIf {
   void get_memory(std::vector<TNodeMemoryInfo>& _return,
                   const TSessionId& session,
                   const std::string& memory_level) override;
+  void get_dispatch_queue_status(TDispatchQueueStatus& _return,
+                                 const TSessionId& session) override;
   void clear_cpu_memory(const TSessionId& session) override;
   void clear_gpu_memory(const TSessionId& session) override;
   void set_cur_session(const TSessionId& parent_session,
@@ -603,6 +605,13 @@ class DBHandler : public OmniSciIf {
   const bool legacy_syntax_;
 
   std::unique_ptr<QueryDispatchQueue> dispatch_queue_;
+  std::unordered_set<std::string> dispatch_interactive_users_;
+  std::unordered_set<std::string> dispatch_batch_users_;
+
+  QueryDispatchQueue::TaskOptions getDispatchOptions(
+      const Catalog_Namespace::SessionInfo& session_info,
+      const lockmgr::LockedTableDescriptors& locks,
+      const bool is_update_delete) const;
 
   template <typename... ARGS>
   std::shared_ptr<query_state::QueryState> create_query_state(ARGS&&... args) {
@@ -426,6 +426,73 @@ void validate_and_set_date_encoding(ColumnDescriptor& cd, int encoding_size) {
   cd.columnType.set_comp_param((encoding_size == 16) ? 16 : 0);
 }
 
+void validate_and_set_rl_encoding(ColumnDescriptor& cd) {
+  // run length encoding
+  if (cd.columnType.get_type() == kARRAY) {
+    throw std::runtime_error(cd.columnName + ": Cannot apply RL encoding to arrays.");
+  }
+  const auto type = cd.columnType.get_type();
+  if (!IS_INTEGER(type) && !is_datetime(type) &&
+      !(type == kDECIMAL || type == kNUMERIC)) {
+    throw std::runtime_error(
+        cd.columnName + ": RL encoding is only supported for integer or time columns.");
+  }
+  cd.columnType.set_compression(kENCODING_RL);
+  cd.columnType.set_comp_param(0);
+}
+
+void validate_and_set_diff_encoding(ColumnDescriptor& cd, int encoding_size) {
+  // differential encoding, as offsets from a per-chunk frame of reference
+  if (cd.columnType.get_type() == kARRAY) {
+    throw std::runtime_error(cd.columnName + ": Cannot apply DIFF encoding to arrays.");
+  }
+  const auto type = cd.columnType.get_type();
+  switch (type) {
+    case kSMALLINT:
+      if (encoding_size == 0) {
+        encoding_size = 8;
+      }
+      if (encoding_size != 8) {
+        throw std::runtime_error(
+            cd.columnName +
+            ": Compression parameter for DIFF encoding on SMALLINT must be 8.");
+      }
+      break;
+    case kINT:
+      if (encoding_size == 0) {
+        encoding_size = 16;
+      }
+      if (encoding_size != 8 && encoding_size != 16) {
+        throw std::runtime_error(
+            cd.columnName +
+            ": Compression parameter for DIFF encoding on INTEGER must be 8 or 16.");
+      }
+      break;
+    case kBIGINT:
+    case kDECIMAL:
+    case kNUMERIC:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      if (encoding_size == 0) {
+        encoding_size = 32;
+      }
+      if (encoding_size != 8 && encoding_size != 16 && encoding_size != 32) {
+        throw std::runtime_error(cd.columnName +
+                                 ": Compression parameter for DIFF encoding on "
+                                 "BIGINT, DECIMAL or time types must be 8 or 16 or 32.");
+      }
+      break;
+    default:
+      throw std::runtime_error(
+          cd.columnName +
+          ": DIFF encoding is only supported for SMALLINT, INTEGER, BIGINT, DECIMAL or "
+          "time columns.");
+  }
+  cd.columnType.set_compression(kENCODING_DIFF);
+  cd.columnType.set_comp_param(encoding_size);
+}
+
 void validate_and_set_encoding(ColumnDescriptor& cd,
                                const Encoding* encoding,
                                const SqlType* column_type) {
@@ -436,15 +503,9 @@ void validate_and_set_encoding(ColumnDescriptor& cd,
     if (boost::iequals(comp, "fixed")) {
       validate_and_set_fixed_encoding(cd, encoding->get_encoding_param(), column_type);
     } else if (boost::iequals(comp, "rl")) {
-      // run length encoding
-      cd.columnType.set_compression(kENCODING_RL);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
+      validate_and_set_rl_encoding(cd);
     } else if (boost::iequals(comp, "diff")) {
-      // differential encoding
-      cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      validate_and_set_diff_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "dict")) {
       validate_and_set_dictionary_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "NONE")) {
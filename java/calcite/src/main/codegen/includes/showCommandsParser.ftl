@@ -94,6 +94,21 @@ SqlDdl SqlShowDiskCacheUsage(Span s) : {
     )
 }
 
+/*
+ * Show usage of the query result cache using the following syntax:
+ *
+ * SHOW RESULT CACHE USAGE
+ */
+SqlDdl SqlShowResultCacheUsage(Span s) :
+{
+}
+{
+    <SHOW> <RESULT> <CACHE> <USAGE>
+    {
+        return new SqlShowResultCacheUsage(s.end(this));
+    }
+}
+
 /*
  * Show table details using the following syntax:
  *
@@ -0,0 +1,19 @@
+package com.mapd.parser.extension.ddl;
+
+import org.apache.calcite.sql.SqlKind;
+import org.apache.calcite.sql.SqlOperator;
+import org.apache.calcite.sql.SqlSpecialOperator;
+import org.apache.calcite.sql.parser.SqlParserPos;
+
+/**
+ * Class that encapsulates all information associated with a SHOW RESULT CACHE USAGE DDL
+ * command.
+ */
+public class SqlShowResultCacheUsage extends SqlShowCommand {
+  private static final SqlOperator OPERATOR =
+          new SqlSpecialOperator("SHOW_RESULT_CACHE_USAGE", SqlKind.OTHER_DDL);
+
+  public SqlShowResultCacheUsage(final SqlParserPos pos) {
+    super(OPERATOR, pos);
+  }
+}
@@ -87,4 +87,13 @@ public class ShowCommandTest extends DDLTest {
             gson.fromJson(result.plan_result, JsonObject.class);
     assertEquals(expectedJsonObject, actualJsonObject);
   }
+
+  @Test
+  public void showResultCacheUsage() throws Exception {
+    final JsonObject expectedJsonObject = getJsonFromFile("show_result_cache_usage.json");
+    final TPlanResult result = processDdlCommand("SHOW RESULT CACHE USAGE;");
+    final JsonObject actualJsonObject =
+            gson.fromJson(result.plan_result, JsonObject.class);
+    assertEquals(expectedJsonObject, actualJsonObject);
+  }
 }
@@ -293,6 +293,23 @@ struct TNodeMemoryInfo {
   6: list<TMemoryData> node_memory_data;
 }
 
+struct TDispatchQueuePriorityStats {
+  1: string priority;
+  2: i64 queue_depth;
+  3: i64 dispatched;
+  4: i64 total_wait_ms;
+  5: i64 max_wait_ms;
+}
+
+struct TDispatchQueueStatus {
+  1: i64 num_workers;
+  2: i64 running;
+  3: i64 reserved_memory_bytes;
+  4: i64 memory_budget_bytes;
+  5: i64 admission_delays;
+  6: list<TDispatchQueuePriorityStats> priority_stats;
+}
+
 struct TTableMeta {
   1: string table_name;
   2: i64 num_cols;
@@ -567,6 +584,7 @@ service OmniSci {
   void stop_heap_profile(1: TSessionId session) throws (1: TOmniSciException e)
   string get_heap_profile(1: TSessionId session) throws (1: TOmniSciException e)
   list<TNodeMemoryInfo> get_memory(1: TSessionId session, 2: string memory_level) throws (1: TOmniSciException e)
+  TDispatchQueueStatus get_dispatch_queue_status(1: TSessionId session) throws (1: TOmniSciException e)
   void clear_cpu_memory(1: TSessionId session) throws (1: TOmniSciException e)
   void clear_gpu_memory(1: TSessionId session) throws (1: TOmniSciException e)
   void set_cur_session(1: TSessionId parent_session, 2: TSessionId leaf_session, 3: string start_time_str, 4: string label) throws (1: TOmniSciException e)